@@ -19,11 +19,47 @@ namespace bs
 		, curveVersion(0), layerIdx((UINT32)-1), stateIdx((UINT32)-1)
 	{ }
 
+	/** Maximum difference between a bone matrix and the matrix rebuilt from its decomposed values, per element. */
+	static constexpr float KEY_POSE_DECOMPOSITION_TOLERANCE = 0.0001f;
+
+	AnimationKeyPoseBone::AnimationKeyPoseBone(const Matrix4& transform)
+		:transform(transform)
+	{
+		transform.decomposition(position, rotation, scale);
+
+		// Decomposition isn't exact for matrices with shear, which can result from non-uniform scale in the hierarchy
+		const Matrix4 rebuilt = Matrix4::TRS(position, rotation, scale);
+
+		isDecomposed = true;
+		for (UINT32 row = 0; row < 3; row++)
+		{
+			for (UINT32 column = 0; column < 4; column++)
+			{
+				const float value = transform[row][column];
+				const float tolerance = KEY_POSE_DECOMPOSITION_TOLERANCE * std::max(1.0f, Math::abs(value));
+
+				if (Math::abs(rebuilt[row][column] - value) > tolerance)
+					isDecomposed = false;
+			}
+		}
+	}
+
+	Matrix4 AnimationKeyPoseBone::interpolate(const AnimationKeyPoseBone& from, const AnimationKeyPoseBone& to, float t)
+	{
+		if (!from.isDecomposed || !to.isDecomposed)
+			return from.transform * (1.0f - t) + to.transform * t;
+
+		return Matrix4::TRS(
+			Vector3::lerp(t, from.position, to.position),
+			Quaternion::lerp(t, from.rotation, to.rotation),
+			Vector3::lerp(t, from.scale, to.scale));
+	}
+
 	AnimationProxy::AnimationProxy(UINT64 id)
 		: id(id), layers(nullptr), numLayers(0), numSceneObjects(0), sceneObjectInfos(nullptr)
 		, sceneObjectTransforms(nullptr), morphChannelInfos(nullptr), morphShapeInfos(nullptr), numMorphChannels(0)
-		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), numGenericCurves(0)
-		, genericCurveOutputs(nullptr)
+		, numMorphShapes(0), numMorphVertices(0), morphChannelWeightsDirty(false), mCullEnabled(true), lodKeyPoseIdx(0)
+		, lodUpdateInterval(1), lodKeyPosesValid(false), numGenericCurves(0), genericCurveOutputs(nullptr)
 	{ }
 
 	AnimationProxy::~AnimationProxy()
@@ -438,12 +474,14 @@ namespace bs
 					if (isClipValid)
 					{
 						state.curves = clipInfo.clip->getCurves();
+						state.compressedCurves = clipInfo.clip->getCompressedCurves();
 						state.disabled = clipInfo.playbackType == AnimPlaybackType::None;
 					}
 					else
 					{
 						static SPtr<AnimationCurves> zeroCurves = bs_shared_ptr_new<AnimationCurves>();
 						state.curves = zeroCurves;
+						state.compressedCurves = nullptr;
 						state.disabled = true;
 					}
 
@@ -731,6 +769,15 @@ namespace bs
 		mDirty |= AnimDirtyStateFlag::Culling;
 	}
 
+	void Animation::setLODLevels(const Vector<AnimationLODLevel>& levels)
+	{
+		mLODLevels = levels;
+		std::stable_sort(mLODLevels.begin(), mLODLevels.end(), 
+			[](const AnimationLODLevel& a, const AnimationLODLevel& b) { return a.distance < b.distance; });
+
+		mDirty |= AnimDirtyStateFlag::LOD;
+	}
+
 	void Animation::play(const HAnimationClip& clip)
 	{
 		AnimationClipInfo* clipInfo = addClip(clip, (UINT32)-1);
@@ -1310,6 +1357,17 @@ namespace bs
 			mDirty.unset(AnimDirtyStateFlag::Culling);
 		}
 
+		// LOD masks need to be rebuilt whenever the skeleton mask changes, which is part of a full rebuild
+		if (mDirty.isSet(AnimDirtyStateFlag::LOD) || mDirty.isSet(AnimDirtyStateFlag::All))
+		{
+			mAnimProxy->lodLevels = mLODLevels;
+			for (auto& level : mAnimProxy->lodLevels)
+				level.mask = level.mask.intersect(mSkeletonMask);
+
+			mAnimProxy->lodKeyPosesValid = false;
+			mDirty.unset(AnimDirtyStateFlag::LOD);
+		}
+
 		auto getAnimatedSOList = [&]()
 		{
 			Vector<AnimatedSceneObject> animatedSO(mSceneObjects.size());
@@ -43,6 +43,37 @@ namespace bs
 		bool stopped = false;
 	};
 
+	/** 
+	 * Determines how an animation is evaluated once it is far enough from the viewer, allowing distant animations to
+	 * trade quality for a reduced evaluation cost.
+	 */
+	struct BS_CORE_EXPORT AnimationLODLevel
+	{
+		/** 
+		 * Distance from the nearest camera to the animation bounds, in world units, from which on this level is used. 
+		 */
+		float distance = 0.0f;
+
+		/** 
+		 * Number of animation updates between two consecutive evaluations of the skeleton pose. Poses for the 
+		 * updates in-between are interpolated from the two most recently evaluated poses. Value of 1 evaluates the pose
+		 * on every update.
+		 */
+		UINT32 updateInterval = 1;
+
+		/** If true, animation clips played on additive layers will be ignored. */
+		bool skipAdditiveLayers = false;
+
+		/** If true, morph shapes will not be re-evaluated and will keep the last evaluated shape. */
+		bool skipMorphShapes = false;
+
+		/** 
+		 * Determines which bones are evaluated. Combined with the mask provided to Animation::setMask(). Bones disabled
+		 * by the mask remain in their default pose.
+		 */
+		SkeletonMask mask;
+	};
+
 	/** @} */
 
 	/** @addtogroup Animation-Internal
@@ -57,7 +88,8 @@ namespace bs
 		Layout = 1 << 1,
 		All = 1 << 2,
 		Culling = 1 << 3,
-		MorphWeights = 1 << 4
+		MorphWeights = 1 << 4,
+		LOD = 1 << 5
 	};
 
 	typedef Flags<AnimDirtyStateFlag> AnimDirtyState;
@@ -171,6 +203,31 @@ namespace bs
 		UINT32 hash; /**< Hash value of the scene object's transform. */
 	};
 
+	/** 
+	 * Transform of a single bone in a skeleton key pose, used for interpolating poses of animations that aren't
+	 * evaluated on every update.
+	 */
+	struct BS_CORE_EXPORT AnimationKeyPoseBone
+	{
+		AnimationKeyPoseBone() = default;
+
+		/** Initializes the bone from its pose matrix, decomposing it into position, rotation and scale if possible. */
+		AnimationKeyPoseBone(const Matrix4& transform);
+
+		/** 
+		 * Interpolates between two bone transforms. Position and scale are interpolated linearly and rotation using a
+		 * normalized linear interpolation, so the interpolated bone is never sheared or shrunk by a rotation. Matrices
+		 * are blended linearly instead if either of them can't be represented by a position, rotation and scale.
+		 */
+		static Matrix4 interpolate(const AnimationKeyPoseBone& from, const AnimationKeyPoseBone& to, float t);
+
+		Matrix4 transform = Matrix4::IDENTITY;
+		Vector3 position = Vector3::ZERO;
+		Quaternion rotation = Quaternion::IDENTITY;
+		Vector3 scale = Vector3::ONE;
+		bool isDecomposed = false; /**< True if @p transform is exactly represented by the decomposed values. */
+	};
+
 	/** Represents a copy of the Animation data for use specifically on the animation thread. */
 	struct AnimationProxy
 	{
@@ -268,6 +325,14 @@ namespace bs
 		AABox mBounds;
 		bool mCullEnabled;
 
+		// Level of detail
+		Vector<AnimationLODLevel> lodLevels; /**< Sorted by distance, with masks combined with @p skeletonMask. */
+		Vector<AnimationKeyPoseBone> lodKeyPoses; /**< Two most recently evaluated skeleton poses, for interpolation. */
+		LocalSkeletonPose lodKeyLocalPoses[2]; /**< Local bone transforms of the poses in @p lodKeyPoses. */
+		UINT32 lodKeyPoseIdx; /**< Index of the most recently evaluated pose in @p lodKeyPoses. */
+		UINT32 lodUpdateInterval; /**< Update interval in use when the key poses were evaluated. */
+		bool lodKeyPosesValid;
+
 		// Single frame sample
 		AnimSampleStep sampleStep = AnimSampleStep::None;
 
@@ -340,6 +405,17 @@ namespace bs
 		/** @copydoc setCulling */
 		bool getCulling() const { return mCull; }
 
+		/**
+		 * Determines levels of detail used for reducing the evaluation cost of the animation when it is far away from 
+		 * the viewer. The level with the largest distance not exceeding the distance between the nearest camera and the
+		 * bounds provided in setBounds() is used. If no level applies, or no levels are provided, the animation is 
+		 * fully evaluated on every update. If there are no cameras the most distant level is used.
+		 */
+		void setLODLevels(const Vector<AnimationLODLevel>& levels);
+
+		/** @copydoc setLODLevels */
+		const Vector<AnimationLODLevel>& getLODLevels() const { return mLODLevels; }
+
 		/** 
 		 * Plays the specified animation clip. 
 		 *
@@ -537,6 +613,7 @@ namespace bs
 		float mDefaultSpeed;
 		AABox mBounds;
 		bool mCull;
+		Vector<AnimationLODLevel> mLODLevels;
 		AnimDirtyState mDirty;
 
 		SPtr<Skeleton> mSkeleton;
@@ -79,17 +79,50 @@ namespace bs
 			generic.erase(iterFind);
 	}
 
+	CompressedAnimationCurves::CompressedAnimationCurves(const AnimationCurves& curves)
+	{
+		position.reserve(curves.position.size());
+		for (auto& entry : curves.position)
+			position.emplace_back(entry.curve);
+
+		rotation.reserve(curves.rotation.size());
+		for (auto& entry : curves.rotation)
+			rotation.emplace_back(entry.curve);
+
+		scale.reserve(curves.scale.size());
+		for (auto& entry : curves.scale)
+			scale.emplace_back(entry.curve);
+	}
+
+	UINT32 CompressedAnimationCurves::getMemorySize() const
+	{
+		UINT32 size = sizeof(*this);
+		for (auto& entry : position)
+			size += entry.getMemorySize();
+
+		for (auto& entry : rotation)
+			size += entry.getMemorySize();
+
+		for (auto& entry : scale)
+			size += entry.getMemorySize();
+
+		return size;
+	}
+
 	AnimationClip::AnimationClip()
 		: Resource(false), mVersion(0), mCurves(bs_shared_ptr_new<AnimationCurves>())
-		, mRootMotion(bs_shared_ptr_new<RootMotion>()), mIsAdditive(false), mLength(0.0f), mSampleRate(1)
+		, mRootMotion(bs_shared_ptr_new<RootMotion>())
+		, mCompressedCurves(bs_shared_ptr_new<CompressedAnimationCurves>()), mIsCompressed(false), mIsAdditive(false)
+		, mLength(0.0f), mSampleRate(1)
 	{
 
 	}
 
 	AnimationClip::AnimationClip(const SPtr<AnimationCurves>& curves, bool isAdditive, UINT32 sampleRate, 
 		const SPtr<RootMotion>& rootMotion)
-		: Resource(false), mVersion(0), mCurves(curves), mRootMotion(rootMotion), mIsAdditive(isAdditive), mLength(0.0f)
-		, mSampleRate(sampleRate)
+		: Resource(false), mVersion(0), mCurves(curves), mRootMotion(rootMotion)
+		, mCompressedCurves(bs_shared_ptr_new<CompressedAnimationCurves>()), mIsCompressed(false)
+		, mIsAdditive(isAdditive), mLength(0.0f), mSampleRate(sampleRate)
 	{
 		if (mCurves == nullptr)
 			mCurves = bs_shared_ptr_new<AnimationCurves>();
@@ -139,12 +172,61 @@ namespace bs
 	void AnimationClip::setCurves(const AnimationCurves& curves)
 	{
 		*mCurves = curves;
+		mCompressedCurves = bs_shared_ptr_new<CompressedAnimationCurves>();
+		mIsCompressed = false;
 
 		buildNameMapping();
 		calculateLength();
 		mVersion++;
 	}
 
+	void AnimationClip::compress()
+	{
+		if (mIsCompressed)
+			return;
+
+		// Curves may be in use by the animation thread, so the existing ones cannot be modified
+		SPtr<CompressedAnimationCurves> compressedCurves = bs_shared_ptr_new<CompressedAnimationCurves>(*mCurves);
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>(*mCurves);
+
+		// Keep the curve entries so the name mapping and curve indices remain valid
+		for (auto& entry : curves->position)
+			entry.curve = TAnimationCurve<Vector3>();
+
+		for (auto& entry : curves->rotation)
+			entry.curve = TAnimationCurve<Quaternion>();
+
+		for (auto& entry : curves->scale)
+			entry.curve = TAnimationCurve<Vector3>();
+
+		mCurves = curves;
+		mCompressedCurves = compressedCurves;
+		mIsCompressed = true;
+		mVersion++;
+	}
+
+	void AnimationClip::decompress()
+	{
+		if (!mIsCompressed)
+			return;
+
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>(*mCurves);
+
+		for (UINT32 i = 0; i < (UINT32)curves->position.size(); i++)
+			curves->position[i].curve = mCompressedCurves->position[i].decompress();
+
+		for (UINT32 i = 0; i < (UINT32)curves->rotation.size(); i++)
+			curves->rotation[i].curve = mCompressedCurves->rotation[i].decompress();
+
+		for (UINT32 i = 0; i < (UINT32)curves->scale.size(); i++)
+			curves->scale[i].curve = mCompressedCurves->scale[i].decompress();
+
+		mCurves = curves;
+		mCompressedCurves = bs_shared_ptr_new<CompressedAnimationCurves>();
+		mIsCompressed = false;
+		mVersion++;
+	}
+
 	bool AnimationClip::hasRootMotion() const
 	{
 		return mRootMotion != nullptr && 
@@ -166,6 +248,15 @@ namespace bs
 
 		for (auto& entry : mCurves->generic)
 			mLength = std::max(mLength, entry.curve.getLength());
+
+		for (auto& entry : mCompressedCurves->position)
+			mLength = std::max(mLength, entry.getLength());
+
+		for (auto& entry : mCompressedCurves->rotation)
+			mLength = std::max(mLength, entry.getLength());
+
+		for (auto& entry : mCompressedCurves->scale)
+			mLength = std::max(mLength, entry.getLength());
 	}
 
 	void AnimationClip::buildNameMapping()
@@ -91,6 +91,30 @@ namespace bs
 		Vector<TNamedAnimationCurve<float>> generic;
 	};
 
+	/**
+	 * Compressed versions of translation/rotation/scale curves from AnimationCurves. Each compressed curve is stored at
+	 * the same index as the curve it was created from.
+	 */
+	struct BS_CORE_EXPORT CompressedAnimationCurves
+	{
+		CompressedAnimationCurves() = default;
+
+		/** Compresses the translation/rotation/scale curves in the provided set of curves. */
+		explicit CompressedAnimationCurves(const AnimationCurves& curves);
+
+		/** Returns the amount of memory used by all the curves, in bytes. */
+		UINT32 getMemorySize() const;
+
+		/** Curves for animating scene object's position. */
+		Vector<TCompressedAnimationCurve<Vector3>> position;
+
+		/** Curves for animating scene object's rotation. */
+		Vector<TCompressedAnimationCurve<Quaternion>> rotation;
+
+		/** Curves for animating scene object's scale. */
+		Vector<TCompressedAnimationCurve<Vector3>> scale;
+	};
+
 	/** Contains a set of animation curves used for moving and rotating the root bone. */
 	struct BS_SCRIPT_EXPORT(m:Animation) RootMotion
 	{
@@ -178,6 +202,31 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:RootMotion,pr:getter)
 		SPtr<RootMotion> getRootMotion() const { return mRootMotion; }
 
+		/**
+		 * Converts the translation/rotation/scale curves of the clip into a quantized format that uses significantly
+		 * less memory, and is evaluated directly by the animation system. After compression the curve entries returned
+		 * by getCurves() remain, but contain no keyframes. Generic curves are not affected.
+		 */
+		void compress();
+
+		/**
+		 * Restores the curves compressed by compress() into their regular form. Restored curves will differ from the
+		 * original ones by the quantization error introduced by compression.
+		 */
+		void decompress();
+
+		/** Checks have the translation/rotation/scale curves of the clip been compressed. See compress(). */
+		bool isCompressed() const { return mIsCompressed; }
+
+		/**
+		 * Returns compressed versions of the translation/rotation/scale curves, or null if the clip isn't compressed.
+		 * Returned value is immutable and may be used from other threads.
+		 */
+		SPtr<CompressedAnimationCurves> getCompressedCurves() const
+		{
+			return mIsCompressed ? mCompressedCurves : nullptr;
+		}
+
 		/** Checks if animation clip has root motion curves separate from the normal animation curves. */
 		BS_SCRIPT_EXPORT(n:HasRootMotion,pr:getter)
 		bool hasRootMotion() const;
@@ -305,6 +354,13 @@ namespace bs
 		 */
 		SPtr<RootMotion> mRootMotion;
 
+		/**
+		 * Compressed translation/rotation/scale curves, valid only if @p mIsCompressed is true. Immutable, same as
+		 * @p mCurves.
+		 */
+		SPtr<CompressedAnimationCurves> mCompressedCurves;
+		bool mIsCompressed;
+
 		/** 
 		 * Contains a map from curve name to curve index. Indices are stored as specified in CurveType enum. 
 		 */
@@ -802,15 +802,16 @@ namespace bs
 			}
 			else
 			{
+				// Search backwards, so the closest key preceding the time is found
 				const UINT32 start = (UINT32)std::max(0, (INT32)animInstance.cachedKey - (INT32)CACHE_LOOKAHEAD);
-				for(UINT32 i = start; i < animInstance.cachedKey; i++)
+				for(UINT32 i = animInstance.cachedKey; i > start; i--)
 				{
-					const KeyFrame& prevKey = mKeyframes[i];
+					const KeyFrame& prevKey = mKeyframes[i - 1];
 
 					if (time >= prevKey.time)
 					{
-						leftKey = i;
-						rightKey = i + 1;
+						leftKey = i - 1;
+						rightKey = i;
 
 						animInstance.cachedKey = leftKey;
 						return;
@@ -981,6 +982,75 @@ namespace bs
 			mKeyframes[i].value = impl::getDiff(mKeyframes[i].value, refKey.value);
 	}
 
+	template <class T>
+	TAnimationCurve<T> TAnimationCurve<T>::reduce(float maxError) const
+	{
+		const auto numKeys = (UINT32)mKeyframes.size();
+		if (numKeys <= 2)
+			return *this;
+
+		// Limits the number of original keys a single reduced segment can span, so the reduction doesn't become
+		// quadratic on long constant or linear curves
+		constexpr UINT32 MAX_SEGMENT_SPAN = 256;
+
+		const auto isWithinError = [&](const KeyFrame& lhs, const KeyFrame& rhs, float time, const T& expected)
+		{
+			const T value = impl::evaluate(lhs, rhs, time);
+			for (UINT32 i = 0; i < impl::getNumComponents<T>(); i++)
+			{
+				if (!(Math::abs(impl::getComponent(value, i) - impl::getComponent(expected, i)) <= maxError))
+					return false;
+			}
+
+			return true;
+		};
+
+		// Checks if a segment between the two keys reproduces the original curve, at all the original keys in-between,
+		// as well as in the middle of each of the original segments
+		const auto canSkipKeys = [&](UINT32 start, UINT32 end)
+		{
+			const KeyFrame& lhs = mKeyframes[start];
+			const KeyFrame& rhs = mKeyframes[end];
+
+			if (end - start > MAX_SEGMENT_SPAN || rhs.time <= lhs.time)
+				return false;
+
+			for (UINT32 i = start; i < end; i++)
+			{
+				const KeyFrame& segmentStart = mKeyframes[i];
+				const KeyFrame& segmentEnd = mKeyframes[i + 1];
+
+				if (segmentEnd.time <= segmentStart.time)
+					return false;
+
+				if (i > start && !isWithinError(lhs, rhs, segmentStart.time, segmentStart.value))
+					return false;
+
+				const float midTime = (segmentStart.time + segmentEnd.time) * 0.5f;
+				if (!isWithinError(lhs, rhs, midTime, impl::evaluate(segmentStart, segmentEnd, midTime)))
+					return false;
+			}
+
+			return true;
+		};
+
+		Vector<KeyFrame> keyframes;
+		keyframes.push_back(mKeyframes[0]);
+
+		UINT32 lastKeptKey = 0;
+		for (UINT32 i = 2; i < numKeys; i++)
+		{
+			if (canSkipKeys(lastKeptKey, i))
+				continue;
+
+			lastKeptKey = i - 1;
+			keyframes.push_back(mKeyframes[lastKeptKey]);
+		}
+
+		keyframes.push_back(mKeyframes[numKeys - 1]);
+		return TAnimationCurve<T>(keyframes);
+	}
+
 	template <class T>
 	std::pair<float, float> TAnimationCurve<T>::getTimeRange() const
 	{
@@ -1145,9 +1215,304 @@ namespace bs
 		}
 	}
 
+	/** Quantizes a value in range [min, min + scale * maxQuantized] to an integer in range [0, maxQuantized]. */
+	static UINT16 quantize(float value, float min, float scale, INT32 maxQuantized)
+	{
+		if (scale <= 0.0f)
+			return 0;
+
+		return (UINT16)Math::clamp(Math::roundToInt((value - min) / scale), 0, maxQuantized);
+	}
+
+	template <class T>
+	TCompressedAnimationCurve<T>::TCompressedAnimationCurve(const TAnimationCurve<T>& curve)
+		:mStart(curve.mStart), mEnd(curve.mEnd), mLength(curve.mLength)
+	{
+		const Vector<TKeyframe<T>>& keyframes = curve.getKeyFrames();
+		const auto numKeys = (UINT32)keyframes.size();
+		if (numKeys == 0)
+			return;
+
+		constexpr float INFINITY_VAL = std::numeric_limits<float>::infinity();
+
+		// Find the ranges of values and tangents, per component. Step tangents are encoded separately so they are not
+		// included in the range.
+		float valueMax[NUM_COMPONENTS];
+		float tangentMax[NUM_COMPONENTS];
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+		{
+			mValueMin[i] = mTangentMin[i] = INFINITY_VAL;
+			valueMax[i] = tangentMax[i] = -INFINITY_VAL;
+		}
+
+		for (auto& entry : keyframes)
+		{
+			for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+			{
+				const float value = impl::getComponent(entry.value, i);
+				mValueMin[i] = std::min(mValueMin[i], value);
+				valueMax[i] = std::max(valueMax[i], value);
+
+				const float inTangent = impl::getComponent(entry.inTangent, i);
+				const float outTangent = impl::getComponent(entry.outTangent, i);
+
+				for (float tangent : { inTangent, outTangent })
+				{
+					if (tangent == INFINITY_VAL)
+						continue;
+
+					mTangentMin[i] = std::min(mTangentMin[i], tangent);
+					tangentMax[i] = std::max(tangentMax[i], tangent);
+				}
+			}
+		}
+
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+		{
+			if (mTangentMin[i] > tangentMax[i])
+				mTangentMin[i] = tangentMax[i] = 0.0f;
+
+			mValueScale[i] = (valueMax[i] - mValueMin[i]) / 65535.0f;
+			mTangentScale[i] = (tangentMax[i] - mTangentMin[i]) / (float)(INFINITE_TANGENT - 1);
+		}
+
+		mTimeStart = keyframes[0].time;
+		mTimeScale = (keyframes[numKeys - 1].time - mTimeStart) / 65535.0f;
+
+		mTimes.resize(numKeys);
+		mKeys.resize(numKeys * KEY_STRIDE);
+
+		for (UINT32 i = 0; i < numKeys; i++)
+		{
+			const TKeyframe<T>& entry = keyframes[i];
+			mTimes[i] = quantize(entry.time, mTimeStart, mTimeScale, 65535);
+
+			// Keys must not start later than the original ones, so evaluating exactly at the key time (e.g. at a step)
+			// yields the key's value
+			while (mTimes[i] > 0 && mTimeStart + mTimes[i] * mTimeScale > entry.time)
+				mTimes[i]--;
+		}
+
+		// On long curves with closely spaced keys the quantization step can be larger than the spacing, in which case
+		// neighbouring keys could end up at the same time
+		bool timesDistinct = true;
+		for (UINT32 i = 1; i < numKeys; i++)
+		{
+			if (keyframes[i].time > keyframes[i - 1].time && mTimes[i] <= mTimes[i - 1])
+			{
+				timesDistinct = false;
+				break;
+			}
+		}
+
+		if (!timesDistinct)
+		{
+			mTimes.clear();
+			mUncompressedTimes.resize(numKeys);
+
+			for (UINT32 i = 0; i < numKeys; i++)
+				mUncompressedTimes[i] = keyframes[i].time;
+		}
+
+		for (UINT32 i = 0; i < numKeys; i++)
+		{
+			const TKeyframe<T>& entry = keyframes[i];
+
+			UINT16* dst = &mKeys[i * KEY_STRIDE];
+			for (UINT32 j = 0; j < NUM_COMPONENTS; j++)
+			{
+				const float inTangent = impl::getComponent(entry.inTangent, j);
+				const float outTangent = impl::getComponent(entry.outTangent, j);
+
+				dst[j] = quantize(impl::getComponent(entry.value, j), mValueMin[j], mValueScale[j], 65535);
+				dst[NUM_COMPONENTS + j] = inTangent == INFINITY_VAL ? INFINITE_TANGENT :
+					quantize(inTangent, mTangentMin[j], mTangentScale[j], INFINITE_TANGENT - 1);
+				dst[NUM_COMPONENTS * 2 + j] = outTangent == INFINITY_VAL ? INFINITE_TANGENT :
+					quantize(outTangent, mTangentMin[j], mTangentScale[j], INFINITE_TANGENT - 1);
+			}
+		}
+	}
+
+	template <class T>
+	T TCompressedAnimationCurve<T>::evaluate(float time, const TCurveCache<T>& cache, bool loop) const
+	{
+		if (mKeys.empty())
+			return impl::getZero<T>();
+
+		if (Math::approxEquals(mLength, 0.0f))
+			time = 0.0f;
+
+		// Wrap time if looping
+		if(loop && mLength > 0.0f)
+		{
+			if (time < mStart)
+				time = time + (std::floor(mEnd - time) / mLength) * mLength;
+			else if (time > mEnd)
+				time = time - std::floor((time - mStart) / mLength) * mLength;
+		}
+
+		// If time is within cache, evaluate it directly
+		if (time >= cache.cachedCurveStart && time < cache.cachedCurveEnd)
+		{
+			return impl::evaluateCubic(time, cache.cachedCurveStart, cache.cachedCurveEnd,
+				cache.cachedCubicCoefficients);
+		}
+
+		// Clamp to start or end, cache constant of the first or last key and return
+		const bool beforeStart = time < mStart;
+		if(beforeStart || time >= mEnd)
+		{
+			const UINT32 key = beforeStart ? 0 : getNumKeyFrames() - 1;
+			const T value = getKeyFrame(key).value;
+
+			cache.cachedCurveStart = beforeStart ? -std::numeric_limits<float>::infinity() : mEnd;
+			cache.cachedCurveEnd = beforeStart ? mStart : std::numeric_limits<float>::infinity();
+			cache.cachedKey = key;
+			cache.cachedCubicCoefficients[0] = impl::getZero<T>();
+			cache.cachedCubicCoefficients[1] = impl::getZero<T>();
+			cache.cachedCubicCoefficients[2] = impl::getZero<T>();
+			cache.cachedCubicCoefficients[3] = value;
+
+			return value;
+		}
+
+		// Since our value is not in cache, search for the valid pair of keys of interpolate
+		UINT32 leftKeyIdx;
+		UINT32 rightKeyIdx;
+
+		findKeys(time, cache, leftKeyIdx, rightKeyIdx);
+
+		// Decode the keys and calculate cubic hermite curve coefficients so we can store them in cache
+		const TKeyframe<T> leftKey = getKeyFrame(leftKeyIdx);
+		const TKeyframe<T> rightKey = getKeyFrame(rightKeyIdx);
+
+		cache.cachedCurveStart = leftKey.time;
+		cache.cachedCurveEnd = rightKey.time;
+
+		return impl::evaluateAndUpdateCache(leftKey, rightKey, time, cache.cachedCubicCoefficients);
+	}
+
+	template <class T>
+	TAnimationCurve<T> TCompressedAnimationCurve<T>::decompress() const
+	{
+		const UINT32 numKeys = getNumKeyFrames();
+
+		Vector<TKeyframe<T>> keyframes(numKeys);
+		for (UINT32 i = 0; i < numKeys; i++)
+			keyframes[i] = getKeyFrame(i);
+
+		return TAnimationCurve<T>(keyframes);
+	}
+
+	template <class T>
+	UINT32 TCompressedAnimationCurve<T>::getMemorySize() const
+	{
+		return (UINT32)(sizeof(*this) + (mTimes.size() + mKeys.size()) * sizeof(UINT16) +
+			mUncompressedTimes.size() * sizeof(float));
+	}
+
+	template <class T>
+	TKeyframe<T> TCompressedAnimationCurve<T>::getKeyFrame(UINT32 idx) const
+	{
+		TKeyframe<T> output;
+		output.time = getKeyTime(idx);
+
+		const UINT16* src = &mKeys[idx * KEY_STRIDE];
+		for (UINT32 i = 0; i < NUM_COMPONENTS; i++)
+		{
+			const UINT16 inTangent = src[NUM_COMPONENTS + i];
+			const UINT16 outTangent = src[NUM_COMPONENTS * 2 + i];
+
+			impl::getComponent(output.value, i) = mValueMin[i] + src[i] * mValueScale[i];
+			impl::getComponent(output.inTangent, i) = inTangent == INFINITE_TANGENT ?
+				std::numeric_limits<float>::infinity() : mTangentMin[i] + inTangent * mTangentScale[i];
+			impl::getComponent(output.outTangent, i) = outTangent == INFINITE_TANGENT ?
+				std::numeric_limits<float>::infinity() : mTangentMin[i] + outTangent * mTangentScale[i];
+		}
+
+		return output;
+	}
+
+	template <class T>
+	void TCompressedAnimationCurve<T>::findKeys(float time, const TCurveCache<T>& animInstance, UINT32& leftKey,
+		UINT32& rightKey) const
+	{
+		constexpr UINT32 CACHE_LOOKAHEAD = 3;
+
+		// Check nearby keys first if there is cached data
+		if (animInstance.cachedKey != (UINT32)-1)
+		{
+			if (time >= getKeyTime(animInstance.cachedKey))
+			{
+				const UINT32 end = std::min(getNumKeyFrames(), animInstance.cachedKey + CACHE_LOOKAHEAD + 1);
+				for (UINT32 i = animInstance.cachedKey + 1; i < end; i++)
+				{
+					if (time < getKeyTime(i))
+					{
+						leftKey = i - 1;
+						rightKey = i;
+
+						animInstance.cachedKey = leftKey;
+						return;
+					}
+				}
+			}
+			else
+			{
+				// Search backwards, so the closest key preceding the time is found
+				const UINT32 start = (UINT32)std::max(0, (INT32)animInstance.cachedKey - (INT32)CACHE_LOOKAHEAD);
+				for(UINT32 i = animInstance.cachedKey; i > start; i--)
+				{
+					if (time >= getKeyTime(i - 1))
+					{
+						leftKey = i - 1;
+						rightKey = i;
+
+						animInstance.cachedKey = leftKey;
+						return;
+					}
+				}
+			}
+		}
+
+		// Cannot find nearby ones, search all keys
+		findKeys(time, leftKey, rightKey);
+		animInstance.cachedKey = leftKey;
+	}
+
+	template <class T>
+	void TCompressedAnimationCurve<T>::findKeys(float time, UINT32& leftKey, UINT32& rightKey) const
+	{
+		INT32 start = 0;
+		auto searchLength = (INT32)getNumKeyFrames();
+
+		while(searchLength > 0)
+		{
+			INT32 half = searchLength >> 1;
+			INT32 mid = start + half;
+
+			if(time < getKeyTime(mid))
+			{
+				searchLength = half;
+			}
+			else
+			{
+				start = mid + 1;
+				searchLength -= (half + 1);
+			}
+		}
+
+		leftKey = std::max(0, start - 1);
+		rightKey = std::min(start, (INT32)getNumKeyFrames() - 1);
+	}
+
 	template class TAnimationCurve<Vector3>;
 	template class TAnimationCurve<Vector2>;
 	template class TAnimationCurve<Quaternion>;
 	template class TAnimationCurve<float>;
 	template class TAnimationCurve<INT32>;
+
+	template class TCompressedAnimationCurve<Vector3>;
+	template class TCompressedAnimationCurve<Quaternion>;
+	template class TCompressedAnimationCurve<float>;
 }
\ No newline at end of file
@@ -138,6 +138,18 @@ namespace bs
 		 */
 		void makeAdditive();
 
+		/**
+		 * Removes keyframes that can be reconstructed from the surrounding keyframes, and returns the resulting curve.
+		 * A keyframe is only removed if the curve without it doesn't deviate from the original curve more than the
+		 * provided error, at any of the original keyframes or in-between them. Tangents of the remaining keyframes are
+		 * preserved.
+		 *
+		 * @param[in]	maxError	Maximum allowed difference between the original and reduced curve, for any of the
+		 *							value components.
+		 * @return					New curve with redundant keyframes removed.
+		 */
+		TAnimationCurve<T> reduce(float maxError) const;
+
 		/** Returns the time of the first and last keyframe in the curve. */
 		std::pair<float, float> getTimeRange() const;
 
@@ -165,6 +177,7 @@ namespace bs
 
 	private:
 		friend struct RTTIPlainType<TAnimationCurve<T>>;
+		friend class TCompressedAnimationCurve<T>;
 
 		/** 
 		 * Returns a pair of keys that can be used for interpolating to field the value at the provided time. This attempts
@@ -217,6 +230,84 @@ namespace bs
 		float mLength;
 	};
 
+	/**
+	 * Animation spline with quantized keyframes, for compact storage and evaluation of large amounts of animation data.
+	 * Keyframe times, values and tangents are stored as 16-bit integers scaled to the range of the respective values in
+	 * the curve, and are decoded as the curve is evaluated. Keyframe times are stored separately from the rest of the
+	 * keyframe data so key searches touch as little memory as possible. Curves whose keys are spaced more closely than
+	 * the time quantization step keep their keyframe times uncompressed, so that no two keys end up at the same time.
+	 *
+	 * Evaluation results match the TAnimationCurve the curve was created from, up to the quantization error of
+	 * 1/65534th of the value range.
+	 */
+	template <class T>
+	class BS_CORE_EXPORT TCompressedAnimationCurve // Note: Curves are expected to be immutable for threading purposes
+	{
+	public:
+		TCompressedAnimationCurve() = default;
+
+		/** Creates a compressed version of the provided curve. */
+		explicit TCompressedAnimationCurve(const TAnimationCurve<T>& curve);
+
+		/** @copydoc TAnimationCurve::evaluate(float, const TCurveCache<T>&, bool) const */
+		T evaluate(float time, const TCurveCache<T>& cache, bool loop = true) const;
+
+		/** Decodes the keyframes and returns them in the form of a regular animation curve. */
+		TAnimationCurve<T> decompress() const;
+
+		/** @copydoc TAnimationCurve::getLength */
+		float getLength() const { return mEnd; }
+
+		/** @copydoc TAnimationCurve::getNumKeyFrames */
+		UINT32 getNumKeyFrames() const { return (UINT32)(mKeys.size() / KEY_STRIDE); }
+
+		/** Returns the amount of memory used by the curve, in bytes. */
+		UINT32 getMemorySize() const;
+
+	private:
+		friend struct RTTIPlainType<TCompressedAnimationCurve<T>>;
+
+		/** Number of floating point components in a single value. */
+		static constexpr UINT32 NUM_COMPONENTS = sizeof(T) / sizeof(float);
+
+		/** Number of quantized values stored per keyframe in @p mKeys (value, in and out tangent). */
+		static constexpr UINT32 KEY_STRIDE = NUM_COMPONENTS * 3;
+
+		/** Quantized value used for representing infinite (step) tangents. */
+		static constexpr UINT16 INFINITE_TANGENT = 0xFFFF;
+
+		/** Decodes the time of the keyframe at the specified index. */
+		float getKeyTime(UINT32 idx) const
+		{
+			if (!mUncompressedTimes.empty())
+				return mUncompressedTimes[idx];
+
+			return mTimeStart + mTimes[idx] * mTimeScale;
+		}
+
+		/** Decodes the keyframe at the specified index. */
+		TKeyframe<T> getKeyFrame(UINT32 idx) const;
+
+		/** @copydoc TAnimationCurve::findKeys(float, const TCurveCache<T>&, UINT32&, UINT32&) const */
+		void findKeys(float time, const TCurveCache<T>& cache, UINT32& leftKey, UINT32& rightKey) const;
+
+		/** @copydoc TAnimationCurve::findKeys(float, UINT32&, UINT32&) const */
+		void findKeys(float time, UINT32& leftKey, UINT32& rightKey) const;
+
+		Vector<UINT16> mTimes;
+		Vector<float> mUncompressedTimes; /**< Used instead of @p mTimes if quantized times can't keep all keys apart. */
+		Vector<UINT16> mKeys;
+		float mStart = 0.0f;
+		float mEnd = 0.0f;
+		float mLength = 0.0f;
+		float mTimeStart = 0.0f;
+		float mTimeScale = 0.0f;
+		float mValueMin[NUM_COMPONENTS] = {};
+		float mValueScale[NUM_COMPONENTS] = {};
+		float mTangentMin[NUM_COMPONENTS] = {};
+		float mTangentScale[NUM_COMPONENTS] = {};
+	};
+
 #ifdef BS_SBGEN
 	template class BS_SCRIPT_EXPORT(m:Animation,n:AnimationCurve) TAnimationCurve<float>;
 	template class BS_SCRIPT_EXPORT(m:Animation,n:Vector3Curve) TAnimationCurve<Vector3>;
@@ -13,6 +13,9 @@
 
 namespace bs
 {
+	/** Maximum number of animations evaluated by a single worker task. */
+	static constexpr UINT32 ANIMATION_BATCH_SIZE = 16;
+
 	AnimationManager::AnimationManager()
 		: mNextId(1), mUpdateRate(1.0f / 60.0f), mAnimationTime(0.0f), mLastAnimationUpdateTime(0.0f)
 		, mNextAnimationUpdateTime(0.0f), mPaused(false), mPoseReadBufferIdx(1), mPoseWriteBufferIdx(0)
@@ -35,6 +38,17 @@ namespace bs
 		mUpdateRate = 1.0f / fps;
 	}
 
+	/** Copies local transforms and override flags of all bones from one pose to another pose of the same size. */
+	static void copyLocalPose(const LocalSkeletonPose& src, LocalSkeletonPose& dst)
+	{
+		assert(src.numBones == dst.numBones);
+
+		memcpy(dst.positions, src.positions, sizeof(Vector3) * src.numBones);
+		memcpy(dst.rotations, src.rotations, sizeof(Quaternion) * src.numBones);
+		memcpy(dst.scales, src.scales, sizeof(Vector3) * src.numBones);
+		memcpy(dst.hasOverride, src.hasOverride, sizeof(bool) * src.numBones);
+	}
+
 	const EvaluatedAnimationData* AnimationManager::update(bool async)
 	{
 		// Wait for any workers to complete
@@ -84,8 +98,9 @@ namespace bs
 			mProxies.push_back(anim.second->mAnimProxy);
 		}
 
-		// Build frustums for culling
+		// Build frustums for culling, and find view positions for LOD selection
 		mCullFrustums.clear();
+		mViewPositions.clear();
 
 		auto& allCameras = gSceneManager().getAllCameras();
 		for(auto& entry : allCameras)
@@ -97,8 +112,11 @@ namespace bs
 			// TODO: Not checking if camera and animation renderable's layers match. If we checked more animations could
 			// be culled.
 			mCullFrustums.push_back(entry.second->getWorldFrustum());
+			mViewPositions.push_back(entry.second->getTransform().getPosition());
 		}
 
+		mUpdateCount++;
+
 		// Prepare the write buffer
 		UINT32 totalNumBones = 0;
 		for (auto& anim : mProxies)
@@ -112,34 +130,35 @@ namespace bs
 		renderData.transforms.resize(totalNumBones);
 		renderData.infos.clear();
 
-		// Queue animation evaluation tasks
+		// Queue animation evaluation tasks. Animations are evaluated in batches so that the cost of scheduling and
+		// synchronization is paid once per batch rather than once per animation.
+		const auto numProxies = (UINT32)mProxies.size();
+		const UINT32 numBatches = Math::divideAndRoundUp(numProxies, ANIMATION_BATCH_SIZE);
+
 		{
 			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mProxies.size();
+			mNumActiveWorkers = numBatches;
 		}
 
 		UINT32 curBoneIdx = 0;
-		for (auto& anim : mProxies)
+		for (UINT32 i = 0; i < numBatches; i++)
 		{
-			auto evaluateAnimWorker = [this, anim, curBoneIdx]()
-			{
-				UINT32 boneIdx = curBoneIdx;
-				evaluateAnimation(anim.get(), boneIdx);
-
-				Lock lock(mMutex);
-				{
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
-				}
+			const UINT32 start = i * ANIMATION_BATCH_SIZE;
+			const UINT32 count = std::min(ANIMATION_BATCH_SIZE, numProxies - start);
 
-				mWorkerDoneSignal.notify_one();
+			auto evaluateAnimWorker = [this, start, count, curBoneIdx]()
+			{
+				evaluateAnimationBatch(start, count, curBoneIdx);
 			};
 
 			SPtr<Task> task = Task::create("AnimWorker", evaluateAnimWorker);
 			TaskScheduler::instance().addTask(task);
 
-			if (anim->skeleton != nullptr)
-				curBoneIdx += anim->skeleton->getNumBones();
+			for (UINT32 j = start; j < start + count; j++)
+			{
+				if (mProxies[j]->skeleton != nullptr)
+					curBoneIdx += mProxies[j]->skeleton->getNumBones();
+			}
 		}
 
 		// Wait for tasks to complete
@@ -165,7 +184,43 @@ namespace bs
 		return &mAnimData[mPoseReadBufferIdx];
 	}
 
-	void AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx)
+	void AnimationManager::evaluateAnimationBatch(UINT32 start, UINT32 count, UINT32 boneIdx)
+	{
+		EvaluatedAnimationData::AnimInfo animInfos[ANIMATION_BATCH_SIZE];
+		bool hasAnimInfo[ANIMATION_BATCH_SIZE];
+
+		for (UINT32 i = 0; i < count; i++)
+		{
+			AnimationProxy* anim = mProxies[start + i].get();
+
+			// Bone ranges are assigned up front, whether the animation ends up evaluated or not
+			UINT32 curBoneIdx = boneIdx;
+			hasAnimInfo[i] = evaluateAnimation(anim, curBoneIdx, animInfos[i]);
+
+			if (anim->skeleton != nullptr)
+				boneIdx += anim->skeleton->getNumBones();
+		}
+
+		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
+
+		// Register the results and mark the batch as done under the same lock
+		{
+			Lock lock(mMutex);
+			for (UINT32 i = 0; i < count; i++)
+			{
+				if (hasAnimInfo[i])
+					renderData.infos[mProxies[start + i]->id] = animInfos[i];
+			}
+
+			assert(mNumActiveWorkers > 0);
+			mNumActiveWorkers--;
+
+			mWorkerDoneSignal.notify_one();
+		}
+	}
+
+	bool AnimationManager::evaluateAnimation(AnimationProxy* anim, UINT32& curBoneIdx, 
+		EvaluatedAnimationData::AnimInfo& animInfo)
 	{
 		if (anim->mCullEnabled)
 		{
@@ -180,7 +235,11 @@ namespace bs
 			}
 
 			if (!isVisible)
-				return;
+			{
+				// Key poses will be out of date by the time the animation becomes visible again
+				anim->lodKeyPosesValid = false;
+				return false;
+			}
 		}
 
 		EvaluatedAnimationData& renderData = mAnimData[mPoseWriteBufferIdx];
@@ -188,9 +247,18 @@ namespace bs
 		UINT32 prevPoseBufferIdx = (mPoseWriteBufferIdx + CoreThread::NUM_SYNC_BUFFERS) % (CoreThread::NUM_SYNC_BUFFERS + 1);
 		EvaluatedAnimationData& prevRenderData = mAnimData[prevPoseBufferIdx];
 
-		EvaluatedAnimationData::AnimInfo animInfo;
 		bool hasAnimInfo = false;
 
+		// Distant animations can be evaluated only every few updates. Evaluations of different animations are staggered
+		// so the cost is spread evenly across updates, instead of all throttled animations being evaluated at once.
+		const AnimationLODLevel* lod = getLODLevel(anim);
+
+		UINT32 lodInterval = 1;
+		if (lod != nullptr && anim->sampleStep == AnimSampleStep::None)
+			lodInterval = std::max(lod->updateInterval, 1U);
+
+		const UINT32 lodPhase = (UINT32)((mUpdateCount + anim->id) % lodInterval);
+
 		// Evaluate skeletal animation
 		if (anim->skeleton != nullptr)
 		{
@@ -218,8 +286,71 @@ namespace bs
 				boneTfrmIdx++;
 			}
 
+			const SkeletonMask& mask = lod != nullptr ? lod->mask : anim->skeletonMask;
+
+			const AnimationStateLayer* layers = anim->layers;
+			UINT32 numLayers = anim->numLayers;
+			AnimationStateLayer* nonAdditiveLayers = nullptr;
+			if (lod != nullptr && lod->skipAdditiveLayers)
+			{
+				nonAdditiveLayers = bs_stack_alloc<AnimationStateLayer>(anim->numLayers);
+
+				numLayers = 0;
+				for (UINT32 i = 0; i < anim->numLayers; i++)
+				{
+					if (!anim->layers[i].additive)
+						nonAdditiveLayers[numLayers++] = anim->layers[i];
+				}
+
+				layers = nonAdditiveLayers;
+			}
+
 			// Animate bones
-			anim->skeleton->getPose(boneDst, anim->skeletonPose, anim->skeletonMask, anim->layers, anim->numLayers);
+			if (lodInterval == 1)
+			{
+				anim->skeleton->getPose(boneDst, anim->skeletonPose, mask, layers, numLayers);
+				anim->lodKeyPosesValid = false;
+			}
+			else
+			{
+				const bool keyPosesValid = anim->lodKeyPosesValid && anim->lodUpdateInterval == lodInterval &&
+					anim->lodKeyPoses.size() == numBones * 2 && anim->lodKeyLocalPoses[0].numBones == numBones;
+
+				if (lodPhase == 0 || !keyPosesValid)
+				{
+					anim->skeleton->getPose(boneDst, anim->skeletonPose, mask, layers, numLayers);
+
+					if (keyPosesValid)
+						anim->lodKeyPoseIdx ^= 1;
+					else
+					{
+						// Nothing to interpolate from, start with both key poses being the same
+						anim->lodKeyPoses.resize(numBones * 2);
+						anim->lodKeyLocalPoses[0] = LocalSkeletonPose(numBones);
+						anim->lodKeyLocalPoses[1] = LocalSkeletonPose(numBones);
+						anim->lodKeyPoseIdx = 0;
+						anim->lodUpdateInterval = lodInterval;
+						anim->lodKeyPosesValid = true;
+
+						for (UINT32 i = 0; i < numBones; i++)
+							anim->lodKeyPoses[numBones + i] = AnimationKeyPoseBone(boneDst[i]);
+
+						copyLocalPose(anim->skeletonPose, anim->lodKeyLocalPoses[1]);
+					}
+
+					AnimationKeyPoseBone* keyPose = anim->lodKeyPoses.data() + anim->lodKeyPoseIdx * numBones;
+					for (UINT32 i = 0; i < numBones; i++)
+						keyPose[i] = AnimationKeyPoseBone(boneDst[i]);
+
+					copyLocalPose(anim->skeletonPose, anim->lodKeyLocalPoses[anim->lodKeyPoseIdx]);
+				}
+
+				// Output trails the most recent evaluation by one interval, so it can always be interpolated towards
+				interpolateKeyPoses(anim, lodPhase / (float)lodInterval, boneDst);
+			}
+
+			if (nonAdditiveLayers != nullptr)
+				bs_stack_free(nonAdditiveLayers);
 
 			curBoneIdx += numBones;
 			hasAnimInfo = true;
@@ -259,12 +390,16 @@ namespace bs
 			if (state.disabled)
 				continue;
 
+			const CompressedAnimationCurves* compressed = state.compressedCurves.get();
+
 			{
 				UINT32 curveIdx = soInfo.curveIndices.position;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-					anim->sceneObjectPose.positions[curveIdx] = curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop);
+					const TCurveCache<Vector3>& cache = state.positionCaches[curveIdx];
+					anim->sceneObjectPose.positions[curveIdx] = compressed ?
+						compressed->position[curveIdx].evaluate(state.time, cache, state.loop) :
+						state.curves->position[curveIdx].curve.evaluate(state.time, cache, state.loop);
 					anim->sceneObjectPose.hasOverride[i * 3 + 0] = false;
 				}
 			}
@@ -273,8 +408,10 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.rotation;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-					anim->sceneObjectPose.rotations[curveIdx] = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
+					const TCurveCache<Quaternion>& cache = state.rotationCaches[curveIdx];
+					anim->sceneObjectPose.rotations[curveIdx] = compressed ?
+						compressed->rotation[curveIdx].evaluate(state.time, cache, state.loop) :
+						state.curves->rotation[curveIdx].curve.evaluate(state.time, cache, state.loop);
 					anim->sceneObjectPose.rotations[curveIdx].normalize();
 					anim->sceneObjectPose.hasOverride[i * 3 + 1] = false;
 				}
@@ -284,8 +421,10 @@ namespace bs
 				UINT32 curveIdx = soInfo.curveIndices.scale;
 				if (curveIdx != (UINT32)-1)
 				{
-					const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-					anim->sceneObjectPose.scales[curveIdx] = curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop);
+					const TCurveCache<Vector3>& cache = state.scaleCaches[curveIdx];
+					anim->sceneObjectPose.scales[curveIdx] = compressed ?
+						compressed->scale[curveIdx].evaluate(state.time, cache, state.loop) :
+						state.curves->scale[curveIdx].curve.evaluate(state.time, cache, state.loop);
 					anim->sceneObjectPose.hasOverride[i * 3 + 2] = false;
 				}
 			}
@@ -424,8 +563,10 @@ namespace bs
 				}
 			}
 
-			// Generate morph shape vertices
-			if (anim->morphChannelWeightsDirty || hasMorphCurves)
+			// Generate morph shape vertices. If skipped due to LOD the dirty flag remains set, so the shape is updated
+			// once the animation gets close enough again.
+			const bool evaluateMorphShapes = lodPhase == 0 && (lod == nullptr || !lod->skipMorphShapes);
+			if ((anim->morphChannelWeightsDirty || hasMorphCurves) && evaluateMorphShapes)
 			{
 				SPtr<MeshData> meshData = bs_shared_ptr_new<MeshData>(anim->numMorphVertices, 0, mBlendShapeVertexDesc);
 
@@ -497,10 +638,86 @@ namespace bs
 		else
 			animInfo.morphShapeInfo.version = 1;
 
-		if (hasAnimInfo)
+		return hasAnimInfo;
+	}
+
+	const AnimationLODLevel* AnimationManager::getLODLevel(const AnimationProxy* anim) const
+	{
+		if (anim->lodLevels.empty())
+			return nullptr;
+
+		// Nothing is being viewed, so nothing will notice the lowest level of detail
+		if (mViewPositions.empty())
+			return &anim->lodLevels.back();
+
+		const Vector3& boundsMin = anim->mBounds.getMin();
+		const Vector3& boundsMax = anim->mBounds.getMax();
+
+		float minDistSqrd = std::numeric_limits<float>::max();
+		for (auto& viewPosition : mViewPositions)
 		{
-			Lock lock(mMutex);
-			renderData.infos[anim->id] = animInfo;
+			Vector3 closestPoint;
+			closestPoint.x = Math::clamp(viewPosition.x, boundsMin.x, boundsMax.x);
+			closestPoint.y = Math::clamp(viewPosition.y, boundsMin.y, boundsMax.y);
+			closestPoint.z = Math::clamp(viewPosition.z, boundsMin.z, boundsMax.z);
+
+			minDistSqrd = std::min(minDistSqrd, viewPosition.squaredDistance(closestPoint));
+		}
+
+		const float distance = std::sqrt(minDistSqrd);
+
+		// Levels are sorted by distance
+		const AnimationLODLevel* output = nullptr;
+		for (auto& level : anim->lodLevels)
+		{
+			if (level.distance > distance)
+				break;
+
+			output = &level;
+		}
+
+		return output;
+	}
+
+	void AnimationManager::interpolateKeyPoses(AnimationProxy* anim, float t, Matrix4* output)
+	{
+		const SPtr<Skeleton>& skeleton = anim->skeleton;
+		const UINT32 numBones = skeleton->getNumBones();
+		const AnimationKeyPoseBone* newPose = anim->lodKeyPoses.data() + anim->lodKeyPoseIdx * numBones;
+		const AnimationKeyPoseBone* oldPose = anim->lodKeyPoses.data() + (anim->lodKeyPoseIdx ^ 1) * numBones;
+
+		for (UINT32 i = 0; i < numBones; i++)
+			output[i] = AnimationKeyPoseBone::interpolate(oldPose[i], newPose[i], t);
+
+		// Scene objects attached to bones read the local pose, so it needs to match the interpolated output
+		const LocalSkeletonPose& newLocalPose = anim->lodKeyLocalPoses[anim->lodKeyPoseIdx];
+		const LocalSkeletonPose& oldLocalPose = anim->lodKeyLocalPoses[anim->lodKeyPoseIdx ^ 1];
+		LocalSkeletonPose& localPose = anim->skeletonPose;
+
+		for (UINT32 i = 0; i < numBones; i++)
+		{
+			localPose.positions[i] = Vector3::lerp(t, oldLocalPose.positions[i], newLocalPose.positions[i]);
+			localPose.rotations[i] = Quaternion::lerp(t, oldLocalPose.rotations[i], newLocalPose.rotations[i]);
+			localPose.scales[i] = Vector3::lerp(t, oldLocalPose.scales[i], newLocalPose.scales[i]);
+			localPose.hasOverride[i] = newLocalPose.hasOverride[i];
+		}
+
+		// Bones overridden by scene objects follow the scene objects as they are now, rather than as they were when the 
+		// key poses were evaluated
+		UINT32 boneTfrmIdx = 0;
+		for (UINT32 i = 0; i < anim->numSceneObjects; i++)
+		{
+			const AnimatedSceneObjectInfo& soInfo = anim->sceneObjectInfos[i];
+			if (soInfo.boneIdx == -1)
+				continue;
+
+			if (localPose.hasOverride[soInfo.boneIdx])
+			{
+				output[soInfo.boneIdx] = anim->sceneObjectTransforms[boneTfrmIdx] * 
+					skeleton->getInvBindPose(soInfo.boneIdx);
+			}
+
+			boneTfrmIdx++;
 		}
 	}
 
@@ -11,6 +11,7 @@
 namespace bs
 {
 	struct AnimationProxy;
+	struct AnimationLODLevel;
 
 	/** @addtogroup Animation-Internal
 	 *  @{
@@ -111,8 +112,38 @@ namespace bs
 		 * @param[in]	anim		Proxy representing the animation to evaluate.
 		 * @param[in]	boneIdx		Index in the output buffer in which to write evaluated bone information. This will be
 		 *							automatically advanced by the number of written bone transforms.
+		 * @param[out]	animInfo	Information about where the evaluated data is stored, to be registered in the write
+		 *							buffer by the caller.
+		 * @return					True if @p animInfo was written to, false if the animation wasn't evaluated.
 		 */
-		void evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx);
+		bool evaluateAnimation(AnimationProxy* anim, UINT32& boneIdx, EvaluatedAnimationData::AnimInfo& animInfo);
+
+		/** 
+		 * Evaluates a batch of consecutive animations from @p mProxies, registers the evaluated data in the currently
+		 * active write buffer and notifies the waiting thread that the batch is done.
+		 *
+		 * @param[in]	start		Index of the first proxy to evaluate.
+		 * @param[in]	count		Number of proxies to evaluate.
+		 * @param[in]	boneIdx		Index in the output buffer at which to write the bone information of the first proxy.
+		 */
+		void evaluateAnimationBatch(UINT32 start, UINT32 count, UINT32 boneIdx);
+
+		/** 
+		 * Determines which level of detail to evaluate the animation with, depending on the distance from the nearest
+		 * camera. Returns null if the animation should be fully evaluated.
+		 */
+		const AnimationLODLevel* getLODLevel(const AnimationProxy* anim) const;
+
+		/** 
+		 * Interpolates between the two most recently evaluated poses of a skeleton whose evaluation is being throttled
+		 * by its level of detail. The local pose of the proxy is interpolated as well. Bones overridden by scene objects
+		 * use the current scene object transforms instead.
+		 *
+		 * @param[in]	anim		Proxy containing the evaluated poses.
+		 * @param[in]	t			Interpolation factor in range [0, 1], with 0 returning the older pose.
+		 * @param[out]	output		Buffer to write the interpolated bone transforms to.
+		 */
+		static void interpolateKeyPoses(AnimationProxy* anim, float t, Matrix4* output);
 
 		UINT64 mNextId;
 		UnorderedMap<UINT64, Animation*> mAnimations;
@@ -128,6 +159,8 @@ namespace bs
 		// Animation thread
 		Vector<SPtr<AnimationProxy>> mProxies;
 		Vector<ConvexVolume> mCullFrustums;
+		Vector<Vector3> mViewPositions;
+		UINT64 mUpdateCount = 0;
 		EvaluatedAnimationData mAnimData[CoreThread::NUM_SYNC_BUFFERS + 1];
 
 		UINT32 mPoseReadBufferIdx;
@@ -19,6 +19,7 @@ namespace bs
 	{
 	private:
 		friend class TAnimationCurve<T>;
+		friend class TCompressedAnimationCurve<T>;
 
 		/** Left-most key the curve was last evaluated at. -1 if no cached data. */
 		mutable UINT32 cachedKey = (UINT32)-1; 
@@ -4,6 +4,7 @@
 #include "Animation/BsAnimationClip.h"
 #include "Animation/BsSkeletonMask.h"
 #include "Private/RTTI/BsSkeletonRTTI.h"
+#include "Math/BsSIMD.h"
 
 namespace bs
 {
@@ -83,6 +84,8 @@ namespace bs
 			mBoneInfo[i].name = bones[i].name;
 			mBoneInfo[i].parent = bones[i].parent;
 		}
+
+		buildHierarchyOrder();
 	}
 
 	Skeleton::~Skeleton()
@@ -113,6 +116,7 @@ namespace bs
 
 			AnimationState state;
 			state.curves = clip.getCurves();
+			state.compressedCurves = clip.getCompressedCurves();
 			state.boneToCurveMapping = boneToCurveMapping.data();
 			state.loop = loop;
 			state.weight = 1.0f;
@@ -141,22 +145,302 @@ namespace bs
 		bs_frame_clear();
 	}
 
+	/** Number of bones processed at once by the pose kernels. */
+	static constexpr UINT32 POSE_SIMD_WIDTH = 4;
+
+	/** 
+	 * Local transforms of all bones in a skeleton, stored in structure-of-arrays form so the pose kernels can process
+	 * multiple bones at once. Arrays are padded to a multiple of POSE_SIMD_WIDTH.
+	 */
+	struct LocalPoseSoA
+	{
+		float* position[3];
+		float* rotation[4];
+		float* scale[3];
+	};
+
+	/** Masks marking which bones have a curve of a specific type in the currently blended animation state. */
+	struct PoseCurveMask
+	{
+		UINT32* position;
+		UINT32* rotation;
+		UINT32* scale;
+	};
+
+	/** Adds the weighted sampled position to the accumulated position of every bone that has a position curve. */
+	static void blendPositions(LocalPoseSoA& pose, const LocalPoseSoA& sample, const PoseCurveMask& curveMask, 
+		float weight, UINT32 count)
+	{
+		const simd::float32x4 w = simd::load_splat<simd::float32x4>(&weight);
+		for(UINT32 i = 0; i < count; i += POSE_SIMD_WIDTH)
+		{
+			const simd::mask_float32x4 mask = simd::to_mask(simd::bit_cast<simd::float32x4>(
+				simd::load_u<simd::uint32x4>(curveMask.position + i)));
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const simd::float32x4 current = simd::load_u<simd::float32x4>(pose.position[j] + i);
+				const simd::float32x4 blended = simd::add(current, 
+					simd::mul(simd::load_u<simd::float32x4>(sample.position[j] + i), w));
+
+				simd::store_u(pose.position[j] + i, simd::blend(blended, current, mask));
+			}
+		}
+	}
+
+	/** Multiplies the accumulated scale of every bone that has a scale curve with the weighted sampled scale. */
+	static void blendScales(LocalPoseSoA& pose, const LocalPoseSoA& sample, const PoseCurveMask& curveMask, 
+		float weight, UINT32 count)
+	{
+		const simd::float32x4 w = simd::load_splat<simd::float32x4>(&weight);
+		for(UINT32 i = 0; i < count; i += POSE_SIMD_WIDTH)
+		{
+			const simd::mask_float32x4 mask = simd::to_mask(simd::bit_cast<simd::float32x4>(
+				simd::load_u<simd::uint32x4>(curveMask.scale + i)));
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const simd::float32x4 current = simd::load_u<simd::float32x4>(pose.scale[j] + i);
+				const simd::float32x4 blended = simd::mul(current, 
+					simd::mul(simd::load_u<simd::float32x4>(sample.scale[j] + i), w));
+
+				simd::store_u(pose.scale[j] + i, simd::blend(blended, current, mask));
+			}
+		}
+	}
+
+	/** 
+	 * Blends the sampled rotation into the accumulated rotation of every bone that has a rotation curve. Additive 
+	 * rotations are applied on top of the accumulated rotation, while others are summed up along the shortest arc.
+	 */
+	static void blendRotations(LocalPoseSoA& pose, const LocalPoseSoA& sample, const PoseCurveMask& curveMask, 
+		float weight, bool additive, UINT32 count)
+	{
+		const simd::float32x4 zero = simd::make_zero();
+		const simd::float32x4 one = simd::make_float(1.0f);
+		const simd::float32x4 w = simd::load_splat<simd::float32x4>(&weight);
+		const simd::float32x4 invW = simd::make_float(1.0f - weight);
+
+		for(UINT32 i = 0; i < count; i += POSE_SIMD_WIDTH)
+		{
+			const simd::mask_float32x4 mask = simd::to_mask(simd::bit_cast<simd::float32x4>(
+				simd::load_u<simd::uint32x4>(curveMask.rotation + i)));
+
+			simd::float32x4 x = simd::load_u<simd::float32x4>(pose.rotation[0] + i);
+			simd::float32x4 y = simd::load_u<simd::float32x4>(pose.rotation[1] + i);
+			simd::float32x4 z = simd::load_u<simd::float32x4>(pose.rotation[2] + i);
+			simd::float32x4 w0 = simd::load_u<simd::float32x4>(pose.rotation[3] + i);
+
+			simd::float32x4 sx = simd::load_u<simd::float32x4>(sample.rotation[0] + i);
+			simd::float32x4 sy = simd::load_u<simd::float32x4>(sample.rotation[1] + i);
+			simd::float32x4 sz = simd::load_u<simd::float32x4>(sample.rotation[2] + i);
+			simd::float32x4 sw = simd::load_u<simd::float32x4>(sample.rotation[3] + i);
+
+			simd::float32x4 nx, ny, nz, nw;
+			if(additive)
+			{
+				// Start from identity if nothing was accumulated yet. Original values are kept intact as bones without a
+				// curve must remain unassigned.
+				const simd::mask_float32x4 isAssigned = simd::cmp_neq(w0, zero);
+				const simd::float32x4 bx = simd::blend(x, zero, isAssigned);
+				const simd::float32x4 by = simd::blend(y, zero, isAssigned);
+				const simd::float32x4 bz = simd::blend(z, zero, isAssigned);
+				const simd::float32x4 bw = simd::blend(w0, one, isAssigned);
+
+				// Same as Quaternion::lerp(weight, Quaternion::IDENTITY, sample)
+				const simd::float32x4 flip = simd::blend(one, simd::neg(one), simd::cmp_ge(sw, zero));
+				sx = simd::mul(w, sx);
+				sy = simd::mul(w, sy);
+				sz = simd::mul(w, sz);
+				sw = simd::add(simd::mul(flip, invW), simd::mul(w, sw));
+
+				const simd::float32x4 length = simd::add(simd::add(simd::add(
+					simd::mul(sw, sw), simd::mul(sx, sx)), simd::mul(sy, sy)), simd::mul(sz, sz));
+				const simd::float32x4 factor = simd::div(one, simd::sqrt(length));
+				sx = simd::mul(sx, factor);
+				sy = simd::mul(sy, factor);
+				sz = simd::mul(sz, factor);
+				sw = simd::mul(sw, factor);
+
+				// Quaternion multiplication
+				nw = simd::sub(simd::sub(simd::sub(simd::mul(bw, sw), simd::mul(bx, sx)), simd::mul(by, sy)), 
+					simd::mul(bz, sz));
+				nx = simd::sub(simd::add(simd::add(simd::mul(bw, sx), simd::mul(bx, sw)), simd::mul(by, sz)), 
+					simd::mul(bz, sy));
+				ny = simd::sub(simd::add(simd::add(simd::mul(bw, sy), simd::mul(by, sw)), simd::mul(bz, sx)), 
+					simd::mul(bx, sz));
+				nz = simd::sub(simd::add(simd::add(simd::mul(bw, sz), simd::mul(bz, sw)), simd::mul(bx, sy)), 
+					simd::mul(by, sx));
+			}
+			else
+			{
+				sx = simd::mul(sx, w);
+				sy = simd::mul(sy, w);
+				sz = simd::mul(sz, w);
+				sw = simd::mul(sw, w);
+
+				// Make sure to blend along the shortest arc
+				const simd::float32x4 dot = simd::add(simd::add(simd::add(
+					simd::mul(sw, w0), simd::mul(sx, x)), simd::mul(sy, y)), simd::mul(sz, z));
+				const simd::mask_float32x4 flip = simd::cmp_lt(dot, zero);
+				sx = simd::blend(simd::neg(sx), sx, flip);
+				sy = simd::blend(simd::neg(sy), sy, flip);
+				sz = simd::blend(simd::neg(sz), sz, flip);
+				sw = simd::blend(simd::neg(sw), sw, flip);
+
+				nx = simd::add(x, sx);
+				ny = simd::add(y, sy);
+				nz = simd::add(z, sz);
+				nw = simd::add(w0, sw);
+			}
+
+			simd::store_u(pose.rotation[0] + i, simd::blend(nx, x, mask));
+			simd::store_u(pose.rotation[1] + i, simd::blend(ny, y, mask));
+			simd::store_u(pose.rotation[2] + i, simd::blend(nz, z, mask));
+			simd::store_u(pose.rotation[3] + i, simd::blend(nw, w0, mask));
+		}
+	}
+
+	/** 
+	 * Normalizes the rotations of a group of POSE_SIMD_WIDTH bones starting at @p first, and converts their local
+	 * transforms into matrices. Bones with an unassigned rotation get an identity rotation. Matrices are written only
+	 * for bones that have @p writeMatrix set.
+	 */
+	static void calcLocalMatrices(LocalPoseSoA& pose, UINT32 first, const bool* writeMatrix, Matrix4* output)
+	{
+		const simd::float32x4 zero = simd::make_zero();
+		const simd::float32x4 one = simd::make_float(1.0f);
+
+		simd::float32x4 x = simd::load_u<simd::float32x4>(pose.rotation[0] + first);
+		simd::float32x4 y = simd::load_u<simd::float32x4>(pose.rotation[1] + first);
+		simd::float32x4 z = simd::load_u<simd::float32x4>(pose.rotation[2] + first);
+		simd::float32x4 w = simd::load_u<simd::float32x4>(pose.rotation[3] + first);
+
+		const simd::mask_float32x4 isAssigned = simd::cmp_neq(w, zero);
+		const simd::float32x4 length = simd::add(simd::add(simd::add(
+			simd::mul(w, w), simd::mul(x, x)), simd::mul(y, y)), simd::mul(z, z));
+		const simd::float32x4 factor = simd::div(one, simd::sqrt(length));
+
+		x = simd::blend(simd::mul(x, factor), zero, isAssigned);
+		y = simd::blend(simd::mul(y, factor), zero, isAssigned);
+		z = simd::blend(simd::mul(z, factor), zero, isAssigned);
+		w = simd::blend(simd::mul(w, factor), one, isAssigned);
+
+		simd::store_u(pose.rotation[0] + first, x);
+		simd::store_u(pose.rotation[1] + first, y);
+		simd::store_u(pose.rotation[2] + first, z);
+		simd::store_u(pose.rotation[3] + first, w);
+
+		// Same as Matrix4::TRS()
+		const simd::float32x4 tx = simd::add(x, x);
+		const simd::float32x4 ty = simd::add(y, y);
+		const simd::float32x4 tz = simd::add(z, z);
+		const simd::float32x4 twx = simd::mul(tx, w);
+		const simd::float32x4 twy = simd::mul(ty, w);
+		const simd::float32x4 twz = simd::mul(tz, w);
+		const simd::float32x4 txx = simd::mul(tx, x);
+		const simd::float32x4 txy = simd::mul(ty, x);
+		const simd::float32x4 txz = simd::mul(tz, x);
+		const simd::float32x4 tyy = simd::mul(ty, y);
+		const simd::float32x4 tyz = simd::mul(tz, y);
+		const simd::float32x4 tzz = simd::mul(tz, z);
+
+		const simd::float32x4 sx = simd::load_u<simd::float32x4>(pose.scale[0] + first);
+		const simd::float32x4 sy = simd::load_u<simd::float32x4>(pose.scale[1] + first);
+		const simd::float32x4 sz = simd::load_u<simd::float32x4>(pose.scale[2] + first);
+
+		simd::float32x4 rows[3][4];
+		rows[0][0] = simd::mul(sx, simd::sub(one, simd::add(tyy, tzz)));
+		rows[0][1] = simd::mul(sy, simd::sub(txy, twz));
+		rows[0][2] = simd::mul(sz, simd::add(txz, twy));
+		rows[0][3] = simd::load_u<simd::float32x4>(pose.position[0] + first);
+
+		rows[1][0] = simd::mul(sx, simd::add(txy, twz));
+		rows[1][1] = simd::mul(sy, simd::sub(one, simd::add(txx, tzz)));
+		rows[1][2] = simd::mul(sz, simd::sub(tyz, twx));
+		rows[1][3] = simd::load_u<simd::float32x4>(pose.position[1] + first);
+
+		rows[2][0] = simd::mul(sx, simd::sub(txz, twy));
+		rows[2][1] = simd::mul(sy, simd::add(tyz, twx));
+		rows[2][2] = simd::mul(sz, simd::sub(one, simd::add(txx, tyy)));
+		rows[2][3] = simd::load_u<simd::float32x4>(pose.position[2] + first);
+
+		// Convert from one register per element to one register per matrix row
+		for(UINT32 i = 0; i < 3; i++)
+			simd::transpose4(rows[i][0], rows[i][1], rows[i][2], rows[i][3]);
+
+		for(UINT32 i = 0; i < POSE_SIMD_WIDTH; i++)
+		{
+			if(!writeMatrix[i])
+				continue;
+
+			Matrix4& matrix = output[first + i];
+			simd::store_u(&matrix[0].x, rows[0][i]);
+			simd::store_u(&matrix[1].x, rows[1][i]);
+			simd::store_u(&matrix[2].x, rows[2][i]);
+			matrix[3] = Vector4(0.0f, 0.0f, 0.0f, 1.0f);
+		}
+	}
+
 	void Skeleton::getPose(Matrix4* pose, LocalSkeletonPose& localPose, const SkeletonMask& mask, 
 		const AnimationStateLayer* layers, UINT32 numLayers)
 	{
-		// Note: If more performance is required this method could be optimized with vector instructions
-
 		assert(localPose.numBones == mNumBones);
+		assert(mHierarchyOrder.size() == mNumBones);
 
-		for(UINT32 i = 0; i < mNumBones; i++)
+		// Local transforms are accumulated and converted to matrices in structure-of-arrays form, multiple bones at a 
+		// time. Curve sampling itself remains per-bone, as every bone has its own set of keyframes.
+		const UINT32 numPadded = Math::divideAndRoundUp(mNumBones, POSE_SIMD_WIDTH) * POSE_SIMD_WIDTH;
+		const UINT32 numComponents = 3 + 4 + 3;
+
+		UINT32 bufferSize = sizeof(float) * numPadded * numComponents * 2 + sizeof(UINT32) * numPadded * 3 + 
+			sizeof(bool) * numPadded * 2;
+		UINT8* buffer = (UINT8*)bs_stack_alloc(bufferSize);
+		UINT8* bufferIter = buffer;
+
+		auto allocComponents = [&](float** components, UINT32 count)
 		{
-			localPose.positions[i] = Vector3::ZERO;
-			localPose.rotations[i] = Quaternion::ZERO;
-			localPose.scales[i] = Vector3::ONE;
+			for(UINT32 i = 0; i < count; i++)
+			{
+				components[i] = (float*)bufferIter;
+				bufferIter += sizeof(float) * numPadded;
+			}
+		};
+
+		LocalPoseSoA local;
+		allocComponents(local.position, 3);
+		allocComponents(local.rotation, 4);
+		allocComponents(local.scale, 3);
+
+		LocalPoseSoA sample;
+		allocComponents(sample.position, 3);
+		allocComponents(sample.rotation, 4);
+		allocComponents(sample.scale, 3);
+
+		PoseCurveMask curveMask;
+		curveMask.position = (UINT32*)bufferIter;
+		curveMask.rotation = curveMask.position + numPadded;
+		curveMask.scale = curveMask.rotation + numPadded;
+		bufferIter += sizeof(UINT32) * numPadded * 3;
+
+		bool* hasAnimCurve = (bool*)bufferIter;
+		bool* writeMatrix = hasAnimCurve + numPadded;
+
+		for(UINT32 i = 0; i < 3; i++)
+		{
+			std::fill(local.position[i], local.position[i] + numPadded, 0.0f);
+			std::fill(local.scale[i], local.scale[i] + numPadded, 1.0f);
+			std::fill(sample.position[i], sample.position[i] + numPadded, 0.0f);
+			std::fill(sample.scale[i], sample.scale[i] + numPadded, 0.0f);
+		}
+
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			std::fill(local.rotation[i], local.rotation[i] + numPadded, 0.0f);
+			std::fill(sample.rotation[i], sample.rotation[i] + numPadded, 0.0f);
 		}
 
-		bool* hasAnimCurve = bs_stack_alloc<bool>(mNumBones);
-		bs_zero_out(hasAnimCurve, mNumBones);
+		bs_zero_out(hasAnimCurve, numPadded);
 
 		// Note: For a possible performance improvement consider keeping an array of only active (non-disabled) bones and
 		// just iterate over them without mask checks. Possibly also a list of active curve mappings to avoid those checks
@@ -189,6 +473,10 @@ namespace bs
 				if (Math::approxEquals(normWeight, 0.0f))
 					continue;
 
+				bs_zero_out(curveMask.position, numPadded * 3);
+
+				// Sample the curves of all the bones
+				const CompressedAnimationCurves* compressed = state.compressedCurves.get();
 				for (UINT32 k = 0; k < mNumBones; k++)
 				{
 					if (!mask.isEnabled(k))
@@ -198,59 +486,57 @@ namespace bs
 					UINT32 curveIdx = mapping.position;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->position[curveIdx].curve;
-						localPose.positions[k] += curve.evaluate(state.time, state.positionCaches[curveIdx], state.loop) * normWeight;
-
-						localPose.hasOverride[k] = false;
-						hasAnimCurve[k] = true;
+						const TCurveCache<Vector3>& cache = state.positionCaches[curveIdx];
+						const Vector3 value = compressed ?
+							compressed->position[curveIdx].evaluate(state.time, cache, state.loop) :
+							state.curves->position[curveIdx].curve.evaluate(state.time, cache, state.loop);
+
+						sample.position[0][k] = value.x;
+						sample.position[1][k] = value.y;
+						sample.position[2][k] = value.z;
+						curveMask.position[k] = 0xFFFFFFFF;
 					}
 
 					curveIdx = mapping.scale;
 					if (curveIdx != (UINT32)-1)
 					{
-						const TAnimationCurve<Vector3>& curve = state.curves->scale[curveIdx].curve;
-						localPose.scales[k] *= curve.evaluate(state.time, state.scaleCaches[curveIdx], state.loop) * normWeight;
-
-						localPose.hasOverride[k] = false;
-						hasAnimCurve[k] = true;
+						const TCurveCache<Vector3>& cache = state.scaleCaches[curveIdx];
+						const Vector3 value = compressed ?
+							compressed->scale[curveIdx].evaluate(state.time, cache, state.loop) :
+							state.curves->scale[curveIdx].curve.evaluate(state.time, cache, state.loop);
+
+						sample.scale[0][k] = value.x;
+						sample.scale[1][k] = value.y;
+						sample.scale[2][k] = value.z;
+						curveMask.scale[k] = 0xFFFFFFFF;
 					}
 
-					if (layer.additive)
+					curveIdx = mapping.rotation;
+					if (curveIdx != (UINT32)-1)
 					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							bool isAssigned = localPose.rotations[k].w != 0.0f;
-							if (!isAssigned)
-								localPose.rotations[k] = Quaternion::IDENTITY;
-
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop);
-							value = Quaternion::lerp(normWeight, Quaternion::IDENTITY, value);
-
-							localPose.rotations[k] *= value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
-						}
+						const TCurveCache<Quaternion>& cache = state.rotationCaches[curveIdx];
+						const Quaternion value = compressed ?
+							compressed->rotation[curveIdx].evaluate(state.time, cache, state.loop) :
+							state.curves->rotation[curveIdx].curve.evaluate(state.time, cache, state.loop);
+
+						sample.rotation[0][k] = value.x;
+						sample.rotation[1][k] = value.y;
+						sample.rotation[2][k] = value.z;
+						sample.rotation[3][k] = value.w;
+						curveMask.rotation[k] = 0xFFFFFFFF;
 					}
-					else
+
+					if(curveMask.position[k] != 0 || curveMask.scale[k] != 0 || curveMask.rotation[k] != 0)
 					{
-						curveIdx = mapping.rotation;
-						if (curveIdx != (UINT32)-1)
-						{
-							const TAnimationCurve<Quaternion>& curve = state.curves->rotation[curveIdx].curve;
-							Quaternion value = curve.evaluate(state.time, state.rotationCaches[curveIdx], state.loop) * normWeight;
-
-							if (value.dot(localPose.rotations[k]) < 0.0f)
-								value = -value;
-
-							localPose.rotations[k] += value;
-							localPose.hasOverride[k] = false;
-							hasAnimCurve[k] = true;
-						}
+						localPose.hasOverride[k] = false;
+						hasAnimCurve[k] = true;
 					}
 				}
+
+				// Blend the samples with the pose accumulated so far
+				blendPositions(local, sample, curveMask, normWeight, numPadded);
+				blendScales(local, sample, curveMask, normWeight, numPadded);
+				blendRotations(local, sample, curveMask, normWeight, layer.additive, numPadded);
 			}
 		}
 
@@ -260,63 +546,76 @@ namespace bs
 			if(hasAnimCurve[i])
 				continue;
 
-			localPose.positions[i] = mBoneTransforms[i].getPosition();
-			localPose.rotations[i] = mBoneTransforms[i].getRotation();
-			localPose.scales[i] = mBoneTransforms[i].getScale();
+			const Vector3& position = mBoneTransforms[i].getPosition();
+			const Quaternion& rotation = mBoneTransforms[i].getRotation();
+			const Vector3& scale = mBoneTransforms[i].getScale();
+
+			local.position[0][i] = position.x;
+			local.position[1][i] = position.y;
+			local.position[2][i] = position.z;
+			local.rotation[0][i] = rotation.x;
+			local.rotation[1][i] = rotation.y;
+			local.rotation[2][i] = rotation.z;
+			local.rotation[3][i] = rotation.w;
+			local.scale[0][i] = scale.x;
+			local.scale[1][i] = scale.y;
+			local.scale[2][i] = scale.z;
 		}
 
-		// Calculate local pose matrices
-		UINT32 isGlobalBytes = sizeof(bool) * mNumBones;
-		bool* isGlobal = (bool*)bs_stack_alloc(isGlobalBytes);
-		memset(isGlobal, 0, isGlobalBytes);
+		// Calculate local pose matrices. Overriden bones already contain their global transform.
+		for(UINT32 i = 0; i < numPadded; i++)
+			writeMatrix[i] = i < mNumBones && !localPose.hasOverride[i];
+
+		for(UINT32 i = 0; i < numPadded; i += POSE_SIMD_WIDTH)
+			calcLocalMatrices(local, i, writeMatrix + i, pose);
 
 		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			bool isAssigned = localPose.rotations[i].w != 0.0f;
-			if (!isAssigned)
-				localPose.rotations[i] = Quaternion::IDENTITY;
-			else
-				localPose.rotations[i].normalize();
-
-			if (localPose.hasOverride[i])
-			{
-				isGlobal[i] = true;
-				continue;
-			}
-
-			pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+			localPose.positions[i] = Vector3(local.position[0][i], local.position[1][i], local.position[2][i]);
+			localPose.rotations[i] = Quaternion(local.rotation[3][i], local.rotation[0][i], local.rotation[1][i], 
+				local.rotation[2][i]);
+			localPose.scales[i] = Vector3(local.scale[0][i], local.scale[1][i], local.scale[2][i]);
 		}
 
-		// Calculate global poses
-		// Note: For a possible performance improvement consider sorting bones in such order so that parents (and overrides)
-		// always come before children, we no isGlobal check is needed.
-		std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+		// Calculate global poses, parents are always processed before their children
+		for(auto& boneIdx : mHierarchyOrder)
 		{
+			if(localPose.hasOverride[boneIdx])
+				continue;
+
 			UINT32 parentBoneIdx = mBoneInfo[boneIdx].parent;
 			if (parentBoneIdx == (UINT32)-1)
-			{
-				isGlobal[boneIdx] = true;
-				return;
-			}
-
-			if (!isGlobal[parentBoneIdx])
-				calcGlobal(parentBoneIdx);
+				continue;
 
-			pose[boneIdx] = pose[parentBoneIdx] * pose[boneIdx];
-			isGlobal[boneIdx] = true;
-		};
+			pose[boneIdx] = simd::multiply(pose[parentBoneIdx], pose[boneIdx]);
+		}
 
 		for (UINT32 i = 0; i < mNumBones; i++)
+			pose[i] = simd::multiply(pose[i], mInvBindPoses[i]);
+
+		bs_stack_free(buffer);
+	}
+
+	void Skeleton::buildHierarchyOrder()
+	{
+		// Sorting the bones by their depth in the hierarchy ensures parents are always placed before their children
+		Vector<UINT32> depths(mNumBones);
+		for(UINT32 i = 0; i < mNumBones; i++)
 		{
-			if (!isGlobal[i])
-				calcGlobal(i);
+			UINT32 parentIdx = mBoneInfo[i].parent;
+			while(parentIdx != (UINT32)-1)
+			{
+				depths[i]++;
+				parentIdx = mBoneInfo[parentIdx].parent;
+			}
 		}
 
-		for (UINT32 i = 0; i < mNumBones; i++)
-			pose[i] = pose[i] * mInvBindPoses[i];
+		mHierarchyOrder.resize(mNumBones);
+		for(UINT32 i = 0; i < mNumBones; i++)
+			mHierarchyOrder[i] = i;
 
-		bs_stack_free(isGlobal);
-		bs_stack_free(hasAnimCurve);
+		std::stable_sort(mHierarchyOrder.begin(), mHierarchyOrder.end(), 
+			[&depths](UINT32 a, UINT32 b) { return depths[a] < depths[b]; });
 	}
 
 	Transform Skeleton::calcBoneTransform(UINT32 idx) const
@@ -43,6 +43,8 @@ namespace bs
 	struct AnimationState
 	{
 		SPtr<AnimationCurves> curves; /**< All curves in the animation clip. */
+		/** Compressed translation/rotation/scale curves, used instead of the ones in @p curves if not null. */
+		SPtr<CompressedAnimationCurves> compressedCurves;
 		AnimationCurveMapping* boneToCurveMapping; /**< Mapping of bone indices to curve indices for quick lookup .*/
 		AnimationCurveMapping* soToCurveMapping; /**< Mapping of scene object indices to curve indices for quick lookup. */
 
@@ -180,11 +182,17 @@ namespace bs
 		Skeleton() = default;
 		Skeleton(BONE_DESC* bones, UINT32 numBones);
 
+		/** Fills out @p mHierarchyOrder from the current bone hierarchy. */
+		void buildHierarchyOrder();
+
 		UINT32 mNumBones = 0;
 		Transform* mBoneTransforms = nullptr;
 		Matrix4* mInvBindPoses = nullptr;
 		SkeletonBoneInfo* mBoneInfo = nullptr;
 
+		/** Indices of all bones, sorted so that parent bones always come before their children. */
+		Vector<UINT32> mHierarchyOrder;
+
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
 		/************************************************************************/
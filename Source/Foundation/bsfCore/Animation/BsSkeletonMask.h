@@ -26,8 +26,12 @@ namespace bs
 		 */
 		bool isEnabled(UINT32 boneIdx) const;
 
+		/** Returns a mask in which only the bones enabled in both this and the @p other mask are enabled. */
+		SkeletonMask intersect(const SkeletonMask& other) const;
+
 	private:
 		friend class SkeletonMaskBuilder;
+		friend struct RTTIPlainType<SkeletonMask>;
 
 		Vector<bool> mIsDisabled;
 	};
@@ -131,8 +131,14 @@ namespace bs
 		MessageHandler::startUp();
 		ProfilerCPU::startUp();
 		ProfilingManager::startUp();
-		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>((numWorkerThreads));
-		TaskScheduler::startUp();
+		// Work stealing task scheduler keeps its worker threads permanently allocated from the pool, so make sure there's
+		// enough room left for other threads
+		UINT32 maxPoolThreads = 16;
+		if(mStartUpDesc.taskScheduler == TaskSchedulerMode::WorkStealing)
+			maxPoolThreads += BS_THREAD_HARDWARE_CONCURRENCY * 2;
+
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numWorkerThreads, maxPoolThreads);
+		TaskScheduler::startUp(mStartUpDesc.taskScheduler);
 		TaskScheduler::instance().removeWorker();
 		RenderStats::startUp();
 		CoreThread::startUp();
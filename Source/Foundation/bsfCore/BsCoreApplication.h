@@ -6,6 +6,7 @@
 #include "Utility/BsModule.h"
 #include "RenderAPI/BsRenderWindow.h"
 #include "Utility/BsEvent.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
@@ -23,6 +24,9 @@ namespace bs
 		String input; /**< Name of the input plugin to use. */
 		bool scripting = false; /**< True to load the scripting system. */
 
+		/** Determines how does the task scheduler distribute tasks between worker threads. */
+		TaskSchedulerMode taskScheduler = TaskSchedulerMode::GlobalQueue;
+
 		RENDER_WINDOW_DESC primaryWindowDesc; /**< Describes the window to create during start-up. */
 
 		Vector<String> importers; /**< A list of importer plugins to load. */
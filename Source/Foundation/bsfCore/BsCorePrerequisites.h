@@ -382,7 +382,9 @@ namespace bs
 	class AnimationClip;
 	class GpuPipelineParamInfo;
 	template <class T> class TAnimationCurve;
+	template <class T> class TCompressedAnimationCurve;
 	struct AnimationCurves;
+	struct CompressedAnimationCurves;
 	class Skeleton;
 	class MorphShapes;
 	class MorphShape;
@@ -398,6 +400,7 @@ namespace bs
 	class Resource;
 	class Resources;
 	class ResourceManifest;
+	class SavedResourceData;
 	class MeshBase;
 	class TransientMesh;
 	class MeshHeap;
@@ -637,6 +640,9 @@ namespace bs
 		TID_ParticleRotation = 1190,
 		TID_Decal = 1191,
 		TID_CDecal = 1192,
+		TID_CompressedAnimationCurve = 1193,
+		TID_SkeletonMask = 1194,
+		TID_AnimationLODLevel = 1195,
 
 		// Moved from Engine layer
 		TID_CCamera = 30000,
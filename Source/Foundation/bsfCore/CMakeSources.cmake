@@ -85,6 +85,7 @@ set(BS_CORE_INC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.h"
 	"bsfCore/Scene/BsTransform.h"
 	"bsfCore/Scene/BsSceneActor.h"
+	"bsfCore/Scene/BsTransformHierarchy.h"
 )
 
 set(BS_CORE_INC_INPUT
@@ -550,6 +551,7 @@ set(BS_CORE_SRC_SCENE
 	"bsfCore/Scene/BsPrefabUtility.cpp"
 	"bsfCore/Scene/BsTransform.cpp"
 	"bsfCore/Scene/BsSceneActor.cpp"
+	"bsfCore/Scene/BsTransformHierarchy.cpp"
 )
 
 set(BS_CORE_INC_AUDIO
@@ -604,6 +606,7 @@ set(BS_CORE_INC_PARTICLES
 	"bsfCore/Particles/BsParticleModule.h"
 	"bsfCore/Particles/BsVectorField.h"
 	"bsfCore/Private/Particles/BsParticleSet.h"
+	"bsfCore/Private/Particles/BsParticleKernels.h"
 )
 
 set(BS_CORE_SRC_PARTICLES
@@ -613,6 +616,7 @@ set(BS_CORE_SRC_PARTICLES
 	"bsfCore/Particles/BsParticleManager.cpp"
 	"bsfCore/Particles/BsParticleDistribution.cpp"
 	"bsfCore/Particles/BsVectorField.cpp"
+	"bsfCore/Private/Particles/BsParticleKernels.cpp"
 )
 
 set(BS_CORE_INC_PLATFORM
@@ -191,6 +191,14 @@ namespace bs
 			mInternal->setCulling(enable);
 	}
 
+	void CAnimation::setLODLevels(const Vector<AnimationLODLevel>& levels)
+	{
+		mLODLevels = levels;
+
+		if (mInternal != nullptr && !mPreviewMode)
+			mInternal->setLODLevels(levels);
+	}
+
 	UINT32 CAnimation::getNumClips() const
 	{
 		if (mInternal != nullptr)
@@ -317,6 +325,7 @@ namespace bs
 			mInternal->setWrapMode(mWrapMode);
 			mInternal->setSpeed(mSpeed);
 			mInternal->setCulling(mEnableCull);
+			mInternal->setLODLevels(mLODLevels);
 		}
 
 		_updateBounds();
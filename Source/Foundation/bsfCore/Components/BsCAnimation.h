@@ -140,6 +140,12 @@ namespace bs
 		BS_SCRIPT_EXPORT(n:Cull,pr:getter)
 		bool getEnableCull() const { return mEnableCull; }
 
+		/** @copydoc Animation::setLODLevels */
+		void setLODLevels(const Vector<AnimationLODLevel>& levels);
+
+		/** @copydoc Animation::getLODLevels */
+		const Vector<AnimationLODLevel>& getLODLevels() const { return mLODLevels; }
+
 		/** @copydoc Animation::getNumClips */
 		BS_SCRIPT_EXPORT(in:true)
 		UINT32 getNumClips() const;
@@ -288,6 +294,7 @@ namespace bs
 		bool mUseBounds;
 		bool mPreviewMode;
 		AABox mBounds;
+		Vector<AnimationLODLevel> mLODLevels;
 
 		Vector<SceneObjectMappingInfo> mMappingInfos;
 
@@ -6,9 +6,29 @@
 #include "Error/BsException.h"
 #include "Math/BsMath.h"
 #include "CoreThread/BsCoreThread.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
+	/** Minimum number of dirty objects before their sync data is generated on multiple threads. */
+	static constexpr UINT32 PARALLEL_SYNC_MIN_OBJECTS = 256;
+
+	/** Minimum number of object groups processed by a single task, when sync data is generated on multiple threads. */
+	static constexpr UINT32 PARALLEL_SYNC_GRAIN_SIZE = 16;
+
+	/** Returns the first entry of the group the entry at @p idx belongs to. Shortens the searched path along the way. */
+	static UINT32 findSyncGroup(FrameVector<UINT32>& groups, UINT32 idx)
+	{
+		while(groups[idx] != idx)
+		{
+			groups[idx] = groups[groups[idx]];
+			idx = groups[idx];
+		}
+
+		return idx;
+	}
+
 	CoreObjectManager::CoreObjectManager()
 		:mNextAvailableID(1)
 	{
@@ -30,6 +50,15 @@ namespace bs
 				"engine objects before shutdown.");
 		}
 #endif
+
+		for(auto& syncData : mCoreSyncData)
+		{
+			for(auto& alloc : syncData.workerAllocs)
+				bs_delete(alloc);
+		}
+
+		for(auto& alloc : mFreeSyncAllocs)
+			bs_delete(alloc);
 	}
 
 	UINT64 CoreObjectManager::generateId()
@@ -64,9 +93,10 @@ namespace bs
 				SPtr<ct::CoreObject> coreObject = object->getCore();
 				if (coreObject != nullptr)
 				{
-					CoreSyncData objSyncData = object->syncToCore(gCoreThread().getFrameAlloc());
+					FrameAlloc* allocator = gCoreThread().getFrameAlloc();
+					CoreSyncData objSyncData = object->syncToCore(allocator);
 				
-					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData));
+					mDestroyedSyncData.push_back(CoreStoredSyncObjData(coreObject, internalId, objSyncData, allocator));
 
 					DirtyObjectData& dirtyObjData = mDirtyObjects[internalId];
 					dirtyObjData.syncDataId = (INT32)mDestroyedSyncData.size() - 1;
@@ -300,8 +330,6 @@ namespace bs
 		mCoreSyncData.push_back(CoreStoredSyncData());
 		CoreStoredSyncData& syncData = mCoreSyncData.back();
 
-		syncData.alloc = allocator;
-		
 		// Add all objects dependant on the dirty objects
 		bs_frame_mark();
 		{
@@ -335,20 +363,33 @@ namespace bs
 		}
 
 		bs_frame_clear();
-		
-		// Order in which objects are recursed in matters, ones with lower ID will have been created before
-		// ones with higher ones and should be updated first.
-		for (auto& objectData : mDirtyObjects)
+
+		Timer timer;
+
+		bs_frame_mark();
 		{
-			std::function<void(CoreObject*)> syncObject = [&](CoreObject* curObj)
+			// Object to sync, or null if the object was destroyed and its data was already generated
+			struct SyncEntry
 			{
-				if (!curObj->isCoreDirty())
+				CoreObject* object;
+				SPtr<ct::CoreObject> objectCore;
+				INT32 destroyedSyncDataId;
+			};
+
+			FrameVector<SyncEntry> syncEntries;
+			FrameUnorderedMap<CoreObject*, UINT32> entryIndices;
+
+			// Determine the order in which to sync the objects. Sync data of the objects is generated later, possibly on
+			// multiple threads, but it is always applied in this order.
+			std::function<void(CoreObject*)> addObject = [&](CoreObject* curObj)
+			{
+				if (!curObj->isCoreDirty() || entryIndices.find(curObj) != entryIndices.end())
 					return; // We already processed it as some other object's dependency
 
+				// Objects without sync data are visited, but are never assigned an entry
+				entryIndices[curObj] = (UINT32)-1;
+
 				// Sync dependencies before dependants
-				// Note: I don't check for recursion. Possible infinite loop if two objects
-				// are dependent on one another.
-				
 				UINT64 id = curObj->getInternalID();
 				auto iterFind = mDependencies.find(id);
 
@@ -356,7 +397,7 @@ namespace bs
 				{
 					const Vector<CoreObject*>& dependencies = iterFind->second;
 					for (auto& dependency : dependencies)
-						syncObject(dependency);
+						addObject(dependency);
 				}
 
 				SPtr<ct::CoreObject> objectCore = curObj->getCore();
@@ -366,23 +407,145 @@ namespace bs
 					return;
 				}
 
-				CoreSyncData objSyncData = curObj->syncToCore(allocator);
-				curObj->markCoreClean();
+				entryIndices[curObj] = (UINT32)syncEntries.size();
+				syncEntries.push_back({ curObj, objectCore, -1 });
+			};
+
+			// Order in which objects are recursed in matters, ones with lower ID will have been created before
+			// ones with higher ones and should be updated first.
+			for (auto& objectData : mDirtyObjects)
+			{
+				CoreObject* object = objectData.second.object;
+				if (object != nullptr)
+					addObject(object);
+				else
+				{
+					// Object was destroyed but we still need to sync its modifications before it was destroyed
+					if (objectData.second.syncDataId != -1)
+						syncEntries.push_back({ nullptr, nullptr, objectData.second.syncDataId });
+				}
+			}
+
+			// Partition the entries into groups, so that an object is in the same group as all of its dirty dependencies.
+			// Each group is identified by its first entry.
+			const UINT32 numEntries = (UINT32)syncEntries.size();
+
+			FrameVector<UINT32> groups(numEntries);
+			for (UINT32 i = 0; i < numEntries; i++)
+				groups[i] = i;
+
+			for (UINT32 i = 0; i < numEntries; i++)
+			{
+				CoreObject* object = syncEntries[i].object;
+				if (object == nullptr)
+					continue;
+
+				auto iterFind = mDependencies.find(object->getInternalID());
+				if (iterFind == mDependencies.end())
+					continue;
+
+				for (auto& dependency : iterFind->second)
+				{
+					auto iterFindEntry = entryIndices.find(dependency);
+					if (iterFindEntry == entryIndices.end() || iterFindEntry->second == (UINT32)-1)
+						continue;
+
+					const UINT32 groupA = findSyncGroup(groups, i);
+					const UINT32 groupB = findSyncGroup(groups, iterFindEntry->second);
 
-				syncData.entries.push_back(CoreStoredSyncObjData(objectCore,
-					curObj->getInternalID(), objSyncData));
+					groups[std::max(groupA, groupB)] = std::min(groupA, groupB);
+				}
+			}
+
+			// Store entries of each group next to each other. Entries within a group retain their sync order.
+			FrameVector<UINT32> groupIndices(numEntries, (UINT32)-1);
+			FrameVector<UINT32> groupOffsets(1, 0);
+			for (UINT32 i = 0; i < numEntries; i++)
+			{
+				const UINT32 group = findSyncGroup(groups, i);
+				if (groupIndices[group] == (UINT32)-1)
+				{
+					groupIndices[group] = (UINT32)groupOffsets.size() - 1;
+					groupOffsets.push_back(0);
+				}
+
+				groupOffsets[groupIndices[group] + 1]++;
+			}
+
+			const UINT32 numGroups = (UINT32)groupOffsets.size() - 1;
+			for (UINT32 i = 0; i < numGroups; i++)
+				groupOffsets[i + 1] += groupOffsets[i];
+
+			FrameVector<UINT32> groupEntries(numEntries);
+			FrameVector<UINT32> groupWriteOffsets(groupOffsets.begin(), groupOffsets.end() - 1);
+			for (UINT32 i = 0; i < numEntries; i++)
+				groupEntries[groupWriteOffsets[groupIndices[findSyncGroup(groups, i)]]++] = i;
+
+			// Generate sync data for groups in range [start, end)
+			syncData.entries.resize(numEntries);
+			const auto generateSyncData = [&](UINT32 start, UINT32 end, FrameAlloc* alloc)
+			{
+				for (UINT32 i = groupOffsets[start]; i < groupOffsets[end]; i++)
+				{
+					const UINT32 entryIdx = groupEntries[i];
+					const SyncEntry& entry = syncEntries[entryIdx];
+
+					if (entry.object == nullptr)
+					{
+						syncData.entries[entryIdx] = mDestroyedSyncData[entry.destroyedSyncDataId];
+						continue;
+					}
+
+					CoreSyncData objSyncData = entry.object->syncToCore(alloc);
+					entry.object->markCoreClean();
+
+					syncData.entries[entryIdx] = CoreStoredSyncObjData(entry.objectCore, entry.object->getInternalID(),
+						objSyncData, alloc);
+				}
 			};
 
-			CoreObject* object = objectData.second.object;
-			if (object != nullptr)
-				syncObject(object);
-			else
+			if (numEntries >= PARALLEL_SYNC_MIN_OBJECTS && numGroups > 1 && TaskScheduler::isStarted())
 			{
-				// Object was destroyed but we still need to sync its modifications before it was destroyed
-				if (objectData.second.syncDataId != -1)
-					syncData.entries.push_back(mDestroyedSyncData[objectData.second.syncDataId]);
+				// Each thread generates its data using a separate allocator, kept alive until the data is applied. This thread
+				// must not execute unrelated tasks while it waits, as they could try to register or unregister core objects
+				// while the objects mutex is held.
+				UnorderedMap<ThreadId, FrameAlloc*> threadAllocs;
+				Mutex threadAllocsMutex;
+
+				TaskScheduler::instance().parallelFor(0, numGroups, PARALLEL_SYNC_GRAIN_SIZE,
+					[&](UINT32 start, UINT32 end)
+				{
+					FrameAlloc* alloc;
+					{
+						Lock allocsLock(threadAllocsMutex);
+
+						FrameAlloc*& threadAlloc = threadAllocs[BS_THREAD_CURRENT_ID];
+						if (threadAlloc == nullptr)
+						{
+							threadAlloc = acquireSyncAlloc();
+							syncData.workerAllocs.push_back(threadAlloc);
+						}
+
+						alloc = threadAlloc;
+					}
+
+					generateSyncData(start, end, alloc);
+				}, TaskPriority::Normal, false);
 			}
+			else
+				generateSyncData(0, numGroups, allocator);
+
+			mLastSyncStats = CoreObjectSyncStats();
+			mLastSyncStats.numObjects = numEntries;
+			mLastSyncStats.numGroups = numGroups;
+			mLastSyncStats.numAllocators = syncData.workerAllocs.empty() ? 1 : (UINT32)syncData.workerAllocs.size();
+
+			for (auto& entry : syncData.entries)
+				mLastSyncStats.numBytes += entry.syncData.getBufferSize();
+
+			mLastSyncStats.time = timer.getMicroseconds();
 		}
+		bs_frame_clear();
 
 		mDirtyObjects.clear();
 		mDestroyedSyncData.clear();
@@ -406,10 +569,41 @@ namespace bs
 			UINT8* data = objSyncData.syncData.getBuffer();
 
 			if (data != nullptr)
-				syncData.alloc->free(data);
+				objSyncData.alloc->free(data);
 		}
 
+		for (auto& alloc : syncData.workerAllocs)
+			releaseSyncAlloc(alloc);
+
 		syncData.entries.clear();
 		mCoreSyncData.pop_front();
 	}
+
+	CoreObjectSyncStats CoreObjectManager::getLastSyncStats() const
+	{
+		Lock lock(mObjectsMutex);
+
+		return mLastSyncStats;
+	}
+
+	FrameAlloc* CoreObjectManager::acquireSyncAlloc()
+	{
+		Lock lock(mSyncAllocMutex);
+
+		if (mFreeSyncAllocs.empty())
+			return bs_new<FrameAlloc>();
+
+		FrameAlloc* alloc = mFreeSyncAllocs.back();
+		mFreeSyncAllocs.pop_back();
+
+		return alloc;
+	}
+
+	void CoreObjectManager::releaseSyncAlloc(FrameAlloc* alloc)
+	{
+		alloc->clear();
+
+		Lock lock(mSyncAllocMutex);
+		mFreeSyncAllocs.push_back(alloc);
+	}
 }
\ No newline at end of file
@@ -12,6 +12,28 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Statistics about a single synchronization of dirty CoreObject%s with the core thread. */
+	struct CoreObjectSyncStats
+	{
+		/** Number of objects whose data was synced. Includes objects destroyed since the previous sync. */
+		UINT32 numObjects = 0;
+
+		/** Total size of the sync data generated for all synced objects, in bytes. */
+		UINT32 numBytes = 0;
+
+		/**
+		 * Number of groups the synced objects were partitioned in. Objects in different groups have no dependencies on
+		 * each other, and their sync data can be generated in parallel.
+		 */
+		UINT32 numGroups = 0;
+
+		/** Number of allocators the sync data was generated into. Larger than one if the data was generated in parallel. */
+		UINT32 numAllocators = 0;
+
+		/** Time spent generating the sync data, in microseconds. */
+		UINT64 time = 0;
+	};
+
 	// TODO Low priority - Add debug option that would remember a call stack for each resource initialization,
 	// so when we fail to release one we know which one it is.
 	
@@ -33,13 +55,15 @@ namespace bs
 				:internalId(0)
 			{ }
 
-			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData)
-				:destinationObj(destObj), syncData(syncData), internalId(internalId)
+			CoreStoredSyncObjData(const SPtr<ct::CoreObject> destObj, UINT64 internalId, const CoreSyncData& syncData,
+				FrameAlloc* alloc)
+				:destinationObj(destObj), syncData(syncData), internalId(internalId), alloc(alloc)
 			{ }
 
 			SPtr<ct::CoreObject> destinationObj;
 			CoreSyncData syncData;
 			UINT64 internalId;
+			FrameAlloc* alloc = nullptr;
 		};
 
 		/**
@@ -48,8 +72,10 @@ namespace bs
 		 */
 		struct CoreStoredSyncData
 		{
-			FrameAlloc* alloc = nullptr;
 			Vector<CoreStoredSyncObjData> entries;
+
+			/** Allocators owned by the manager that were used for generating the data in parallel. */
+			Vector<FrameAlloc*> workerAllocs;
 		};
 
 		/** Contains information about a dirty CoreObject that requires syncing to the core thread. */	
@@ -96,11 +122,18 @@ namespace bs
 		 */
 		void syncToCore(CoreObject* object);
 
+		/** Returns statistics about the most recent synchronization performed through syncToCore(). */
+		CoreObjectSyncStats getLastSyncStats() const;
+
 	private:
 		/**
 		 * Stores all syncable data from dirty core objects into memory allocated by the provided allocator. Additional 
 		 * meta-data is stored internally to be used by call to syncUpload().
 		 *
+		 * Dirty objects are partitioned into groups of objects that depend on each other. When there are many dirty
+		 * objects the groups are processed in parallel, each task storing its data using a separate allocator owned by
+		 * the manager.
+		 *
 		 * @param[in]	allocator Allocator to use for allocating memory for stored data.
 		 *
 		 * @note	Sim thread only.
@@ -124,6 +157,12 @@ namespace bs
 		 */
 		void updateDependencies(CoreObject* object, Vector<CoreObject*>* dependencies);
 
+		/** Returns an unused allocator for storing sync data on a worker thread. */
+		FrameAlloc* acquireSyncAlloc();
+
+		/** Clears an allocator previously returned by acquireSyncAlloc() and makes it available for reuse. */
+		void releaseSyncAlloc(FrameAlloc* alloc);
+
 		UINT64 mNextAvailableID;
 		Map<UINT64, CoreObject*> mObjects;
 		Map<UINT64, DirtyObjectData> mDirtyObjects;
@@ -133,7 +172,11 @@ namespace bs
 		Vector<CoreStoredSyncObjData> mDestroyedSyncData;
 		List<CoreStoredSyncData> mCoreSyncData;
 
-		Mutex mObjectsMutex;
+		CoreObjectSyncStats mLastSyncStats;
+		Vector<FrameAlloc*> mFreeSyncAllocs;
+
+		mutable Mutex mObjectsMutex;
+		Mutex mSyncAllocMutex;
 	};
 
 	/** @} */
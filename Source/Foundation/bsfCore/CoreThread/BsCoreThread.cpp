@@ -4,17 +4,20 @@
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
 #include "BsCoreApplication.h"
-
-using namespace std::placeholders;
+#include "Debug/BsDebug.h"
 
 namespace bs
 {
+	/** Maximum number of commands that may be waiting in the internal command queue before submitting threads stall. */
+	static constexpr UINT32 COMMAND_RING_CAPACITY = 4096;
+
 	CoreThread::QueueData CoreThread::mPerThreadQueue;
 	BS_THREADLOCAL CoreThread::ThreadQueueContainer* CoreThread::QueueData::current = nullptr;
 
 	CoreThread::CoreThread()
 		: mActiveFrameAlloc(0)
 		, mCoreThreadShutdown(false)
+		, mCoreThreadWaiting(false)
 		, mCoreThreadStarted(false)
 		, mCommandQueue(nullptr)
 		, mMaxCommandNotifyId(0)
@@ -27,7 +30,8 @@ namespace bs
 
 		mSimThreadId = BS_THREAD_CURRENT_ID;
 		mCoreThreadId = mSimThreadId; // For now
-		mCommandQueue = bs_new<CommandQueue<CommandQueueSync>>(BS_THREAD_CURRENT_ID);
+		mCommandQueue = bs_new<CommandRing<>>(COMMAND_RING_CAPACITY);
+		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
 
 		initCoreThread();
 	}
@@ -93,14 +97,20 @@ namespace bs
 		while(true)
 		{
 			// Wait until we get some ready commands
-			Queue<QueuedCommand>* commands = nullptr;
+			if(mCommandQueue->isEmpty())
 			{
 				Lock lock(mCommandQueueMutex);
 
+				// Submitting threads only lock the mutex and signal if they see this flag set after queuing their command,
+				// so the flag must be visible before the queue is checked again
+				mCoreThreadWaiting.store(true, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
 				while(mCommandQueue->isEmpty())
 				{
 					if(mCoreThreadShutdown)
 					{
+						mCoreThreadWaiting.store(false, std::memory_order_relaxed);
 						TaskScheduler::instance().addWorker();
 						return;
 					}
@@ -110,11 +120,12 @@ namespace bs
 					TaskScheduler::instance().removeWorker();
 				}
 
-				commands = mCommandQueue->flush();
+				mCoreThreadWaiting.store(false, std::memory_order_relaxed);
 			}
 
 			// Play commands
-			mCommandQueue->playbackWithNotify(commands, std::bind(&CoreThread::commandCompletedNotify, this, _1)); 
+			while(mCommandQueue->tryExecute())
+			{ }
 		}
 #endif
 	}
@@ -183,6 +194,27 @@ namespace bs
 		getQueue()->submitToCoreThread(blockUntilComplete);
 	}
 
+	template<class T>
+	void CoreThread::queueInternalCommand(T&& command)
+	{
+#if BS_FORCE_SINGLETHREADED_RENDERING
+		command();
+#else
+		mCommandQueue->push(std::forward<T>(command));
+
+		// Pairs with the fence in runCoreThread(). Either the core thread sees the new command before going to sleep, or
+		// we see that it is waiting and wake it up.
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if(mCoreThreadWaiting.load(std::memory_order_relaxed))
+		{
+			// Make sure the core thread is either already waiting on the signal, or hasn't checked the queue yet
+			{ Lock lock(mCommandQueueMutex); }
+
+			mCommandReadyCondition.notify_one();
+		}
+#endif
+	}
+
 	AsyncOp CoreThread::queueReturnCommand(std::function<void(AsyncOp&)> commandCallback, CoreThreadQueueFlags flags)
 	{
 		assert(BS_THREAD_CURRENT_ID != getCoreThreadId() && "Cannot queue commands on the core thread for the core thread");
@@ -191,23 +223,28 @@ namespace bs
 			return getQueue()->queueReturnCommand(commandCallback);
 		else
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+			bool blockUntilComplete = !BS_FORCE_SINGLETHREADED_RENDERING && flags.isSet(CTQF_BlockUntilComplete);
 
-			AsyncOp op;
+			AsyncOp op(mAsyncOpSyncData);
 			UINT32 commandId = -1;
+
+			if (blockUntilComplete)
+				commandId = mMaxCommandNotifyId.fetch_add(1, std::memory_order_relaxed);
+
+			queueInternalCommand([this, callback = std::move(commandCallback), op, commandId]() mutable
 			{
-				Lock lock(mCommandQueueMutex);
+				callback(op);
 
-				if (blockUntilComplete)
+				if(!op.hasCompleted())
 				{
-					commandId = mMaxCommandNotifyId++;
-					op = mCommandQueue->queueReturn(commandCallback, true, commandId);
+					LOGDBG("Async operation return value wasn't resolved properly. Resolving automatically to nullptr. " \
+						"Make sure to complete the operation before returning from the command callback method.");
+					op._completeOperation(nullptr);
 				}
-				else
-					op = mCommandQueue->queueReturn(commandCallback);
-			}
 
-			mCommandReadyCondition.notify_all();
+				if (commandId != (UINT32)-1)
+					commandCompletedNotify(commandId);
+			});
 
 			if (blockUntilComplete)
 				blockUntilCommandCompleted(commandId);
@@ -224,22 +261,19 @@ namespace bs
 			getQueue()->queueCommand(commandCallback);
 		else
 		{
-			bool blockUntilComplete = flags.isSet(CTQF_BlockUntilComplete);
+			bool blockUntilComplete = !BS_FORCE_SINGLETHREADED_RENDERING && flags.isSet(CTQF_BlockUntilComplete);
 
 			UINT32 commandId = -1;
-			{
-				Lock lock(mCommandQueueMutex);
+			if (blockUntilComplete)
+				commandId = mMaxCommandNotifyId.fetch_add(1, std::memory_order_relaxed);
 
-				if (blockUntilComplete)
-				{
-					commandId = mMaxCommandNotifyId++;
-					mCommandQueue->queue(commandCallback, true, commandId);
-				}
-				else
-					mCommandQueue->queue(commandCallback);
-			}
+			queueInternalCommand([this, callback = std::move(commandCallback), commandId]()
+			{
+				callback();
 
-			mCommandReadyCondition.notify_all();
+				if (commandId != (UINT32)-1)
+					commandCompletedNotify(commandId);
+			});
 
 			if (blockUntilComplete)
 				blockUntilCommandCompleted(commandId);
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "CoreThread/BsCommandQueue.h"
+#include "Threading/BsCommandRing.h"
 #include "CoreThread/BsCoreThreadQueue.h"
 #include "Threading/BsThreadPool.h"
 
@@ -54,6 +55,8 @@ namespace bs
 	 *      which point they are made visible to the core thread, and will begin executing.
 	 * 	  - Commands can also be submitted directly to the internal command queue (via a special flag), but with a 
 	 * 	    performance cost due to extra synchronization required.
+	 *    - The internal command queue is a lock-free ring, so any number of threads may submit to it without contending
+	 *      on a mutex. A mutex is only used for waking up the core thread if it ran out of commands.
 	 */
 	class BS_CORE_EXPORT CoreThread : public Module<CoreThread>
 	{
@@ -153,6 +156,7 @@ namespace bs
 		Vector<ThreadQueueContainer*> mAllQueues;
 
 		volatile bool mCoreThreadShutdown;
+		std::atomic<bool> mCoreThreadWaiting;
 
 		HThread mCoreThread;
 		bool mCoreThreadStarted;
@@ -166,9 +170,10 @@ namespace bs
 		Mutex mThreadStartedMutex;
 		Signal mCoreThreadStartedCondition;
 
-		CommandQueue<CommandQueueSync>* mCommandQueue;
+		CommandRing<>* mCommandQueue;
+		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
 
-		UINT32 mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
+		std::atomic<UINT32> mMaxCommandNotifyId; /**< ID that will be assigned to the next command with a notifier callback. */
 		Vector<UINT32> mCommandsCompleted; /**< Completed commands that have notifier callbacks set up */
 
 		/** Starts the core thread worker method. Should only be called once. */
@@ -180,6 +185,13 @@ namespace bs
 		/** Shutdowns the core thread. It will complete all ready commands before shutdown. */
 		void shutdownCoreThread();
 
+		/**
+		 * Adds a command to the internal command queue, and wakes up the core thread if it is waiting for commands. Safe
+		 * to call from any thread.
+		 */
+		template<class T>
+		void queueInternalCommand(T&& command);
+
 		/** Creates or retrieves a queue for the calling thread. */
 		SPtr<TCoreThreadQueue<CommandQueueNoSync>> getQueue();
 
@@ -6,6 +6,8 @@
 #include "Math/BsMath.h"
 #include "Error/BsException.h"
 #include "Image/BsTexture.h"
+#include "Math/BsSIMD.h"
+#include "Threading/BsTaskScheduler.h"
 #include <nvtt.h>
 
 namespace bs
@@ -1879,6 +1881,406 @@ namespace bs
 		}
 	}
 
+	/** Minimum number of pixels an image must have before its rows are processed on multiple threads. */
+	static constexpr UINT32 PARALLEL_PIXEL_THRESHOLD = 256 * 256;
+
+	/** Minimum number of pixels processed by a single thread, when processing rows on multiple threads. */
+	static constexpr UINT32 PARALLEL_PIXEL_GRAIN = 64 * 1024;
+
+	/**
+	 * Calls @p worker for every row of pixels in the source and destination, with pointers to the first pixel of the
+	 * row in both. Source and destination must have the same dimensions. Rows of large images are split between
+	 * multiple threads if the task scheduler is running.
+	 */
+	static void forEachPixelRow(const PixelData& src, const PixelData& dst, 
+		const std::function<void(const UINT8*, UINT8*)>& worker)
+	{
+		const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+		const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+		const UINT8* srcData = static_cast<UINT8*>(src.getData())
+			+ (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
+		UINT8* dstData = static_cast<UINT8*>(dst.getData())
+			+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
+
+		const UINT32 height = src.getHeight();
+		const UINT32 numRows = height * src.getDepth();
+
+		const auto processRows = [&](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const UINT32 y = i % height;
+				const UINT32 z = i / height;
+
+				const UINT8* srcRow = srcData + (z * src.getSlicePitch() + y * src.getRowPitch()) * srcPixelSize;
+				UINT8* dstRow = dstData + (z * dst.getSlicePitch() + y * dst.getRowPitch()) * dstPixelSize;
+
+				worker(srcRow, dstRow);
+			}
+		};
+
+		const UINT32 width = std::max(src.getWidth(), 1U);
+		if (width * numRows >= PARALLEL_PIXEL_THRESHOLD && TaskScheduler::isStarted())
+		{
+			const UINT32 rowsPerTask = std::max(PARALLEL_PIXEL_GRAIN / width, 1U);
+			TaskScheduler::instance().parallelFor(0, numRows, rowsPerTask, processRows);
+		}
+		else
+			processRows(0, numRows);
+	}
+
+	/** Converts a row of @p count pixels from one format to another. */
+	typedef void(*PixelRowConverter)(const UINT8* src, UINT8* dst, UINT32 count);
+
+	/** 
+	 * Describes a pixel format that stores 8-bit normalized channels in a 32-bit word (RGBA8, BGRA8, RGB8 and BGR8). 
+	 * Formats without alpha leave the last byte unused.
+	 */
+	template<PixelFormat Format> struct WordPixelFormat { };
+	template<> struct WordPixelFormat<PF_RGBA8> { static constexpr bool BGR = false, HAS_ALPHA = true; };
+	template<> struct WordPixelFormat<PF_BGRA8> { static constexpr bool BGR = true, HAS_ALPHA = true; };
+	template<> struct WordPixelFormat<PF_RGB8> { static constexpr bool BGR = false, HAS_ALPHA = false; };
+	template<> struct WordPixelFormat<PF_BGR8> { static constexpr bool BGR = true, HAS_ALPHA = false; };
+
+	/** Swaps the first and the third byte of a 32-bit word. */
+	static UINT32 swapRedBlue(UINT32 value)
+	{
+		return (value & 0xFF00FF00) | ((value >> 16) & 0x000000FF) | ((value << 16) & 0x00FF0000);
+	}
+
+	/** @copydoc swapRedBlue(UINT32) */
+	static simd::uint32x4 swapRedBlue(const simd::uint32x4& value)
+	{
+		const simd::uint32x4 greenAlphaMask = simd::make_uint(0xFF00FF00);
+		const simd::uint32x4 redMask = simd::make_uint(0x00FF0000);
+		const simd::uint32x4 blueMask = simd::make_uint(0x000000FF);
+
+		const simd::uint32x4 greenAlpha = simd::bit_and(value, greenAlphaMask);
+		const simd::uint32x4 red = simd::shift_r<16>(simd::bit_and(value, redMask));
+		const simd::uint32x4 blue = simd::shift_l<16>(simd::bit_and(value, blueMask));
+
+		return simd::bit_or(greenAlpha, simd::bit_or(red, blue));
+	}
+
+	/** Converts between two formats described by WordPixelFormat, by reordering channels and setting missing alpha. */
+	template<PixelFormat Src, PixelFormat Dst>
+	static void convertWordToWord(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		constexpr bool srcAlpha = WordPixelFormat<Src>::HAS_ALPHA;
+		constexpr bool dstAlpha = WordPixelFormat<Dst>::HAS_ALPHA;
+
+		constexpr bool swap = WordPixelFormat<Src>::BGR != WordPixelFormat<Dst>::BGR;
+		constexpr UINT32 keepMask = srcAlpha && dstAlpha ? 0xFFFFFFFF : 0x00FFFFFF;
+		constexpr UINT32 setMask = !srcAlpha && dstAlpha ? 0xFF000000 : 0;
+
+		const simd::uint32x4 keepMaskVec = simd::make_uint(keepMask);
+		const simd::uint32x4 setMaskVec = simd::make_uint(setMask);
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			simd::uint32x4 value = simd::load_u<simd::uint32x4>(src + i * 4);
+			if (swap)
+				value = swapRedBlue(value);
+
+			value = simd::bit_or(simd::bit_and(value, keepMaskVec), setMaskVec);
+			simd::store_u(dst + i * 4, value);
+		}
+
+		for (; i < count; i++)
+		{
+			UINT32 value;
+			memcpy(&value, src + i * 4, sizeof(value));
+
+			if (swap)
+				value = swapRedBlue(value);
+
+			value = (value & keepMask) | setMask;
+			memcpy(dst + i * 4, &value, sizeof(value));
+		}
+	}
+
+	/** Expands a R8 or RG8 format to a format described by WordPixelFormat. */
+	template<PixelFormat Src, PixelFormat Dst>
+	static void convertByteToWord(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		constexpr UINT32 numChannels = Src == PF_RG8 ? 2 : 1;
+		constexpr UINT32 redShift = WordPixelFormat<Dst>::BGR ? 16 : 0;
+		constexpr UINT32 alpha = WordPixelFormat<Dst>::HAS_ALPHA ? 0xFF000000 : 0;
+
+		UINT32* output = (UINT32*)dst;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			UINT32 value = ((UINT32)src[i * numChannels] << redShift) | alpha;
+			if (numChannels > 1)
+				value |= (UINT32)src[i * numChannels + 1] << 8;
+
+			output[i] = value;
+		}
+	}
+
+	/** Converts a format described by WordPixelFormat to RGBA32F. */
+	template<PixelFormat Src>
+	static void convertWordToFloat(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		float* output = (float*)dst;
+
+		const simd::uint32x4 byteMask = simd::make_uint(0xFF);
+		const simd::float32x4 maxValue = simd::make_float(255.0f);
+		const simd::float32x4 one = simd::make_float(1.0f);
+		const auto toUnorm = [&](const simd::uint32x4& value)
+		{
+			const simd::int32x4 channel = simd::bit_cast<simd::int32x4>(simd::bit_and(value, byteMask));
+			return simd::float32x4(simd::div(simd::to_float32(channel), maxValue));
+		};
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			const simd::uint32x4 value = simd::load_u<simd::uint32x4>(src + i * 4);
+
+			// Split the channels, so each register contains the same channel of four pixels
+			simd::float32x4 r = toUnorm(value);
+			simd::float32x4 g = toUnorm(simd::shift_r<8>(value));
+			simd::float32x4 b = toUnorm(simd::shift_r<16>(value));
+			simd::float32x4 a = one;
+			if (WordPixelFormat<Src>::HAS_ALPHA)
+				a = toUnorm(simd::shift_r<24>(value));
+
+			if (WordPixelFormat<Src>::BGR)
+				std::swap(r, b);
+
+			// And interleave them back, so each register contains a single pixel
+			simd::transpose4(r, g, b, a);
+			simd::store_u(output + i * 4 + 0, r);
+			simd::store_u(output + i * 4 + 4, g);
+			simd::store_u(output + i * 4 + 8, b);
+			simd::store_u(output + i * 4 + 12, a);
+		}
+
+		for (; i < count; i++)
+		{
+			float* pixel = output + i * 4;
+			PixelUtil::unpackColor(pixel, pixel + 1, pixel + 2, pixel + 3, Src, src + i * 4);
+		}
+	}
+
+	/** Converts RGBA32F to a format described by WordPixelFormat. */
+	template<PixelFormat Dst>
+	static void convertFloatToWord(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const float* input = (const float*)src;
+
+		const simd::float32x4 zero = simd::make_float(0.0f);
+		const simd::float32x4 one = simd::make_float(1.0f);
+		const simd::float32x4 maxValue = simd::make_float(255.0f);
+		const simd::float32x4 half = simd::make_float(0.5f);
+		const auto toByte = [&](const simd::float32x4& value)
+		{
+			// Same as Bitwise::unormToUint<8>()
+			const simd::float32x4 clamped = simd::min(simd::max(value, zero), one);
+			const simd::int32x4 rounded = simd::to_int32(simd::add(simd::mul(clamped, maxValue), half));
+
+			return simd::bit_cast<simd::uint32x4>(rounded);
+		};
+
+		UINT32 i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			simd::float32x4 r = simd::load_u<simd::float32x4>(input + i * 4 + 0);
+			simd::float32x4 g = simd::load_u<simd::float32x4>(input + i * 4 + 4);
+			simd::float32x4 b = simd::load_u<simd::float32x4>(input + i * 4 + 8);
+			simd::float32x4 a = simd::load_u<simd::float32x4>(input + i * 4 + 12);
+
+			// Registers contain a pixel each, transpose so each contains a single channel of all four pixels
+			simd::transpose4(r, g, b, a);
+
+			if (WordPixelFormat<Dst>::BGR)
+				std::swap(r, b);
+
+			simd::uint32x4 value = simd::bit_or(toByte(r), simd::shift_l<8>(toByte(g)));
+			value = simd::bit_or(value, simd::shift_l<16>(toByte(b)));
+
+			if (WordPixelFormat<Dst>::HAS_ALPHA)
+				value = simd::bit_or(value, simd::shift_l<24>(toByte(a)));
+
+			simd::store_u(dst + i * 4, value);
+		}
+
+		for (; i < count; i++)
+			PixelUtil::packColor(input[i * 4], input[i * 4 + 1], input[i * 4 + 2], input[i * 4 + 3], Dst, dst + i * 4);
+	}
+
+	/** Converts a format described by WordPixelFormat to RGBA16F. */
+	template<PixelFormat Src>
+	static void convertWordToHalf(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		// Only 256 possible inputs, so they are converted up front
+		struct HalfTable
+		{
+			HalfTable()
+			{
+				for (UINT32 i = 0; i < 256; i++)
+					values[i] = Bitwise::floatToHalf(Bitwise::uintToUnorm<8>(i));
+			}
+
+			UINT16 values[256];
+		};
+
+		static const HalfTable table;
+		constexpr UINT32 redIdx = WordPixelFormat<Src>::BGR ? 2 : 0;
+		constexpr UINT32 blueIdx = WordPixelFormat<Src>::BGR ? 0 : 2;
+		const UINT16 one = Bitwise::floatToHalf(1.0f);
+
+		UINT16* output = (UINT16*)dst;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const UINT8* pixel = src + i * 4;
+
+			output[i * 4 + 0] = table.values[pixel[redIdx]];
+			output[i * 4 + 1] = table.values[pixel[1]];
+			output[i * 4 + 2] = table.values[pixel[blueIdx]];
+			output[i * 4 + 3] = WordPixelFormat<Src>::HAS_ALPHA ? table.values[pixel[3]] : one;
+		}
+	}
+
+	/** Converts RGBA16F to a format described by WordPixelFormat. */
+	template<PixelFormat Dst>
+	static void convertHalfToWord(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		// Every possible half value is converted up front, which is much faster than decoding them individually
+		struct ByteTable
+		{
+			ByteTable()
+			{
+				values = bs_newN<UINT8>(65536);
+				for (UINT32 i = 0; i < 65536; i++)
+				{
+					// Table includes NaN encodings, which can't be converted
+					const float value = Bitwise::halfToFloat((UINT16)i);
+					values[i] = std::isnan(value) ? 0 : (UINT8)Bitwise::unormToUint<8>(value);
+				}
+			}
+
+			~ByteTable()
+			{
+				bs_deleteN(values, 65536);
+			}
+
+			UINT8* values;
+		};
+
+		static const ByteTable table;
+		constexpr UINT32 redShift = WordPixelFormat<Dst>::BGR ? 16 : 0;
+		constexpr UINT32 blueShift = WordPixelFormat<Dst>::BGR ? 0 : 16;
+
+		const UINT16* input = (const UINT16*)src;
+		UINT32* output = (UINT32*)dst;
+		for (UINT32 i = 0; i < count; i++)
+		{
+			const UINT16* pixel = input + i * 4;
+
+			UINT32 value = (UINT32)table.values[pixel[0]] << redShift;
+			value |= (UINT32)table.values[pixel[1]] << 8;
+			value |= (UINT32)table.values[pixel[2]] << blueShift;
+
+			if (WordPixelFormat<Dst>::HAS_ALPHA)
+				value |= (UINT32)table.values[pixel[3]] << 24;
+
+			output[i] = value;
+		}
+	}
+
+	/** Converts RGBA16F to RGBA32F. */
+	static void convertHalfToFloat(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const UINT16* input = (const UINT16*)src;
+		float* output = (float*)dst;
+
+		for (UINT32 i = 0; i < count * 4; i++)
+			output[i] = Bitwise::halfToFloat(input[i]);
+	}
+
+	/** Converts RGBA32F to RGBA16F. */
+	static void convertFloatToHalf(const UINT8* src, UINT8* dst, UINT32 count)
+	{
+		const float* input = (const float*)src;
+		UINT16* output = (UINT16*)dst;
+
+		for (UINT32 i = 0; i < count * 4; i++)
+			output[i] = Bitwise::floatToHalf(input[i]);
+	}
+
+	/** Converter specialized for a particular pair of formats. */
+	struct PixelConverterDesc
+	{
+		PixelFormat src;
+		PixelFormat dst;
+		PixelRowConverter convert;
+	};
+
+	/** 
+	 * Converters for commonly used pairs of formats. Each produces the same output as converting the pixels one by one
+	 * using unpackColor() and packColor().
+	 */
+	static const PixelConverterDesc PIXEL_CONVERTERS[] =
+	{
+		{ PF_RGBA8, PF_BGRA8, &convertWordToWord<PF_RGBA8, PF_BGRA8> },
+		{ PF_RGBA8, PF_RGB8, &convertWordToWord<PF_RGBA8, PF_RGB8> },
+		{ PF_RGBA8, PF_BGR8, &convertWordToWord<PF_RGBA8, PF_BGR8> },
+		{ PF_BGRA8, PF_RGBA8, &convertWordToWord<PF_BGRA8, PF_RGBA8> },
+		{ PF_BGRA8, PF_RGB8, &convertWordToWord<PF_BGRA8, PF_RGB8> },
+		{ PF_BGRA8, PF_BGR8, &convertWordToWord<PF_BGRA8, PF_BGR8> },
+		{ PF_RGB8, PF_RGBA8, &convertWordToWord<PF_RGB8, PF_RGBA8> },
+		{ PF_RGB8, PF_BGRA8, &convertWordToWord<PF_RGB8, PF_BGRA8> },
+		{ PF_RGB8, PF_BGR8, &convertWordToWord<PF_RGB8, PF_BGR8> },
+		{ PF_BGR8, PF_RGBA8, &convertWordToWord<PF_BGR8, PF_RGBA8> },
+		{ PF_BGR8, PF_BGRA8, &convertWordToWord<PF_BGR8, PF_BGRA8> },
+		{ PF_BGR8, PF_RGB8, &convertWordToWord<PF_BGR8, PF_RGB8> },
+
+		{ PF_R8, PF_RGBA8, &convertByteToWord<PF_R8, PF_RGBA8> },
+		{ PF_R8, PF_BGRA8, &convertByteToWord<PF_R8, PF_BGRA8> },
+		{ PF_R8, PF_RGB8, &convertByteToWord<PF_R8, PF_RGB8> },
+		{ PF_R8, PF_BGR8, &convertByteToWord<PF_R8, PF_BGR8> },
+		{ PF_RG8, PF_RGBA8, &convertByteToWord<PF_RG8, PF_RGBA8> },
+		{ PF_RG8, PF_BGRA8, &convertByteToWord<PF_RG8, PF_BGRA8> },
+		{ PF_RG8, PF_RGB8, &convertByteToWord<PF_RG8, PF_RGB8> },
+		{ PF_RG8, PF_BGR8, &convertByteToWord<PF_RG8, PF_BGR8> },
+
+		{ PF_RGBA8, PF_RGBA32F, &convertWordToFloat<PF_RGBA8> },
+		{ PF_BGRA8, PF_RGBA32F, &convertWordToFloat<PF_BGRA8> },
+		{ PF_RGB8, PF_RGBA32F, &convertWordToFloat<PF_RGB8> },
+		{ PF_BGR8, PF_RGBA32F, &convertWordToFloat<PF_BGR8> },
+		{ PF_RGBA32F, PF_RGBA8, &convertFloatToWord<PF_RGBA8> },
+		{ PF_RGBA32F, PF_BGRA8, &convertFloatToWord<PF_BGRA8> },
+		{ PF_RGBA32F, PF_RGB8, &convertFloatToWord<PF_RGB8> },
+		{ PF_RGBA32F, PF_BGR8, &convertFloatToWord<PF_BGR8> },
+
+		{ PF_RGBA8, PF_RGBA16F, &convertWordToHalf<PF_RGBA8> },
+		{ PF_BGRA8, PF_RGBA16F, &convertWordToHalf<PF_BGRA8> },
+		{ PF_RGB8, PF_RGBA16F, &convertWordToHalf<PF_RGB8> },
+		{ PF_BGR8, PF_RGBA16F, &convertWordToHalf<PF_BGR8> },
+		{ PF_RGBA16F, PF_RGBA8, &convertHalfToWord<PF_RGBA8> },
+		{ PF_RGBA16F, PF_BGRA8, &convertHalfToWord<PF_BGRA8> },
+		{ PF_RGBA16F, PF_RGB8, &convertHalfToWord<PF_RGB8> },
+		{ PF_RGBA16F, PF_BGR8, &convertHalfToWord<PF_BGR8> },
+
+		{ PF_RGBA16F, PF_RGBA32F, &convertHalfToFloat },
+		{ PF_RGBA32F, PF_RGBA16F, &convertFloatToHalf },
+	};
+
+	/** Returns a converter specialized for the provided pair of formats, or null if one doesn't exist. */
+	static PixelRowConverter findPixelConverter(PixelFormat src, PixelFormat dst)
+	{
+		for (auto& entry : PIXEL_CONVERTERS)
+		{
+			if (entry.src == src && entry.dst == dst)
+				return entry.convert;
+		}
+
+		return nullptr;
+	}
+
 	void PixelUtil::bulkPixelConversion(const PixelData &src, PixelData &dst)
 	{
 		assert(src.getWidth() == dst.getWidth() &&
@@ -1961,41 +2363,37 @@ namespace bs
 			return;
 		}
 
-		UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
-		UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
-		UINT8 *srcptr = static_cast<UINT8*>(src.getData())
-			+ (src.getLeft() + src.getTop() * src.getRowPitch() + src.getFront() * src.getSlicePitch()) * srcPixelSize;
-		UINT8 *dstptr = static_cast<UINT8*>(dst.getData())
-			+ (dst.getLeft() + dst.getTop() * dst.getRowPitch() + dst.getFront() * dst.getSlicePitch()) * dstPixelSize;
+		const UINT32 width = src.getWidth();
+
+		const PixelRowConverter converter = findPixelConverter(src.getFormat(), dst.getFormat());
+		if (converter != nullptr)
+		{
+			forEachPixelRow(src, dst, [converter, width](const UINT8* srcRow, UINT8* dstRow)
+			{
+				converter(srcRow, dstRow, width);
+			});
 
-		// Calculate pitches+skips in bytes
-		UINT32 srcRowSkipBytes = src.getRowSkip()*srcPixelSize;
-		UINT32 srcSliceSkipBytes = src.getSliceSkip()*srcPixelSize;
-		UINT32 dstRowSkipBytes = dst.getRowSkip()*dstPixelSize;
-		UINT32 dstSliceSkipBytes = dst.getSliceSkip()*dstPixelSize;
+			return;
+		}
 
 		// The brute force fallback
-		float r, g, b, a;
-		for (UINT32 z = src.getFront(); z < src.getBack(); z++)
+		const PixelFormat srcFormat = src.getFormat();
+		const PixelFormat dstFormat = dst.getFormat();
+		const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(srcFormat);
+		const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dstFormat);
+
+		forEachPixelRow(src, dst, [=](const UINT8* srcRow, UINT8* dstRow)
 		{
-			for (UINT32 y = src.getTop(); y < src.getBottom(); y++)
+			float r, g, b, a;
+			for (UINT32 x = 0; x < width; x++)
 			{
-				for (UINT32 x = src.getLeft(); x < src.getRight(); x++)
-				{
-					unpackColor(&r, &g, &b, &a, src.getFormat(), srcptr);
-					packColor(r, g, b, a, dst.getFormat(), dstptr);
+				unpackColor(&r, &g, &b, &a, srcFormat, srcRow);
+				packColor(r, g, b, a, dstFormat, dstRow);
 
-					srcptr += srcPixelSize;
-					dstptr += dstPixelSize;
-				}
-
-				srcptr += srcRowSkipBytes;
-				dstptr += dstRowSkipBytes;
+				srcRow += srcPixelSize;
+				dstRow += dstPixelSize;
 			}
-
-			srcptr += srcSliceSkipBytes;
-			dstptr += dstSliceSkipBytes;
-		}
+		});
 	}
 
 	void PixelUtil::flipComponentOrder(PixelData& data)
@@ -2393,68 +2791,82 @@ namespace bs
 				color.a);
 	}
 
-	void PixelUtil::linearToSRGB(PixelData& pixelData)
+	/** 
+	 * Applies @p func to the red, green and blue channels of every pixel, leaving alpha unchanged. Formats with 8-bit
+	 * normalized channels are converted using a lookup table, instead of evaluating the function for every pixel.
+	 */
+	static void applyToColorChannels(PixelData& pixelData, float(*func)(float))
 	{
-		UINT32 depth = pixelData.getDepth();
-		UINT32 height = pixelData.getHeight();
-		UINT32 width = pixelData.getWidth();
+		const PixelFormat format = pixelData.getFormat();
+		const PixelFormatDescription& desc = getDescriptionFor(format);
+		const UINT32 width = pixelData.getWidth();
 
-		UINT32 pixelSize = PixelUtil::getNumElemBytes(pixelData.getFormat());
-		UINT8* data = pixelData.getData();
+		const UINT32 byteFormatFlags = PFF_INTEGER | PFF_NORMALIZED;
+		const bool isByteFormat = (desc.flags & (byteFormatFlags | PFF_SIGNED)) == byteFormatFlags &&
+			desc.componentType == PCT_BYTE && desc.elemBytes <= 4;
 
-		for (UINT32 z = 0; z < depth; z++)
+		if (isByteFormat)
 		{
-			UINT32 zDataIdx = z * pixelData.getSlicePitch() * pixelSize;
+			UINT8 table[256];
+			for (UINT32 i = 0; i < 256; i++)
+				table[i] = (UINT8)Bitwise::unormToUint<8>(func(Bitwise::uintToUnorm<8>(i)));
 
-			for (UINT32 y = 0; y < height; y++)
-			{
-				UINT32 yDataIdx = y * pixelData.getRowPitch() * pixelSize;
+			// Color channels are converted, alpha is kept and unused bytes are cleared, same as packColor() does
+			enum class ByteType { Unused, Color, Alpha };
+			ByteType byteTypes[4] = { ByteType::Unused, ByteType::Unused, ByteType::Unused, ByteType::Unused };
 
-				for (UINT32 x = 0; x < width; x++)
-				{
-					UINT32 dataIdx = x * pixelSize + yDataIdx + zDataIdx;
-					UINT8* dest = data + dataIdx;
+			const UINT8 shifts[] = { desc.rshift, desc.gshift, desc.bshift };
+			for (UINT32 i = 0; i < std::min((UINT32)desc.componentCount, 3U); i++)
+				byteTypes[shifts[i] / 8] = ByteType::Color;
 
-					Color color;
+			if (desc.flags & PFF_HASALPHA)
+				byteTypes[desc.ashift / 8] = ByteType::Alpha;
 
-					PixelUtil::unpackColor(&color, pixelData.getFormat(), dest);
-					color = linearToSRGB(color);
-					PixelUtil::packColor(color, pixelData.getFormat(), dest);
+			const UINT32 pixelSize = desc.elemBytes;
+			forEachPixelRow(pixelData, pixelData, [&](const UINT8* srcRow, UINT8* dstRow)
+			{
+				for (UINT32 x = 0; x < width * pixelSize; x += pixelSize)
+				{
+					for (UINT32 i = 0; i < pixelSize; i++)
+					{
+						switch (byteTypes[i])
+						{
+						case ByteType::Color: dstRow[x + i] = table[srcRow[x + i]]; break;
+						case ByteType::Alpha: dstRow[x + i] = srcRow[x + i]; break;
+						default: dstRow[x + i] = 0; break;
+						}
+					}
 				}
-			}
-		}
-	}
-
-	void PixelUtil::SRGBToLinear(PixelData& pixelData)
-	{
-		UINT32 depth = pixelData.getDepth();
-		UINT32 height = pixelData.getHeight();
-		UINT32 width = pixelData.getWidth();
+			});
 
-		UINT32 pixelSize = PixelUtil::getNumElemBytes(pixelData.getFormat());
-		UINT8* data = pixelData.getData();
+			return;
+		}
 
-		for (UINT32 z = 0; z < depth; z++)
+		const UINT32 pixelSize = PixelUtil::getNumElemBytes(format);
+		forEachPixelRow(pixelData, pixelData, [&](const UINT8* srcRow, UINT8* dstRow)
 		{
-			UINT32 zDataIdx = z * pixelData.getSlicePitch() * pixelSize;
-
-			for (UINT32 y = 0; y < height; y++)
+			for (UINT32 x = 0; x < width; x++)
 			{
-				UINT32 yDataIdx = y * pixelData.getRowPitch() * pixelSize;
+				Color color;
+				PixelUtil::unpackColor(&color, format, srcRow + x * pixelSize);
 
-				for (UINT32 x = 0; x < width; x++)
-				{
-					UINT32 dataIdx = x * pixelSize + yDataIdx + zDataIdx;
-					UINT8* dest = data + dataIdx;
+				color.r = func(color.r);
+				color.g = func(color.g);
+				color.b = func(color.b);
 
-					Color color;
-
-					PixelUtil::unpackColor(&color, pixelData.getFormat(), dest);
-					color = SRGBToLinear(color);
-					PixelUtil::packColor(color, pixelData.getFormat(), dest);
-				}
+				PixelUtil::packColor(color, format, dstRow + x * pixelSize);
 			}
-		}
+		});
+	}
+
+	void PixelUtil::linearToSRGB(PixelData& pixelData)
+	{
+		applyToColorChannels(pixelData, &bs::linearToSRGB);
+	}
+
+	void PixelUtil::SRGBToLinear(PixelData& pixelData)
+	{
+		applyToColorChannels(pixelData, &bs::SRGBToLinear);
 	}
 
 	void PixelUtil::compress(const PixelData& src, PixelData& dst, const CompressionOptions& options)
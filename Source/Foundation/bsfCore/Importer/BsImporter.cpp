@@ -13,9 +13,54 @@
 #include "Resources/BsResources.h"
 #include "Threading/BsThreadPool.h"
 #include "Threading/BsTaskScheduler.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsBinarySerializer.h"
+#include "Utility/BsUtility.h"
 
 namespace bs
 {
+	/** Identifies a valid import cache entry. */
+	static constexpr UINT32 IMPORT_CACHE_MAGIC = 0x43495342; // "BSIC"
+
+	/** Extension of import cache entry files. */
+	static const char* IMPORT_CACHE_EXTENSION = u8".asset";
+
+	/** 
+	 * Returns a hash of the contents of a file an import depends on, or an empty string if the file cannot be read. The
+	 * modification time is intentionally not part of the hash, so touching or re-saving a file without changes keeps the
+	 * cached result valid.
+	 */
+	static String getDependencyHash(const Path& path)
+	{
+		SPtr<DataStream> fileStream = FileSystem::openFile(path);
+		if(fileStream == nullptr)
+			return StringUtil::BLANK;
+
+		const String contentHash = md5(*fileStream);
+		fileStream->close();
+
+		return contentHash;
+	}
+
+	/** Reads a string written by writeCacheString(). Returns false if the stream doesn't contain a valid string. */
+	static bool readCacheString(DataStream& stream, String& output)
+	{
+		UINT32 size = 0;
+		if(stream.read(&size, sizeof(size)) != sizeof(size) || size > stream.size() - stream.tell())
+			return false;
+
+		output.resize(size);
+		return size == 0 || stream.read(&output[0], size) == size;
+	}
+
+	/** Writes a string to an import cache entry. */
+	static void writeCacheString(DataStream& stream, const String& value)
+	{
+		const UINT32 size = (UINT32)value.size();
+		stream.write(&size, sizeof(size));
+		stream.write(value.data(), size);
+	}
+
 	Importer::Importer()
 	{
 		mAsyncOpSyncData = bs_shared_ptr_new<AsyncOpSyncData>();
@@ -117,6 +162,12 @@ namespace bs
 		if(importer == nullptr)
 			return nullptr;
 
+		const String cacheKey = getCacheKey(importer, inputFilePath, importOptions, false);
+
+		Vector<SubResourceRaw> cachedOutput;
+		if(readFromCache(cacheKey, cachedOutput))
+			return cachedOutput[0].value;
+
 		const UINT64 taskId = waitForAsync(importer);
 		SPtr<Resource> output = importer->import(inputFilePath, importOptions);
 		
@@ -133,6 +184,9 @@ namespace bs
 			}
 		}
 
+		if(output != nullptr)
+			writeToCache(cacheKey, importer, inputFilePath, { { u8"primary", output } });
+
 		return output;
 	}
 
@@ -142,8 +196,14 @@ namespace bs
 		if(!importer)
 			return Vector<SubResourceRaw>();
 
+		const String cacheKey = getCacheKey(importer, inputFilePath, importOptions, true);
+
+		Vector<SubResourceRaw> output;
+		if(readFromCache(cacheKey, output))
+			return output;
+
 		const UINT64 taskId = waitForAsync(importer);
-		Vector<SubResourceRaw> output = importer->importAll(inputFilePath, importOptions);
+		output = importer->importAll(inputFilePath, importOptions);
 
 		if(importer->getAsyncMode() == ImporterAsyncMode::Single)
 		{
@@ -157,6 +217,8 @@ namespace bs
 				mTaskCompleted.notify_one();
 			}
 		}
+
+		writeToCache(cacheKey, importer, inputFilePath, output);
 		return output;
 	}
 
@@ -238,10 +300,17 @@ namespace bs
 		[this, taskId, queuedOp] 
 		{ 
 			AsyncOp op = queuedOp.op;
+			const String cacheKey = getCacheKey(queuedOp.importer, queuedOp.filePath, queuedOp.importOptions, 
+				queuedOp.importAll);
+
 			if (queuedOp.importAll)
 			{
-				Vector<SubResourceRaw> rawSubresources = queuedOp.importer->importAll(queuedOp.filePath,
-					queuedOp.importOptions);
+				Vector<SubResourceRaw> rawSubresources;
+				if(!readFromCache(cacheKey, rawSubresources))
+				{
+					rawSubresources = queuedOp.importer->importAll(queuedOp.filePath, queuedOp.importOptions);
+					writeToCache(cacheKey, queuedOp.importer, queuedOp.filePath, rawSubresources);
+				}
 
 				if(queuedOp.handle)
 				{
@@ -259,7 +328,20 @@ namespace bs
 			}
 			else
 			{
-				SPtr<Resource> resourcePtr = queuedOp.importer->import(queuedOp.filePath, queuedOp.importOptions);
+				SPtr<Resource> resourcePtr;
+
+				Vector<SubResourceRaw> cachedOutput;
+				if(readFromCache(cacheKey, cachedOutput))
+					resourcePtr = cachedOutput[0].value;
+				else
+				{
+					resourcePtr = queuedOp.importer->import(queuedOp.filePath, queuedOp.importOptions);
+					if(resourcePtr != nullptr)
+					{
+						writeToCache(cacheKey, queuedOp.importer, queuedOp.filePath, 
+							{ { u8"primary", resourcePtr } });
+					}
+				}
 
 				if(queuedOp.handle)
 				{
@@ -298,6 +380,199 @@ namespace bs
 		TaskScheduler::instance().addTask(task);
 	}
 
+	void Importer::setCacheDirectory(const Path& path)
+	{
+		Lock lock(mCacheMutex);
+		mCacheDirectory = path;
+	}
+
+	Path Importer::getCacheDirectory() const
+	{
+		Lock lock(mCacheMutex);
+		return mCacheDirectory;
+	}
+
+	String Importer::getCacheKey(SpecificImporter* importer, const Path& filePath, 
+		const SPtr<const ImportOptions>& importOptions, bool importAll) const
+	{
+		if(getCacheDirectory().isEmpty())
+			return StringUtil::BLANK;
+
+		SPtr<DataStream> fileStream = FileSystem::openFile(filePath);
+		if(fileStream == nullptr)
+			return StringUtil::BLANK;
+
+		const String contentHash = md5(*fileStream);
+		fileStream->close();
+
+		MemorySerializer ms;
+		UINT32 numOptionBytes = 0;
+		UINT8* optionBytes = ms.encode(const_cast<ImportOptions*>(importOptions.get()), numOptionBytes);
+		const String optionsHash = md5(String((const char*)optionBytes, numOptionBytes));
+		bs_free(optionBytes);
+
+		// Importers have no unique identifier, so the file extension and the type of import options stand in for one
+		StringStream key;
+		key << contentHash << optionsHash << filePath.getExtension() << importOptions->getTypeId() 
+			<< importer->getVersion() << importAll;
+
+		return md5(key.str());
+	}
+
+	bool Importer::readFromCache(const String& key, Vector<SubResourceRaw>& output) const
+	{
+		if(key.empty())
+			return false;
+
+		Path entryPath = getCacheDirectory();
+		entryPath.append(key + IMPORT_CACHE_EXTENSION);
+
+		if(!FileSystem::isFile(entryPath))
+			return false;
+
+		SPtr<DataStream> fileStream = FileSystem::openFile(entryPath);
+		if(fileStream == nullptr)
+			return false;
+
+		// Read the entire entry up front so the data blocks of the decoded resources can reference it directly
+		SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(fileStream);
+		fileStream->close();
+
+		UINT32 magic = 0;
+		UINT32 numDependencies = 0;
+		if(stream->read(&magic, sizeof(magic)) != sizeof(magic) || magic != IMPORT_CACHE_MAGIC || 
+			stream->read(&numDependencies, sizeof(numDependencies)) != sizeof(numDependencies))
+		{
+			LOGWRN("Ignoring an invalid import cache entry: " + entryPath.toString());
+			return false;
+		}
+
+		// Entries whose dependencies changed are out of date, and get overwritten once the file is imported again
+		for(UINT32 i = 0; i < numDependencies; i++)
+		{
+			String dependencyPath;
+			String dependencyHash;
+			if(!readCacheString(*stream, dependencyPath) || !readCacheString(*stream, dependencyHash))
+			{
+				LOGWRN("Ignoring an invalid import cache entry: " + entryPath.toString());
+				return false;
+			}
+
+			if(getDependencyHash(dependencyPath) != dependencyHash)
+				return false;
+		}
+
+		UINT32 numEntries = 0;
+		if(stream->read(&numEntries, sizeof(numEntries)) != sizeof(numEntries))
+		{
+			LOGWRN("Ignoring an invalid import cache entry: " + entryPath.toString());
+			return false;
+		}
+
+		CoreSerializationContext serzContext;
+		serzContext.flags = SF_KeepResourceSourceData;
+
+		Vector<SubResourceRaw> entries;
+		for(UINT32 i = 0; i < numEntries; i++)
+		{
+			SubResourceRaw entry;
+
+			if(!readCacheString(*stream, entry.name))
+				break;
+
+			UINT32 objectSize = 0;
+			if(stream->read(&objectSize, sizeof(objectSize)) != sizeof(objectSize) || 
+				objectSize > stream->size() - stream->tell())
+				break;
+
+			BinarySerializer bs;
+			SPtr<IReflectable> object = bs.decode(stream, objectSize, &serzContext);
+			if(object == nullptr || !object->isDerivedFrom(Resource::getRTTIStatic()))
+				break;
+
+			entry.value = std::static_pointer_cast<Resource>(object);
+			entries.push_back(entry);
+		}
+
+		if(entries.empty() || entries.size() != numEntries)
+		{
+			LOGWRN("Ignoring an invalid import cache entry: " + entryPath.toString());
+			return false;
+		}
+
+		output = std::move(entries);
+		return true;
+	}
+
+	void Importer::writeToCache(const String& key, SpecificImporter* importer, const Path& filePath, 
+		const Vector<SubResourceRaw>& resources) const
+	{
+		if(key.empty() || resources.empty())
+			return;
+
+		Vector<Path> dependencies;
+		if(!importer->getDependencies(filePath, resources, dependencies))
+			return;
+
+		Vector<String> dependencyHashes;
+		for(auto& entry : dependencies)
+		{
+			dependencyHashes.push_back(getDependencyHash(entry));
+			if(dependencyHashes.back().empty())
+				return;
+		}
+
+		const Path cacheDirectory = getCacheDirectory();
+		if(!FileSystem::exists(cacheDirectory))
+			FileSystem::createDir(cacheDirectory);
+
+		Path entryPath = cacheDirectory;
+		entryPath.append(key + IMPORT_CACHE_EXTENSION);
+
+		// Write to a unique temporary file and move it in place once done, so that readers never see a partially written
+		// entry, even if the same file is imported by multiple threads or processes at once
+		Path tempPath = cacheDirectory;
+		tempPath.append(key + "." + UUIDGenerator::generateRandom().toString() + ".tmp");
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+		if(stream == nullptr)
+		{
+			LOGWRN("Unable to create an import cache entry: " + tempPath.toString());
+			return;
+		}
+
+		const UINT32 magic = IMPORT_CACHE_MAGIC;
+		const UINT32 numDependencies = (UINT32)dependencies.size();
+		stream->write(&magic, sizeof(magic));
+		stream->write(&numDependencies, sizeof(numDependencies));
+
+		for(UINT32 i = 0; i < numDependencies; i++)
+		{
+			writeCacheString(*stream, dependencies[i].toString());
+			writeCacheString(*stream, dependencyHashes[i]);
+		}
+
+		const UINT32 numEntries = (UINT32)resources.size();
+		stream->write(&numEntries, sizeof(numEntries));
+
+		for(auto& entry : resources)
+		{
+			writeCacheString(*stream, entry.name);
+
+			MemorySerializer ms;
+			UINT32 numBytes = 0;
+			UINT8* bytes = ms.encode(entry.value.get(), numBytes);
+
+			stream->write(&numBytes, sizeof(numBytes));
+			stream->write(bytes, numBytes);
+
+			bs_free(bytes);
+		}
+
+		stream->close();
+		FileSystem::move(tempPath, entryPath);
+	}
+
 	SPtr<ImportOptions> Importer::createImportOptions(const Path& inputFilePath)
 	{
 		if(!FileSystem::isFile(inputFilePath))
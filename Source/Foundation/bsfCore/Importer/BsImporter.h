@@ -126,6 +126,21 @@ namespace bs
 		 */
 		bool supportsFileType(const UINT8* magicNumber, UINT32 magicNumSize) const;
 
+		/**
+		 * Sets a directory in which the results of import operations are cached. Cache entries are keyed by the contents of
+		 * the source file, the import options and the importer version, so importing an unchanged file with the same
+		 * options deserializes the previously imported resources instead of running the importer again. Entries also
+		 * record the contents and modification times of any other files the import depended on (see 
+		 * SpecificImporter::getDependencies), and are ignored if those changed. Provide an empty path to disable caching
+		 * (default).
+		 *
+		 * @note	Thread safe.
+		 */
+		void setCacheDirectory(const Path& path);
+
+		/** Returns the directory in which the results of import operations are cached. Empty if caching is disabled. */
+		Path getCacheDirectory() const;
+
 		/** @name Internal
 		 *  @{
 		 */
@@ -200,6 +215,27 @@ namespace bs
 		 */
 		UINT64 waitForAsync(SpecificImporter* importer);
 
+		/**
+		 * Returns a key uniquely identifying the result of importing the provided file using the provided importer and
+		 * options. Returns an empty string if caching is disabled.
+		 */
+		String getCacheKey(SpecificImporter* importer, const Path& filePath, const SPtr<const ImportOptions>& importOptions,
+			bool importAll) const;
+
+		/** 
+		 * Loads the resources stored in the import cache under the provided key. Returns false if the cache has no valid
+		 * entry for the key, or if any of the files the entry depends on changed since it was written.
+		 */
+		bool readFromCache(const String& key, Vector<SubResourceRaw>& output) const;
+
+		/** 
+		 * Stores the provided resources in the import cache under the provided key, along with the dependencies reported
+		 * by the importer that imported them from @p filePath. Does nothing if the key is empty, there are no resources
+		 * or the dependencies cannot be determined.
+		 */
+		void writeToCache(const String& key, SpecificImporter* importer, const Path& filePath, 
+			const Vector<SubResourceRaw>& resources) const;
+
 		Vector<SpecificImporter*> mAssetImporters;
 
 		SPtr<AsyncOpSyncData> mAsyncOpSyncData;
@@ -208,6 +244,9 @@ namespace bs
 		mutable Mutex mImportMutex;
 		mutable UINT64 mTaskId = 0;
 
+		Path mCacheDirectory;
+		mutable Mutex mCacheMutex;
+
 		/** Information about a task queued for a specific import operation. */
 		struct QueuedTask
 		{
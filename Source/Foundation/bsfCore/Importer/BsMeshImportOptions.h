@@ -139,7 +139,8 @@ namespace bs
 
 		/**	
 		 * Enables or disables keyframe reduction. Keyframe reduction will reduce the number of key-frames in an animation
-		 * clip by removing identical keyframes, and therefore reducing the size of the clip.
+		 * clip by removing keyframes that can be reconstructed from their neighbors within the error specified by
+		 * setKeyFrameReductionError(), and therefore reducing the size of the clip.
 		 */
 		void setKeyFrameReduction(bool enabled) { mReduceKeyFrames = enabled; }
 
@@ -150,6 +151,34 @@ namespace bs
 		 */
 		bool getKeyFrameReduction() const { return mReduceKeyFrames; }
 
+		/**
+		 * Sets the maximum error keyframe reduction is allowed to introduce, for any component of an animated position,
+		 * rotation (quaternion) or scale. Only relevant if keyframe reduction is enabled.
+		 */
+		void setKeyFrameReductionError(float error) { mKeyFrameReductionError = error; }
+
+		/**
+		 * Returns the maximum error keyframe reduction is allowed to introduce.
+		 *
+		 * @see	setKeyFrameReductionError
+		 */
+		float getKeyFrameReductionError() const { return mKeyFrameReductionError; }
+
+		/**
+		 * Enables or disables animation compression. When enabled the position, rotation and scale curves of imported
+		 * animation clips are quantized, significantly reducing their size at the cost of a small loss of precision.
+		 *
+		 * @see	AnimationClip::compress
+		 */
+		void setAnimationCompression(bool enabled) { mCompressAnimation = enabled; }
+
+		/**
+		 * Checks is animation compression enabled.
+		 *
+		 * @see	setAnimationCompression
+		 */
+		bool getAnimationCompression() const { return mCompressAnimation; }
+
 		/**	
 		 * Enables or disables import of root motion curves. When enabled, any animation curves in imported animations 
 		 * affecting the root bone will be available through a set of separate curves in AnimationClip, and they won't be
@@ -176,6 +205,8 @@ namespace bs
 		bool mImportSkin;
 		bool mImportAnimation;
 		bool mReduceKeyFrames;
+		float mKeyFrameReductionError;
+		bool mCompressAnimation;
 		bool mImportRootMotion;
 		float mImportScale;
 		CollisionMeshType mCollisionMeshType;
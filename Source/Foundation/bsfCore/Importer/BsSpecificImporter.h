@@ -55,6 +55,26 @@ namespace bs
 		/** Returns the level of asynchronous import supported by this importer. */
 		virtual ImporterAsyncMode getAsyncMode() const { return ImporterAsyncMode::Multi; }
 
+		/**
+		 * Returns the version of the importer. Should be incremented whenever a change to the importer changes the
+		 * resources it outputs, so that results of previous imports stored in the import cache are no longer used.
+		 */
+		virtual UINT32 getVersion() const { return 0; }
+
+		/**
+		 * Outputs paths of files other than the imported file whose contents were used for creating the provided import
+		 * results (for example files included by a shader). Used by the import cache for detecting when a cached result
+		 * is out of date.
+		 *
+		 * @param[in]	filePath		Path of the file the resources were imported from.
+		 * @param[in]	resources		Resources output by import() or importAll().
+		 * @param[out]	dependencies	Paths of the files the resources depend on.
+		 * @return						False if the dependencies cannot be determined, in which case the results are not
+		 *								cached.
+		 */
+		virtual bool getDependencies(const Path& filePath, const Vector<SubResourceRaw>& resources, 
+			Vector<Path>& dependencies) const { return true; }
+
 		/**
 		 * Imports the given file. If file contains more than one resource only the primary resource is imported (for 
 		 * example for an FBX a mesh would be imported, but animations ignored).
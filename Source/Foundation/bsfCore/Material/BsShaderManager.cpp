@@ -11,8 +11,18 @@ namespace bs
 		return Importer::instance().import<ShaderInclude>(name);
 	}
 
+	Path DefaultShaderIncludeHandler::findIncludePath(const String& name) const
+	{
+		return name;
+	}
+
 	HShaderInclude ShaderManager::findInclude(const String& name) const
 	{
 		return mIncludeHandler->findInclude(name);
 	}
+
+	Path ShaderManager::findIncludePath(const String& name) const
+	{
+		return mIncludeHandler->findIncludePath(name);
+	}
 }
\ No newline at end of file
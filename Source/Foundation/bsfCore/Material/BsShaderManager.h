@@ -22,6 +22,12 @@ namespace bs
 
 		/** Attempts to find a shader include resource based on its name. */
 		virtual HShaderInclude findInclude(const String& name) const = 0;
+
+		/** 
+		 * Returns the path of the file findInclude() loads the include with the provided name from. Returns an empty path
+		 * if the handler cannot map includes to files.
+		 */
+		virtual Path findIncludePath(const String& name) const { return Path::BLANK; }
 	};
 
 	/**
@@ -33,6 +39,9 @@ namespace bs
 	public:
 		/** @copydoc IShaderIncludeHandler::findInclude */
 		virtual HShaderInclude findInclude(const String& name) const override;
+
+		/** @copydoc IShaderIncludeHandler::findIncludePath */
+		virtual Path findIncludePath(const String& name) const override;
 	};
 
 	/**	A global manager that handles various shader specific operations. */
@@ -50,6 +59,12 @@ namespace bs
 		 */
 		HShaderInclude findInclude(const String& name) const;
 
+		/** 
+		 * Returns the path of the file the include with the provided name is loaded from. Returns an empty path if the
+		 * active handler cannot map includes to files.
+		 */
+		Path findIncludePath(const String& name) const;
+
 		/** Changes the active include handler that determines how is a shader include name mapped to the actual resource. */
 		void setIncludeHandler(const SPtr<IShaderIncludeHandler>& handler) { mIncludeHandler = handler; }
 
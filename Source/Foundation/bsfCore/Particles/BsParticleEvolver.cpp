@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Particles/BsVectorField.h"
 #include "Image/BsSpriteTexture.h"
@@ -40,6 +41,24 @@ namespace bs
 		return tfrm.multiplyDirection(input);
 	}
 
+	/**
+	 * Transforms a 3D vector into the same space as the particle system. @p inWorldSpace parameter controls whether the
+	 * vector is assumed to be in world or local space.
+	 *
+	 * @tparam	dir		If true the vector is assumed to be a direction, otherwise a point.
+	 */
+	template<bool dir = false>
+	Vector3 toSimulationSpace(const Vector3& value, const ParticleSystemState& state, bool inWorldSpace)
+	{
+		if(state.worldSpace == inWorldSpace)
+			return value;
+
+		if(state.worldSpace)
+			return applyTransform<dir>(state.localToWorld, value);
+		else
+			return applyTransform<dir>(state.worldToLocal, value);
+	}
+
 	/**
 	 * Evaluates a 3D vector distribution and transforms the output into the same space as the particle system. 
 	 * @p inWorldSpace parameter controls whether the values in the distribution are assumed to be in world or local space.
@@ -50,15 +69,61 @@ namespace bs
 	Vector3 evaluateTransformed(const Vector3Distribution& distribution, const ParticleSystemState& state, float t, 
 		const Random& factor, bool inWorldSpace)
 	{
-		const Vector3 output = distribution.evaluate(t, factor);
+		return toSimulationSpace<dir>(distribution.evaluate(t, factor), state, inWorldSpace);
+	}
 
-		if(state.worldSpace == inWorldSpace)
-			return output;
+	/** Maximum number of particles processed at once by the vectorized evolver paths. */
+	static constexpr UINT32 PARTICLE_BATCH_SIZE = 256;
 
-		if(state.worldSpace)
-			return applyTransform<dir>(state.localToWorld, output);
-		else
-			return applyTransform<dir>(state.worldToLocal, output);
+	/**
+	 * Splits the particle range [@p startIdx, @p endIdx) into batches of at most PARTICLE_BATCH_SIZE particles, and calls
+	 * @p predicate with the first particle index and size of each batch.
+	 */
+	template<class PR>
+	void forEachBatch(UINT32 startIdx, UINT32 endIdx, PR predicate)
+	{
+		for(UINT32 i = startIdx; i < endIdx; i += PARTICLE_BATCH_SIZE)
+			predicate(i, std::min(PARTICLE_BATCH_SIZE, endIdx - i));
+	}
+
+	/**
+	 * Adds a vector distribution value to each particle in a range of @p values, scaled by @p scale. Handles constant and
+	 * random range distributions using vectorized kernels. Returns false if the distribution is of some other type, in
+	 * which case the caller must evaluate it per-particle.
+	 */
+	bool addVectorizedDistribution(const Vector3Distribution& distribution, const ParticleSystemState& state,
+		bool inWorldSpace, const UINT32* seeds, UINT32 seedOffset, float scale, Vector3* values, UINT32 count)
+	{
+		switch(distribution.getType())
+		{
+		case PDT_Constant:
+		{
+			const Vector3 value = toSimulationSpace<true>(distribution.getMinConstant(), state, inWorldSpace) * scale;
+			ParticleKernels::add(values, value, count);
+
+			return true;
+		}
+		case PDT_RandomRange:
+		{
+			// Note: Transforming the range end-points rather than the evaluated value, which is equivalent since the
+			// transform is linear
+			const Vector3 minValue = toSimulationSpace<true>(distribution.getMinConstant(), state, inWorldSpace);
+			const Vector3 maxValue = toSimulationSpace<true>(distribution.getMaxConstant(), state, inWorldSpace);
+
+			float factors[PARTICLE_BATCH_SIZE];
+			Vector3 batchValues[PARTICLE_BATCH_SIZE];
+			forEachBatch(0, count, [&](UINT32 idx, UINT32 batchSize)
+			{
+				ParticleKernels::randomUNorm(seeds + idx, seedOffset, factors, batchSize);
+				ParticleKernels::lerp(factors, minValue, maxValue, batchValues, batchSize);
+				ParticleKernels::integrate(values + idx, batchValues, scale, batchSize);
+			});
+
+			return true;
+		}
+		default:
+			return false;
+		}
 	}
 
 	ParticleTextureAnimation::ParticleTextureAnimation(const PARTICLE_TEXTURE_ANIMATION_DESC& desc)
@@ -233,6 +298,13 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		// Without spacing all particles share the same time-step, so non-curve velocities can be applied in bulk
+		if(!spacing && addVectorizedDistribution(mDesc.velocity, state, mDesc.worldSpace, particles.seed + startIdx,
+			PARTICLE_LINEAR_VELOCITY, state.timeStep, particles.position + startIdx, count))
+		{
+			return;
+		}
+
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
@@ -284,6 +356,13 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		// Without spacing all particles share the same time-step, so non-curve forces can be applied in bulk
+		if(!spacing && addVectorizedDistribution(mDesc.force, state, mDesc.worldSpace, particles.seed + startIdx,
+			PARTICLE_FORCE, state.timeStep * state.timeStep, particles.velocity + startIdx, count))
+		{
+			return;
+		}
+
 		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
@@ -340,16 +419,18 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+		if(!spacing)
+		{
+			ParticleKernels::add(particles.velocity + startIdx, gravity * state.timeStep, count);
+			return;
+		}
+
+		const float subFrameSpacing = count > 0 ? 1.0f / count : 1.0f;
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
-			float timeStep = state.timeStep;
-			if(spacing)
-			{
-				const UINT32 localIdx = i - startIdx;
-				const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
-				timeStep *= subFrameOffset;
-			}
+			const UINT32 localIdx = i - startIdx;
+			const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
+			const float timeStep = state.timeStep * subFrameOffset;
 
 			particles.velocity[i] += gravity * timeStep;
 		}
@@ -385,6 +466,29 @@ namespace bs
 		const UINT32 endIdx = startIdx + count;
 		ParticleSetData& particles = set.getParticles();
 
+		switch(mDesc.color.getType())
+		{
+		case PDT_Constant:
+			std::fill(particles.color + startIdx, particles.color + endIdx, mDesc.color.getMinGradient().evaluate(0.0f));
+			return;
+		case PDT_RandomRange:
+		{
+			const RGBA minColor = mDesc.color.getMinGradient().evaluate(0.0f);
+			const RGBA maxColor = mDesc.color.getMaxGradient().evaluate(0.0f);
+
+			float factors[PARTICLE_BATCH_SIZE];
+			forEachBatch(startIdx, endIdx, [&](UINT32 idx, UINT32 batchSize)
+			{
+				ParticleKernels::randomUNorm(particles.seed + idx, PARTICLE_COLOR, factors, batchSize);
+				ParticleKernels::lerp(factors, minColor, maxColor, particles.color + idx, batchSize);
+			});
+
+			return;
+		}
+		default:
+			break;
+		}
+
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
 			const UINT32 colorSeed = particles.seed[i] + PARTICLE_COLOR;
@@ -426,23 +530,62 @@ namespace bs
 
 		if(!mDesc.use3DSize)
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			const PropertyDistributionType type = mDesc.size.getType();
+			if(type == PDT_Constant)
 			{
-				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+				const float size = mDesc.size.getMinConstant();
+				std::fill(particles.size + startIdx, particles.size + endIdx, Vector3(size, size, size));
+			}
+			else if(type == PDT_RandomRange)
+			{
+				float sizes[PARTICLE_BATCH_SIZE];
+				forEachBatch(startIdx, endIdx, [&](UINT32 idx, UINT32 batchSize)
+				{
+					ParticleKernels::randomUNorm(particles.seed + idx, PARTICLE_SIZE, sizes, batchSize);
+					ParticleKernels::lerp(sizes, mDesc.size.getMinConstant(), mDesc.size.getMaxConstant(), batchSize);
+
+					for(UINT32 i = 0; i < batchSize; i++)
+						particles.size[idx + i] = Vector3(sizes[i], sizes[i], sizes[i]);
+				});
+			}
+			else
+			{
+				for (UINT32 i = startIdx; i < endIdx; i++)
+				{
+					const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
+					const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / 
+						particles.initialLifetime[i];
 
-				const float size = mDesc.size.evaluate(particleT, Random(sizeSeed));
-				particles.size[i] = Vector3(size, size, size);
+					const float size = mDesc.size.evaluate(particleT, Random(sizeSeed));
+					particles.size[i] = Vector3(size, size, size);
+				}
 			}
 		}
 		else
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			const PropertyDistributionType type = mDesc.size3D.getType();
+			if(type == PDT_Constant)
+				std::fill(particles.size + startIdx, particles.size + endIdx, mDesc.size3D.getMinConstant());
+			else if(type == PDT_RandomRange)
 			{
-				const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+				float factors[PARTICLE_BATCH_SIZE];
+				forEachBatch(startIdx, endIdx, [&](UINT32 idx, UINT32 batchSize)
+				{
+					ParticleKernels::randomUNorm(particles.seed + idx, PARTICLE_SIZE, factors, batchSize);
+					ParticleKernels::lerp(factors, mDesc.size3D.getMinConstant(), mDesc.size3D.getMaxConstant(),
+						particles.size + idx, batchSize);
+				});
+			}
+			else
+			{
+				for (UINT32 i = startIdx; i < endIdx; i++)
+				{
+					const UINT32 sizeSeed = particles.seed[i] + PARTICLE_SIZE;
+					const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / 
+						particles.initialLifetime[i];
 
-				particles.size[i] = mDesc.size3D.evaluate(particleT, Random(sizeSeed));
+					particles.size[i] = mDesc.size3D.evaluate(particleT, Random(sizeSeed));
+				}
 			}
 		}
 	}
@@ -479,23 +622,63 @@ namespace bs
 
 		if(!mDesc.use3DRotation)
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			const PropertyDistributionType type = mDesc.rotation.getType();
+			if(type == PDT_Constant)
+			{
+				const float rotation = mDesc.rotation.getMinConstant();
+				std::fill(particles.rotation + startIdx, particles.rotation + endIdx, Vector3(rotation, 0.0f, 0.0f));
+			}
+			else if(type == PDT_RandomRange)
+			{
+				float rotations[PARTICLE_BATCH_SIZE];
+				forEachBatch(startIdx, endIdx, [&](UINT32 idx, UINT32 batchSize)
+				{
+					ParticleKernels::randomUNorm(particles.seed + idx, PARTICLE_ROTATION, rotations, batchSize);
+					ParticleKernels::lerp(rotations, mDesc.rotation.getMinConstant(), mDesc.rotation.getMaxConstant(),
+						batchSize);
+
+					for(UINT32 i = 0; i < batchSize; i++)
+						particles.rotation[idx + i] = Vector3(rotations[i], 0.0f, 0.0f);
+				});
+			}
+			else
 			{
-				const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+				for (UINT32 i = startIdx; i < endIdx; i++)
+				{
+					const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
+					const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / 
+						particles.initialLifetime[i];
 
-				const float rotation = mDesc.rotation.evaluate(particleT, Random(rotationSeed));
-				particles.rotation[i] = Vector3(rotation, 0.0f, 0.0f);
+					const float rotation = mDesc.rotation.evaluate(particleT, Random(rotationSeed));
+					particles.rotation[i] = Vector3(rotation, 0.0f, 0.0f);
+				}
 			}
 		}
 		else
 		{
-			for (UINT32 i = startIdx; i < endIdx; i++)
+			const PropertyDistributionType type = mDesc.rotation3D.getType();
+			if(type == PDT_Constant)
+				std::fill(particles.rotation + startIdx, particles.rotation + endIdx, mDesc.rotation3D.getMinConstant());
+			else if(type == PDT_RandomRange)
+			{
+				float factors[PARTICLE_BATCH_SIZE];
+				forEachBatch(startIdx, endIdx, [&](UINT32 idx, UINT32 batchSize)
+				{
+					ParticleKernels::randomUNorm(particles.seed + idx, PARTICLE_ROTATION, factors, batchSize);
+					ParticleKernels::lerp(factors, mDesc.rotation3D.getMinConstant(), mDesc.rotation3D.getMaxConstant(),
+						particles.rotation + idx, batchSize);
+				});
+			}
+			else
 			{
-				const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
-				const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / particles.initialLifetime[i];
+				for (UINT32 i = startIdx; i < endIdx; i++)
+				{
+					const UINT32 rotationSeed = particles.seed[i] + PARTICLE_ROTATION;
+					const float particleT = (particles.initialLifetime[i] - particles.lifetime[i]) / 
+						particles.initialLifetime[i];
 
-				particles.rotation[i] = mDesc.rotation3D.evaluate(particleT, Random(rotationSeed));
+					particles.rotation[i] = mDesc.rotation3D.evaluate(particleT, Random(rotationSeed));
+				}
 			}
 		}
 	}
@@ -666,42 +849,62 @@ namespace bs
 
 			numPlanes[1] = (UINT32)mCollisionPlanes.size();
 
-			for(UINT32 i = startIdx; i < endIdx; i++)
+			// Most particles are expected to be away from the planes, so find the ones that are close to any of them up
+			// front, and only resolve collisions for those
+			UINT32 contacts[PARTICLE_BATCH_SIZE / 32];
+			UINT32 objContacts[PARTICLE_BATCH_SIZE / 32];
+			forEachBatch(startIdx, endIdx, [&](UINT32 batchIdx, UINT32 batchSize)
 			{
-				Vector3& position = particles.position[i];
-				Vector3& velocity = particles.velocity[i];
+				ParticleKernels::findPlaneContacts(particles.position + batchIdx, batchSize, planes[0], numPlanes[0],
+					mDesc.radius, objContacts);
+				ParticleKernels::findPlaneContacts(particles.position + batchIdx, batchSize, planes[1], numPlanes[1],
+					mDesc.radius, contacts);
 
-				for(UINT32 j = 0; j < bs_size(planes); j++)
+				const UINT32 numWords = Math::divideAndRoundUp(batchSize, 32U);
+				for(UINT32 word = 0; word < numWords; word++)
 				{
-					for (UINT32 k = 0; k < numPlanes[j]; k++)
+					UINT32 mask = contacts[word] | objContacts[word];
+					while(mask != 0)
 					{
-						const Plane& plane = planes[j][k];
+						const UINT32 i = batchIdx + word * 32 + Bitwise::leastSignificantBit(mask);
+						mask &= mask - 1;
 
-						const float dist = plane.getDistance(position);
-						if (dist > mDesc.radius)
-							continue;
+						Vector3& position = particles.position[i];
+						Vector3& velocity = particles.velocity[i];
 
-						const float distToTravelAlongNormal = plane.normal.dot(velocity);
+						for(UINT32 j = 0; j < bs_size(planes); j++)
+						{
+							for (UINT32 k = 0; k < numPlanes[j]; k++)
+							{
+								const Plane& plane = planes[j][k];
 
-						// Ignore movement parallel to the plane
-						if (Math::approxEquals(distToTravelAlongNormal, 0.0f))
-							continue;
+								const float dist = plane.getDistance(position);
+								if (dist > mDesc.radius)
+									continue;
 
-						const float distFromBoundary = mDesc.radius - dist;
-						const float rayT = distFromBoundary / distToTravelAlongNormal;
+								const float distToTravelAlongNormal = plane.normal.dot(velocity);
 
-						ParticleHitInfo hitInfo;
-						hitInfo.normal = plane.normal;
-						hitInfo.position = position + velocity * rayT;
-						hitInfo.idx = i;
+								// Ignore movement parallel to the plane
+								if (Math::approxEquals(distToTravelAlongNormal, 0.0f))
+									continue;
 
-						calcCollisionResponse(position, velocity, hitInfo, mDesc);
-						particles.lifetime[i] -= mDesc.lifetimeLoss * particles.initialLifetime[i];
+								const float distFromBoundary = mDesc.radius - dist;
+								const float rayT = distFromBoundary / distToTravelAlongNormal;
 
-						break;
+								ParticleHitInfo hitInfo;
+								hitInfo.normal = plane.normal;
+								hitInfo.position = position + velocity * rayT;
+								hitInfo.idx = i;
+
+								calcCollisionResponse(position, velocity, hitInfo, mDesc);
+								particles.lifetime[i] -= mDesc.lifetimeLoss * particles.initialLifetime[i];
+
+								break;
+							}
+						}
 					}
 				}
-			}
+			});
 
 			if(objPlanes)
 				bs_stack_free(objPlanes);
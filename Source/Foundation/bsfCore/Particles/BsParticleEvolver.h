@@ -52,6 +52,9 @@ namespace bs
 		/** 
 		 * Updates properties of particles in the provided range according to the ruleset of the evolver. 
 		 * 
+		 * Systems with many particles split them into multiple ranges that are evolved in parallel, each with its own
+		 * copy of @p random. Implementations must therefore only modify particles within the provided range.
+		 *
 		 * @param[in]	random			Utility class for generating random numbers.
 		 * @param[in]	state			Particle system state for this frame.
 		 * @param[in]	set				Set containing the particles to update.
@@ -8,9 +8,24 @@
 #include "Private/Particles/BsParticleSet.h"
 #include "Animation/BsAnimationManager.h"
 #include "Image/BsPixelUtil.h"
+#include "Scene/BsSceneManager.h"
+#include "Renderer/BsCamera.h"
 
 namespace bs
 {
+	/** 
+	 * Time in seconds after which the bounds used for culling systems with automatic bounds are recalculated from their
+	 * particles. In-between the bounds are only grown conservatively.
+	 */
+	static constexpr float CULL_BOUNDS_REFRESH_INTERVAL = 0.5f;
+
+	/** Returns the provided bounds grown by @p distance in every direction. */
+	static AABox expandBounds(const AABox& bounds, float distance)
+	{
+		const Vector3 offset(distance, distance, distance);
+		return AABox(bounds.getMin() - offset, bounds.getMax() + offset);
+	}
+
 	/** Helper method used for writing particle data into the @p pixels buffer. */
 	template<class T, class PR>
 	void iterateOverPixels(PixelData& pixels, UINT32 count, UINT32 stride, PR predicate)
@@ -352,9 +367,6 @@ namespace bs
 
 	ParticlePerFrameData* ParticleManager::update(const EvaluatedAnimationData& animData)
 	{
-		// Note: Allow the worker threads to work alongside the main thread? Would require extra synchronization but
-		// potentially no benefit?
-
 		// Advance the buffers (last write buffer becomes read buffer)
 		if (mSwapBuffers)
 		{
@@ -367,105 +379,180 @@ namespace bs
 		if(mPaused)
 			return &mSimulationData[mReadBufferIdx];
 
-		// TODO - Perform culling (but only on deterministic particle systems). In which case cache the bounds so we don't
-		// need to recalculate them below
+		// Build frustums for culling
+		mCullFrustums.clear();
+
+		auto& allCameras = gSceneManager().getAllCameras();
+		for(auto& entry : allCameras)
+		{
+			bool isOverlayCamera = entry.second->getRenderSettings()->overlayOnly;
+			if (isOverlayCamera)
+				continue;
+
+			mCullFrustums.push_back({ entry.second->getWorldFrustum(), entry.second->getLayers() });
+		}
 
 		// Prepare the write buffer
 		ParticlePerFrameData& simulationData = mSimulationData[mWriteBufferIdx];
 		simulationData.cpuData.clear();
 		simulationData.gpuData.clear();
 
-		// Queue evaluation tasks
-		{
-			Lock lock(mMutex);
-			mNumActiveWorkers = (UINT32)mSystems.size();
-		}
-
 		float timeDelta = gTime().getFrameDelta();
 
 		ParticleSimulationDataPool& simDataPool = m->simDataPool[mWriteBufferIdx];
 		simDataPool.clear();
 
-		for (auto& system : mSystems)
+		mSystemsToUpdate.assign(mSystems.begin(), mSystems.end());
+
+		const auto evaluateWorker = [this, timeDelta, &animData, &simDataPool, &simulationData](UINT32 idx)
 		{
-			const auto evaluateWorker = [this, timeDelta, system, &animData, &simDataPool, &simulationData]()
+			ParticleSystem* system = mSystemsToUpdate[idx];
+			const ParticleSystemSettings& settings = system->getSettings();
+
+			// Systems with automatic bounds are culled using the bounds of their particles the last time the bounds were
+			// refreshed, grown by the area new particles can spawn in, and by how far any particle can travel during its
+			// lifetime. This holds no matter how long the system remains culled. Systems whose particles can't be bounded
+			// this way are never culled.
+			AABox spawnBounds;
+			float travelDistance = 0.0f;
+			const bool hasCullBounds = settings.useAutomaticBounds && 
+				system->_calculateMaxExtents(spawnBounds, travelDistance);
+
+			if(hasCullBounds)
+			{
+				if(!system->mCullBoundsValid)
+				{
+					system->mCullBounds = calculateCullBounds(*system, spawnBounds);
+					system->mCullBoundsAge = 0.0f;
+					system->mCullBoundsValid = true;
+				}
+				else // World space systems spawn particles along the path they moved on
+					system->mCullBounds.merge(spawnBounds);
+			}
+			else
+				system->mCullBoundsValid = false;
+
+			// Advance the simulation. Deterministic systems that aren't visible keep their current particles and only
+			// keep track of the skipped time, which is caught up with once they become visible again.
+			bool visible = true;
+			if(system->isDeterministic())
+			{
+				if(!settings.useAutomaticBounds)
+					visible = isVisible(*system, settings.customBounds);
+				else if(hasCullBounds)
+					visible = isVisible(*system, expandBounds(system->mCullBounds, travelDistance));
+			}
+
+			if(visible)
+			{
+				if(system->mCulledTime > 0.0f)
+				{
+					system->fastForward(system->mCulledTime + timeDelta, &animData);
+					system->mCulledTime = 0.0f;
+				}
+				else
+					system->_simulate(timeDelta, &animData);
+			}
+			else if(system->mState == ParticleSystem::State::Playing)
+				system->mCulledTime += timeDelta;
+
+			if(hasCullBounds && visible)
 			{
-				// Advance the simulation
-				system->_simulate(timeDelta, &animData);
+				system->mCullBoundsAge += timeDelta;
+				if(system->mCullBoundsAge >= CULL_BOUNDS_REFRESH_INTERVAL)
+				{
+					system->mCullBounds = calculateCullBounds(*system, spawnBounds);
+					system->mCullBoundsAge = 0.0f;
+				}
+			}
 
-				ParticleRenderData* simulationDataCPU = nullptr;
-				ParticleGPUSimulationData* simulationDataGPU = nullptr;
-				if(system->mParticleSet)
+			ParticleRenderData* simulationDataCPU = nullptr;
+			ParticleGPUSimulationData* simulationDataGPU = nullptr;
+			if(system->mParticleSet)
+			{
+				// Generate simulation data to transfer to the core thread
+				const UINT32 numParticles = system->mParticleSet->getParticleCount();
+
+				if(settings.gpuSimulation)
+					simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+				else
 				{
-					// Generate simulation data to transfer to the core thread
-					const UINT32 numParticles = system->mParticleSet->getParticleCount();
-					const ParticleSystemSettings& settings = system->getSettings();
+					if(settings.renderMode == ParticleRenderMode::Billboard)
+						simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
+					else
+						simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
 
-					if(settings.gpuSimulation)
-						simulationDataGPU = simDataPool.allocGPU(*system->mParticleSet);
+					simulationDataCPU->numParticles = numParticles;
+
+					if(hasCullBounds)
+						simulationDataCPU->bounds = expandBounds(system->mCullBounds, travelDistance);
+					else if(settings.useAutomaticBounds)
+						simulationDataCPU->bounds = system->_calculateBounds();
 					else
+						simulationDataCPU->bounds = settings.customBounds;
+
+					// If using a camera-independant sorting mode, sort the particles right away
+					switch (settings.sortMode)
 					{
-						if(settings.renderMode == ParticleRenderMode::Billboard)
-							simulationDataCPU = simDataPool.allocCPUBillboard(*system->mParticleSet);
-						else
-							simulationDataCPU = simDataPool.allocCPUMesh(*system->mParticleSet);
-
-						simulationDataCPU->numParticles = numParticles;
-
-						if(settings.useAutomaticBounds)
-							simulationDataCPU->bounds = system->_calculateBounds();
-						else
-							simulationDataCPU->bounds = settings.customBounds;
-
-						// If using a camera-independant sorting mode, sort the particles right away
-						switch (settings.sortMode)
-						{
-						default:
-						case ParticleSortMode::None: // No sort, just point the indices back to themselves
-							for (UINT32 i = 0; i < numParticles; i++)
-								simulationDataCPU->indices[i] = i;
-							break;
-						case ParticleSortMode::OldToYoung:
-						case ParticleSortMode::YoungToOld:
-							sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
-							break;
-						case ParticleSortMode::Distance: break;
-						}
+					default:
+					case ParticleSortMode::None: // No sort, just point the indices back to themselves
+						for (UINT32 i = 0; i < numParticles; i++)
+							simulationDataCPU->indices[i] = i;
+						break;
+					case ParticleSortMode::OldToYoung:
+					case ParticleSortMode::YoungToOld:
+						sortParticles(*system->mParticleSet, settings.sortMode, Vector3::ZERO, simulationDataCPU->indices.data());
+						break;
+					case ParticleSortMode::Distance: break;
 					}
 				}
+			}
 
-				{
-					Lock lock(mMutex);
+			{
+				Lock lock(mMutex);
+
+				if(simulationDataCPU)
+					simulationData.cpuData[system->mId] = simulationDataCPU;
+				else if(simulationDataGPU)
+					simulationData.gpuData[system->mId] = simulationDataGPU;
+			}
+		};
 
-					assert(mNumActiveWorkers > 0);
-					mNumActiveWorkers--;
+		// Evaluate systems in parallel. The current thread evaluates systems as well while it waits.
+		SPtr<TaskGroup> taskGroup = TaskGroup::create("ParticleWorker", evaluateWorker, (UINT32)mSystemsToUpdate.size());
+		TaskScheduler::instance().addTaskGroup(taskGroup);
+		taskGroup->wait();
 
-					if(simulationDataCPU)
-						simulationData.cpuData[system->mId] = simulationDataCPU;
-					else if(simulationDataGPU)
-						simulationData.gpuData[system->mId] = simulationDataGPU;
-				}
+		mSwapBuffers = true;
 
-				mWorkerDoneSignal.notify_one();
-			};
+		return &mSimulationData[mWriteBufferIdx];
+	}
 
-			SPtr<Task> task = Task::create("ParticleWorker", evaluateWorker);
-			TaskScheduler::instance().addTask(task);
-		}
+	bool ParticleManager::isVisible(const ParticleSystem& system, const AABox& bounds) const
+	{
+		AABox worldBounds = bounds;
+		if(system.getSettings().simulationSpace == ParticleSimulationSpace::Local)
+			worldBounds.transformAffine(system.getTransform().getMatrix());
 
-		// Wait for tasks to complete
-		TaskScheduler::instance().addWorker(); // Make the current core available for work (since this thread waits)
+		for(auto& entry : mCullFrustums)
 		{
-			Lock lock(mMutex);
+			if((entry.layers & system.getLayer()) == 0)
+				continue;
 
-			while (mNumActiveWorkers > 0)
-				mWorkerDoneSignal.wait(lock);
+			if(entry.frustum.intersects(worldBounds))
+				return true;
 		}
-		TaskScheduler::instance().removeWorker();
 
-		mSwapBuffers = true;
+		return false;
+	}
 
-		return &mSimulationData[mWriteBufferIdx];
+	AABox ParticleManager::calculateCullBounds(const ParticleSystem& system, const AABox& spawnBounds)
+	{
+		AABox bounds = spawnBounds;
+		if(system.mParticleSet && system.mParticleSet->getParticleCount() > 0)
+			bounds.merge(system._calculateBounds());
+
+		return bounds;
 	}
 
 	void ParticleManager::sortParticles(const ParticleSet& set, ParticleSortMode sortMode, const Vector3& viewPoint, 
@@ -6,6 +6,7 @@
 #include "Image/BsPixelData.h"
 #include "Utility/BsModule.h"
 #include "Math/BsAABox.h"
+#include "Math/BsConvexVolume.h"
 #include "CoreThread/BsCoreThread.h"
 #include "BsParticleSystem.h"
 
@@ -148,10 +149,31 @@ namespace bs
 		 */
 		void sortParticles(const ParticleSet& set, ParticleSortMode sortMode, const Vector3& viewPoint, UINT32* indices);
 
+		/** 
+		 * Checks if the provided bounds of a particle system, in its simulation space, are visible by at least one of the
+		 * cull frustums whose camera renders the system's layer.
+		 */
+		bool isVisible(const ParticleSystem& system, const AABox& bounds) const;
+
+		/** 
+		 * Calculates the bounds used for culling a system with automatic bounds, from its current particles and the
+		 * area it spawns particles in. Does not include the distance particles can travel from there.
+		 */
+		static AABox calculateCullBounds(const ParticleSystem& system, const AABox& spawnBounds);
+
+		/** Frustum of a camera particle systems are culled against. */
+		struct CullFrustum
+		{
+			ConvexVolume frustum;
+			UINT64 layers;
+		};
+
 		Members* m;
 
 		UINT32 mNextId = 1;
 		UnorderedSet<ParticleSystem*> mSystems;
+		Vector<ParticleSystem*> mSystemsToUpdate;
+		Vector<CullFrustum> mCullFrustums;
 
 		bool mPaused = false;
 
@@ -161,10 +183,8 @@ namespace bs
 		UINT32 mReadBufferIdx = 1;
 		UINT32 mWriteBufferIdx = 0;
 		
-		Signal mWorkerDoneSignal;
 		Mutex mMutex;
 
-		UINT32 mNumActiveWorkers = 0;
 		bool mSwapBuffers = false;
 	};
 
@@ -5,6 +5,7 @@
 #include "Particles/BsParticleEmitter.h"
 #include "Particles/BsParticleEvolver.h"
 #include "Private/Particles/BsParticleSet.h"
+#include "Private/Particles/BsParticleKernels.h"
 #include "Private/RTTI/BsParticleSystemRTTI.h"
 #include "Allocators/BsPoolAlloc.h"
 #include "Material/BsMaterial.h"
@@ -14,11 +15,24 @@
 #include "Particles/BsVectorField.h"
 #include "Mesh/BsMesh.h"
 #include "CoreThread/BsCoreObjectSync.h"
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs
 {
 	static constexpr UINT32 INITIAL_PARTICLE_CAPACITY = 1000;
 
+	/** Minimum number of particles in a CPU simulated system before its simulation is split between multiple threads. */
+	static constexpr UINT32 PARALLEL_SIMULATION_MIN_PARTICLES = 16384;
+
+	/** Minimum number of particles simulated by a single task, when a system is simulated on multiple threads. */
+	static constexpr UINT32 PARALLEL_SIMULATION_GRAIN_SIZE = 4096;
+
+	/** Preferred length of a single simulation step when fast-forwarding a system that was culled, in seconds. */
+	static constexpr float FAST_FORWARD_STEP = 1.0f / 30.0f;
+
+	/** Maximum number of simulation steps performed when fast-forwarding a system that was culled. */
+	static constexpr UINT32 MAX_FAST_FORWARD_STEPS = 32;
+
 	RTTITypeBase* ParticleSystemSettings::getRTTIStatic()
 	{
 		return ParticleSystemSettingsRTTI::instance();
@@ -220,6 +234,7 @@ namespace bs
 
 		mState = State::Playing;
 		mTime = 0.0f;
+		mCulledTime = 0.0f;
 		mRandom.setSeed(mSeed);
 	}
 
@@ -235,6 +250,7 @@ namespace bs
 			return;
 
 		mState = State::Stopped;
+		mCulledTime = 0.0f;
 		mParticleSet->clear();
 	}
 
@@ -278,9 +294,14 @@ namespace bs
 		{
 			const UINT32 numParticles = mParticleSet->getParticleCount();
 
-			preSimulate(state, 0, numParticles, false, 0.0f);
-			simulate(state, 0, numParticles, false, 0.0f);
-			postSimulate(state, 0, numParticles, false, 0.0f);
+			if(numParticles >= PARALLEL_SIMULATION_MIN_PARTICLES)
+				simulateParallel(state);
+			else
+			{
+				preSimulate(state, 0, numParticles, false, 0.0f);
+				simulate(state, 0, numParticles, false, 0.0f);
+				postSimulate(state, 0, numParticles, false, 0.0f);
+			}
 		}
 
 		mTime = newTime;
@@ -308,51 +329,35 @@ namespace bs
 			particles.lifetime[i] -= timeStep;
 		}
 
-		// Kill expired particles
-		UINT32 numParticles = count;
-		for (UINT32 i = 0; i < numParticles;)
-		{
-			const UINT32 particleIdx = startIdx + i;
-			if (particles.lifetime[particleIdx] <= 0.0f)
-			{
-				mParticleSet->freeParticle(particleIdx);
-				numParticles--;
-			}
-			else
-				i++;
-		}
+		freeExpiredParticles(startIdx, count);
 
 		// Remember old positions
 		for (UINT32 i = startIdx; i < endIdx; i++)
 			particles.prevPosition[i] = particles.position[i];
 
-		// Evolve pre-simulation
-		for(auto& evolver : mEvolvers)
-		{
-			const ParticleEvolverProperties& props = evolver->getProperties();
-			if (props.priority < 0)
-				break;
-
-			evolver->evolve(mRandom, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
-		}
+		evolve(mRandom, state, startIdx, count, spacing, spacingOffset, true);
 	}
 
 	void ParticleSystem::simulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
 		float spacingOffset)
 	{
 		const ParticleSetData& particles = mParticleSet->getParticles();
-		const float subFrameSpacing = (spacing && count > 0) ? 1.0f / count : 1.0f;
+
+		if(!spacing)
+		{
+			ParticleKernels::integrate(particles.position + startIdx, particles.velocity + startIdx, state.timeStep, 
+				count);
+			return;
+		}
+
+		const float subFrameSpacing = count > 0 ? 1.0f / count : 1.0f;
 		const UINT32 endIdx = startIdx + count;
 
 		for (UINT32 i = startIdx; i < endIdx; i++)
 		{
-			float timeStep = state.timeStep;
-			if(spacing)
-			{
-				const UINT32 localIdx = i - startIdx;
-				const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
-				timeStep *= subFrameOffset;
-			}
+			const UINT32 localIdx = i - startIdx;
+			const float subFrameOffset = ((float)localIdx + spacingOffset) * subFrameSpacing;
+			const float timeStep = state.timeStep * subFrameOffset;
 
 			particles.position[i] += particles.velocity[i] * timeStep;
 		}
@@ -361,14 +366,77 @@ namespace bs
 	void ParticleSystem::postSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
 		float spacingOffset)
 	{
-		// Evolve post-simulation
+		evolve(mRandom, state, startIdx, count, spacing, spacingOffset, false);
+	}
+
+	void ParticleSystem::simulateParallel(const ParticleSystemState& state)
+	{
+		const ParticleSetData& particles = mParticleSet->getParticles();
+		TaskScheduler& taskScheduler = TaskScheduler::instance();
+
+		// Decrement lifetime and kill expired particles up front, as killing particles moves other particles around and
+		// cannot run while other threads are updating them
+		taskScheduler.parallelFor(0, mParticleSet->getParticleCount(), PARALLEL_SIMULATION_GRAIN_SIZE, 
+			[&particles, &state](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+				particles.lifetime[i] -= state.timeStep;
+		});
+
+		freeExpiredParticles(0, mParticleSet->getParticleCount());
+
+		// Each range of particles gets its own random number generator, seeded from the system's generator and the
+		// range's first particle, so ranges don't repeat each other's random sequences. The system's generator only
+		// advances by the single value used for seeding.
+		const UINT32 rangeSeed = mRandom.get();
+		taskScheduler.parallelFor(0, mParticleSet->getParticleCount(), PARALLEL_SIMULATION_GRAIN_SIZE, 
+			[this, &particles, &state, rangeSeed](UINT32 begin, UINT32 end)
+		{
+			size_t seed = rangeSeed;
+			hash_combine(seed, begin);
+
+			Random random((UINT32)seed);
+			const UINT32 count = end - begin;
+
+			// Remember old positions
+			for (UINT32 i = begin; i < end; i++)
+				particles.prevPosition[i] = particles.position[i];
+
+			evolve(random, state, begin, count, false, 0.0f, true);
+			simulate(state, begin, count, false, 0.0f);
+			evolve(random, state, begin, count, false, 0.0f, false);
+		});
+	}
+
+	void ParticleSystem::evolve(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, 
+		bool spacing, float spacingOffset, bool preSimulation)
+	{
+		// Evolvers with negative priority run after the simulation, and the rest before it
 		for(auto& evolver : mEvolvers)
 		{
 			const ParticleEvolverProperties& props = evolver->getProperties();
-			if(props.priority >= 0)
+			if((props.priority >= 0) != preSimulation)
 				continue;
 
-			evolver->evolve(mRandom, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
+			evolver->evolve(random, state, *mParticleSet, startIdx, count, spacing, spacingOffset);
+		}
+	}
+
+	void ParticleSystem::freeExpiredParticles(UINT32 startIdx, UINT32 count)
+	{
+		const ParticleSetData& particles = mParticleSet->getParticles();
+
+		UINT32 numParticles = count;
+		for (UINT32 i = 0; i < numParticles;)
+		{
+			const UINT32 particleIdx = startIdx + i;
+			if (particles.lifetime[particleIdx] <= 0.0f)
+			{
+				mParticleSet->freeParticle(particleIdx);
+				numParticles--;
+			}
+			else
+				i++;
 		}
 	}
 
@@ -389,6 +457,202 @@ namespace bs
 		return bounds;
 	}
 
+	/** Returns the largest absolute value the distribution can evaluate to, at any time. */
+	static float getMaxAbsValue(const FloatDistribution& distribution)
+	{
+		switch(distribution.getType())
+		{
+		default:
+		case PDT_Constant:
+			return Math::abs(distribution.getMinConstant());
+		case PDT_RandomRange:
+			return std::max(Math::abs(distribution.getMinConstant()), Math::abs(distribution.getMaxConstant()));
+		case PDT_Curve:
+		case PDT_RandomCurveRange:
+			{
+				const std::pair<float, float> minRange = distribution.getMinCurve().calculateRange();
+				const std::pair<float, float> maxRange = distribution.getMaxCurve().calculateRange();
+
+				return std::max(
+					std::max(Math::abs(minRange.first), Math::abs(minRange.second)),
+					std::max(Math::abs(maxRange.first), Math::abs(maxRange.second)));
+			}
+		}
+	}
+
+	/** 
+	 * Returns the radius around the emitter origin that contains every position the shape can spawn a particle at. 
+	 * Returns false for shapes whose extents cannot be determined.
+	 */
+	static bool getShapeRadius(ParticleEmitterShape* shape, float& radius)
+	{
+		radius = 0.0f;
+		if(shape == nullptr)
+			return true;
+
+		if(rtti_is_of_type<ParticleEmitterConeShape>(shape))
+		{
+			const PARTICLE_CONE_SHAPE_DESC& desc = static_cast<const ParticleEmitterConeShape*>(shape)->getOptions();
+			radius = Math::abs(desc.radius);
+
+			if(desc.type == ParticleEmitterConeType::Volume)
+			{
+				const Radian angle = Radian(desc.angle);
+				if(angle.valueRadians() >= Math::HALF_PI)
+					return false;
+
+				const float length = Math::abs(desc.length);
+				radius += length + length * Math::tan(angle);
+			}
+
+			return true;
+		}
+
+		if(rtti_is_of_type<ParticleEmitterSphereShape>(shape))
+			radius = Math::abs(static_cast<const ParticleEmitterSphereShape*>(shape)->getOptions().radius);
+		else if(rtti_is_of_type<ParticleEmitterHemisphereShape>(shape))
+			radius = Math::abs(static_cast<const ParticleEmitterHemisphereShape*>(shape)->getOptions().radius);
+		else if(rtti_is_of_type<ParticleEmitterCircleShape>(shape))
+			radius = Math::abs(static_cast<const ParticleEmitterCircleShape*>(shape)->getOptions().radius);
+		else if(rtti_is_of_type<ParticleEmitterBoxShape>(shape))
+			radius = static_cast<const ParticleEmitterBoxShape*>(shape)->getOptions().extents.length();
+		else if(rtti_is_of_type<ParticleEmitterRectShape>(shape))
+			radius = static_cast<const ParticleEmitterRectShape*>(shape)->getOptions().extents.length();
+		else if(rtti_is_of_type<ParticleEmitterLineShape>(shape))
+			radius = Math::abs(static_cast<const ParticleEmitterLineShape*>(shape)->getOptions().length);
+		else
+			return false;
+
+		return true;
+	}
+
+	bool ParticleSystem::_calculateMaxExtents(AABox& spawnBounds, float& travelDistance) const
+	{
+		// Evolvers that move particles can accelerate them past their initial speed
+		for(auto& evolver : mEvolvers)
+		{
+			if(rtti_is_of_type<ParticleVelocity>(evolver.get()) || rtti_is_of_type<ParticleOrbit>(evolver.get()) ||
+				rtti_is_of_type<ParticleForce>(evolver.get()) || rtti_is_of_type<ParticleGravity>(evolver.get()) ||
+				rtti_is_of_type<ParticleCollisions>(evolver.get()))
+				return false;
+		}
+
+		float maxSpawnRadius = 0.0f;
+		float maxTravelDistance = 0.0f;
+		for(auto& emitter : mEmitters)
+		{
+			float spawnRadius;
+			if(!getShapeRadius(emitter->getShape(), spawnRadius))
+				return false;
+
+			const float speed = getMaxAbsValue(emitter->getInitialSpeed());
+			const float lifetime = getMaxAbsValue(emitter->getInitialLifetime());
+
+			maxSpawnRadius = std::max(maxSpawnRadius, spawnRadius);
+			maxTravelDistance = std::max(maxTravelDistance, speed * lifetime);
+		}
+
+		// World space particles are spawned and given their velocity using the full transform, so they scale with it.
+		// Local space particles are transformed when rendering instead.
+		Vector3 origin = Vector3::ZERO;
+		if(mSettings.simulationSpace == ParticleSimulationSpace::World)
+		{
+			const Vector3 scale = mTransform.getScale();
+			const float maxScale = std::max(std::max(Math::abs(scale.x), Math::abs(scale.y)), Math::abs(scale.z));
+
+			origin = mTransform.getPosition();
+			maxSpawnRadius *= maxScale;
+			maxTravelDistance *= maxScale;
+		}
+
+		const Vector3 spawnExtents(maxSpawnRadius, maxSpawnRadius, maxSpawnRadius);
+		spawnBounds = AABox(origin - spawnExtents, origin + spawnExtents);
+		travelDistance = maxTravelDistance;
+
+		return true;
+	}
+
+	bool ParticleSystem::isDeterministic() const
+	{
+		if(mSettings.useAutomaticSeed || mSettings.gpuSimulation)
+			return false;
+
+		// Skinned mesh emitters depend on the animation state
+		for(auto& emitter : mEmitters)
+		{
+			ParticleEmitterShape* shape = emitter->getShape();
+			if(shape && rtti_is_of_type<ParticleEmitterSkinnedMeshShape>(shape))
+				return false;
+		}
+
+		// Physics scene and plane scene objects can change independently of the particle system
+		for(auto& evolver : mEvolvers)
+		{
+			if(!rtti_is_of_type<ParticleCollisions>(evolver.get()))
+				continue;
+
+			const auto collisions = static_cast<ParticleCollisions*>(evolver.get());
+			if(collisions->getOptions().mode == ParticleCollisionMode::World || !collisions->getPlaneObjects().empty())
+				return false;
+		}
+
+		return true;
+	}
+
+	float ParticleSystem::calculateMaxParticleLifetime() const
+	{
+		float maxLifetime = 0.0f;
+		for(auto& emitter : mEmitters)
+		{
+			const FloatDistribution& lifetime = emitter->getInitialLifetime();
+			switch(lifetime.getType())
+			{
+			default:
+			case PDT_Constant:
+				maxLifetime = std::max(maxLifetime, lifetime.getMinConstant());
+				break;
+			case PDT_RandomRange:
+				maxLifetime = std::max(maxLifetime, std::max(lifetime.getMinConstant(), lifetime.getMaxConstant()));
+				break;
+			case PDT_Curve:
+				maxLifetime = std::max(maxLifetime, lifetime.getMinCurve().calculateRange().second);
+				break;
+			case PDT_RandomCurveRange:
+				maxLifetime = std::max(maxLifetime, lifetime.getMinCurve().calculateRange().second);
+				maxLifetime = std::max(maxLifetime, lifetime.getMaxCurve().calculateRange().second);
+				break;
+			}
+		}
+
+		return maxLifetime;
+	}
+
+	void ParticleSystem::fastForward(float timeDelta, const EvaluatedAnimationData* animData)
+	{
+		if(mState != State::Playing)
+			return;
+
+		// Particles spawned before the last maximum lifetime are all dead by the end of the time delta, so there is no
+		// need to simulate that part of the time period
+		const float maxLifetime = calculateMaxParticleLifetime();
+		if(timeDelta > maxLifetime)
+		{
+			float timeStep;
+			mTime = _advanceTime(mTime, timeDelta - maxLifetime, mSettings.duration, mSettings.isLooping, timeStep);
+			mParticleSet->clear();
+
+			timeDelta = maxLifetime;
+		}
+
+		// Simulate the remaining period using larger time steps than normal, as the system isn't visible in-between
+		const UINT32 numSteps = Math::clamp((UINT32)Math::ceilToInt(timeDelta / FAST_FORWARD_STEP), 1U, 
+			MAX_FAST_FORWARD_STEPS);
+		const float stepSize = timeDelta / numSteps;
+
+		for(UINT32 i = 0; i < numSteps; i++)
+			_simulate(stepSize, animData);
+	}
+
 	float ParticleSystem::_advanceTime(float time, float timeDelta, float duration, bool loop, float& timeStep)
 	{
 		timeStep = timeDelta;
@@ -212,7 +212,8 @@ namespace bs
 		/**
 		 * Determines should the particle system bounds be automatically calculated, or should the fixed value provided
 		 * be used. Bounds are used primarily for culling purposes. Note that automatic bounds are not supported when GPU
-		 * simulation is enabled.
+		 * simulation is enabled. Automatic bounds are conservative and only get refreshed periodically, and systems whose
+		 * evolvers move the particles (e.g. velocity, force or gravity) can only be culled when using custom bounds.
 		 */
 		BS_SCRIPT_EXPORT()
 		bool useAutomaticBounds = true;
@@ -528,6 +529,19 @@ namespace bs
 		 */
 		AABox _calculateBounds() const;
 
+		/** 
+		 * Calculates the bounds of the area particles are spawned in, as well as the maximum distance a particle can
+		 * travel from its spawn position over its lifetime. Together with the bounds of the existing particles this gives
+		 * a conservative bound of the system that holds no matter how far the simulation advances. Both values are in
+		 * the simulation space of the particle system.
+		 *
+		 * @param[out]	spawnBounds		Bounds containing every position a particle can be spawned at.
+		 * @param[out]	travelDistance	Maximum distance a particle can move away from its spawn position.
+		 * @return						False if no such bound can be determined, for example when evolvers accelerate
+		 *								the particles or emitters spawn particles from a mesh.
+		 */
+		bool _calculateMaxExtents(AABox& spawnBounds, float& travelDistance) const;
+
 		/** 
 		 * Advances the particle system time according to the current time, time delta and the provided settings. 
 		 * 
@@ -604,6 +618,54 @@ namespace bs
 		 */
 		void postSimulate(const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, float spacingOffset);
 
+		/**
+		 * Performs the same operations as preSimulate(), simulate() and postSimulate() over all the particles in the
+		 * system, but splits the particles into ranges that are processed in parallel.
+		 *
+		 * @param[in]	state			State describing the current state of the simulation.
+		 */
+		void simulateParallel(const ParticleSystemState& state);
+
+		/**
+		 * Executes evolvers on the provided range of particles.
+		 *
+		 * @param[in]	random			Random number generator to provide to the evolvers.
+		 * @param[in]	state			State describing the current state of the simulation.
+		 * @param[in]	startIdx		Index of the first particle to update.
+		 * @param[in]	count			Number of particles to update, starting from @p startIdx.
+		 * @param[in]	spacing			When false all particles will use the same time-step. If true the time-step will
+		 *								be divided by @p count so particles are uniformly distributed over the 
+		 *								time-step.
+		 * @param[in]	spacingOffset	Extra offset that controls the starting position of the first particle when
+		 *								calculating spacing. Should be in range [0, 1). 0 = beginning of the current
+		 *								time step, 1 = start of next particle.
+		 * @param[in]	preSimulation	If true executes the evolvers that need to run before the simulation, otherwise
+		 *								executes the evolvers that need to run after it.
+		 */
+		void evolve(Random& random, const ParticleSystemState& state, UINT32 startIdx, UINT32 count, bool spacing, 
+			float spacingOffset, bool preSimulation);
+
+		/** Frees all particles in the provided range whose lifetime has expired. */
+		void freeExpiredParticles(UINT32 startIdx, UINT32 count);
+
+		/** 
+		 * Checks can the state of the particle system be reconstructed from its settings and time alone. Only such systems
+		 * can skip simulation while they aren't visible. This requires a manual seed, CPU simulation, and no emitters or
+		 * evolvers that depend on external objects (animation, physics or scene objects).
+		 */
+		bool isDeterministic() const;
+
+		/** Returns the longest initial lifetime any of the emitters can assign to a particle. */
+		float calculateMaxParticleLifetime() const;
+
+		/** 
+		 * Advances the simulation by @p timeDelta, used for catching up after the system was culled. Only the part of the 
+		 * time period during which currently alive particles could have been spawned is simulated, using a limited
+		 * number of time steps. The resulting particles are not identical to those of a system that was continuously 
+		 * simulated, but follow the same distribution.
+		 */
+		void fastForward(float timeDelta, const EvaluatedAnimationData* animData);
+
 		/** @copydoc CoreObject::createCore */
 		SPtr<ct::CoreObject> createCore() const override;
 
@@ -631,6 +693,11 @@ namespace bs
 		Random mRandom;
 		ParticleSet* mParticleSet = nullptr;
 
+		float mCulledTime = 0.0f; // Managed by ParticleManager
+		AABox mCullBounds; // Managed by ParticleManager
+		float mCullBoundsAge = 0.0f; // Managed by ParticleManager
+		bool mCullBoundsValid = false; // Managed by ParticleManager
+
 		/************************************************************************/
 		/* 								RTTI		                     		*/
 		/************************************************************************/
@@ -0,0 +1,250 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Private/Particles/BsParticleKernels.h"
+#include "Math/BsSIMD.h"
+#include "Math/BsRandom.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	// Kernels below treat arrays of Vector3 as flat arrays of floats, where four vectors span three SIMD registers
+	static_assert(sizeof(Vector3) == sizeof(float) * 3, "Vector3 must be tightly packed.");
+
+	/**
+	 * Returns the components of @p value repeated over the three registers that span four consecutive Vector3 values in
+	 * a flat float array.
+	 */
+	static void splatVector3(const Vector3& value, simd::float32x4& v0, simd::float32x4& v1, simd::float32x4& v2)
+	{
+		v0 = simd::make_float(value.x, value.y, value.z, value.x);
+		v1 = simd::make_float(value.y, value.z, value.x, value.y);
+		v2 = simd::make_float(value.z, value.x, value.y, value.z);
+	}
+
+	/**
+	 * Expands four per-vector values into the three registers that span four consecutive Vector3 values in a flat float
+	 * array, so that each vector component receives the value of its vector.
+	 */
+	static void expandToVector3(const simd::float32x4& value, simd::float32x4& v0, simd::float32x4& v1, simd::float32x4& v2)
+	{
+		v0 = simd::permute4<0, 0, 0, 1>(value);
+		v1 = simd::permute4<1, 1, 2, 2>(value);
+		v2 = simd::permute4<2, 3, 3, 3>(value);
+	}
+
+	/** Loads four consecutive Vector3 values and de-interleaves their components into separate registers. */
+	static void loadVector3x4(const Vector3* src, simd::float32x4& x, simd::float32x4& y, simd::float32x4& z)
+	{
+		const simd::float32x4 a = simd::load_u<simd::float32x4>(&src[0].x); // x0 y0 z0 x1
+		const simd::float32x4 b = simd::load_u<simd::float32x4>(&src[1].y); // y1 z1 x2 y2
+		const simd::float32x4 c = simd::load_u<simd::float32x4>(&src[2].z); // z2 x3 y3 z3
+
+		x = simd::shuffle2<0, 2, 0, 2>(simd::shuffle2<0, 0, 3, 3>(a, a), simd::shuffle2<2, 2, 1, 1>(b, c));
+		y = simd::shuffle2<0, 2, 0, 2>(simd::shuffle2<1, 1, 0, 0>(a, b), simd::shuffle2<3, 3, 2, 2>(b, c));
+		z = simd::shuffle2<0, 2, 0, 2>(simd::shuffle2<2, 2, 1, 1>(a, b), simd::shuffle2<0, 0, 3, 3>(c, c));
+	}
+
+	void ParticleKernels::add(Vector3* values, const Vector3& value, UINT32 count)
+	{
+		simd::float32x4 v0, v1, v2;
+		splatVector3(value, v0, v1, v2);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			float* dst = &values[i].x;
+
+			simd::store_u(dst, simd::add(simd::load_u<simd::float32x4>(dst), v0));
+			simd::store_u(dst + 4, simd::add(simd::load_u<simd::float32x4>(dst + 4), v1));
+			simd::store_u(dst + 8, simd::add(simd::load_u<simd::float32x4>(dst + 8), v2));
+		}
+
+		for(; i < count; i++)
+			values[i] += value;
+	}
+
+	void ParticleKernels::integrate(Vector3* values, const Vector3* deltas, float scale, UINT32 count)
+	{
+		const simd::float32x4 s = simd::load_splat<simd::float32x4>(&scale);
+
+		// Components are independent, so the data can be processed as a flat array of floats
+		float* dst = &values[0].x;
+		const float* src = &deltas[0].x;
+		const UINT32 numFloats = count * 3;
+
+		UINT32 i = 0;
+		for(; i + 4 <= numFloats; i += 4)
+		{
+			const simd::float32x4 delta = simd::mul(simd::load_u<simd::float32x4>(src + i), s);
+			simd::store_u(dst + i, simd::add(simd::load_u<simd::float32x4>(dst + i), delta));
+		}
+
+		for(; i < numFloats; i++)
+			dst[i] += src[i] * scale;
+	}
+
+	void ParticleKernels::randomUNorm(const UINT32* seeds, UINT32 seedOffset, float* output, UINT32 count)
+	{
+		// Replicates the first value returned by Random after setSeed()
+		const simd::uint32x4 offset = simd::make_uint(seedOffset);
+		const simd::uint32x4 seedScale = simd::make_uint(0x03c3629f);
+		const simd::uint32x4 one = simd::make_uint(1);
+		const simd::uint32x4 mantissaMask = simd::make_uint(0x007FFFFF);
+		const simd::float32x4 range = simd::make_float(8388607.0f);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			const simd::uint32x4 seed = simd::add(simd::load_u<simd::uint32x4>(seeds + i), offset);
+
+			simd::uint32x4 t = simd::add(simd::mul_lo(seed, seedScale), one);
+			t = simd::bit_xor(t, simd::shift_l<11>(t));
+			t = simd::bit_xor(t, simd::shift_r<8>(t));
+			t = simd::bit_xor(t, seed);
+			t = simd::bit_xor(t, simd::shift_r<19>(seed));
+
+			// Masked value fits in 23 bits, so a signed conversion is exact
+			const simd::float32x4 value = simd::to_float32(simd::int32x4(simd::bit_and(t, mantissaMask)));
+			simd::store_u(output + i, simd::div(value, range));
+		}
+
+		for(; i < count; i++)
+			output[i] = Random(seeds[i] + seedOffset).getUNorm();
+	}
+
+	void ParticleKernels::lerp(float* values, float min, float max, UINT32 count)
+	{
+		const simd::float32x4 one = simd::make_float(1.0f);
+		const simd::float32x4 minValue = simd::load_splat<simd::float32x4>(&min);
+		const simd::float32x4 maxValue = simd::load_splat<simd::float32x4>(&max);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			const simd::float32x4 t = simd::load_u<simd::float32x4>(values + i);
+			const simd::float32x4 value = simd::add(simd::mul(simd::sub(one, t), minValue), simd::mul(t, maxValue));
+
+			simd::store_u(values + i, value);
+		}
+
+		for(; i < count; i++)
+			values[i] = Math::lerp(values[i], min, max);
+	}
+
+	void ParticleKernels::lerp(const float* factors, const Vector3& min, const Vector3& max, Vector3* output,
+		UINT32 count)
+	{
+		const simd::float32x4 one = simd::make_float(1.0f);
+
+		simd::float32x4 min0, min1, min2;
+		splatVector3(min, min0, min1, min2);
+
+		simd::float32x4 max0, max1, max2;
+		splatVector3(max, max0, max1, max2);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			simd::float32x4 t0, t1, t2;
+			expandToVector3(simd::load_u<simd::float32x4>(factors + i), t0, t1, t2);
+
+			float* dst = &output[i].x;
+			simd::store_u(dst, simd::add(simd::mul(simd::sub(one, t0), min0), simd::mul(t0, max0)));
+			simd::store_u(dst + 4, simd::add(simd::mul(simd::sub(one, t1), min1), simd::mul(t1, max1)));
+			simd::store_u(dst + 8, simd::add(simd::mul(simd::sub(one, t2), min2), simd::mul(t2, max2)));
+		}
+
+		for(; i < count; i++)
+			output[i] = Math::lerp(factors[i], min, max);
+	}
+
+	void ParticleKernels::lerp(const float* factors, RGBA min, RGBA max, RGBA* output, UINT32 count)
+	{
+		constexpr UINT32 RB_MASK = 0x00FF00FF;
+		constexpr UINT32 GA_MASK = 0xFF00FF00;
+
+		const simd::float32x4 byteScale = simd::make_float(255.0f);
+		const simd::float32x4 half = simd::make_float(0.5f);
+		const simd::float32x4 zero = simd::make_zero();
+		const simd::float32x4 one = simd::make_float(1.0f);
+
+		// Same as Color::lerp(UINT8, RGBA, RGBA), two channels at a time
+		const simd::uint32x4 rbFrom = simd::make_uint(min & RB_MASK);
+		const simd::uint32x4 rbDiff = simd::make_uint((max & RB_MASK) - (min & RB_MASK));
+		const simd::uint32x4 gaFrom = simd::make_uint((min & GA_MASK) >> 8);
+		const simd::uint32x4 gaDiff = simd::make_uint(((max & GA_MASK) >> 8) - ((min & GA_MASK) >> 8));
+		const simd::uint32x4 rbMask = simd::make_uint(RB_MASK);
+		const simd::uint32x4 gaMask = simd::make_uint(GA_MASK);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			// Same as Bitwise::unormToUint<8>
+			const simd::float32x4 t = simd::min(simd::max(simd::load_u<simd::float32x4>(factors + i), zero), one);
+			const simd::uint32x4 byteT = simd::uint32x4(simd::to_int32(simd::add(simd::mul(t, byteScale), half)));
+
+			const simd::uint32x4 rb = simd::bit_and(simd::add(rbFrom, simd::shift_r<8>(simd::mul_lo(rbDiff, byteT))),
+				rbMask);
+			const simd::uint32x4 ga = simd::bit_and(
+				simd::shift_l<8>(simd::add(gaFrom, simd::shift_r<8>(simd::mul_lo(gaDiff, byteT)))), gaMask);
+
+			simd::store_u(output + i, simd::bit_or(rb, ga));
+		}
+
+		for(; i < count; i++)
+			output[i] = Color::lerp((UINT8)Bitwise::unormToUint<8>(factors[i]), min, max);
+	}
+
+	void ParticleKernels::findPlaneContacts(const Vector3* positions, UINT32 count, const Plane* planes,
+		UINT32 numPlanes, float radius, UINT32* output)
+	{
+		const UINT32 numWords = Math::divideAndRoundUp(count, 32U);
+		memset(output, 0, numWords * sizeof(UINT32));
+
+		if(numPlanes == 0)
+			return;
+
+		const simd::float32x4 r = simd::load_splat<simd::float32x4>(&radius);
+
+		UINT32 i = 0;
+		for(; i + 4 <= count; i += 4)
+		{
+			simd::float32x4 x, y, z;
+			loadVector3x4(positions + i, x, y, z);
+
+			simd::uint32x4 contact = simd::make_zero();
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				const Plane& plane = planes[j];
+
+				// Same as Plane::getDistance
+				const simd::float32x4 dist = simd::sub(simd::add(simd::add(
+					simd::mul(simd::load_splat<simd::float32x4>(&plane.normal.x), x),
+					simd::mul(simd::load_splat<simd::float32x4>(&plane.normal.y), y)),
+					simd::mul(simd::load_splat<simd::float32x4>(&plane.normal.z), z)),
+					simd::load_splat<simd::float32x4>(&plane.d));
+
+				contact = simd::bit_or(contact, simd::bit_cast<simd::uint32x4>(simd::cmp_le(dist, r)));
+			}
+
+			// One bit per byte, keep only one bit per lane
+			const UINT32 contactBits = simd::extract_bits_any(simd::bit_cast<simd::uint8x16>(contact));
+			const UINT32 contactMask = (contactBits & 0x1) | ((contactBits >> 3) & 0x2) | ((contactBits >> 6) & 0x4) |
+				((contactBits >> 9) & 0x8);
+
+			output[i / 32] |= contactMask << (i % 32);
+		}
+
+		for(; i < count; i++)
+		{
+			for(UINT32 j = 0; j < numPlanes; j++)
+			{
+				if(planes[j].getDistance(positions[i]) <= radius)
+				{
+					output[i / 32] |= 1U << (i % 32);
+					break;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,61 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Image/BsColor.h"
+#include "Math/BsVector3.h"
+#include "Math/BsPlane.h"
+
+namespace bs
+{
+	/** @addtogroup Particles-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Vectorized operations over ranges of particle data, used by the particle system and its built-in evolvers. Each
+	 * operation processes four particles at a time and handles any remaining particles one by one. Results match the
+	 * equivalent scalar code exactly, unless noted otherwise.
+	 */
+	class BS_CORE_EXPORT ParticleKernels
+	{
+	public:
+		/** Adds @p value to each of the @p count entries in @p values. */
+		static void add(Vector3* values, const Vector3& value, UINT32 count);
+
+		/** Adds @p deltas scaled by @p scale to each of the @p count entries in @p values. */
+		static void integrate(Vector3* values, const Vector3* deltas, float scale, UINT32 count);
+
+		/**
+		 * Generates a random value in range [0, 1] for each of the @p count entries in @p seeds. The value for entry i
+		 * equals Random(seeds[i] + seedOffset).getUNorm().
+		 */
+		static void randomUNorm(const UINT32* seeds, UINT32 seedOffset, float* output, UINT32 count);
+
+		/**
+		 * Interpolates between @p min and @p max using each of the @p count factors in @p values, and writes the results
+		 * back into @p values. Same as Math::lerp().
+		 */
+		static void lerp(float* values, float min, float max, UINT32 count);
+
+		/** Interpolates between @p min and @p max using each of the @p count @p factors. Same as Math::lerp(). */
+		static void lerp(const float* factors, const Vector3& min, const Vector3& max, Vector3* output, UINT32 count);
+
+		/**
+		 * Interpolates between @p min and @p max using each of the @p count @p factors. Factors are converted to 8-bit
+		 * and interpolated the same as in Color::lerp(UINT8, RGBA, RGBA).
+		 */
+		static void lerp(const float* factors, RGBA min, RGBA max, RGBA* output, UINT32 count);
+
+		/**
+		 * Finds all positions whose signed distance to any of the provided planes is at most @p radius. Results are
+		 * written as a bitmask with a set bit for each such position. @p output must have room for at least
+		 * Math::divideAndRoundUp(count, 32) words.
+		 */
+		static void findPlaneContacts(const Vector3* positions, UINT32 count, const Plane* planes, UINT32 numPlanes,
+			float radius, UINT32* output);
+	};
+
+	/** @} */
+}
@@ -77,6 +77,10 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mSampleRate, 7)
 			BS_RTTI_MEMBER_PLAIN_NAMED(rootMotionPos, mRootMotion->position, 8)
 			BS_RTTI_MEMBER_PLAIN_NAMED(rootMotionRot, mRootMotion->rotation, 9)
+			BS_RTTI_MEMBER_PLAIN_NAMED(compressedPositionCurves, mCompressedCurves->position, 10)
+			BS_RTTI_MEMBER_PLAIN_NAMED(compressedRotationCurves, mCompressedCurves->rotation, 11)
+			BS_RTTI_MEMBER_PLAIN_NAMED(compressedScaleCurves, mCompressedCurves->scale, 12)
+			BS_RTTI_MEMBER_PLAIN(mIsCompressed, 13)
 		BS_END_RTTI_MEMBERS
 	public:
 		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
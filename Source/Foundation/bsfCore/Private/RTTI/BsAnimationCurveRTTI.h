@@ -98,6 +98,90 @@ namespace bs
 		}
 	};
 
+	template<class T> struct RTTIPlainType<TCompressedAnimationCurve<T>>
+	{
+		enum { id = TID_CompressedAnimationCurve }; enum { hasDynamicSize = 1 };
+
+		/** @copydoc RTTIPlainType::toMemory */
+		static void toMemory(const TCompressedAnimationCurve<T>& data, char* memory)
+		{
+			UINT32 size = sizeof(UINT32);
+			char* memoryStart = memory;
+			memory += sizeof(UINT32);
+
+			UINT32 version = 0; // In case the data structure changes
+			memory = rttiWriteElem(version, memory, size);
+			memory = rttiWriteElem(data.mStart, memory, size);
+			memory = rttiWriteElem(data.mEnd, memory, size);
+			memory = rttiWriteElem(data.mLength, memory, size);
+			memory = rttiWriteElem(data.mTimeStart, memory, size);
+			memory = rttiWriteElem(data.mTimeScale, memory, size);
+
+			for(UINT32 i = 0; i < TCompressedAnimationCurve<T>::NUM_COMPONENTS; i++)
+			{
+				memory = rttiWriteElem(data.mValueMin[i], memory, size);
+				memory = rttiWriteElem(data.mValueScale[i], memory, size);
+				memory = rttiWriteElem(data.mTangentMin[i], memory, size);
+				memory = rttiWriteElem(data.mTangentScale[i], memory, size);
+			}
+
+			memory = rttiWriteElem(data.mTimes, memory, size);
+			memory = rttiWriteElem(data.mKeys, memory, size);
+			memory = rttiWriteElem(data.mUncompressedTimes, memory, size);
+
+			memcpy(memoryStart, &size, sizeof(UINT32));
+		}
+
+		/** @copydoc RTTIPlainType::fromMemory */
+		static UINT32 fromMemory(TCompressedAnimationCurve<T>& data, char* memory)
+		{
+			UINT32 size = 0;
+			memory = rttiReadElem(size, memory);
+
+			UINT32 version;
+			memory = rttiReadElem(version, memory);
+
+			memory = rttiReadElem(data.mStart, memory);
+			memory = rttiReadElem(data.mEnd, memory);
+			memory = rttiReadElem(data.mLength, memory);
+			memory = rttiReadElem(data.mTimeStart, memory);
+			memory = rttiReadElem(data.mTimeScale, memory);
+
+			for(UINT32 i = 0; i < TCompressedAnimationCurve<T>::NUM_COMPONENTS; i++)
+			{
+				memory = rttiReadElem(data.mValueMin[i], memory);
+				memory = rttiReadElem(data.mValueScale[i], memory);
+				memory = rttiReadElem(data.mTangentMin[i], memory);
+				memory = rttiReadElem(data.mTangentScale[i], memory);
+			}
+
+			memory = rttiReadElem(data.mTimes, memory);
+			memory = rttiReadElem(data.mKeys, memory);
+			memory = rttiReadElem(data.mUncompressedTimes, memory);
+
+			return size;
+		}
+
+		/** @copydoc RTTIPlainType::getDynamicSize */
+		static UINT32 getDynamicSize(const TCompressedAnimationCurve<T>& data)
+		{
+			UINT64 dataSize = sizeof(UINT32) + sizeof(UINT32);
+			dataSize += rttiGetElemSize(data.mStart);
+			dataSize += rttiGetElemSize(data.mEnd);
+			dataSize += rttiGetElemSize(data.mLength);
+			dataSize += rttiGetElemSize(data.mTimeStart);
+			dataSize += rttiGetElemSize(data.mTimeScale);
+			dataSize += sizeof(float) * 4 * TCompressedAnimationCurve<T>::NUM_COMPONENTS;
+			dataSize += rttiGetElemSize(data.mTimes);
+			dataSize += rttiGetElemSize(data.mKeys);
+			dataSize += rttiGetElemSize(data.mUncompressedTimes);
+
+			assert(dataSize <= std::numeric_limits<UINT32>::max());
+
+			return (UINT32)dataSize;
+		}
+	};
+
 	template<class T> struct RTTIPlainType<TNamedAnimationCurve<T>>
 	{
 		enum { id = TID_NamedAnimationCurve }; enum { hasDynamicSize = 1 };
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Reflection/BsRTTIType.h"
 #include "Components/BsCAnimation.h"
+#include "Animation/BsSkeletonMask.h"
 #include "Private/RTTI/BsGameObjectRTTI.h"
 
 namespace bs
@@ -14,6 +15,106 @@ namespace bs
 	 *  @{
 	 */
 
+	template<> struct RTTIPlainType<SkeletonMask>
+	{
+		enum { id = TID_SkeletonMask }; enum { hasDynamicSize = 1 };
+
+		static void toMemory(const SkeletonMask& data, char* memory)
+		{
+			static constexpr UINT32 VERSION = 0;
+
+			const UINT32 size = getDynamicSize(data);
+
+			memory = rttiWriteElem(size, memory);
+			memory = rttiWriteElem(VERSION, memory);
+			memory = rttiWriteElem(data.mIsDisabled, memory);
+		}
+
+		static UINT32 fromMemory(SkeletonMask& data, char* memory)
+		{
+			UINT32 size = 0;
+			memory = rttiReadElem(size, memory);
+
+			UINT32 version = 0;
+			memory = rttiReadElem(version, memory);
+
+			switch(version)
+			{
+			case 0:
+				memory = rttiReadElem(data.mIsDisabled, memory);
+				break;
+			default:
+				LOGERR("Unknown version of SkeletonMask data. Unable to deserialize.");
+				break;
+			}
+
+			return size;
+		}
+
+		static UINT32 getDynamicSize(const SkeletonMask& data)
+		{
+			UINT64 dataSize = sizeof(UINT32) * 2 + rttiGetElemSize(data.mIsDisabled);
+
+			assert(dataSize <= std::numeric_limits<UINT32>::max());
+			return (UINT32)dataSize;
+		}
+	};
+
+	template<> struct RTTIPlainType<AnimationLODLevel>
+	{
+		enum { id = TID_AnimationLODLevel }; enum { hasDynamicSize = 1 };
+
+		static void toMemory(const AnimationLODLevel& data, char* memory)
+		{
+			static constexpr UINT32 VERSION = 0;
+
+			const UINT32 size = getDynamicSize(data);
+
+			memory = rttiWriteElem(size, memory);
+			memory = rttiWriteElem(VERSION, memory);
+			memory = rttiWriteElem(data.distance, memory);
+			memory = rttiWriteElem(data.updateInterval, memory);
+			memory = rttiWriteElem(data.skipAdditiveLayers, memory);
+			memory = rttiWriteElem(data.skipMorphShapes, memory);
+			memory = rttiWriteElem(data.mask, memory);
+		}
+
+		static UINT32 fromMemory(AnimationLODLevel& data, char* memory)
+		{
+			UINT32 size = 0;
+			memory = rttiReadElem(size, memory);
+
+			UINT32 version = 0;
+			memory = rttiReadElem(version, memory);
+
+			switch(version)
+			{
+			case 0:
+				memory = rttiReadElem(data.distance, memory);
+				memory = rttiReadElem(data.updateInterval, memory);
+				memory = rttiReadElem(data.skipAdditiveLayers, memory);
+				memory = rttiReadElem(data.skipMorphShapes, memory);
+				memory = rttiReadElem(data.mask, memory);
+				break;
+			default:
+				LOGERR("Unknown version of AnimationLODLevel data. Unable to deserialize.");
+				break;
+			}
+
+			return size;
+		}
+
+		static UINT32 getDynamicSize(const AnimationLODLevel& data)
+		{
+			UINT64 dataSize = sizeof(UINT32) * 2 + rttiGetElemSize(data.distance) + 
+				rttiGetElemSize(data.updateInterval) + rttiGetElemSize(data.skipAdditiveLayers) + 
+				rttiGetElemSize(data.skipMorphShapes) + rttiGetElemSize(data.mask);
+
+			assert(dataSize <= std::numeric_limits<UINT32>::max());
+			return (UINT32)dataSize;
+		}
+	};
+
 	class BS_CORE_EXPORT CAnimationRTTI : public RTTIType<CAnimation, Component, CAnimationRTTI>
 	{
 		BS_BEGIN_RTTI_MEMBERS
@@ -23,6 +124,7 @@ namespace bs
 			BS_RTTI_MEMBER_PLAIN(mEnableCull, 3)
 			BS_RTTI_MEMBER_PLAIN(mUseBounds, 4)
 			BS_RTTI_MEMBER_PLAIN(mBounds, 5)
+			BS_RTTI_MEMBER_PLAIN(mLODLevels, 6)
 		BS_END_RTTI_MEMBERS
 	public:
 		const String& getRTTIName() override
@@ -40,7 +40,7 @@ namespace bs
 				// deserialized handles pointing to this object can be resolved.
 				SPtr<Component> compPtr = std::static_pointer_cast<Component>(deserializationData.ptr);
 
-				GameObjectHandleBase handle = GameObjectManager::instance().registerObject(compPtr);
+				GameObjectHandleBase handle = coreContext->goState->registerNewObject(compPtr);
 				coreContext->goState->registerObject(deserializationData.originalId, handle);
 			}
 			
@@ -41,8 +41,7 @@ namespace bs
 
 		void setData(MeshData* obj, const SPtr<DataStream>& value, UINT32 size)
 		{
-			obj->allocateInternalBuffer(size);
-			value->read(obj->getData(), size);
+			obj->readFromStream(value, size);
 		}
 
 	public:
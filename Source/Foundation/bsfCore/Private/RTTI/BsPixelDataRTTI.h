@@ -52,8 +52,7 @@ namespace bs
 
 		void setData(PixelData* obj, const SPtr<DataStream>& value, UINT32 size)
 		{
-			obj->allocateInternalBuffer(size);
-			value->read(obj->getData(), size);
+			obj->readFromStream(value, size);
 		}
 		
 	public:
@@ -134,7 +134,7 @@ namespace bs
 			// deserialized handles pointing to this object can be resolved.
 			SPtr<SceneObject> soPtr = std::static_pointer_cast<SceneObject>(goDeserializationData.ptr);
 
-			HSceneObject soHandle = SceneObject::createInternal(soPtr);
+			HSceneObject soHandle = SceneObject::createInternal(soPtr, coreContext->goState.get());
 			coreContext->goState->registerObject(goDeserializationData.originalId, soHandle);
 
 			// We stored all components and children in a temporary structure because they rely on the SceneObject being
@@ -61,6 +61,12 @@ namespace bs
 				&SkeletonRTTI::setBoneTransform, &SkeletonRTTI::setNumBoneTransforms);
 		}
 
+		void onDeserializationEnded(IReflectable* obj, SerializationContext* context) override
+		{
+			Skeleton* skeleton = static_cast<Skeleton*>(obj);
+			skeleton->buildHierarchyOrder();
+		}
+
 		const String& getRTTIName() override
 		{
 			static String name = "Skeleton";
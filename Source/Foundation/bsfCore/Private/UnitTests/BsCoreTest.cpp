@@ -2,8 +2,39 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Testing/BsConsoleTestOutput.h"
 #include "Testing/BsTestSuite.h"
+#include "Animation/BsAnimation.h"
 #include "Animation/BsAnimationCurve.h"
+#include "Animation/BsAnimationClip.h"
+#include "Animation/BsAnimationManager.h"
+#include "Animation/BsSkeleton.h"
+#include "Animation/BsSkeletonMask.h"
 #include "Particles/BsParticleDistribution.h"
+#include "Private/Particles/BsParticleKernels.h"
+#include "Scene/BsGameObjectManager.h"
+#include "Scene/BsSceneManager.h"
+#include "Scene/BsSceneObject.h"
+#include "Scene/BsSceneActor.h"
+#include "Scene/BsTransformHierarchy.h"
+#include "Resources/BsResources.h"
+#include "Resources/BsResource.h"
+#include "Private/RTTI/BsResourceRTTI.h"
+#include "Managers/BsResourceListenerManager.h"
+#include "Importer/BsImporter.h"
+#include "Importer/BsImportOptions.h"
+#include "Image/BsPixelData.h"
+#include "Image/BsPixelUtil.h"
+#include "CoreThread/BsCoreObjectManager.h"
+#include "CoreThread/BsCoreObjectCore.h"
+#include "CoreThread/BsCoreThread.h"
+#include "Threading/BsTaskScheduler.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsTimer.h"
+#include "Utility/BsTime.h"
+#include "Math/BsRandom.h"
+#include "Debug/BsDebug.h"
+#include "Renderer/BsRenderQueue.h"
+#include "Renderer/BsRenderElement.h"
 
 namespace bs
 {
@@ -17,20 +48,327 @@ namespace bs
 		return acceleration * time;
 	}
 
+	/** Minimal game object used for testing GameObjectManager. */
+	class TestGameObject : public GameObject
+	{
+	public:
+		RTTITypeBase* getRTTI() const override { return nullptr; }
+
+	protected:
+		void destroyInternal(GameObjectHandleBase& handle, bool immediate) override { }
+	};
+
+	/** Scene actor that counts how many times its state was updated from its scene object. */
+	class TestSceneActor : public SceneActor
+	{
+	public:
+		void _updateState(const SceneObject& so, bool force) override
+		{
+			numUpdates++;
+			SceneActor::_updateState(so, force);
+		}
+
+		UINT32 numUpdates = 0;
+	};
+
+	static constexpr UINT32 TID_TestResource = 99100;
+
+	/** Minimal resource containing a block of data, used for testing resource loading. */
+	class TestResource : public Resource
+	{
+	public:
+		TestResource()
+			:Resource(false)
+		{ }
+
+		/** Creates a new resource containing @p size randomly generated values. */
+		static HResource create(UINT32 size, Random& random)
+		{
+			SPtr<TestResource> resource = _createPtr();
+			resource->mData.resize(size);
+
+			// Keep the values in a small range so the data compresses well
+			for(auto& entry : resource->mData)
+				entry = (UINT32)random.getRange(0, 255);
+
+			return gResources()._createResourceHandle(resource);
+		}
+
+		/** Creates a new resource without a handle. */
+		static SPtr<TestResource> _createPtr()
+		{
+			SPtr<TestResource> resource = bs_core_ptr<TestResource>(new (bs_alloc<TestResource>()) TestResource());
+			resource->_setThisPtr(resource);
+			resource->initialize();
+
+			return resource;
+		}
+
+		/** Returns the sum of all values in the resource. */
+		UINT64 getChecksum() const
+		{
+			UINT64 sum = 0;
+			for(auto& entry : mData)
+				sum += entry;
+
+			return sum;
+		}
+
+		Vector<UINT32> mData;
+
+		friend class TestResourceRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	class TestResourceRTTI : public RTTIType<TestResource, Resource, TestResourceRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mData, 0)
+		BS_END_RTTI_MEMBERS
+
+	public:
+		const String& getRTTIName() override
+		{
+			static String name = "TestResource";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_TestResource;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return TestResource::_createPtr();
+		}
+	};
+
+	RTTITypeBase* TestResource::getRTTIStatic()
+	{
+		return TestResourceRTTI::instance();
+	}
+
+	RTTITypeBase* TestResource::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
+	/** Importer that creates a TestResource from a file containing its values, and counts the number of imports. */
+	class TestResourceImporter : public SpecificImporter
+	{
+	public:
+		bool isExtensionSupported(const String& ext) const override { return ext == "testres"; }
+		bool isMagicNumberSupported(const UINT8* magicNumPtr, UINT32 numBytes) const override { return true; }
+		UINT32 getVersion() const override { return version; }
+
+		bool getDependencies(const Path& filePath, const Vector<SubResourceRaw>& resources, 
+			Vector<Path>& dependencies) const override
+		{
+			if(!dependency.isEmpty())
+				dependencies.push_back(dependency);
+
+			return true;
+		}
+
+		SPtr<Resource> import(const Path& filePath, SPtr<const ImportOptions> importOptions) override
+		{
+			SPtr<TestResource> resource = TestResource::_createPtr();
+
+			// Data of the dependency, if any, is appended to the data of the imported file
+			for(auto& path : { filePath, dependency })
+			{
+				if(path.isEmpty())
+					continue;
+
+				SPtr<DataStream> stream = FileSystem::openFile(path);
+
+				const size_t offset = resource->mData.size();
+				resource->mData.resize(offset + stream->size() / sizeof(UINT32));
+				stream->read(resource->mData.data() + offset, (resource->mData.size() - offset) * sizeof(UINT32));
+			}
+
+			numImports++;
+			return resource;
+		}
+
+		std::atomic<UINT32> numImports{0};
+		UINT32 version = 0;
+		Path dependency;
+	};
+
+	namespace ct
+	{
+	/** Core thread counterpart of bs::TestCoreObject. Records the order in which objects receive their sync data. */
+	class TestCoreObject : public CoreObject
+	{
+	public:
+		TestCoreObject(Vector<UINT32>& syncOrder)
+			:mSyncOrder(syncOrder)
+		{ }
+
+	protected:
+		void syncToCore(const CoreSyncData& data) override
+		{
+			mSyncOrder.push_back(data.getData<UINT32>());
+		}
+
+		Vector<UINT32>& mSyncOrder;
+	};
+
+	/** Render element that is never drawn, only used for identifying elements in a render queue. */
+	class TestRenderElement : public RenderElement
+	{
+	public:
+		void draw() const override { }
+	};
+
+	/** Render queue that accepts shader properties directly, so elements can be sorted without creating materials. */
+	class TestRenderQueue : public RenderQueue
+	{
+	public:
+		using RenderQueue::RenderQueue;
+		using RenderQueue::add;
+	};
+	}
+
+	/** Core object that can depend on another core object, and syncs its index to the core thread. */
+	class TestCoreObject : public CoreObject
+	{
+	public:
+		TestCoreObject(UINT32 idx, Vector<UINT32>& syncOrder)
+			:CoreObject(false), mIdx(idx), mSyncOrder(syncOrder)
+		{ }
+
+		/** Creates a new core object with the specified index. Indices are written to @p syncOrder as they are synced. */
+		static SPtr<TestCoreObject> create(UINT32 idx, Vector<UINT32>& syncOrder)
+		{
+			SPtr<TestCoreObject> object = bs_core_ptr<TestCoreObject>(
+				new (bs_alloc<TestCoreObject>()) TestCoreObject(idx, syncOrder));
+			object->_setThisPtr(object);
+			object->initialize();
+
+			return object;
+		}
+
+		/** Makes the object depend on another object, or on no object if null. */
+		void setDependency(const SPtr<TestCoreObject>& dependency)
+		{
+			mDependency = dependency;
+			markDependenciesDirty();
+		}
+
+		/** Marks the object as requiring a sync to the core thread. */
+		void markDirty() { markCoreDirty(); }
+
+	protected:
+		SPtr<ct::CoreObject> createCore() const override
+		{
+			SPtr<ct::TestCoreObject> core = bs_shared_ptr<ct::TestCoreObject>(
+				new (bs_alloc<ct::TestCoreObject>()) ct::TestCoreObject(mSyncOrder));
+			core->_setThisPtr(core);
+
+			return core;
+		}
+
+		CoreSyncData syncToCore(FrameAlloc* allocator) override
+		{
+			UINT8* data = allocator->alloc(sizeof(mIdx));
+			memcpy(data, &mIdx, sizeof(mIdx));
+
+			return CoreSyncData(data, sizeof(mIdx));
+		}
+
+		void getCoreDependencies(Vector<CoreObject*>& dependencies) override
+		{
+			if(mDependency != nullptr)
+				dependencies.push_back(mDependency.get());
+		}
+
+		UINT32 mIdx;
+		Vector<UINT32>& mSyncOrder;
+		SPtr<TestCoreObject> mDependency;
+	};
+
 	class CoreTestSuite : public TestSuite
 	{
 	public:
 		CoreTestSuite();
+		void startUp() override;
+		void shutDown() override;
 
 	private:
 		void testAnimCurveIntegration();
 		void testLookupTable();
+		void testGameObjectManager();
+		void testResourceLoading();
+		void testImportCache();
+		void testPixelConversion();
+		void testAnimationEvaluation();
+		void testAnimationKeyPoseInterpolation();
+		void testAnimationLOD();
+		void testAnimationCompression();
+		void testParticleSimulation();
+		void testSceneActorUpdates();
+		void testTransformHierarchy();
+		void testCoreObjectSync();
+		void testRenderQueueSort();
 	};
 
 	CoreTestSuite::CoreTestSuite()
 	{
 		BS_ADD_TEST(CoreTestSuite::testAnimCurveIntegration);
 		BS_ADD_TEST(CoreTestSuite::testLookupTable);
+		BS_ADD_TEST(CoreTestSuite::testGameObjectManager);
+		BS_ADD_TEST(CoreTestSuite::testResourceLoading);
+		BS_ADD_TEST(CoreTestSuite::testImportCache);
+		BS_ADD_TEST(CoreTestSuite::testPixelConversion);
+		BS_ADD_TEST(CoreTestSuite::testAnimationEvaluation);
+		BS_ADD_TEST(CoreTestSuite::testAnimationKeyPoseInterpolation);
+		BS_ADD_TEST(CoreTestSuite::testAnimationLOD);
+		BS_ADD_TEST(CoreTestSuite::testAnimationCompression);
+		BS_ADD_TEST(CoreTestSuite::testParticleSimulation);
+		BS_ADD_TEST(CoreTestSuite::testSceneActorUpdates);
+		BS_ADD_TEST(CoreTestSuite::testTransformHierarchy);
+		BS_ADD_TEST(CoreTestSuite::testCoreObjectSync);
+		BS_ADD_TEST(CoreTestSuite::testRenderQueueSort);
+	}
+
+	void CoreTestSuite::startUp()
+	{
+		// Required by the task scheduler, benchmark logging, resource loading, import, scene, animation and core object
+		// sync tests. Modules can only be started once, so they are shared by all the tests.
+		const UINT32 numCores = std::max(1U, BS_THREAD_HARDWARE_CONCURRENCY);
+		MemStack::beginThread();
+		ThreadPool::startUp<TThreadPool<ThreadBansheePolicy>>(numCores, numCores * 8 + 16);
+		Time::startUp();
+		TaskScheduler::startUp();
+		CoreThread::startUp();
+		CoreObjectManager::startUp();
+		Resources::startUp();
+		ResourceListenerManager::startUp();
+		GameObjectManager::startUp();
+		SceneManager::startUp();
+		AnimationManager::startUp();
+		Importer::startUp();
+	}
+
+	void CoreTestSuite::shutDown()
+	{
+		Importer::shutDown();
+		AnimationManager::shutDown();
+		SceneManager::shutDown();
+		GameObjectManager::shutDown();
+		ResourceListenerManager::shutDown();
+		Resources::shutDown();
+		CoreObjectManager::shutDown();
+		CoreThread::shutDown();
+		TaskScheduler::shutDown();
+		Time::shutDown();
+		ThreadPool::shutDown();
+		MemStack::endThread();
 	}
 
 	void CoreTestSuite::testAnimCurveIntegration()
@@ -143,16 +481,2043 @@ namespace bs
 				BS_TEST_ASSERT(Math::approxEquals(valueLookup[j], valueCurve[j], EPSILON));
 		}
 	}
-}
 
-using namespace bs;
+	void CoreTestSuite::testGameObjectManager()
+	{
+		static constexpr UINT32 NUM_OBJECTS = 10000;
 
-int main()
-{
-	SPtr<TestSuite> tests = CoreTestSuite::create<CoreTestSuite>();
+		GameObjectManager& manager = GameObjectManager::instance();
 
-	ExceptionTestOutput testOutput;
-	tests->run(testOutput);
+		auto createObject = []()
+		{
+			return bs_shared_ptr_new<TestGameObject>();
+		};
 
-	return 0;
-}
\ No newline at end of file
+		Vector<GameObjectHandleBase> handles;
+		Vector<UINT64> ids;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			handles.push_back(manager.registerObject(createObject()));
+			ids.push_back(handles.back().getInstanceId());
+		}
+
+		// Every ID must be unique and resolve to its object
+		BS_TEST_ASSERT(UnorderedSet<UINT64>(ids.begin(), ids.end()).size() == NUM_OBJECTS);
+
+		bool allFound = true;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			GameObjectHandleBase handle;
+			allFound &= manager.tryGetObject(ids[i], handle) && handle.get() == handles[i].get();
+		}
+
+		BS_TEST_ASSERT(allFound);
+
+		// Freed slots get reused, but IDs of destroyed objects must never resolve to their replacements
+		for(UINT32 i = 0; i < NUM_OBJECTS; i += 2)
+			manager.unregisterObject(handles[i]);
+
+		Vector<GameObjectHandleBase> newHandles;
+		for(UINT32 i = 0; i < NUM_OBJECTS / 2; i++)
+			newHandles.push_back(manager.registerObject(createObject()));
+
+		bool validStates = true;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			const bool destroyed = (i % 2) == 0;
+			validStates &= manager.objectExists(ids[i]) != destroyed;
+			validStates &= handles[i].isDestroyed() == destroyed;
+		}
+
+		for(auto& entry : newHandles)
+			validStates &= manager.getObject(entry.getInstanceId()).get() == entry.get();
+
+		BS_TEST_ASSERT(validStates);
+
+		// Objects registered through reserved slots behave the same as regularly registered ones
+		Vector<UINT32> slots;
+		manager.reserveSlots(64, slots);
+
+		Vector<GameObjectHandleBase> batchHandles;
+		for(UINT32 i = 0; i < 32; i++)
+		{
+			batchHandles.push_back(manager.registerObject(createObject(), slots.back()));
+			slots.pop_back();
+		}
+
+		manager.releaseSlots(slots);
+
+		bool batchFound = true;
+		for(auto& entry : batchHandles)
+			batchFound &= manager.getObject(entry.getInstanceId()).get() == entry.get();
+
+		BS_TEST_ASSERT(batchFound);
+
+		// Remapping to an ID whose slot has since been reused
+		const UINT64 remappedId = ids[0];
+		const UINT64 oldId = ids[1];
+		manager.remapId(oldId, remappedId);
+
+		BS_TEST_ASSERT(!manager.objectExists(oldId));
+		BS_TEST_ASSERT(manager.getObject(remappedId).get() == handles[1].get());
+
+		manager.remapId(remappedId, oldId);
+		BS_TEST_ASSERT(!manager.objectExists(remappedId));
+		BS_TEST_ASSERT(manager.getObject(oldId).get() == handles[1].get());
+	}
+
+	void CoreTestSuite::testResourceLoading()
+	{
+		static constexpr UINT32 NUM_RESOURCES = 2000;
+
+		// Save the resources, registering them in the default manifest. Every other resource is compressed.
+		const Path directory = FileSystem::getTempDirectoryPath() + "ResourceLoadTest/";
+
+		Random random(1234);
+		Vector<UUID> uuids;
+		Vector<UINT64> checksums;
+		UINT64 totalSize = 0;
+		for(UINT32 i = 0; i < NUM_RESOURCES; i++)
+		{
+			const UINT32 size = (UINT32)random.getRange(1024, 8192);
+			HResource resource = TestResource::create(size, random);
+
+			gResources().save(resource, directory + ("Resource" + toString(i) + ".asset"), true, (i % 2) == 1);
+
+			uuids.push_back(resource.getUUID());
+			checksums.push_back(static_resource_cast<TestResource>(resource)->getChecksum());
+			totalSize += size * sizeof(UINT32);
+		}
+
+		gResources().unloadAll();
+
+		auto toMs = [](UINT64 time) { return toString(time / 1000.0f, 0, 0, ' ', std::ios::fixed) + " ms"; };
+		auto logStage = [&](const String& name, const ResourceLoadStats::Stage& stage, UINT64 wallTime)
+		{
+			const float occupancy = wallTime > 0 ? stage.busyTime / (float)wallTime : 0.0f;
+
+			gDebug().logDebug("  " + name + ": " + toString(stage.numProcessed) + " resources, busy " + 
+				toMs(stage.busyTime) + ", average occupancy " + toString(occupancy, 2, 0, ' ', std::ios::fixed) + 
+				", peak " + toString(stage.peakActive));
+		};
+
+		// Load all resources asynchronously. On the second run wait on the last queued resource straight away, which
+		// should move it ahead of the rest of the queue.
+		for(UINT32 run = 0; run < 2; run++)
+		{
+			const bool waitOnLast = run == 1;
+			gResources().resetLoadStats();
+
+			Timer timer;
+
+			Vector<HResource> handles;
+			for(auto& entry : uuids)
+				handles.push_back(gResources().loadFromUUID(entry, true));
+
+			UINT64 lastLoadTime = 0;
+			if(waitOnLast)
+			{
+				handles.back().blockUntilLoaded();
+				lastLoadTime = timer.getMicroseconds();
+			}
+
+			for(auto& entry : handles)
+				entry.blockUntilLoaded();
+
+			const UINT64 wallTime = timer.getMicroseconds();
+
+			bool allMatch = true;
+			for(UINT32 i = 0; i < NUM_RESOURCES; i++)
+			{
+				allMatch &= handles[i].isLoaded() && 
+					static_resource_cast<TestResource>(handles[i])->getChecksum() == checksums[i];
+			}
+
+			BS_TEST_ASSERT(allMatch);
+
+			const ResourceLoadStats stats = gResources().getLoadStats();
+			BS_TEST_ASSERT(stats.deserialize.numProcessed == NUM_RESOURCES);
+
+			gDebug().logDebug("Loaded " + toString(NUM_RESOURCES) + " resources (" + toString(totalSize / (1024 * 1024)) + 
+				" MB) in " + toMs(wallTime));
+
+			if(waitOnLast)
+			{
+				gDebug().logDebug("  Last queued resource available after " + toMs(lastLoadTime) + ", " + 
+					toString(stats.numBoosted) + " load(s) boosted");
+			}
+
+			logStage("Read", stats.read, wallTime);
+			logStage("Decompress", stats.decompress, wallTime);
+			logStage("Deserialize", stats.deserialize, wallTime);
+
+			gResources().unloadAll();
+		}
+
+		FileSystem::remove(directory);
+	}
+
+	void CoreTestSuite::testImportCache()
+	{
+		auto importer = bs_new<TestResourceImporter>();
+		gImporter()._registerAssetImporter(importer);
+
+		const Path directory = FileSystem::getTempDirectoryPath() + "ImportCacheTest/";
+
+		const Path cacheDirectory = directory + "Cache/";
+		const Path sourcePath = directory + "Source.testres";
+		const Path dependencyPath = directory + "Dependency.bin";
+
+		auto writeFile = [&](const Path& path, UINT32 count)
+		{
+			Vector<UINT32> values(count);
+			for(UINT32 i = 0; i < count; i++)
+				values[i] = i;
+
+			SPtr<DataStream> stream = FileSystem::createAndOpenFile(path);
+			stream->write(values.data(), values.size() * sizeof(UINT32));
+			stream->close();
+		};
+
+		auto writeSource = [&](UINT32 count) { writeFile(sourcePath, count); };
+
+		auto importSize = [&]()
+		{
+			SPtr<TestResource> resource = std::static_pointer_cast<TestResource>(gImporter()._import(sourcePath));
+			return resource != nullptr ? (UINT32)resource->mData.size() : 0;
+		};
+
+		FileSystem::createDir(directory);
+		writeSource(1000);
+
+		// Without a cache directory every import runs the importer
+		BS_TEST_ASSERT(importSize() == 1000);
+		BS_TEST_ASSERT(importSize() == 1000);
+		BS_TEST_ASSERT(importer->numImports == 2);
+
+		// Only the first import of an unchanged file runs the importer
+		gImporter().setCacheDirectory(cacheDirectory);
+		BS_TEST_ASSERT(importSize() == 1000);
+		BS_TEST_ASSERT(importSize() == 1000);
+		BS_TEST_ASSERT(importer->numImports == 3);
+
+		Vector<SubResourceRaw> subresources = gImporter()._importAll(sourcePath);
+		BS_TEST_ASSERT(subresources.size() == 1);
+		BS_TEST_ASSERT(importer->numImports == 4);
+
+		subresources = gImporter()._importAll(sourcePath);
+		BS_TEST_ASSERT(subresources.size() == 1 && subresources[0].name == "primary");
+		BS_TEST_ASSERT(importer->numImports == 4);
+
+		// Asynchronous imports share the cache
+		AsyncOp op = gImporter().importAsync(sourcePath, nullptr, UUID::EMPTY, false);
+		op.blockUntilComplete();
+		BS_TEST_ASSERT(op.getReturnValue<SPtr<Resource>>() != nullptr);
+		BS_TEST_ASSERT(importer->numImports == 4);
+
+		// Changing the source file or the importer version invalidates the cached result
+		writeSource(2000);
+		BS_TEST_ASSERT(importSize() == 2000);
+		BS_TEST_ASSERT(importer->numImports == 5);
+
+		importer->version++;
+		BS_TEST_ASSERT(importSize() == 2000);
+		BS_TEST_ASSERT(importSize() == 2000);
+		BS_TEST_ASSERT(importer->numImports == 6);
+
+		// Changing a file the import depends on invalidates the cached result, while the main file stays the same
+		writeFile(dependencyPath, 100);
+		importer->dependency = dependencyPath;
+		importer->version++;
+		BS_TEST_ASSERT(importSize() == 2100);
+		BS_TEST_ASSERT(importSize() == 2100);
+		BS_TEST_ASSERT(importer->numImports == 7);
+
+		// Re-saving a dependency with the same contents only changes its modification time, which keeps the cache valid
+		const std::time_t dependencyTime = FileSystem::getLastModifiedTime(dependencyPath);
+		while(FileSystem::getLastModifiedTime(dependencyPath) == dependencyTime)
+		{
+			BS_THREAD_SLEEP(100)
+			writeFile(dependencyPath, 100);
+		}
+
+		BS_TEST_ASSERT(importSize() == 2100);
+		BS_TEST_ASSERT(importer->numImports == 7);
+
+		writeFile(dependencyPath, 200);
+		BS_TEST_ASSERT(importSize() == 2200);
+		BS_TEST_ASSERT(importSize() == 2200);
+		BS_TEST_ASSERT(importer->numImports == 8);
+
+		importer->dependency = Path::BLANK;
+		FileSystem::remove(directory);
+	}
+
+	void CoreTestSuite::testPixelConversion()
+	{
+		static constexpr UINT32 BENCHMARK_SIZE = 1024;
+		static const PixelFormat FORMATS[] = 
+		{ 
+			PF_R8, PF_RG8, PF_RGB8, PF_BGR8, PF_RGBA8, PF_BGRA8, PF_RGBA16F, PF_RGBA32F 
+		};
+
+		// Converts pixels one by one, as a reference for the optimized conversions
+		auto convertPerPixel = [](const PixelData& src, PixelData& dst, bool toSRGB)
+		{
+			const UINT32 srcPixelSize = PixelUtil::getNumElemBytes(src.getFormat());
+			const UINT32 dstPixelSize = PixelUtil::getNumElemBytes(dst.getFormat());
+
+			for(UINT32 y = 0; y < src.getHeight(); y++)
+			{
+				for(UINT32 x = 0; x < src.getWidth(); x++)
+				{
+					Color color;
+					PixelUtil::unpackColor(&color, src.getFormat(), src.getData() + 
+						(y * src.getRowPitch() + x) * srcPixelSize);
+
+					if(toSRGB)
+						color = PixelUtil::linearToSRGB(color);
+
+					PixelUtil::packColor(color, dst.getFormat(), dst.getData() + 
+						(y * dst.getRowPitch() + x) * dstPixelSize);
+				}
+			}
+		};
+
+		// Colors are partially out of range, to make sure conversions clamp the same way
+		Random random(1234);
+		auto createImage = [&](PixelFormat format, UINT32 width, UINT32 height)
+		{
+			Vector<Color> colors(width * height);
+			for(auto& entry : colors)
+			{
+				for(UINT32 i = 0; i < 4; i++)
+					entry[i] = random.getUNorm() * 1.5f - 0.25f;
+			}
+
+			SPtr<PixelData> image = PixelData::create(width, height, 1, format);
+			image->setColors(colors);
+
+			return image;
+		};
+
+		auto isEqual = [](const PixelData& a, const PixelData& b)
+		{
+			return memcmp(a.getData(), b.getData(), a.getConsecutiveSize()) == 0;
+		};
+
+		// Conversions between all formats must match the per-pixel reference exactly. Width is picked so the end of
+		// each row isn't a multiple of the SIMD width.
+		bool allMatch = true;
+		for(auto srcFormat : FORMATS)
+		{
+			SPtr<PixelData> src = createImage(srcFormat, 67, 13);
+			for(auto dstFormat : FORMATS)
+			{
+				if(srcFormat == dstFormat)
+					continue;
+
+				SPtr<PixelData> expected = PixelData::create(src->getWidth(), src->getHeight(), 1, dstFormat);
+				convertPerPixel(*src, *expected, false);
+
+				SPtr<PixelData> output = PixelData::create(src->getWidth(), src->getHeight(), 1, dstFormat);
+				PixelUtil::bulkPixelConversion(*src, *output);
+
+				if(!isEqual(*output, *expected))
+				{
+					gDebug().logDebug("Mismatch converting " + PixelUtil::getFormatName(srcFormat) + " to " + 
+						PixelUtil::getFormatName(dstFormat));
+					allMatch = false;
+				}
+			}
+
+			SPtr<PixelData> expected = PixelData::create(src->getWidth(), src->getHeight(), 1, srcFormat);
+			convertPerPixel(*src, *expected, true);
+
+			PixelUtil::linearToSRGB(*src);
+			if(!isEqual(*src, *expected))
+			{
+				gDebug().logDebug("Mismatch converting " + PixelUtil::getFormatName(srcFormat) + " to sRGB");
+				allMatch = false;
+			}
+		}
+
+		BS_TEST_ASSERT(allMatch);
+
+		// Benchmark all the pairs, along with the per-pixel reference
+		const float numMegapixels = BENCHMARK_SIZE * BENCHMARK_SIZE / 1000000.0f;
+		auto toMPS = [numMegapixels](UINT64 time) 
+		{ 
+			const float seconds = std::max(time / 1000000.0f, 0.000001f);
+			return toString(numMegapixels / seconds, 0, 0, ' ', std::ios::fixed) + " MP/s";
+		};
+
+		gDebug().logDebug("Pixel conversion of " + toString(BENCHMARK_SIZE) + "x" + toString(BENCHMARK_SIZE) + 
+			" images:");
+		for(auto srcFormat : FORMATS)
+		{
+			SPtr<PixelData> src = createImage(srcFormat, BENCHMARK_SIZE, BENCHMARK_SIZE);
+			for(auto dstFormat : FORMATS)
+			{
+				if(srcFormat == dstFormat)
+					continue;
+
+				SPtr<PixelData> output = PixelData::create(BENCHMARK_SIZE, BENCHMARK_SIZE, 1, dstFormat);
+
+				Timer timer;
+				convertPerPixel(*src, *output, false);
+				const UINT64 referenceTime = timer.getMicroseconds();
+
+				timer.reset();
+				PixelUtil::bulkPixelConversion(*src, *output);
+				const UINT64 time = timer.getMicroseconds();
+
+				gDebug().logDebug("  " + PixelUtil::getFormatName(srcFormat) + " -> " + 
+					PixelUtil::getFormatName(dstFormat) + ": " + toMPS(time) + " (per-pixel " + 
+					toMPS(referenceTime) + ")");
+			}
+
+			Timer timer;
+			convertPerPixel(*src, *src, true);
+			const UINT64 referenceTime = timer.getMicroseconds();
+
+			timer.reset();
+			PixelUtil::linearToSRGB(*src);
+			const UINT64 time = timer.getMicroseconds();
+
+			gDebug().logDebug("  " + PixelUtil::getFormatName(srcFormat) + " linear -> sRGB: " + toMPS(time) + 
+				" (per-pixel " + toMPS(referenceTime) + ")");
+		}
+
+	}
+
+	void CoreTestSuite::testAnimationEvaluation()
+	{
+		static constexpr UINT32 NUM_BONES = 64;
+		static constexpr UINT32 NUM_CHARACTERS = 2000;
+		static constexpr UINT32 NUM_KEYFRAMES = 8;
+		static constexpr UINT32 OVERRIDE_BONE = 5;
+
+		Random random(4321);
+		auto randomRotation = [&random]()
+		{
+			return Quaternion(random.getUnitVector(), Radian(random.getUNorm() * Math::TWO_PI));
+		};
+
+		auto randomScale = [&random]()
+		{
+			return Vector3(0.5f + random.getUNorm(), 0.5f + random.getUNorm(), 0.5f + random.getUNorm());
+		};
+
+		// Build the hierarchy with parents before children, then shuffle the bones so that isn't the case anymore
+		UINT32 boneOrder[NUM_BONES];
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+			boneOrder[i] = i;
+
+		for(UINT32 i = NUM_BONES - 1; i > 0; i--)
+			std::swap(boneOrder[i], boneOrder[random.get() % (i + 1)]);
+
+		BONE_DESC bones[NUM_BONES];
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			BONE_DESC& bone = bones[boneOrder[i]];
+			bone.name = "Bone" + toString(boneOrder[i]);
+			bone.parent = i == 0 ? (UINT32)-1 : boneOrder[random.get() % i];
+			bone.localTfrm = Transform(random.getPointInSphere(), randomRotation(), randomScale());
+			bone.invBindPose = Matrix4::TRS(random.getPointInSphere(), randomRotation(), randomScale());
+		}
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones, NUM_BONES);
+
+		// Every few bones don't have curves, so they use the default transform
+		auto hasCurves = [](UINT32 boneIdx) { return (boneIdx % 4) != 1; };
+
+		// Two different clips, both with curves for the same bones
+		const UINT32 numClips = 2;
+		SPtr<AnimationCurves> curves[numClips];
+		Vector<AnimationCurveMapping> mapping(NUM_BONES);
+		for(UINT32 i = 0; i < numClips; i++)
+		{
+			curves[i] = bs_shared_ptr_new<AnimationCurves>();
+
+			UINT32 curveIdx = 0;
+			for(UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				if(!hasCurves(j))
+				{
+					mapping[j] = { (UINT32)-1, (UINT32)-1, (UINT32)-1 };
+					continue;
+				}
+
+				Vector<TKeyframe<Vector3>> positionKeys(NUM_KEYFRAMES);
+				Vector<TKeyframe<Quaternion>> rotationKeys(NUM_KEYFRAMES);
+				Vector<TKeyframe<Vector3>> scaleKeys(NUM_KEYFRAMES);
+				for(UINT32 k = 0; k < NUM_KEYFRAMES; k++)
+				{
+					const float time = (float)k;
+					positionKeys[k] = { random.getPointInSphere(), Vector3::ZERO, Vector3::ZERO, time };
+					rotationKeys[k] = { randomRotation(), Quaternion::ZERO, Quaternion::ZERO, time };
+					scaleKeys[k] = { randomScale(), Vector3::ZERO, Vector3::ZERO, time };
+				}
+
+				curves[i]->position.push_back({ bones[j].name, TAnimationCurve<Vector3>(positionKeys) });
+				curves[i]->rotation.push_back({ bones[j].name, TAnimationCurve<Quaternion>(rotationKeys) });
+				curves[i]->scale.push_back({ bones[j].name, TAnimationCurve<Vector3>(scaleKeys) });
+
+				mapping[j] = { curveIdx, curveIdx, curveIdx };
+				curveIdx++;
+			}
+		}
+
+		const UINT32 numCurves = (UINT32)curves[0]->position.size();
+
+		// Same mapping, except some bones have no rotation curve. Used for an additive layer evaluated before a regular
+		// one, where bones without a curve must remain unassigned for the regular layer to blend into.
+		Vector<AnimationCurveMapping> noRotationMapping = mapping;
+		for(UINT32 i = 0; i < NUM_BONES; i += 3)
+			noRotationMapping[i].rotation = (UINT32)-1;
+
+		/** Animation state of a single character, with two blended clips and one additive clip on top. */
+		struct Character
+		{
+			Vector<TCurveCache<Vector3>> positionCaches;
+			Vector<TCurveCache<Quaternion>> rotationCaches;
+			Vector<TCurveCache<Vector3>> scaleCaches;
+
+			AnimationState states[3];
+			AnimationStateLayer layers[2];
+			LocalSkeletonPose localPose;
+			Vector<Matrix4> pose;
+		};
+
+		auto createCharacter = [&](float time, bool additiveFirst = false)
+		{
+			SPtr<Character> character = bs_shared_ptr_new<Character>();
+			character->positionCaches.resize(numCurves * 3);
+			character->rotationCaches.resize(numCurves * 3);
+			character->scaleCaches.resize(numCurves * 3);
+			character->localPose = LocalSkeletonPose(NUM_BONES);
+			character->pose.resize(NUM_BONES);
+
+			const float weights[] = { 0.7f, 0.3f, 0.5f };
+			for(UINT32 i = 0; i < 3; i++)
+			{
+				AnimationState& state = character->states[i];
+				state.curves = curves[i % numClips];
+				state.boneToCurveMapping = mapping.data();
+				state.soToCurveMapping = nullptr;
+				state.positionCaches = &character->positionCaches[i * numCurves];
+				state.rotationCaches = &character->rotationCaches[i * numCurves];
+				state.scaleCaches = &character->scaleCaches[i * numCurves];
+				state.genericCaches = nullptr;
+				state.time = time + i * 0.37f;
+				state.weight = weights[i];
+				state.loop = true;
+				state.disabled = false;
+			}
+
+			AnimationStateLayer regularLayer = { &character->states[0], 2, 0, false };
+			AnimationStateLayer additiveLayer = { &character->states[2], 1, 1, true };
+
+			if(additiveFirst)
+			{
+				character->states[2].boneToCurveMapping = noRotationMapping.data();
+
+				character->layers[0] = additiveLayer;
+				character->layers[1] = regularLayer;
+			}
+			else
+			{
+				character->layers[0] = regularLayer;
+				character->layers[1] = additiveLayer;
+			}
+
+			return character;
+		};
+
+		// Sets up the overrides the same way AnimationManager does, with one bone transformed externally
+		const Matrix4 overrideTfrm = Matrix4::TRS(Vector3(1.0f, 2.0f, 3.0f), randomRotation(), Vector3::ONE);
+		auto prepareCharacter = [&](Character& character)
+		{
+			memset(character.localPose.hasOverride, 0, sizeof(bool) * NUM_BONES);
+			character.localPose.hasOverride[OVERRIDE_BONE] = true;
+			character.pose[OVERRIDE_BONE] = overrideTfrm;
+		};
+
+		// Evaluates the pose one bone at a time, as a reference for the optimized evaluation
+		auto getPoseReference = [&](Character& character)
+		{
+			LocalSkeletonPose& localPose = character.localPose;
+			Matrix4* pose = character.pose.data();
+
+			bool hasAnimCurve[NUM_BONES] = { };
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				localPose.positions[i] = Vector3::ZERO;
+				localPose.rotations[i] = Quaternion::ZERO;
+				localPose.scales[i] = Vector3::ONE;
+			}
+
+			for(auto& layer : character.layers)
+			{
+				float invLayerWeight = 1.0f;
+				if(layer.additive)
+				{
+					float weightSum = 0.0f;
+					for(UINT32 i = 0; i < layer.numStates; i++)
+						weightSum += layer.states[i].weight;
+
+					invLayerWeight = 1.0f / weightSum;
+				}
+
+				for(UINT32 i = 0; i < layer.numStates; i++)
+				{
+					const AnimationState& state = layer.states[i];
+					const float weight = state.weight * invLayerWeight;
+
+					for(UINT32 j = 0; j < NUM_BONES; j++)
+					{
+						const AnimationCurveMapping& curveMapping = state.boneToCurveMapping[j];
+						if(curveMapping.position == (UINT32)-1)
+							continue;
+
+						localPose.positions[j] += state.curves->position[curveMapping.position].curve.evaluate(
+							state.time, state.positionCaches[curveMapping.position], state.loop) * weight;
+						localPose.scales[j] *= state.curves->scale[curveMapping.scale].curve.evaluate(state.time, 
+							state.scaleCaches[curveMapping.scale], state.loop) * weight;
+
+						localPose.hasOverride[j] = false;
+						hasAnimCurve[j] = true;
+
+						if(curveMapping.rotation == (UINT32)-1)
+							continue;
+
+						Quaternion rotation = state.curves->rotation[curveMapping.rotation].curve.evaluate(state.time, 
+							state.rotationCaches[curveMapping.rotation], state.loop);
+						if(layer.additive)
+						{
+							if(localPose.rotations[j].w == 0.0f)
+								localPose.rotations[j] = Quaternion::IDENTITY;
+
+							localPose.rotations[j] *= Quaternion::lerp(weight, Quaternion::IDENTITY, rotation);
+						}
+						else
+						{
+							rotation = rotation * weight;
+							if(rotation.dot(localPose.rotations[j]) < 0.0f)
+								rotation = -rotation;
+
+							localPose.rotations[j] += rotation;
+						}
+					}
+				}
+			}
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				if(!hasAnimCurve[i])
+				{
+					localPose.positions[i] = bones[i].localTfrm.getPosition();
+					localPose.rotations[i] = bones[i].localTfrm.getRotation();
+					localPose.scales[i] = bones[i].localTfrm.getScale();
+				}
+
+				if(localPose.rotations[i].w == 0.0f)
+					localPose.rotations[i] = Quaternion::IDENTITY;
+				else
+					localPose.rotations[i].normalize();
+
+				if(!localPose.hasOverride[i])
+					pose[i] = Matrix4::TRS(localPose.positions[i], localPose.rotations[i], localPose.scales[i]);
+			}
+
+			bool isGlobal[NUM_BONES];
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+				isGlobal[i] = localPose.hasOverride[i];
+
+			std::function<void(UINT32)> calcGlobal = [&](UINT32 boneIdx)
+			{
+				const UINT32 parentIdx = bones[boneIdx].parent;
+				if(parentIdx != (UINT32)-1)
+				{
+					if(!isGlobal[parentIdx])
+						calcGlobal(parentIdx);
+
+					pose[boneIdx] = pose[parentIdx] * pose[boneIdx];
+				}
+
+				isGlobal[boneIdx] = true;
+			};
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+			{
+				if(!isGlobal[i])
+					calcGlobal(i);
+			}
+
+			for(UINT32 i = 0; i < NUM_BONES; i++)
+				pose[i] = pose[i] * bones[i].invBindPose;
+		};
+
+		SkeletonMask mask(NUM_BONES);
+		auto getPose = [&](Character& character)
+		{
+			skeleton->getPose(character.pose.data(), character.localPose, mask, character.layers, 2);
+		};
+
+		// Optimized evaluation must match the reference, up to floating point precision. Every other iteration 
+		// evaluates the additive layer first.
+		bool allMatch = true;
+		for(UINT32 i = 0; i < 16; i++)
+		{
+			const float time = (i / 2) * 0.93f;
+			const bool additiveFirst = (i % 2) != 0;
+
+			SPtr<Character> expected = createCharacter(time, additiveFirst);
+			prepareCharacter(*expected);
+			getPoseReference(*expected);
+
+			SPtr<Character> output = createCharacter(time, additiveFirst);
+			prepareCharacter(*output);
+			getPose(*output);
+
+			for(UINT32 j = 0; j < NUM_BONES; j++)
+			{
+				for(UINT32 k = 0; k < 4; k++)
+				{
+					for(UINT32 l = 0; l < 4; l++)
+					{
+						const float a = expected->pose[j][k][l];
+						const float b = output->pose[j][k][l];
+
+						if(!Math::approxEquals(a, b, 0.0001f * std::max(1.0f, Math::abs(a))))
+							allMatch = false;
+					}
+				}
+
+				if(!Math::approxEquals(expected->localPose.rotations[j], output->localPose.rotations[j], 0.0001f) ||
+					!Math::approxEquals(expected->localPose.positions[j], output->localPose.positions[j], 0.0001f))
+					allMatch = false;
+			}
+		}
+
+		BS_TEST_ASSERT(allMatch);
+
+		// Benchmark a crowd of characters, each playing its clips at a different time
+		Vector<SPtr<Character>> crowd(NUM_CHARACTERS);
+		for(UINT32 i = 0; i < NUM_CHARACTERS; i++)
+		{
+			crowd[i] = createCharacter(random.getUNorm() * NUM_KEYFRAMES);
+			prepareCharacter(*crowd[i]);
+		}
+
+		auto toCharactersPerMs = [](UINT64 time)
+		{
+			const float ms = std::max(time / 1000.0f, 0.001f);
+			return toString(NUM_CHARACTERS / ms, 1, 0, ' ', std::ios::fixed) + " characters/ms";
+		};
+
+		Timer timer;
+		for(auto& character : crowd)
+			getPoseReference(*character);
+
+		const UINT64 referenceTime = timer.getMicroseconds();
+
+		timer.reset();
+		for(auto& character : crowd)
+			getPose(*character);
+
+		const UINT64 singleThreadedTime = timer.getMicroseconds();
+
+		// Same crowd evaluated by the animation manager, which evaluates animations in batches across tasks
+		const HAnimationClip clip = AnimationClip::create(curves[0]);
+		const HAnimationClip additiveClip = AnimationClip::create(curves[1], true);
+
+		Vector<SPtr<Animation>> animations(NUM_CHARACTERS);
+		for(UINT32 i = 0; i < NUM_CHARACTERS; i++)
+		{
+			animations[i] = Animation::create();
+			animations[i]->setSkeleton(skeleton);
+			animations[i]->setCulling(false);
+			animations[i]->play(clip);
+			animations[i]->blendAdditive(additiveClip, 0.5f, 0.0f, 1);
+
+			AnimationClipState state;
+			animations[i]->getState(clip, state);
+			state.time = random.getUNorm() * NUM_KEYFRAMES;
+			animations[i]->setState(clip, state);
+		}
+
+		// The first update builds the animation proxies, so it isn't timed. Updates are performed only if enough time has 
+		// passed since the last one, so advance the time before each.
+		AnimationManager& animationManager = AnimationManager::instance();
+		animationManager.setUpdateRate(std::numeric_limits<UINT32>::max());
+
+		gTime()._update();
+		animationManager.update(false);
+		gTime()._update();
+
+		timer.reset();
+		animationManager.update(false);
+		const UINT64 batchedTime = timer.getMicroseconds();
+
+		animations.clear();
+
+		gDebug().logDebug("Animation evaluation of " + toString(NUM_CHARACTERS) + " characters with " + 
+			toString(NUM_BONES) + " bones: " + toCharactersPerMs(batchedTime) + " batched by AnimationManager, " + 
+			toCharactersPerMs(singleThreadedTime) + " single threaded (per-bone reference " + 
+			toCharactersPerMs(referenceTime) + ")");
+	}
+
+	void CoreTestSuite::testAnimationKeyPoseInterpolation()
+	{
+		static constexpr float EPSILON = 0.0001f;
+
+		// A bone rotating by a large angle between two key poses, as with long LOD update intervals
+		const Vector3 position(1.0f, 2.0f, 3.0f);
+		const AnimationKeyPoseBone from(Matrix4::TRS(position, Quaternion::IDENTITY, Vector3::ONE));
+		const AnimationKeyPoseBone to(Matrix4::TRS(position + Vector3(0.0f, 1.0f, 0.0f), 
+			Quaternion(Degree(30.0f), Degree(120.0f), Degree(0.0f)), Vector3::ONE));
+
+		BS_TEST_ASSERT(from.isDecomposed && to.isDecomposed);
+
+		// Interpolated bones must remain rigid, with no shrinking or shearing
+		bool isOrthonormal = true;
+		for(UINT32 i = 0; i <= 10; i++)
+		{
+			const Matrix4 transform = AnimationKeyPoseBone::interpolate(from, to, i / 10.0f);
+			const Vector3 axes[3] =
+			{
+				Vector3(transform[0][0], transform[1][0], transform[2][0]),
+				Vector3(transform[0][1], transform[1][1], transform[2][1]),
+				Vector3(transform[0][2], transform[1][2], transform[2][2])
+			};
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				isOrthonormal &= Math::abs(axes[j].length() - 1.0f) < EPSILON;
+				isOrthonormal &= Math::abs(axes[j].dot(axes[(j + 1) % 3])) < EPSILON;
+			}
+		}
+
+		BS_TEST_ASSERT(isOrthonormal);
+
+		// End points match the key poses
+		const Matrix4 end = AnimationKeyPoseBone::interpolate(from, to, 1.0f);
+
+		bool endMatches = true;
+		for(UINT32 row = 0; row < 4; row++)
+		{
+			for(UINT32 column = 0; column < 4; column++)
+				endMatches &= Math::abs(end[row][column] - to.transform[row][column]) < EPSILON;
+		}
+
+		BS_TEST_ASSERT(endMatches);
+
+		// Sheared matrices can't be decomposed, and are blended as they are
+		Matrix4 shear = Matrix4::IDENTITY;
+		shear[0][1] = 0.5f;
+
+		const AnimationKeyPoseBone sheared(shear);
+		BS_TEST_ASSERT(!sheared.isDecomposed);
+		BS_TEST_ASSERT(Math::abs(AnimationKeyPoseBone::interpolate(sheared, sheared, 0.5f)[0][1] - 0.5f) < EPSILON);
+	}
+
+	void CoreTestSuite::testAnimationLOD()
+	{
+		static constexpr float EPSILON = 0.001f;
+		static constexpr UINT32 UPDATE_INTERVAL = 4;
+		static constexpr UINT32 NUM_FRAMES = 20;
+
+		// Root bone, with three children: one overridden by a scene object, one with an attached scene object, and one
+		// disabled by the LOD mask
+		BONE_DESC bones[4];
+		for(UINT32 i = 0; i < 4; i++)
+		{
+			bones[i].name = "Bone" + toString(i);
+			bones[i].parent = i == 0 ? (UINT32)-1 : 0;
+			bones[i].localTfrm = Transform::IDENTITY;
+			bones[i].invBindPose = Matrix4::IDENTITY;
+		}
+
+		const Vector3 maskedBonePosition(0.0f, 0.0f, 5.0f);
+		bones[3].localTfrm = Transform(maskedBonePosition, Quaternion::IDENTITY, Vector3::ONE);
+
+		SPtr<Skeleton> skeleton = Skeleton::create(bones, 4);
+
+		// Bones move linearly with time, so the time an output pose was evaluated at can be determined from it
+		auto linearCurve = [](const Vector3& direction)
+		{
+			Vector<TKeyframe<Vector3>> keys = 
+			{
+				{ Vector3::ZERO, direction, direction, 0.0f },
+				{ direction * 100.0f, direction, direction, 100.0f }
+			};
+
+			return TAnimationCurve<Vector3>(keys);
+		};
+
+		SPtr<AnimationCurves> curves = bs_shared_ptr_new<AnimationCurves>();
+		curves->position.push_back({ "Bone0", linearCurve(Vector3(1.0f, 0.0f, 0.0f)) });
+		curves->position.push_back({ "Bone2", linearCurve(Vector3(0.0f, 0.0f, 2.0f)) });
+		curves->position.push_back({ "Bone3", linearCurve(Vector3(0.0f, 1.0f, 0.0f)) });
+
+		const Quaternion additiveRotation(Degree(0.0f), Degree(90.0f), Degree(0.0f));
+		Vector<TKeyframe<Quaternion>> rotationKeys = 
+		{
+			{ additiveRotation, Quaternion::ZERO, Quaternion::ZERO, 0.0f },
+			{ additiveRotation, Quaternion::ZERO, Quaternion::ZERO, 100.0f }
+		};
+
+		SPtr<AnimationCurves> additiveCurves = bs_shared_ptr_new<AnimationCurves>();
+		additiveCurves->rotation.push_back({ "Bone0", TAnimationCurve<Quaternion>(rotationKeys) });
+
+		const HAnimationClip clip = AnimationClip::create(curves);
+		const HAnimationClip additiveClip = AnimationClip::create(additiveCurves, true);
+
+		// There are no cameras, so the most distant level is always used
+		SkeletonMaskBuilder maskBuilder(skeleton);
+		maskBuilder.setBoneState("Bone3", false);
+
+		AnimationLODLevel lod;
+		lod.updateInterval = UPDATE_INTERVAL;
+		lod.skipAdditiveLayers = true;
+		lod.mask = maskBuilder.getMask();
+
+		HSceneObject overrideSO = SceneObject::create("Override");
+		HSceneObject attachedSO = SceneObject::create("Attached");
+
+		SPtr<Animation> animation = Animation::create();
+		animation->setSkeleton(skeleton);
+		animation->setCulling(false);
+		animation->setSpeed(0.0f);
+		animation->setLODLevels({ lod });
+		animation->mapCurveToSceneObject("Bone1", overrideSO);
+		animation->mapCurveToSceneObject("Bone2", attachedSO);
+		animation->play(clip);
+		animation->blendAdditive(additiveClip, 1.0f, 0.0f, 1);
+
+		AnimationManager& animationManager = AnimationManager::instance();
+		animationManager.setUpdateRate(std::numeric_limits<UINT32>::max());
+
+		bool throttledPoseMatches = true;
+		bool additiveSkipped = true;
+		bool maskApplied = true;
+		bool overrideApplied = true;
+		bool attachedMatches = true;
+
+		Vector3 prevOverridePosition;
+		Vector3 prevAttachedPosition;
+		for(UINT32 i = 0; i < NUM_FRAMES; i++)
+		{
+			AnimationClipState state;
+			animation->getState(clip, state);
+			state.time = (float)i;
+			state.speed = 0.0f;
+			animation->setState(clip, state);
+
+			const Vector3 overridePosition(0.0f, 7.0f + i, 0.0f);
+			overrideSO->setWorldPosition(overridePosition);
+
+			// Updates are skipped unless time has advanced since the last one
+			do
+			{
+				gTime()._update();
+			} while(gTime().getFrameDelta() <= 0.0f);
+
+			// Returned data is the data evaluated by the previous update
+			const EvaluatedAnimationData* data = animationManager.update(false);
+
+			// Wait until enough key poses were evaluated for the output to trail them by exactly one interval
+			if(i > UPDATE_INTERVAL * 2 + 1)
+			{
+				auto iterFind = data->infos.find(animation->_getId());
+				BS_TEST_ASSERT(iterFind != data->infos.end());
+
+				const Matrix4* pose = data->transforms.data() + iterFind->second.poseInfo.startIdx;
+				const float time = (float)(i - 1) - UPDATE_INTERVAL;
+
+				throttledPoseMatches &= Math::approxEquals(pose[0].getTranslation(), Vector3(time, 0.0f, 0.0f), 
+					EPSILON);
+				additiveSkipped &= Math::approxEquals(pose[0].multiplyDirection(Vector3::UNIT_X), Vector3::UNIT_X,
+					EPSILON);
+				maskApplied &= Math::approxEquals(pose[3].getTranslation(), Vector3(time, 0.0f, 0.0f) + 
+					maskedBonePosition, EPSILON);
+				overrideApplied &= Math::approxEquals(pose[1].getTranslation(), prevOverridePosition, EPSILON);
+				attachedMatches &= Math::approxEquals(pose[2].getTranslation(), prevAttachedPosition, EPSILON);
+			}
+
+			prevOverridePosition = overridePosition;
+			prevAttachedPosition = attachedSO->getTransform().getPosition();
+		}
+
+		BS_TEST_ASSERT(throttledPoseMatches);
+		BS_TEST_ASSERT(additiveSkipped);
+		BS_TEST_ASSERT(maskApplied);
+		BS_TEST_ASSERT(overrideApplied);
+		BS_TEST_ASSERT(attachedMatches);
+
+		animation = nullptr;
+		overrideSO->destroy(true);
+		attachedSO->destroy(true);
+	}
+
+	void CoreTestSuite::testAnimationCompression()
+	{
+		static constexpr UINT32 NUM_BONES = 64;
+		static constexpr UINT32 NUM_SAMPLES = 600;
+		static constexpr UINT32 NUM_INSTANCES = 200;
+		static constexpr UINT32 NUM_FRAMES = 60;
+		static constexpr float SAMPLE_RATE = 60.0f;
+		static constexpr float MAX_ERROR = 0.0001f;
+		static constexpr float MAX_QUANTIZATION_ERROR = 0.001f;
+
+		Random random(1234);
+
+		// Baked curves the way the importer outputs them, with a key every sample and tangents following the motion.
+		// Every few bones have constant position and scale, which is common for bones that only rotate.
+		AnimationCurves curves;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			const bool isConstant = (i % 4) == 3;
+			const Vector3 amplitude = random.getPointInSphere();
+			const Vector3 frequency(0.5f + random.getUNorm(), 0.5f + random.getUNorm(), 0.5f + random.getUNorm());
+			const Vector3 axis = random.getUnitVector();
+			const float angularSpeed = random.getUNorm() * Math::PI;
+
+			Vector<TKeyframe<Vector3>> positionKeys(NUM_SAMPLES);
+			Vector<TKeyframe<Quaternion>> rotationKeys(NUM_SAMPLES);
+			Vector<TKeyframe<Vector3>> scaleKeys(NUM_SAMPLES);
+			for(UINT32 j = 0; j < NUM_SAMPLES; j++)
+			{
+				const float time = j / SAMPLE_RATE;
+
+				Vector3 position = amplitude;
+				Vector3 positionTangent = Vector3::ZERO;
+				if(!isConstant)
+				{
+					for(UINT32 k = 0; k < 3; k++)
+					{
+						position[k] = amplitude[k] * std::sin(frequency[k] * time);
+						positionTangent[k] = amplitude[k] * frequency[k] * std::cos(frequency[k] * time);
+					}
+				}
+
+				// Derivative of a rotation around a fixed axis is the same rotation offset by half a turn
+				const float angle = angularSpeed * time;
+				const Quaternion rotation(axis, Radian(angle));
+				const Quaternion rotationTangent = Quaternion(axis, Radian(angle + Math::PI)) * (angularSpeed * 0.5f);
+
+				Vector3 scale = Vector3::ONE;
+				Vector3 scaleTangent = Vector3::ZERO;
+				if(!isConstant)
+				{
+					scale += Vector3::ONE * (0.1f * std::sin(time));
+					scaleTangent = Vector3::ONE * (0.1f * std::cos(time));
+				}
+
+				positionKeys[j] = { position, positionTangent, positionTangent, time };
+				rotationKeys[j] = { rotation, rotationTangent, rotationTangent, time };
+				scaleKeys[j] = { scale, scaleTangent, scaleTangent, time };
+			}
+
+			const String name = "Bone" + toString(i);
+			curves.position.push_back({ name, TAnimationCurve<Vector3>(positionKeys) });
+			curves.rotation.push_back({ name, TAnimationCurve<Quaternion>(rotationKeys) });
+			curves.scale.push_back({ name, TAnimationCurve<Vector3>(scaleKeys) });
+		}
+
+		AnimationCurves reducedCurves = curves;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			reducedCurves.position[i].curve = curves.position[i].curve.reduce(MAX_ERROR);
+			reducedCurves.rotation[i].curve = curves.rotation[i].curve.reduce(MAX_ERROR);
+			reducedCurves.scale[i].curve = curves.scale[i].curve.reduce(MAX_ERROR);
+		}
+
+		const CompressedAnimationCurves compressedCurves(reducedCurves);
+
+		// Largest difference between any of the components of two values
+		auto getError = [](const auto& a, const auto& b, UINT32 numComponents)
+		{
+			float error = 0.0f;
+			for(UINT32 i = 0; i < numComponents; i++)
+				error = std::max(error, Math::abs(a[i] - b[i]));
+
+			return error;
+		};
+
+		// Reduced curves must stay within the error at the original keys and in-between them. Compressed curves must
+		// match the curves they were created from, up to the quantization error, including outside of the curve range.
+		float reductionError = 0.0f;
+		float quantizationError = 0.0f;
+		UINT32 numKeys = 0;
+		UINT32 numReducedKeys = 0;
+		for(UINT32 i = 0; i < NUM_BONES; i++)
+		{
+			TCurveCache<Vector3> positionCaches[2];
+			TCurveCache<Quaternion> rotationCaches[2];
+			TCurveCache<Vector3> scaleCaches[2];
+
+			for(INT32 j = -(INT32)NUM_SAMPLES / 4; j < (INT32)(NUM_SAMPLES * 5) / 4; j++)
+			{
+				const float time = j / SAMPLE_RATE;
+
+				if(j >= 0 && j < (INT32)NUM_SAMPLES)
+				{
+					for(float sampleTime : { time, time + 0.5f / SAMPLE_RATE })
+					{
+						reductionError = std::max(reductionError, getError(
+							curves.position[i].curve.evaluate(sampleTime, false),
+							reducedCurves.position[i].curve.evaluate(sampleTime, false), 3));
+						reductionError = std::max(reductionError, getError(
+							curves.rotation[i].curve.evaluate(sampleTime, false),
+							reducedCurves.rotation[i].curve.evaluate(sampleTime, false), 4));
+						reductionError = std::max(reductionError, getError(
+							curves.scale[i].curve.evaluate(sampleTime, false),
+							reducedCurves.scale[i].curve.evaluate(sampleTime, false), 3));
+					}
+				}
+
+				quantizationError = std::max(quantizationError, getError(
+					reducedCurves.position[i].curve.evaluate(time, positionCaches[0], true),
+					compressedCurves.position[i].evaluate(time, positionCaches[1], true), 3));
+				quantizationError = std::max(quantizationError, getError(
+					reducedCurves.rotation[i].curve.evaluate(time, rotationCaches[0], true),
+					compressedCurves.rotation[i].evaluate(time, rotationCaches[1], true), 4));
+				quantizationError = std::max(quantizationError, getError(
+					reducedCurves.scale[i].curve.evaluate(time, scaleCaches[0], true),
+					compressedCurves.scale[i].evaluate(time, scaleCaches[1], true), 3));
+			}
+
+			numKeys += curves.position[i].curve.getNumKeyFrames() + curves.rotation[i].curve.getNumKeyFrames() +
+				curves.scale[i].curve.getNumKeyFrames();
+			numReducedKeys += reducedCurves.position[i].curve.getNumKeyFrames() +
+				reducedCurves.rotation[i].curve.getNumKeyFrames() + reducedCurves.scale[i].curve.getNumKeyFrames();
+
+			BS_TEST_ASSERT(compressedCurves.rotation[i].getNumKeyFrames() ==
+				reducedCurves.rotation[i].curve.getNumKeyFrames());
+			BS_TEST_ASSERT(compressedCurves.rotation[i].decompress().getNumKeyFrames() ==
+				reducedCurves.rotation[i].curve.getNumKeyFrames());
+		}
+
+		BS_TEST_ASSERT(reductionError <= MAX_ERROR * 1.01f);
+		BS_TEST_ASSERT(quantizationError <= MAX_QUANTIZATION_ERROR);
+		BS_TEST_ASSERT(numReducedKeys * 4 < numKeys);
+
+		// Step keys must be preserved by both the reduction and compression
+		{
+			const float inf = std::numeric_limits<float>::infinity();
+			Vector<TKeyframe<float>> stepKeys(8);
+			for(UINT32 i = 0; i < (UINT32)stepKeys.size(); i++)
+				stepKeys[i] = { (float)(i % 3), inf, inf, (float)i };
+
+			const TAnimationCurve<float> stepCurve = TAnimationCurve<float>(stepKeys).reduce(MAX_ERROR);
+			const TCompressedAnimationCurve<float> compressedStepCurve(stepCurve);
+
+			BS_TEST_ASSERT(stepCurve.getNumKeyFrames() == (UINT32)stepKeys.size());
+
+			TCurveCache<float> cache;
+			for(UINT32 i = 0; i < (UINT32)stepKeys.size() * 4; i++)
+			{
+				const float time = i * 0.25f;
+				const float expected = stepKeys[std::min(i / 4, (UINT32)stepKeys.size() - 1)].value;
+
+				BS_TEST_ASSERT(Math::approxEquals(compressedStepCurve.evaluate(time, cache, false), expected,
+					MAX_QUANTIZATION_ERROR));
+			}
+		}
+
+		// Keys spaced more closely than the time quantization step of a long curve must remain distinct
+		{
+			const float inf = std::numeric_limits<float>::infinity();
+			Vector<TKeyframe<float>> denseKeys(16);
+			for(UINT32 i = 0; i < (UINT32)denseKeys.size() - 1; i++)
+				denseKeys[i] = { (float)i, inf, inf, i * 0.01f };
+
+			denseKeys.back() = { (float)(denseKeys.size() - 1), inf, inf, 10000.0f };
+
+			const TCompressedAnimationCurve<float> compressedDenseCurve((TAnimationCurve<float>(denseKeys)));
+			const TAnimationCurve<float> decompressedDenseCurve = compressedDenseCurve.decompress();
+
+			BS_TEST_ASSERT(decompressedDenseCurve.getNumKeyFrames() == (UINT32)denseKeys.size());
+			for(UINT32 i = 0; i < (UINT32)denseKeys.size(); i++)
+			{
+				const TKeyframe<float>& key = decompressedDenseCurve.getKeyFrame(i);
+				BS_TEST_ASSERT(key.time == denseKeys[i].time);
+
+				if(i > 0)
+					BS_TEST_ASSERT(key.time > decompressedDenseCurve.getKeyFrame(i - 1).time);
+			}
+
+			TCurveCache<float> cache;
+			for(UINT32 i = 0; i < (UINT32)denseKeys.size() - 1; i++)
+			{
+				BS_TEST_ASSERT(Math::approxEquals(compressedDenseCurve.evaluate(denseKeys[i].time, cache, false),
+					denseKeys[i].value, MAX_QUANTIZATION_ERROR));
+			}
+		}
+
+		// Looped evaluation outside of the curve range must wrap the same way as the uncompressed curve
+		{
+			const Vector<TKeyframe<float>> loopKeys =
+			{
+				{ 1.0f, 0.0f, 0.0f, 0.0f },
+				{ 3.0f, 0.0f, 0.0f, 1.0f },
+				{ -2.0f, 0.0f, 0.0f, 2.0f },
+			};
+
+			const TAnimationCurve<float> loopCurve(loopKeys);
+			const TCompressedAnimationCurve<float> compressedLoopCurve(loopCurve);
+
+			TCurveCache<float> cache;
+			TCurveCache<float> compressedCache;
+			for(INT32 i = -40; i < 40; i++)
+			{
+				const float time = i * 0.15f;
+
+				BS_TEST_ASSERT(Math::approxEquals(compressedLoopCurve.evaluate(time, compressedCache),
+					loopCurve.evaluate(time, cache), MAX_QUANTIZATION_ERROR * 3.0f));
+			}
+		}
+
+		// Report memory use
+		auto getMemorySize = [](const AnimationCurves& curves)
+		{
+			UINT32 size = 0;
+			for(auto& entry : curves.position)
+				size += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+
+			for(auto& entry : curves.rotation)
+				size += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Quaternion>);
+
+			for(auto& entry : curves.scale)
+				size += entry.curve.getNumKeyFrames() * sizeof(TKeyframe<Vector3>);
+
+			return size;
+		};
+
+		auto toKB = [](UINT32 size) { return toString(size / 1024.0f, 1, 0, ' ', std::ios::fixed) + " KB"; };
+
+		gDebug().logDebug("Animation curves of " + toString(NUM_BONES) + " bones with " + toString(NUM_SAMPLES) +
+			" samples: " + toKB(getMemorySize(curves)) + " baked (" + toString(numKeys) + " keys), " +
+			toKB(getMemorySize(reducedCurves)) + " reduced (" + toString(numReducedKeys) + " keys), " +
+			toKB(compressedCurves.getMemorySize()) + " reduced and compressed");
+
+		// Benchmark playback of many instances of the clip at different times, evaluating all bones every frame
+		struct Instance
+		{
+			Vector<TCurveCache<Vector3>> positionCaches;
+			Vector<TCurveCache<Quaternion>> rotationCaches;
+			Vector<TCurveCache<Vector3>> scaleCaches;
+			float time;
+		};
+
+		Vector<float> startTimes(NUM_INSTANCES);
+		for(UINT32 i = 0; i < NUM_INSTANCES; i++)
+			startTimes[i] = random.getUNorm() * NUM_SAMPLES / SAMPLE_RATE;
+
+		auto benchmark = [&](auto evaluate)
+		{
+			Vector<Instance> instances(NUM_INSTANCES);
+			for(UINT32 i = 0; i < NUM_INSTANCES; i++)
+			{
+				instances[i].positionCaches.resize(NUM_BONES);
+				instances[i].rotationCaches.resize(NUM_BONES);
+				instances[i].scaleCaches.resize(NUM_BONES);
+				instances[i].time = startTimes[i];
+			}
+
+			Vector3 sum = Vector3::ZERO;
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_FRAMES; i++)
+			{
+				for(auto& instance : instances)
+				{
+					for(UINT32 j = 0; j < NUM_BONES; j++)
+						sum += evaluate(instance, j);
+
+					instance.time += 1.0f / SAMPLE_RATE;
+				}
+			}
+
+			const UINT64 time = timer.getMicroseconds();
+
+			// Make sure the evaluation isn't optimized away
+			if(sum.x == std::numeric_limits<float>::infinity())
+				gDebug().logDebug("");
+
+			const float ms = std::max(time / 1000.0f, 0.001f);
+			return toString((NUM_INSTANCES * NUM_FRAMES * NUM_BONES) / ms, 1, 0, ' ', std::ios::fixed) + " bones/ms";
+		};
+
+		auto evaluateCurves = [](const AnimationCurves& curves, Instance& instance, UINT32 idx)
+		{
+			const Vector3 position = curves.position[idx].curve.evaluate(instance.time, instance.positionCaches[idx]);
+			const Quaternion rotation = curves.rotation[idx].curve.evaluate(instance.time,
+				instance.rotationCaches[idx]);
+			const Vector3 scale = curves.scale[idx].curve.evaluate(instance.time, instance.scaleCaches[idx]);
+
+			return position + scale + Vector3(rotation.x, rotation.y, rotation.z);
+		};
+
+		const String bakedSpeed = benchmark([&](Instance& instance, UINT32 idx)
+		{
+			return evaluateCurves(curves, instance, idx);
+		});
+
+		const String reducedSpeed = benchmark([&](Instance& instance, UINT32 idx)
+		{
+			return evaluateCurves(reducedCurves, instance, idx);
+		});
+
+		const String compressedSpeed = benchmark([&](Instance& instance, UINT32 idx)
+		{
+			const Vector3 position = compressedCurves.position[idx].evaluate(instance.time,
+				instance.positionCaches[idx]);
+			const Quaternion rotation = compressedCurves.rotation[idx].evaluate(instance.time,
+				instance.rotationCaches[idx]);
+			const Vector3 scale = compressedCurves.scale[idx].evaluate(instance.time, instance.scaleCaches[idx]);
+
+			return position + scale + Vector3(rotation.x, rotation.y, rotation.z);
+		});
+
+		gDebug().logDebug("Animation curve evaluation of " + toString(NUM_INSTANCES) + " instances: " + bakedSpeed +
+			" baked, " + reducedSpeed + " reduced, " + compressedSpeed + " reduced and compressed");
+	}
+
+	void CoreTestSuite::testParticleSimulation()
+	{
+		static constexpr UINT32 NUM_PARTICLES = 500000;
+		static constexpr UINT32 NUM_FRAMES = 10;
+		static constexpr UINT32 BATCH_SIZE = 256;
+		static constexpr UINT32 GRAIN_SIZE = 4096;
+		static constexpr float TIME_STEP = 1.0f / 60.0f;
+		static constexpr UINT32 FORCE_SEED = 0x1b618144;
+		static constexpr UINT32 SIZE_SEED = 0x91088409;
+		static constexpr UINT32 COLOR_SEED = 0x378578b2;
+
+		const Vector3 gravity(0.0f, -9.81f, 0.0f);
+		const Vector3 minForce(-1.0f, 0.0f, -2.0f);
+		const Vector3 maxForce(1.0f, 5.0f, 0.5f);
+		const float minSize = 0.1f;
+		const float maxSize = 0.4f;
+		const RGBA minColor = Color(1.0f, 0.5f, 0.0f, 1.0f).getAsRGBA();
+		const RGBA maxColor = Color(0.2f, 0.1f, 0.9f, 0.0f).getAsRGBA();
+
+		struct Particles
+		{
+			Vector<Vector3> position;
+			Vector<Vector3> velocity;
+			Vector<float> size;
+			Vector<RGBA> color;
+		};
+
+		Random random(1234);
+		Vector<UINT32> seeds(NUM_PARTICLES);
+		Particles initial;
+		initial.position.resize(NUM_PARTICLES);
+		initial.velocity.resize(NUM_PARTICLES);
+		initial.size.resize(NUM_PARTICLES);
+		initial.color.resize(NUM_PARTICLES);
+
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+		{
+			seeds[i] = random.get();
+			initial.position[i] = random.getPointInSphere() * 10.0f;
+			initial.velocity[i] = random.getUnitVector() * 2.0f;
+		}
+
+		// Same as the per-particle code used by the evolvers when the kernels can't be used
+		auto simulateReference = [&](Particles& particles, UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+			{
+				particles.velocity[i] += gravity * TIME_STEP;
+
+				const Vector3 force = Math::lerp(Random(seeds[i] + FORCE_SEED).getUNorm(), minForce, maxForce);
+				particles.velocity[i] += force * TIME_STEP;
+				particles.position[i] += particles.velocity[i] * TIME_STEP;
+
+				particles.size[i] = Math::lerp(Random(seeds[i] + SIZE_SEED).getUNorm(), minSize, maxSize);
+
+				const UINT32 byteFactor = Bitwise::unormToUint<8>(Random(seeds[i] + COLOR_SEED).getUNorm());
+				particles.color[i] = Color::lerp((UINT8)byteFactor, minColor, maxColor);
+			}
+		};
+
+		auto simulate = [&](Particles& particles, UINT32 begin, UINT32 end)
+		{
+			float factors[BATCH_SIZE];
+			Vector3 forces[BATCH_SIZE];
+			for(UINT32 i = begin; i < end; i += BATCH_SIZE)
+			{
+				const UINT32 count = std::min(BATCH_SIZE, end - i);
+
+				ParticleKernels::add(&particles.velocity[i], gravity * TIME_STEP, count);
+
+				ParticleKernels::randomUNorm(&seeds[i], FORCE_SEED, factors, count);
+				ParticleKernels::lerp(factors, minForce, maxForce, forces, count);
+				ParticleKernels::integrate(&particles.velocity[i], forces, TIME_STEP, count);
+				ParticleKernels::integrate(&particles.position[i], &particles.velocity[i], TIME_STEP, count);
+
+				ParticleKernels::randomUNorm(&seeds[i], SIZE_SEED, &particles.size[i], count);
+				ParticleKernels::lerp(&particles.size[i], minSize, maxSize, count);
+
+				ParticleKernels::randomUNorm(&seeds[i], COLOR_SEED, factors, count);
+				ParticleKernels::lerp(factors, minColor, maxColor, &particles.color[i], count);
+			}
+		};
+
+		auto simulateParallel = [&](Particles& particles, UINT32 begin, UINT32 end)
+		{
+			TaskScheduler::instance().parallelFor(begin, end, GRAIN_SIZE, [&](UINT32 chunkBegin, UINT32 chunkEnd)
+			{
+				simulate(particles, chunkBegin, chunkEnd);
+			});
+		};
+
+		auto benchmark = [&](Particles& particles, auto simulateFrame)
+		{
+			particles = initial;
+
+			Timer timer;
+			for(UINT32 i = 0; i < NUM_FRAMES; i++)
+				simulateFrame(particles, 0, NUM_PARTICLES);
+
+			return timer.getMicroseconds();
+		};
+
+		Particles reference;
+		Particles vectorized;
+		Particles parallel;
+
+		const UINT64 referenceTime = benchmark(reference, simulateReference);
+		const UINT64 vectorizedTime = benchmark(vectorized, simulate);
+		const UINT64 parallelTime = benchmark(parallel, simulateParallel);
+
+		// Kernels must produce the same results as the per-particle code, regardless of how the particles are split
+		bool allMatch = true;
+		for(UINT32 i = 0; i < NUM_PARTICLES && allMatch; i++)
+		{
+			for(auto& entry : { &vectorized, &parallel })
+			{
+				allMatch &= entry->position[i] == reference.position[i];
+				allMatch &= entry->velocity[i] == reference.velocity[i];
+				allMatch &= entry->size[i] == reference.size[i];
+				allMatch &= entry->color[i] == reference.color[i];
+			}
+		}
+
+		BS_TEST_ASSERT(allMatch);
+
+		// Plane contacts must match the per-particle distance test
+		Plane planes[2] = { Plane(Vector3::UNIT_Y, -5.0f), Plane(Vector3::normalize(Vector3(1.0f, 0.0f, 1.0f)), 4.0f) };
+		const float radius = 0.5f;
+
+		Vector<UINT32> contacts(Math::divideAndRoundUp(NUM_PARTICLES, 32U));
+		ParticleKernels::findPlaneContacts(reference.position.data(), NUM_PARTICLES, planes, 2, radius, contacts.data());
+
+		bool contactsMatch = true;
+		for(UINT32 i = 0; i < NUM_PARTICLES; i++)
+		{
+			const bool isContact = planes[0].getDistance(reference.position[i]) <= radius ||
+				planes[1].getDistance(reference.position[i]) <= radius;
+
+			contactsMatch &= isContact == ((contacts[i / 32] & (1U << (i % 32))) != 0);
+		}
+
+		BS_TEST_ASSERT(contactsMatch);
+
+		auto toParticlesPerMs = [](UINT64 time)
+		{
+			const float ms = std::max(time / 1000.0f, 0.001f);
+			return toString((NUM_PARTICLES * NUM_FRAMES) / ms, 1, 0, ' ', std::ios::fixed) + " particles/ms";
+		};
+
+		gDebug().logDebug("Particle simulation of " + toString(NUM_PARTICLES) + " particles: " + 
+			toParticlesPerMs(parallelTime) + " vectorized and parallel, " + toParticlesPerMs(vectorizedTime) + 
+			" vectorized, " + toParticlesPerMs(referenceTime) + " per-particle reference");
+	}
+
+	void CoreTestSuite::testSceneActorUpdates()
+	{
+		static constexpr UINT32 NUM_STATIC = 100000;
+		static constexpr UINT32 NUM_MOVABLE = 1000;
+		static constexpr UINT32 NUM_OBJECTS = NUM_STATIC + NUM_MOVABLE;
+
+		Vector<HSceneObject> objects;
+		Vector<SPtr<TestSceneActor>> actors;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			HSceneObject so = SceneObject::create("SceneActor");
+			if(i < NUM_STATIC)
+				so->setMobility(ObjectMobility::Static);
+
+			SPtr<TestSceneActor> actor = bs_shared_ptr_new<TestSceneActor>();
+			gSceneManager()._bindActor(actor, so);
+
+			objects.push_back(so);
+			actors.push_back(actor);
+		}
+
+		auto countUpdated = [&actors](UINT32 start, UINT32 end, UINT32 numUpdates)
+		{
+			UINT32 count = 0;
+			for(UINT32 i = start; i < end; i++)
+			{
+				if(actors[i]->numUpdates == numUpdates)
+					count++;
+			}
+
+			return count;
+		};
+
+		// Newly bound actors are updated once
+		gSceneManager()._updateCoreObjectTransforms();
+		BS_TEST_ASSERT(countUpdated(0, NUM_OBJECTS, 1) == NUM_OBJECTS);
+		BS_TEST_ASSERT(actors[0]->getMobility() == ObjectMobility::Static);
+
+		// Nothing changed, so no actors should be touched
+		Timer timer;
+		gSceneManager()._updateCoreObjectTransforms();
+		const UINT64 idleTime = timer.getMicroseconds();
+
+		BS_TEST_ASSERT(countUpdated(0, NUM_OBJECTS, 1) == NUM_OBJECTS);
+
+		// Moving all objects only updates actors bound to movable objects, as static objects ignore transform changes
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+			objects[i]->setPosition(Vector3((float)i, 0.0f, 0.0f));
+
+		timer.reset();
+		gSceneManager()._updateCoreObjectTransforms();
+		const UINT64 moveTime = timer.getMicroseconds();
+
+		BS_TEST_ASSERT(countUpdated(0, NUM_STATIC, 1) == NUM_STATIC);
+		BS_TEST_ASSERT(countUpdated(NUM_STATIC, NUM_OBJECTS, 2) == NUM_MOVABLE);
+
+		bool transformsMatch = true;
+		for(UINT32 i = NUM_STATIC; i < NUM_OBJECTS; i++)
+			transformsMatch &= actors[i]->getTransform().getPosition() == objects[i]->getTransform().getPosition();
+
+		BS_TEST_ASSERT(transformsMatch);
+
+		// Changes to the parent propagate to actors bound to its children, but only movable children follow transforms
+		objects[NUM_STATIC + 1]->setParent(objects[NUM_STATIC]);
+		objects[1]->setParent(objects[NUM_STATIC]);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		objects[NUM_STATIC]->setPosition(Vector3(0.0f, 10.0f, 0.0f));
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(actors[NUM_STATIC + 1]->numUpdates == 4);
+		BS_TEST_ASSERT(actors[NUM_STATIC + 1]->getTransform().getPosition() == 
+			objects[NUM_STATIC + 1]->getTransform().getPosition());
+		BS_TEST_ASSERT(actors[1]->numUpdates == 1);
+
+		// Active state changes are propagated regardless of mobility
+		objects[NUM_STATIC]->setActive(false);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(!actors[NUM_STATIC]->getActive());
+		BS_TEST_ASSERT(!actors[NUM_STATIC + 1]->getActive());
+		BS_TEST_ASSERT(!actors[1]->getActive());
+
+		// Unbound actors are no longer updated
+		gSceneManager()._unbindActor(actors[NUM_STATIC]);
+		objects[NUM_STATIC]->setActive(true);
+		gSceneManager()._updateCoreObjectTransforms();
+
+		BS_TEST_ASSERT(!actors[NUM_STATIC]->getActive());
+		BS_TEST_ASSERT(actors[1]->getActive());
+
+		for(auto& entry : actors)
+			gSceneManager()._unbindActor(entry);
+
+		for(auto& entry : objects)
+		{
+			if(!entry.isDestroyed())
+				entry->destroy(true);
+		}
+
+		auto toMs = [](UINT64 time) { return toString(time / 1000.0f, 2, 0, ' ', std::ios::fixed) + " ms"; };
+		gDebug().logDebug("Scene actor update of " + toString(NUM_OBJECTS) + " actors: " + toMs(idleTime) + 
+			" with no changes, " + toMs(moveTime) + " with " + toString(NUM_MOVABLE) + " moved");
+	}
+
+	void CoreTestSuite::testTransformHierarchy()
+	{
+		static constexpr UINT32 NUM_NODES = 1000000;
+		static constexpr UINT32 NUM_RUNS = 10;
+
+		// Generate a random hierarchy, with a few extra root nodes. Parents are always generated before their children.
+		Random random(4321);
+		Vector<INT32> parents(NUM_NODES);
+		Vector<Transform> locals(NUM_NODES);
+		for(UINT32 i = 0; i < NUM_NODES; i++)
+		{
+			if(i == 0 || (i % 1000) == 1)
+				parents[i] = -1;
+			else if(i < 8)
+				parents[i] = 0;
+			else
+				parents[i] = random.getRange(0, (i - 1) / 4);
+
+			Quaternion rotation(random.getSNorm(), random.getSNorm(), random.getSNorm(), random.getSNorm());
+			rotation.normalize();
+
+			const Vector3 position(random.getSNorm(), random.getSNorm(), random.getSNorm());
+			const Vector3 scale(0.5f + random.getUNorm(), 0.5f + random.getUNorm(), 0.5f + random.getUNorm());
+
+			locals[i] = Transform(position, rotation, scale);
+		}
+
+		// Reference, equivalent to calculating each scene object's world transform separately
+		Vector<Transform> reference(NUM_NODES);
+
+		Timer timer;
+		for(UINT32 run = 0; run < NUM_RUNS; run++)
+		{
+			for(UINT32 i = 0; i < NUM_NODES; i++)
+			{
+				reference[i] = locals[i];
+				if(parents[i] >= 0)
+					reference[i].makeWorld(reference[parents[i]]);
+			}
+		}
+
+		const UINT64 referenceTime = timer.getMicroseconds();
+
+		TransformHierarchy hierarchy;
+
+		timer.reset();
+		hierarchy.build(parents, locals);
+		const UINT64 buildTime = timer.getMicroseconds();
+
+		timer.reset();
+		for(UINT32 run = 0; run < NUM_RUNS; run++)
+			hierarchy.updateWorldTransforms();
+
+		const UINT64 hierarchyTime = timer.getMicroseconds();
+
+		// Results must match the reference exactly
+		bool parentsMatch = true;
+		bool transformsMatch = true;
+		for(UINT32 i = 0; i < NUM_NODES; i++)
+		{
+			const UINT32 nodeIdx = hierarchy.getNodeIdx(i);
+			const INT32 parentIdx = hierarchy.getParent(nodeIdx);
+
+			if(parents[i] >= 0)
+				parentsMatch &= parentIdx == (INT32)hierarchy.getNodeIdx(parents[i]) && parentIdx < (INT32)nodeIdx;
+			else
+				parentsMatch &= parentIdx == -1;
+
+			const Transform world = hierarchy.getWorldTransform(nodeIdx);
+			transformsMatch &= world.getPosition() == reference[i].getPosition();
+			transformsMatch &= world.getRotation() == reference[i].getRotation();
+			transformsMatch &= world.getScale() == reference[i].getScale();
+		}
+
+		BS_TEST_ASSERT(parentsMatch);
+		BS_TEST_ASSERT(transformsMatch);
+
+		// Local transform changes are applied on the next update
+		const Vector3 offset(0.0f, 5.0f, 0.0f);
+		hierarchy.setLocalTransform(hierarchy.getNodeIdx(0), Transform(offset, Quaternion::IDENTITY, Vector3::ONE));
+		hierarchy.updateWorldTransforms();
+
+		BS_TEST_ASSERT(hierarchy.getWorldTransform(hierarchy.getNodeIdx(2)).getPosition() == 
+			locals[2].getPosition() + offset);
+
+		// Hierarchies built from scene objects match the scene object world transforms
+		HSceneObject root = SceneObject::create("Root");
+		root->setPosition(Vector3(1.0f, 2.0f, 3.0f));
+		root->setRotation(Quaternion(Degree(0.0f), Degree(45.0f), Degree(0.0f)));
+
+		HSceneObject child = SceneObject::create("Child");
+		child->setParent(root);
+		child->setPosition(Vector3(4.0f, 0.0f, 0.0f));
+
+		HSceneObject immovableChild = SceneObject::create("ImmovableChild");
+		immovableChild->setParent(child);
+		immovableChild->setMobility(ObjectMobility::Immovable);
+
+		HSceneObject grandChild = SceneObject::create("GrandChild");
+		grandChild->setParent(immovableChild);
+		grandChild->setPosition(Vector3(0.0f, 1.0f, 0.0f));
+
+		TransformHierarchy sceneHierarchy;
+		sceneHierarchy.build(root);
+		sceneHierarchy.updateWorldTransforms();
+
+		BS_TEST_ASSERT(sceneHierarchy.getNumNodes() == 4);
+
+		for(UINT32 i = 0; i < sceneHierarchy.getNumNodes(); i++)
+		{
+			const Transform& expected = sceneHierarchy.getSceneObject(i)->getTransform();
+			const Transform world = sceneHierarchy.getWorldTransform(i);
+
+			BS_TEST_ASSERT(world.getPosition().distance(expected.getPosition()) < 0.0001f);
+			BS_TEST_ASSERT(Math::abs(Quaternion::dot(world.getRotation(), expected.getRotation())) > 0.9999f);
+		}
+
+		// Hierarchies built from objects that have a parent account for the transforms of the parent
+		HSceneObject subRoot = SceneObject::create("SubRoot");
+		subRoot->setParent(child);
+		subRoot->setPosition(Vector3(0.0f, 0.0f, 2.0f));
+		subRoot->setRotation(Quaternion(Degree(30.0f), Degree(0.0f), Degree(60.0f)));
+		subRoot->setScale(Vector3(2.0f, 1.0f, 0.5f));
+
+		HSceneObject subChild = SceneObject::create("SubChild");
+		subChild->setParent(subRoot);
+		subChild->setPosition(Vector3(1.0f, -1.0f, 3.0f));
+		subChild->setRotation(Quaternion(Degree(0.0f), Degree(90.0f), Degree(0.0f)));
+
+		TransformHierarchy subHierarchy;
+		subHierarchy.build(subRoot);
+		subHierarchy.updateWorldTransforms();
+
+		BS_TEST_ASSERT(subHierarchy.getNumNodes() == 2);
+
+		for(UINT32 i = 0; i < subHierarchy.getNumNodes(); i++)
+		{
+			const Transform& expected = subHierarchy.getSceneObject(i)->getTransform();
+			const Transform world = subHierarchy.getWorldTransform(i);
+
+			BS_TEST_ASSERT(world.getPosition().distance(expected.getPosition()) < 0.0001f);
+			BS_TEST_ASSERT(Math::abs(Quaternion::dot(world.getRotation(), expected.getRotation())) > 0.9999f);
+			BS_TEST_ASSERT(world.getScale().distance(expected.getScale()) < 0.0001f);
+		}
+
+		// Local transforms modified in the hierarchy are applied to the scene objects on request
+		subHierarchy.setLocalTransform(0, Transform(Vector3(5.0f, 0.0f, 0.0f), Quaternion::IDENTITY, Vector3::ONE));
+		subHierarchy.setLocalTransform(1, Transform(Vector3(0.0f, 3.0f, 0.0f), Quaternion::IDENTITY, Vector3::ONE));
+		subHierarchy.applyToSceneObjects();
+
+		BS_TEST_ASSERT(subRoot->getTransform().getPosition().distance(Vector3(5.0f, 0.0f, 0.0f)) < 0.0001f);
+		BS_TEST_ASSERT(subChild->getTransform().getPosition().distance(Vector3(5.0f, 3.0f, 0.0f)) < 0.0001f);
+		BS_TEST_ASSERT(subChild->getLocalTransform().getPosition() == Vector3(0.0f, 3.0f, 0.0f));
+
+		// Invalid parents and cycles are reported, and leave the hierarchy empty
+		TransformHierarchy invalidHierarchy;
+		invalidHierarchy.build({ -1, 0, 5 }, Vector<Transform>(3));
+		BS_TEST_ASSERT(invalidHierarchy.getNumNodes() == 0 && invalidHierarchy.getNumLevels() == 0);
+
+		invalidHierarchy.build({ -1, 2, 3, 1, 3 }, Vector<Transform>(5));
+		BS_TEST_ASSERT(invalidHierarchy.getNumNodes() == 0 && invalidHierarchy.getNumLevels() == 0);
+
+		invalidHierarchy.build({ -1, 0 }, Vector<Transform>(3));
+		BS_TEST_ASSERT(invalidHierarchy.getNumNodes() == 0 && invalidHierarchy.getNumLevels() == 0);
+
+		invalidHierarchy.updateWorldTransforms();
+
+		root->destroy(true);
+
+		auto toNodesPerMs = [](UINT64 time)
+		{
+			const float ms = std::max(time / 1000.0f, 0.001f);
+			return toString((NUM_NODES * NUM_RUNS) / ms, 1, 0, ' ', std::ios::fixed) + " nodes/ms";
+		};
+
+		gDebug().logDebug("World transforms of " + toString(NUM_NODES) + " nodes over " + 
+			toString(hierarchy.getNumLevels()) + " levels: " + toNodesPerMs(hierarchyTime) + " transform hierarchy (built in " +
+			toString(buildTime / 1000.0f, 1, 0, ' ', std::ios::fixed) + " ms), " + toNodesPerMs(referenceTime) + 
+			" per-node reference");
+	}
+
+	void CoreTestSuite::testCoreObjectSync()
+	{
+		static constexpr UINT32 NUM_CHAINS = 128;
+		static constexpr UINT32 CHAIN_LENGTH = 4;
+		static constexpr UINT32 NUM_OBJECTS = NUM_CHAINS * CHAIN_LENGTH;
+
+		Vector<UINT32> syncOrder;
+		const auto sync = [&syncOrder]()
+		{
+			syncOrder.clear();
+
+			CoreObjectManager::instance().syncToCore();
+			gCoreThread().update();
+			gCoreThread().submitAll(true);
+		};
+
+		// Objects in each chain depend on the next object in the chain. Dependants are created before their dependencies,
+		// so they have lower IDs, but must still be synced after them.
+		Vector<SPtr<TestCoreObject>> objects(NUM_OBJECTS);
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+			objects[i] = TestCoreObject::create(i, syncOrder);
+
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			if((i % CHAIN_LENGTH) != CHAIN_LENGTH - 1)
+				objects[i]->setDependency(objects[i + 1]);
+		}
+
+		// Sync anything left dirty by other tests, so only the objects below are counted
+		sync();
+
+		for(auto& entry : objects)
+			entry->markDirty();
+
+		sync();
+
+		Vector<UINT32> syncPositions(NUM_OBJECTS, (UINT32)-1);
+		for(UINT32 i = 0; i < (UINT32)syncOrder.size(); i++)
+		{
+			if(syncOrder[i] < NUM_OBJECTS)
+				syncPositions[syncOrder[i]] = i;
+		}
+
+		bool allSynced = syncOrder.size() == NUM_OBJECTS;
+		bool dependenciesFirst = true;
+		for(UINT32 i = 0; i < NUM_OBJECTS; i++)
+		{
+			allSynced &= syncPositions[i] != (UINT32)-1;
+
+			if((i % CHAIN_LENGTH) != CHAIN_LENGTH - 1)
+				dependenciesFirst &= syncPositions[i + 1] < syncPositions[i];
+		}
+
+		BS_TEST_ASSERT(allSynced);
+		BS_TEST_ASSERT(dependenciesFirst);
+
+		// Each chain is independent of the others, so it forms its own group
+		CoreObjectSyncStats stats = CoreObjectManager::instance().getLastSyncStats();
+		BS_TEST_ASSERT(stats.numObjects == NUM_OBJECTS);
+		BS_TEST_ASSERT(stats.numGroups == NUM_CHAINS);
+		BS_TEST_ASSERT(stats.numBytes == NUM_OBJECTS * sizeof(UINT32));
+		BS_TEST_ASSERT(stats.numAllocators >= 1);
+
+		// Dirty dependencies mark their direct dependants dirty as well
+		objects[CHAIN_LENGTH - 1]->markDirty();
+		sync();
+
+		BS_TEST_ASSERT(syncOrder.size() == 2 && syncOrder[0] == CHAIN_LENGTH - 1 && syncOrder[1] == CHAIN_LENGTH - 2);
+
+		stats = CoreObjectManager::instance().getLastSyncStats();
+		BS_TEST_ASSERT(stats.numObjects == 2);
+		BS_TEST_ASSERT(stats.numGroups == 1);
+		BS_TEST_ASSERT(stats.numAllocators == 1);
+
+		for(auto& entry : objects)
+			entry->destroy();
+	}
+
+	void CoreTestSuite::testRenderQueueSort()
+	{
+		static constexpr UINT32 NUM_SHADERS = 12;
+		static constexpr UINT32 NUM_ELEMENTS = 2000;
+
+		// Shaders differ in queue priority, sort type and whether their passes can be separated, like opaque and
+		// transparent shaders of a real scene do
+		struct ShaderDesc
+		{
+			UINT32 id;
+			INT32 priority;
+			QueueSortType sortType;
+			bool separablePasses;
+		};
+
+		struct ElementDesc
+		{
+			UINT32 shaderIdx;
+			UINT32 techniqueIdx;
+			UINT32 numPasses;
+			float distance;
+		};
+
+		Random random(2468);
+
+		Vector<ShaderDesc> shaders(NUM_SHADERS);
+		for(UINT32 i = 0; i < NUM_SHADERS; i++)
+		{
+			static const QueueSortType SORT_TYPES[] = 
+				{ QueueSortType::FrontToBack, QueueSortType::BackToFront, QueueSortType::None };
+
+			shaders[i].id = 100 + i * 37;
+			shaders[i].priority = random.getRange(-1, 1) * 1000;
+			shaders[i].sortType = SORT_TYPES[i % 3];
+			shaders[i].separablePasses = (i % 4) != 0;
+		}
+
+		// Distances are exactly representable in the quantized distance bits of the sort key, so the packed keys must
+		// reproduce the comparator order exactly
+		Vector<ElementDesc> elementDescs(NUM_ELEMENTS);
+		for(auto& entry : elementDescs)
+		{
+			entry.shaderIdx = (UINT32)random.getRange(0, NUM_SHADERS - 1);
+			entry.techniqueIdx = (UINT32)random.getRange(0, 2);
+			entry.numPasses = (UINT32)random.getRange(1, 3);
+			entry.distance = random.getRange(0, 400) * 0.5f;
+		}
+
+		Vector<ct::TestRenderElement> renderElements(NUM_ELEMENTS);
+
+		// Reference ordering, using the comparators the render queue used before it switched to packed sort keys
+		struct ReferenceElement
+		{
+			INT32 priority;
+			float distance;
+			UINT32 shaderId;
+			UINT32 techniqueIdx;
+			UINT32 passIdx;
+			UINT32 numPasses;
+			UINT32 seqIdx;
+			UINT32 elementIdx;
+		};
+
+		auto sortReference = [&](ct::StateReduction mode)
+		{
+			Vector<ReferenceElement> reference;
+			for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			{
+				const ElementDesc& desc = elementDescs[i];
+				const ShaderDesc& shader = shaders[desc.shaderIdx];
+
+				float distance = desc.distance;
+				if(shader.sortType == QueueSortType::None)
+					distance = 0.0f;
+				else if(shader.sortType == QueueSortType::BackToFront)
+					distance = -distance;
+
+				const UINT32 numSortable = shader.separablePasses ? desc.numPasses : 1;
+				for(UINT32 j = 0; j < numSortable; j++)
+				{
+					reference.push_back({ shader.priority, distance, shader.id, desc.techniqueIdx, j,
+						shader.separablePasses ? 1 : desc.numPasses, (UINT32)reference.size(), i });
+				}
+			}
+
+			std::sort(reference.begin(), reference.end(), [mode](const ReferenceElement& a, const ReferenceElement& b)
+			{
+				const auto material = [](const ReferenceElement& x) 
+					{ return std::make_tuple(x.shaderId, x.techniqueIdx, x.passIdx); };
+
+				if(a.priority != b.priority)
+					return a.priority > b.priority;
+
+				switch(mode)
+				{
+				default:
+				case ct::StateReduction::None:
+					return std::make_tuple(a.distance, a.seqIdx) < std::make_tuple(b.distance, b.seqIdx);
+				case ct::StateReduction::Material:
+					return std::tuple_cat(material(a), std::make_tuple(a.distance, a.seqIdx)) < 
+						std::tuple_cat(material(b), std::make_tuple(b.distance, b.seqIdx));
+				case ct::StateReduction::Distance:
+					return std::tuple_cat(std::make_tuple(a.distance), material(a), std::make_tuple(a.seqIdx)) <
+						std::tuple_cat(std::make_tuple(b.distance), material(b), std::make_tuple(b.seqIdx));
+				}
+			});
+
+			Vector<std::pair<UINT32, UINT32>> output;
+			for(auto& entry : reference)
+			{
+				for(UINT32 j = 0; j < entry.numPasses; j++)
+					output.push_back(std::make_pair(entry.elementIdx, entry.passIdx + j));
+			}
+
+			return output;
+		};
+
+		static const ct::StateReduction MODES[] = { ct::StateReduction::None, ct::StateReduction::Material, ct::StateReduction::Distance };
+		for(auto& mode : MODES)
+		{
+			ct::TestRenderQueue queue(mode);
+			for(UINT32 i = 0; i < NUM_ELEMENTS; i++)
+			{
+				const ElementDesc& desc = elementDescs[i];
+				const ShaderDesc& shader = shaders[desc.shaderIdx];
+
+				queue.add(&renderElements[i], desc.distance, desc.techniqueIdx, desc.numPasses, shader.id, 
+					shader.priority, shader.sortType, shader.separablePasses);
+			}
+
+			queue.sort();
+
+			const Vector<ct::RenderQueueElement>& sorted = queue.getSortedElements();
+			const Vector<std::pair<UINT32, UINT32>> expected = sortReference(mode);
+
+			bool matchesReference = sorted.size() == expected.size();
+			for(UINT32 i = 0; i < (UINT32)sorted.size() && matchesReference; i++)
+			{
+				const auto elementIdx = (UINT32)(static_cast<const ct::TestRenderElement*>(sorted[i].renderElem) - 
+					renderElements.data());
+
+				matchesReference &= elementIdx == expected[i].first && sorted[i].passIdx == expected[i].second;
+				matchesReference &= sorted[i].techniqueIdx == elementDescs[elementIdx].techniqueIdx;
+			}
+
+			BS_TEST_ASSERT(matchesReference);
+
+			// Spell out the rules the reference encodes: higher priority queues go first, and unless elements are
+			// grouped by material first, opaque elements go front to back while transparent ones go back to front
+			bool priorityOrdered = true;
+			bool distanceOrdered = true;
+			for(UINT32 i = 1; i < (UINT32)sorted.size(); i++)
+			{
+				const ElementDesc& prev = elementDescs[expected[i - 1].first];
+				const ElementDesc& cur = elementDescs[expected[i].first];
+				const ShaderDesc& prevShader = shaders[prev.shaderIdx];
+				const ShaderDesc& curShader = shaders[cur.shaderIdx];
+
+				priorityOrdered &= prevShader.priority >= curShader.priority;
+
+				if(mode == ct::StateReduction::Material || prevShader.priority != curShader.priority || 
+					prevShader.sortType != curShader.sortType)
+					continue;
+
+				if(curShader.sortType == QueueSortType::FrontToBack)
+					distanceOrdered &= prev.distance <= cur.distance;
+				else if(curShader.sortType == QueueSortType::BackToFront)
+					distanceOrdered &= prev.distance >= cur.distance;
+			}
+
+			BS_TEST_ASSERT(priorityOrdered);
+			BS_TEST_ASSERT(distanceOrdered);
+
+			// When grouping by material, each shader, technique and pass combination is applied in a single run
+			if(mode == ct::StateReduction::Material)
+			{
+				UINT32 numApplied = 0;
+				for(auto& entry : sorted)
+					numApplied += entry.applyPass ? 1 : 0;
+
+				UnorderedSet<UINT64> runs;
+				bool grouped = true;
+				UINT64 prevRun = (UINT64)-1;
+				for(UINT32 i = 0; i < (UINT32)sorted.size(); i++)
+				{
+					const ElementDesc& desc = elementDescs[expected[i].first];
+					if(!shaders[desc.shaderIdx].separablePasses)
+						continue;
+
+					const UINT64 run = ((UINT64)shaders[desc.shaderIdx].id << 32) | (desc.techniqueIdx << 8) | 
+						sorted[i].passIdx;
+
+					if(run != prevRun)
+						grouped &= runs.insert(run).second;
+
+					prevRun = run;
+				}
+
+				BS_TEST_ASSERT(grouped);
+				BS_TEST_ASSERT(numApplied < (UINT32)sorted.size());
+			}
+		}
+	}
+}
+
+using namespace bs;
+
+int main()
+{
+	SPtr<TestSuite> tests = CoreTestSuite::create<CoreTestSuite>();
+
+	ExceptionTestOutput testOutput;
+	tests->run(testOutput);
+
+	return 0;
+}
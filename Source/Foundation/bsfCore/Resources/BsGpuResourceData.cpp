@@ -4,6 +4,7 @@
 #include "Private/RTTI/BsGpuResourceDataRTTI.h"
 #include "CoreThread/BsCoreThread.h"
 #include "Error/BsException.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -18,6 +19,7 @@ namespace bs
 		mData = copy.mData;
 		mLocked = copy.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mDataOwner = copy.mDataOwner;
 	}
 
 	GpuResourceData::~GpuResourceData()
@@ -30,6 +32,7 @@ namespace bs
 		mData = rhs.mData;
 		mLocked = rhs.mLocked; // TODO - This should be shared by all copies pointing to the same data?
 		mOwnsData = false;
+		mDataOwner = rhs.mDataOwner;
 
 		return *this;
 	}
@@ -70,7 +73,7 @@ namespace bs
 
 	void GpuResourceData::freeInternalBuffer()
 	{
-		if(mData == nullptr || !mOwnsData)
+		if(mData == nullptr || (!mOwnsData && mDataOwner == nullptr))
 			return;
 
 #if !BS_FORCE_SINGLETHREADED_RENDERING
@@ -81,8 +84,11 @@ namespace bs
 		}
 #endif
 
-		bs_free(mData);
+		if(mOwnsData)
+			bs_free(mData);
+
 		mData = nullptr;
+		mDataOwner = nullptr;
 	}
 
 	void GpuResourceData::setExternalBuffer(UINT8* data)
@@ -101,6 +107,26 @@ namespace bs
 		mOwnsData = false;
 	}
 
+	void GpuResourceData::readFromStream(const SPtr<DataStream>& stream, UINT32 size)
+	{
+		if(!stream->isFile())
+		{
+			auto memStream = std::static_pointer_cast<MemoryDataStream>(stream);
+			if(memStream->isView() && (memStream->size() - memStream->tell()) >= size)
+			{
+				UINT8* data = memStream->getCurrentPtr();
+				memStream->skip(size);
+
+				setExternalBuffer(data);
+				mDataOwner = stream;
+				return;
+			}
+		}
+
+		allocateInternalBuffer(size);
+		stream->read(mData, size);
+	}
+
 	void GpuResourceData::_lock() const
 	{
 		mLocked = true;
@@ -66,6 +66,13 @@ namespace bs
 		 */
 		void setExternalBuffer(UINT8* data);
 
+		/**
+		 * Populates the internal buffer with @p size bytes read from the provided stream. If the stream is a view of memory
+		 * kept alive by another stream (for example a memory mapped file, see MemoryDataStream::isView()), the data is 
+		 * referenced directly instead of being copied, and the stream is kept alive for as long as the data is in use.
+		 */
+		void readFromStream(const SPtr<DataStream>& stream, UINT32 size);
+
 		/** Checks if the internal buffer is locked due to some other thread using it. */
 		bool isLocked() const { return mLocked; }
 
@@ -86,6 +93,7 @@ namespace bs
 		UINT8* mData;
 		bool mOwnsData;
 		mutable bool mLocked;
+		SPtr<DataStream> mDataOwner;
 
 		/************************************************************************/
 		/* 								SERIALIZATION                      		*/
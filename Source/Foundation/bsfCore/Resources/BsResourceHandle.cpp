@@ -29,6 +29,9 @@ namespace bs
 
 		if (!mData->mIsCreated)
 		{
+			// Make sure the resource isn't stuck behind other queued loads while we wait
+			gResources().boostLoad(mData->mUUID);
+
 			Lock lock(mResourceCreatedMutex);
 			while (!mData->mIsCreated)
 			{
@@ -17,6 +17,7 @@
 #include "FileSystem/BsDataStream.h"
 #include "Serialization/BsBinarySerializer.h"
 #include "Reflection/BsRTTIType.h"
+#include "Utility/BsTimer.h"
 
 namespace bs
 {
@@ -31,6 +32,13 @@ namespace bs
 
 	Resources::~Resources()
 	{
+		// Queued loads reference this object, let them finish first
+		{
+			Lock lock(mFileLoadMutex);
+			while (!mFileLoads.empty())
+				mFileLoadCondition.wait(lock);
+		}
+
 		unloadAll();
 	}
 
@@ -325,20 +333,14 @@ namespace bs
 		if (initiateLoad)
 		{
 			// Synchronous or the resource doesn't support async, read the file immediately
+			const bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
 			if (synchronous)
 			{
-				loadCallback(filePath, outputResource, loadFlags.isSet(ResourceLoadFlag::KeepSourceData));
-			}
-			else // Asynchronous, read the file on a worker thread
-			{
-				String fileName = filePath.getFilename();
-				String taskName = "Resource load: " + fileName;
-
-				bool keepSourceData = loadFlags.isSet(ResourceLoadFlag::KeepSourceData);
-				SPtr<Task> task = Task::create(taskName, 
-					std::bind(&Resources::loadCallback, this, filePath, outputResource, keepSourceData));
-				TaskScheduler::instance().addTask(task);
+				SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, keepSourceData);
+				loadCallback(rawResource, outputResource);
 			}
+			else // Asynchronous, queue the file for reading and deserialization on worker threads
+				queueFileLoad(filePath, outputResource, keepSourceData);
 		}
 		else
 		{
@@ -354,53 +356,102 @@ namespace bs
 
 	SPtr<Resource> Resources::loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData)
 	{
-		Lock fileLock = FileScheduler::getLock(filePath);
+		FileLoadData loadData(filePath, HResource(), loadWithSaveData);
 
-		SPtr<DataStream> stream = FileSystem::openFile(filePath, true);
-		if (stream == nullptr)
-			return nullptr;
+		bool success = readResourceFile(loadData);
+		if (success)
+		{
+			decompressResourceData(loadData);
+			success = loadData.stream != nullptr;
+		}
 
-		if (stream->size() > std::numeric_limits<UINT32>::max())
+		if (!success)
 		{
-			BS_EXCEPT(InternalErrorException,
-				"File size is larger that UINT32 can hold. Ask a programmer to use a bigger data type.");
+			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+			return nullptr;
 		}
 
+		return deserializeResource(loadData);
+	}
+
+	bool Resources::readResourceFile(FileLoadData& loadData)
+	{
+		Lock fileLock = FileScheduler::getLock(loadData.filePath);
+
+		// Map the file if possible so that large data blocks can be referenced directly from the mapping instead of being
+		// copied. Resources loaded for editing are read normally since they are likely to be overwritten when saved.
+		SPtr<DataStream> stream;
+		if (!loadData.loadWithSaveData)
+			stream = FileSystem::openFileMapped(loadData.filePath);
+
+		if (stream == nullptr)
+			stream = FileSystem::openFile(loadData.filePath, true);
+
+		if (stream == nullptr)
+			return false;
+
 		CoreSerializationContext serzContext;
-		serzContext.flags = loadWithSaveData ? SF_KeepResourceSourceData : 0;
+		serzContext.flags = loadData.loadWithSaveData ? SF_KeepResourceSourceData : 0;
 
 		// Read meta-data
-		SPtr<SavedResourceData> metaData;
+		if (!stream->eof())
 		{
-			if (!stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
+			UINT32 objectSize = 0;
+			stream->read(&objectSize, sizeof(objectSize));
 
-				BinarySerializer bs;
-				metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, &serzContext));
-			}
+			BinarySerializer bs;
+			loadData.metaData = std::static_pointer_cast<SavedResourceData>(bs.decode(stream, objectSize, &serzContext));
 		}
 
-		// Read resource data
-		SPtr<IReflectable> loadedData;
+		if (loadData.metaData == nullptr || stream->eof())
+			return false;
+
+		stream->read(&loadData.objectSize, sizeof(loadData.objectSize));
+
+		// Bring the rest of the file into memory, so the remaining stages never wait on the disk. Mapped files are left
+		// as they are, their pages are read on first access.
+		if (stream->isFile())
 		{
-			if(metaData && !stream->eof())
-			{
-				UINT32 objectSize = 0;
-				stream->read(&objectSize, sizeof(objectSize));
+			const size_t remainingSize = stream->size() - stream->tell();
 
-				if (metaData->getCompressionMethod() != 0)
-					stream = Compression::decompress(stream);
+			SPtr<MemoryDataStream> memStream = bs_shared_ptr_new<MemoryDataStream>(remainingSize);
+			stream->read(memStream->getPtr(), remainingSize);
 
-				BinarySerializer bs;
-				loadedData = bs.decode(stream, objectSize, &serzContext);
-			}
+			loadData.stream = memStream;
 		}
+		else
+			loadData.stream = stream;
+
+		return true;
+	}
+
+	void Resources::decompressResourceData(FileLoadData& loadData)
+	{
+		switch (loadData.metaData->getCompressionMethod())
+		{
+		case 1:
+			loadData.stream = Compression::decompress(loadData.stream);
+			break;
+		case 2:
+			loadData.stream = Compression::decompressBlocks(loadData.stream);
+			break;
+		default:
+			break;
+		}
+	}
+
+	SPtr<Resource> Resources::deserializeResource(FileLoadData& loadData)
+	{
+		CoreSerializationContext serzContext;
+		serzContext.flags = loadData.loadWithSaveData ? SF_KeepResourceSourceData : 0;
+
+		BinarySerializer bs;
+		SPtr<IReflectable> loadedData = bs.decode(loadData.stream, loadData.objectSize, &serzContext);
+		loadData.stream = nullptr;
 
 		if (loadedData == nullptr)
 		{
-			LOGERR("Unable to load resource at path \"" + filePath.toString() + "\"");
+			LOGERR("Unable to load resource at path \"" + loadData.filePath.toString() + "\"");
 		}
 		else
 		{
@@ -412,6 +463,232 @@ namespace bs
 		return resource;
 	}
 
+	void Resources::queueFileLoad(const Path& filePath, const HResource& resource, bool loadWithSaveData)
+	{
+		FileLoadData* loadData = bs_new<FileLoadData>(filePath, resource, loadWithSaveData);
+
+		{
+			Lock lock(mFileLoadMutex);
+
+			mFileLoads[resource.getUUID()] = loadData;
+			mQueuedFileReads.push_back(loadData);
+		}
+
+		dispatchFileReads();
+	}
+
+	void Resources::dispatchFileReads()
+	{
+		Vector<FileLoadData*> readsToStart;
+		{
+			Lock lock(mFileLoadMutex);
+
+			while (!mQueuedFileReads.empty() && mNumScheduledReads < MAX_CONCURRENT_READS)
+			{
+				// Boosted loads ignore the read-ahead limit, since whoever is waiting on them can't wait for the 
+				// deserialization backlog to clear
+				FileLoadData* loadData = mQueuedFileReads.front();
+				if (!loadData->boosted && (mNumScheduledReads + mNumPendingDeserializations) >= MAX_READ_AHEAD)
+					break;
+
+				mQueuedFileReads.pop_front();
+				mNumScheduledReads++;
+
+				readsToStart.push_back(loadData);
+			}
+		}
+
+		for (auto& entry : readsToStart)
+			queueStageTask("Resource read: ", &Resources::readTask, entry);
+	}
+
+	void Resources::readTask(FileLoadData* loadData)
+	{
+		{
+			Lock lock(mFileLoadMutex);
+			beginLoadStage(mLoadStats.read, mNumActiveReads);
+		}
+
+		Timer timer;
+		const bool success = readResourceFile(*loadData);
+		const UINT64 time = timer.getMicroseconds();
+
+		{
+			Lock lock(mFileLoadMutex);
+			endLoadStage(mLoadStats.read, mNumActiveReads, time);
+
+			mNumScheduledReads--;
+			mNumPendingDeserializations++;
+		}
+
+		// Must happen before the load is passed on to the next stage, as the load might finish and let the manager
+		// shut down at any point after that
+		dispatchFileReads();
+
+		if (!success)
+			deserializeTask(loadData);
+		else if (loadData->metaData->getCompressionMethod() != 0)
+			queueStageTask("Resource decompress: ", &Resources::decompressTask, loadData);
+		else
+			queueStageTask("Resource deserialize: ", &Resources::deserializeTask, loadData);
+	}
+
+	void Resources::decompressTask(FileLoadData* loadData)
+	{
+		{
+			Lock lock(mFileLoadMutex);
+			beginLoadStage(mLoadStats.decompress, mNumActiveDecompressions);
+		}
+
+		Timer timer;
+		decompressResourceData(*loadData);
+		const UINT64 time = timer.getMicroseconds();
+
+		{
+			Lock lock(mFileLoadMutex);
+			endLoadStage(mLoadStats.decompress, mNumActiveDecompressions, time);
+		}
+
+		queueStageTask("Resource deserialize: ", &Resources::deserializeTask, loadData);
+	}
+
+	void Resources::deserializeTask(FileLoadData* loadData)
+	{
+		SPtr<Resource> rawResource;
+		if (loadData->stream != nullptr)
+		{
+			{
+				Lock lock(mFileLoadMutex);
+				beginLoadStage(mLoadStats.deserialize, mNumActiveDeserializations);
+			}
+
+			Timer timer;
+			rawResource = deserializeResource(*loadData);
+			const UINT64 time = timer.getMicroseconds();
+
+			{
+				Lock lock(mFileLoadMutex);
+				endLoadStage(mLoadStats.deserialize, mNumActiveDeserializations, time);
+			}
+		}
+		else
+		{
+			LOGERR("Unable to load resource at path \"" + loadData->filePath.toString() + "\"");
+		}
+
+		loadCallback(rawResource, loadData->resource);
+
+		{
+			Lock lock(mFileLoadMutex);
+			mNumPendingDeserializations--;
+		}
+
+		dispatchFileReads();
+
+		// The destructor waits until all loads are removed, so this must be the last access to this object
+		{
+			Lock lock(mFileLoadMutex);
+			mFileLoads.erase(loadData->resource.getUUID());
+
+			if (mFileLoads.empty())
+				mFileLoadCondition.notify_all();
+		}
+
+		bs_delete(loadData);
+	}
+
+	void Resources::queueStageTask(const String& name, void(Resources::*method)(FileLoadData*), FileLoadData* loadData)
+	{
+		bool boosted;
+		{
+			Lock lock(mFileLoadMutex);
+			boosted = loadData->boosted;
+		}
+
+		const TaskPriority priority = boosted ? TaskPriority::High : TaskPriority::Normal;
+
+		SPtr<Task> task = Task::create(name + loadData->filePath.getFilename(), std::bind(method, this, loadData), 
+			priority);
+		TaskScheduler::instance().addTask(task);
+	}
+
+	void Resources::boostLoad(const UUID& uuid)
+	{
+		// Find the resource and all of its dependencies that are still loading
+		Vector<UUID> loadsToBoost = { uuid };
+		{
+			Lock inProgressLock(mInProgressResourcesMutex);
+
+			for (UINT32 i = 0; i < (UINT32)loadsToBoost.size(); i++)
+			{
+				auto iterFind = mInProgressResources.find(loadsToBoost[i]);
+				if (iterFind == mInProgressResources.end())
+					continue;
+
+				for (auto& dependency : iterFind->second->dependencies)
+				{
+					const UUID& dependencyUUID = dependency.getUUID();
+					if (std::find(loadsToBoost.begin(), loadsToBoost.end(), dependencyUUID) == loadsToBoost.end())
+						loadsToBoost.push_back(dependencyUUID);
+				}
+			}
+		}
+
+		bool anyBoosted = false;
+		{
+			Lock lock(mFileLoadMutex);
+
+			for (auto& entry : loadsToBoost)
+			{
+				auto iterFind = mFileLoads.find(entry);
+				if (iterFind == mFileLoads.end() || iterFind->second->boosted)
+					continue;
+
+				FileLoadData* loadData = iterFind->second;
+				loadData->boosted = true;
+
+				// Move the load to the front of the queue, if it wasn't read yet
+				auto iterQueued = std::find(mQueuedFileReads.begin(), mQueuedFileReads.end(), loadData);
+				if (iterQueued != mQueuedFileReads.end())
+				{
+					mQueuedFileReads.erase(iterQueued);
+					mQueuedFileReads.push_front(loadData);
+
+					mLoadStats.numBoosted++;
+					anyBoosted = true;
+				}
+			}
+		}
+
+		if (anyBoosted)
+			dispatchFileReads();
+	}
+
+	void Resources::beginLoadStage(ResourceLoadStats::Stage& stage, UINT32& numActive)
+	{
+		numActive++;
+		stage.peakActive = std::max(stage.peakActive, numActive);
+	}
+
+	void Resources::endLoadStage(ResourceLoadStats::Stage& stage, UINT32& numActive, UINT64 time)
+	{
+		numActive--;
+		stage.numProcessed++;
+		stage.busyTime += time;
+	}
+
+	ResourceLoadStats Resources::getLoadStats() const
+	{
+		Lock lock(mFileLoadMutex);
+		return mLoadStats;
+	}
+
+	void Resources::resetLoadStats()
+	{
+		Lock lock(mFileLoadMutex);
+		mLoadStats = ResourceLoadStats();
+	}
+
 	void Resources::release(ResourceHandleBase& resource)
 	{
 		const UUID& uuid = resource.getUUID();
@@ -610,7 +887,7 @@ namespace bs
 		for (UINT32 i = 0; i < (UINT32)dependencyList.size(); i++)
 			dependencyUUIDs[i] = dependencyList[i].resource.getUUID();
 
-		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 1 : 0;
+		UINT32 compressionMethod = (compress && resource->isCompressible()) ? 2 : 0;
 		SPtr<SavedResourceData> resourceData = bs_shared_ptr_new<SavedResourceData>(dependencyUUIDs, 
 			resource->allowAsyncLoading(), compressionMethod);
 
@@ -674,7 +951,7 @@ namespace bs
 			if (compressionMethod != 0)
 			{
 				SPtr<DataStream> srcStream = std::static_pointer_cast<DataStream>(objStream);
-				objStream = Compression::compress(srcStream);
+				objStream = Compression::compressBlocks(srcStream);
 			}
 
 			stream.write((char*)&numBytes, sizeof(numBytes));
@@ -908,10 +1185,8 @@ namespace bs
 		}
 	}
 
-	void Resources::loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData)
+	void Resources::loadCallback(const SPtr<Resource>& rawResource, HResource& resource)
 	{
-		SPtr<Resource> rawResource = loadFromDiskAndDeserialize(filePath, loadWithSaveData);
-
 		{
 			Lock lock(mInProgressResourcesMutex);
 
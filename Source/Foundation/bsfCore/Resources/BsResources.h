@@ -39,6 +39,33 @@ namespace bs
 	typedef Flags<ResourceLoadFlag> ResourceLoadFlags;
 	BS_FLAGS_OPERATORS(ResourceLoadFlag);
 
+	/** 
+	 * Statistics about asynchronous resource loads. Asynchronous loads go through three stages: reading the file, 
+	 * decompressing it (if compressed) and deserializing it. Each stage runs as a separate task.
+	 */
+	struct ResourceLoadStats
+	{
+		/** Statistics about a single stage of the load process. */
+		struct Stage
+		{
+			/** Number of resources processed by the stage. */
+			UINT32 numProcessed = 0;
+
+			/** Maximum number of resources that were processed by the stage at the same time. */
+			UINT32 peakActive = 0;
+
+			/** Time spent processing resources in the stage, summed over all threads, in microseconds. */
+			UINT64 busyTime = 0;
+		};
+
+		Stage read;
+		Stage decompress;
+		Stage deserialize;
+
+		/** Number of queued loads moved to the front of the read queue because a thread was waiting on them. */
+		UINT32 numBoosted = 0;
+	};
+
 	/**
 	 * Manager for dealing with all engine resources. It allows you to save new resources and load existing ones.
 	 *
@@ -75,6 +102,23 @@ namespace bs
 			bool notifyImmediately;
 		};
 
+		/** Resource file that is being loaded, as it moves through the load stages. */
+		struct FileLoadData
+		{
+			FileLoadData(const Path& filePath, const HResource& resource, bool loadWithSaveData)
+				:filePath(filePath), resource(resource), loadWithSaveData(loadWithSaveData)
+			{ }
+
+			Path filePath;
+			HResource resource;
+			bool loadWithSaveData;
+			bool boosted = false;
+
+			SPtr<DataStream> stream;
+			SPtr<SavedResourceData> metaData;
+			UINT32 objectSize = 0;
+		};
+
 	public:
 		Resources();
 		~Resources();
@@ -255,6 +299,12 @@ namespace bs
 		 */
 		SPtr<ResourceManifest> getResourceManifest(const String& name) const;
 
+		/** Returns statistics about asynchronous loads performed since start-up or the last call to resetLoadStats(). */
+		ResourceLoadStats getLoadStats() const;
+
+		/** Clears the statistics returned by getLoadStats(). */
+		void resetLoadStats();
+
 		/** Attempts to retrieve file path from the provided UUID. Returns true if successful, false otherwise. */
 		bool getFilePathFromUUID(const UUID& uuid, Path& filePath) const;
 
@@ -326,11 +376,56 @@ namespace bs
 		/** Performs actually reading and deserializing of the resource file. Called from various worker threads. */
 		SPtr<Resource> loadFromDiskAndDeserialize(const Path& filePath, bool loadWithSaveData);
 
+		/** 
+		 * Opens the resource file, reads its meta-data and makes sure the rest of its contents are in memory. Returns 
+		 * false if the file cannot be read.
+		 */
+		static bool readResourceFile(FileLoadData& loadData);
+
+		/** Decompresses the resource data read by readResourceFile(), if it was saved compressed. */
+		static void decompressResourceData(FileLoadData& loadData);
+
+		/** Deserializes the resource from the data read by readResourceFile() and decompressResourceData(). */
+		static SPtr<Resource> deserializeResource(FileLoadData& loadData);
+
+		/** 
+		 * Queues an asynchronous load of the resource file. The file will be read once the number of reads in progress, 
+		 * and the number of read files waiting to be deserialized, drop below their limits.
+		 */
+		void queueFileLoad(const Path& filePath, const HResource& resource, bool loadWithSaveData);
+
+		/** Starts read tasks for queued file loads, as long as the read limits allow it. */
+		void dispatchFileReads();
+
+		/** Task that performs the read stage of a queued file load, and queues the next stage. */
+		void readTask(FileLoadData* loadData);
+
+		/** Task that performs the decompress stage of a queued file load, and queues the next stage. */
+		void decompressTask(FileLoadData* loadData);
+
+		/** Task that performs the deserialize stage of a queued file load, and completes the load. */
+		void deserializeTask(FileLoadData* loadData);
+
+		/** Queues a task that runs @p method with the provided load data as its parameter. */
+		void queueStageTask(const String& name, void(Resources::*method)(FileLoadData*), FileLoadData* loadData);
+
+		/** 
+		 * Moves the queued load of the specified resource, and the queued loads of any of its dependencies that are still
+		 * loading, to the front of the read queue. Called when a thread is about to wait on the resource.
+		 */
+		void boostLoad(const UUID& uuid);
+
+		/** Records that a resource entered a stage of the load process. */
+		void beginLoadStage(ResourceLoadStats::Stage& stage, UINT32& numActive);
+
+		/** Records that a resource exited a stage of the load process, after spending @p time microseconds in it. */
+		void endLoadStage(ResourceLoadStats::Stage& stage, UINT32& numActive, UINT64 time);
+
 		/**	Triggered when individual resource has finished loading. */
 		void loadComplete(HResource& resource);
 
-		/**	Callback triggered when the task manager is ready to process the loading task. */
-		void loadCallback(const Path& filePath, HResource& resource, bool loadWithSaveData);
+		/**	Called when the resource file has been loaded, with the loaded resource or null if the load failed. */
+		void loadCallback(const SPtr<Resource>& rawResource, HResource& resource);
 
 		/**	Destroys a resource, freeing its memory. */
 		void destroy(ResourceHandleBase& resource);
@@ -348,6 +443,26 @@ namespace bs
 		UnorderedMap<UUID, LoadedResourceData> mLoadedResources;
 		UnorderedMap<UUID, ResourceLoadData*> mInProgressResources; // Resources that are being asynchronously loaded
 		UnorderedMap<UUID, Vector<ResourceLoadData*>> mDependantLoads; // Allows dependency to be notified when a dependant is loaded
+
+		/** Maximum number of files read at the same time. */
+		static constexpr UINT32 MAX_CONCURRENT_READS = 4;
+
+		/** 
+		 * Maximum number of files that have been read or are being read, but haven't been deserialized yet. Limits the
+		 * memory used by files waiting on deserialization when reading is faster than deserialization.
+		 */
+		static constexpr UINT32 MAX_READ_AHEAD = 16;
+
+		mutable Mutex mFileLoadMutex;
+		Signal mFileLoadCondition;
+		Deque<FileLoadData*> mQueuedFileReads;
+		UnorderedMap<UUID, FileLoadData*> mFileLoads; // All file loads that are queued or in progress
+		UINT32 mNumScheduledReads = 0; // Reads that were handed over to the task scheduler but haven't finished yet
+		UINT32 mNumActiveReads = 0;
+		UINT32 mNumActiveDecompressions = 0;
+		UINT32 mNumActiveDeserializations = 0;
+		UINT32 mNumPendingDeserializations = 0; // Files that were read but haven't been deserialized yet
+		ResourceLoadStats mLoadStats;
 	};
 
 	/** Provides easier access to Resources manager. */
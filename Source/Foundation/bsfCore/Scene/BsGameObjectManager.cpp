@@ -2,33 +2,49 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Scene/BsGameObjectManager.h"
 #include "Scene/BsGameObject.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
+	/** Initial number of slots reserved by a deserialization state. Doubled with each new batch. */
+	static constexpr UINT32 MIN_SLOT_BATCH_SIZE = 16;
+
+	/** Maximum number of slots reserved by a deserialization state at once. */
+	static constexpr UINT32 MAX_SLOT_BATCH_SIZE = 1024;
+
+	GameObjectManager::GameObjectManager()
+	{
+		for(auto& entry : mPages)
+			entry.store(nullptr, std::memory_order_relaxed);
+	}
+
 	GameObjectManager::~GameObjectManager()
 	{
 		destroyQueuedObjects();
+
+		for(auto& entry : mPages)
+		{
+			Slot* page = entry.load(std::memory_order_relaxed);
+			if(page != nullptr)
+				bs_deleteN(page, SLOTS_PER_PAGE);
+		}
 	}
 
 	GameObjectHandleBase GameObjectManager::getObject(UINT64 id) const
 	{
-		Lock lock(mMutex);
-
-		const auto iterFind = mObjects.find(id);
-		if (iterFind != mObjects.end())
-			return iterFind->second;
+		SPtr<GameObjectHandleData> handleData = findHandleData(id);
+		if (handleData != nullptr)
+			return GameObjectHandleBase(std::move(handleData));
 
 		return nullptr;
 	}
 
 	bool GameObjectManager::tryGetObject(UINT64 id, GameObjectHandleBase& object) const
 	{
-		Lock lock(mMutex);
-
-		const auto iterFind = mObjects.find(id);
-		if (iterFind != mObjects.end())
+		SPtr<GameObjectHandleData> handleData = findHandleData(id);
+		if (handleData != nullptr)
 		{
-			object = iterFind->second;
+			object = GameObjectHandleBase(std::move(handleData));
 			return true;
 		}
 
@@ -37,9 +53,15 @@ namespace bs
 
 	bool GameObjectManager::objectExists(UINT64 id) const
 	{
-		Lock lock(mMutex);
+		const Slot* slot = getSlot((UINT32)(id & SLOT_INDEX_MASK));
+		if (slot != nullptr && slot->id.load(std::memory_order_acquire) == id)
+			return true;
 
-		return mObjects.find(id) != mObjects.end();
+		if (mNumRemappedObjects.load(std::memory_order_acquire) == 0)
+			return false;
+
+		Lock lock(mMutex);
+		return mRemappedObjects.find(id) != mRemappedObjects.end();
 	}
 
 	void GameObjectManager::remapId(UINT64 oldId, UINT64 newId)
@@ -47,14 +69,17 @@ namespace bs
 		if (oldId == newId)
 			return;
 
-		Lock lock(mMutex);
-		mObjects[newId] = mObjects[oldId];
-		mObjects.erase(oldId);
+		SPtr<GameObjectHandleData> handleData = findHandleData(oldId);
+		if (handleData == nullptr)
+			handleData = bs_shared_ptr_new<GameObjectHandleData>(nullptr);
+
+		removeHandleData(oldId);
+		setHandleData(newId, handleData);
 	}
 
 	UINT64 GameObjectManager::reserveId()
 	{
-		return mNextAvailableID.fetch_add(1, std::memory_order_relaxed);
+		return mNextAvailableID.fetch_add(1, std::memory_order_relaxed) | RESERVED_ID_FLAG;
 	}
 
 	void GameObjectManager::queueForDestroy(const GameObjectHandleBase& object)
@@ -76,27 +101,183 @@ namespace bs
 
 	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object)
 	{
-		const UINT64 id = mNextAvailableID.fetch_add(1, std::memory_order_relaxed);
+		UINT32 slotIdx;
+		{
+			Lock lock(mMutex);
+			slotIdx = allocateSlot();
+		}
+
+		return registerInSlot(object, slotIdx);
+	}
+
+	GameObjectHandleBase GameObjectManager::registerObject(const SPtr<GameObject>& object, UINT32 reservedSlot)
+	{
+		return registerInSlot(object, reservedSlot);
+	}
+
+	void GameObjectManager::reserveSlots(UINT32 count, Vector<UINT32>& slots)
+	{
+		Lock lock(mMutex);
+
+		// Check the limit up front so a failed reservation doesn't leave some of the slots allocated
+		const UINT64 numAvailableSlots = (UINT64)mFreeSlots.size() + ((UINT64)SLOT_INDEX_MASK + 1 - mNumSlots);
+		if (count > numAvailableSlots)
+		{
+			BS_EXCEPT(InvalidStateException, "Maximum number of game objects exceeded. Limit is " +
+				toString((UINT64)SLOT_INDEX_MASK + 1) + ".");
+		}
+
+		slots.reserve(slots.size() + count);
+		for (UINT32 i = 0; i < count; i++)
+			slots.push_back(allocateSlot());
+	}
+
+	void GameObjectManager::releaseSlots(const Vector<UINT32>& slots)
+	{
+		Lock lock(mMutex);
+
+		mFreeSlots.insert(mFreeSlots.end(), slots.begin(), slots.end());
+	}
+
+	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
+	{
+		removeHandleData(object->getInstanceId());
+
+		onDestroyed(static_object_cast<GameObject>(object));
+		object.destroy();
+	}
+
+	GameObjectManager::Slot* GameObjectManager::getSlot(UINT32 index) const
+	{
+		Slot* page = mPages[index / SLOTS_PER_PAGE].load(std::memory_order_acquire);
+		if (page == nullptr)
+			return nullptr;
+
+		return &page[index % SLOTS_PER_PAGE];
+	}
+
+	UINT32 GameObjectManager::allocateSlot()
+	{
+		if (!mFreeSlots.empty())
+		{
+			const UINT32 slotIdx = mFreeSlots.back();
+			mFreeSlots.pop_back();
+
+			return slotIdx;
+		}
+
+		// IDs only have room for this many slot indices, and the page table is sized accordingly
+		if (mNumSlots > SLOT_INDEX_MASK)
+		{
+			BS_EXCEPT(InvalidStateException, "Maximum number of game objects exceeded. Limit is " +
+				toString((UINT64)SLOT_INDEX_MASK + 1) + ".");
+		}
+
+		const UINT32 slotIdx = mNumSlots++;
+
+		const UINT32 pageIdx = slotIdx / SLOTS_PER_PAGE;
+		if (mPages[pageIdx].load(std::memory_order_relaxed) == nullptr)
+			mPages[pageIdx].store(bs_newN<Slot>(SLOTS_PER_PAGE), std::memory_order_release);
+
+		return slotIdx;
+	}
+
+	GameObjectHandleBase GameObjectManager::registerInSlot(const SPtr<GameObject>& object, UINT32 slotIdx)
+	{
+		Slot* slot = getSlot(slotIdx);
+
+		// Generation is only modified by the thread owning the slot, while the slot is unused
+		const UINT64 id = (slot->generation << SLOT_INDEX_BITS) | slotIdx;
 		object->initialize(object, id);
 
 		GameObjectHandleBase handle(object);
 		{
-			Lock lock(mMutex);
-			mObjects[id] = handle;
+			ScopedSpinLock lock(slot->lock);
+
+			slot->handleData = handle.mData;
+			slot->id.store(id, std::memory_order_release);
 		}
 
 		return handle;
 	}
 
-	void GameObjectManager::unregisterObject(GameObjectHandleBase& object)
+	void GameObjectManager::setHandleData(UINT64 id, const SPtr<GameObjectHandleData>& handleData)
 	{
+		Slot* slot = getSlot((UINT32)(id & SLOT_INDEX_MASK));
+		if (slot != nullptr && slot->id.load(std::memory_order_acquire) == id)
 		{
-			Lock lock(mMutex);
-			mObjects.erase(object->getInstanceId());
+			ScopedSpinLock lock(slot->lock);
+			if (slot->id.load(std::memory_order_relaxed) == id)
+			{
+				slot->handleData = handleData;
+				return;
+			}
 		}
 
-		onDestroyed(static_object_cast<GameObject>(object));
-		object.destroy();
+		Lock lock(mMutex);
+		mRemappedObjects[id] = handleData;
+		mNumRemappedObjects.store((UINT32)mRemappedObjects.size(), std::memory_order_release);
+	}
+
+	SPtr<GameObjectHandleData> GameObjectManager::findHandleData(UINT64 id) const
+	{
+		const Slot* slot = getSlot((UINT32)(id & SLOT_INDEX_MASK));
+		if (slot != nullptr && slot->id.load(std::memory_order_acquire) == id)
+		{
+			ScopedSpinLock lock(slot->lock);
+			if (slot->id.load(std::memory_order_relaxed) == id)
+				return slot->handleData;
+		}
+
+		// Remapped IDs are rare, avoid locking unless there are some
+		if (mNumRemappedObjects.load(std::memory_order_acquire) == 0)
+			return nullptr;
+
+		Lock lock(mMutex);
+		const auto iterFind = mRemappedObjects.find(id);
+		if (iterFind != mRemappedObjects.end())
+			return iterFind->second;
+
+		return nullptr;
+	}
+
+	void GameObjectManager::removeHandleData(UINT64 id)
+	{
+		const UINT32 slotIdx = (UINT32)(id & SLOT_INDEX_MASK);
+
+		Slot* slot = getSlot(slotIdx);
+		if (slot != nullptr && slot->id.load(std::memory_order_acquire) == id)
+		{
+			SPtr<GameObjectHandleData> handleData;
+			bool freed = false;
+			{
+				ScopedSpinLock lock(slot->lock);
+				if (slot->id.load(std::memory_order_relaxed) == id)
+				{
+					// Release the handle data outside of the spin lock
+					handleData = std::move(slot->handleData);
+					slot->id.store(0, std::memory_order_release);
+					slot->generation++;
+
+					freed = true;
+				}
+			}
+
+			if (freed)
+			{
+				Lock lock(mMutex);
+				mFreeSlots.push_back(slotIdx);
+
+				return;
+			}
+		}
+
+		if (mNumRemappedObjects.load(std::memory_order_acquire) == 0)
+			return;
+
+		Lock lock(mMutex);
+		mRemappedObjects.erase(id);
+		mNumRemappedObjects.store((UINT32)mRemappedObjects.size(), std::memory_order_release);
 	}
 
 	GameObjectDeserializationState::GameObjectDeserializationState(UINT32 options)
@@ -105,6 +286,9 @@ namespace bs
 
 	GameObjectDeserializationState::~GameObjectDeserializationState()
 	{
+		if (!mReservedSlots.empty())
+			GameObjectManager::instance().releaseSlots(mReservedSlots);
+
 		BS_ASSERT(mUnresolvedHandles.empty() && "Deserialization state being destroyed before all handles are resolved.");
 		BS_ASSERT(mDeserializedObjects.empty() && "Deserialization state being destroyed before all objects are resolved.");
 	}
@@ -166,6 +350,14 @@ namespace bs
 		mEndCallbacks.clear();
 		mUnresolvedHandleData.clear();
 		mDeserializedObjects.clear();
+
+		if (!mReservedSlots.empty())
+		{
+			GameObjectManager::instance().releaseSlots(mReservedSlots);
+			mReservedSlots.clear();
+		}
+
+		mSlotBatchSize = 0;
 	}
 
 	void GameObjectDeserializationState::registerUnresolvedHandle(UINT64 originalId, GameObjectHandleBase& object)
@@ -226,6 +418,23 @@ namespace bs
 		mDeserializedObjects[newId] = object;
 	}
 
+	GameObjectHandleBase GameObjectDeserializationState::registerNewObject(const SPtr<GameObject>& object)
+	{
+		GameObjectManager& gameObjectManager = GameObjectManager::instance();
+
+		// Start with small batches so deserializing a handful of objects doesn't keep many slots reserved
+		if (mReservedSlots.empty())
+		{
+			mSlotBatchSize = Math::clamp(mSlotBatchSize * 2, MIN_SLOT_BATCH_SIZE, MAX_SLOT_BATCH_SIZE);
+			gameObjectManager.reserveSlots(mSlotBatchSize, mReservedSlots);
+		}
+
+		const UINT32 slotIdx = mReservedSlots.back();
+		mReservedSlots.pop_back();
+
+		return gameObjectManager.registerObject(object, slotIdx);
+	}
+
 	void GameObjectDeserializationState::registerOnDeserializationEndCallback(std::function<void()> callback)
 	{
 		mEndCallbacks.push_back(callback);
@@ -5,6 +5,7 @@
 #include "BsCorePrerequisites.h"
 #include "Utility/BsModule.h"
 #include "Scene/BsGameObject.h"
+#include "Threading/BsSpinLock.h"
 
 namespace bs
 {
@@ -32,12 +33,18 @@ namespace bs
 	/**
 	 * Tracks GameObject creation and destructions. Also resolves GameObject references from GameObject handles.
 	 *
-	 * @note	Sim thread only.
+	 * Objects are stored in a generational slot table. Instance IDs encode the index of the slot the object lives in, and
+	 * the generation of the slot, which is incremented whenever the slot is freed so that stale IDs never resolve to a newer
+	 * object. Looking up an object by its ID therefore never takes the manager-wide lock, it only briefly locks the slot
+	 * itself. The lock is only taken when allocating or freeing slots, which can also be done in batches, and for IDs
+	 * that were remapped to a value that no longer matches their slot.
+	 *
+	 * @note	Methods marked as thread safe can be called from any thread, the rest are sim thread only.
 	 */
 	class BS_CORE_EXPORT GameObjectManager : public Module<GameObjectManager>
 	{
 	public:
-		GameObjectManager() = default;
+		GameObjectManager();
 		~GameObjectManager();
 
 		/**
@@ -50,6 +57,30 @@ namespace bs
 		 */
 		GameObjectHandleBase registerObject(const SPtr<GameObject>& object);
 
+		/**
+		 * Registers a new GameObject using a slot previously reserved through reserveSlots() and returns the handle to the
+		 * object. The slot is consumed by this call.
+		 *
+		 * @note	Thread safe.
+		 */
+		GameObjectHandleBase registerObject(const SPtr<GameObject>& object, UINT32 reservedSlot);
+
+		/**
+		 * Reserves slots for @p count objects and appends their indices to @p slots. This allows a large number of
+		 * objects to be registered through registerObject(const SPtr<GameObject>&, UINT32) while only locking the manager
+		 * once. Slots that end up not being used must be returned through releaseSlots().
+		 *
+		 * @note	Thread safe.
+		 */
+		void reserveSlots(UINT32 count, Vector<UINT32>& slots);
+
+		/**
+		 * Returns slots reserved through reserveSlots() that weren't used for registering an object.
+		 *
+		 * @note	Thread safe.
+		 */
+		void releaseSlots(const Vector<UINT32>& slots);
+
 		/**
 		 * Unregisters a GameObject. Handles to this object will no longer be valid after this call. This should be called
 		 * whenever a GameObject is destroyed.
@@ -106,8 +137,57 @@ namespace bs
 		Event<void(const HGameObject&)> onDestroyed;
 
 	private:
-		std::atomic<UINT64> mNextAvailableID = { 1 } ; // 0 is not a valid ID
-		Map<UINT64, GameObjectHandleBase> mObjects;
+		/** Entry in the object table, referencing a single registered object. */
+		struct Slot
+		{
+			/** ID of the object stored in the slot, or 0 if the slot is unused. */
+			std::atomic<UINT64> id = { 0 };
+			SPtr<GameObjectHandleData> handleData;
+			UINT64 generation = 1;
+			mutable SpinLock lock;
+		};
+
+		static constexpr UINT32 SLOT_INDEX_BITS = 24;
+		static constexpr UINT64 SLOT_INDEX_MASK = (1ULL << SLOT_INDEX_BITS) - 1;
+		static constexpr UINT32 SLOTS_PER_PAGE = 4096;
+		static constexpr UINT32 MAX_PAGES = (1U << SLOT_INDEX_BITS) / SLOTS_PER_PAGE;
+
+		/** Set on IDs allocated through reserveId() so they can never match an ID of a slot. */
+		static constexpr UINT64 RESERVED_ID_FLAG = 1ULL << 63;
+
+		/** Returns the slot with the specified index, or null if no slot with that index was ever allocated. */
+		Slot* getSlot(UINT32 index) const;
+
+		/**
+		 * Allocates a new slot, reusing a previously freed one if possible. Reports a fatal error if all slots are in use.
+		 * Caller must hold the mutex.
+		 */
+		UINT32 allocateSlot();
+
+		/** Stores an object in a reserved slot and returns its handle. */
+		GameObjectHandleBase registerInSlot(const SPtr<GameObject>& object, UINT32 slotIdx);
+
+		/**
+		 * Associates handle data with the specified ID, replacing any existing entry with the same ID. Handle data is
+		 * stored in the slot encoded in the ID if that slot holds the ID, otherwise it is stored in the remapped object
+		 * map.
+		 */
+		void setHandleData(UINT64 id, const SPtr<GameObjectHandleData>& handleData);
+
+		/** Finds handle data associated with the specified ID. Returns null if the ID isn't registered. */
+		SPtr<GameObjectHandleData> findHandleData(UINT64 id) const;
+
+		/** Removes the entry with the specified ID, freeing its slot if it owns one. */
+		void removeHandleData(UINT64 id);
+
+		std::atomic<UINT64> mNextAvailableID = { 1 } ;
+		std::atomic<Slot*> mPages[MAX_PAGES];
+		UINT32 mNumSlots = 0;
+		Vector<UINT32> mFreeSlots;
+
+		UnorderedMap<UINT64, SPtr<GameObjectHandleData>> mRemappedObjects;
+		std::atomic<UINT32> mNumRemappedObjects = { 0 };
+
 		Map<UINT64, GameObjectHandleBase> mQueuedForDestroy;
 
 		mutable Mutex mMutex;
@@ -140,6 +220,12 @@ namespace bs
 		/** Notifies the system about a new deserialized game object and its original ID. */
 		void registerObject(UINT64 originalId, GameObjectHandleBase& object);
 
+		/**
+		 * Registers a newly deserialized game object with the GameObjectManager and returns its handle. Slots in the
+		 * manager are reserved in batches, so deserializing large hierarchies doesn't lock the manager for every object.
+		 */
+		GameObjectHandleBase registerNewObject(const SPtr<GameObject>& object);
+
 		/**	Registers a callback that will be triggered when GameObject serialization ends. */
 		void registerOnDeserializationEndCallback(std::function<void()> callback);
 
@@ -152,6 +238,8 @@ namespace bs
 		UnorderedMap<UINT64, GameObjectHandleBase> mDeserializedObjects;
 		Vector<UnresolvedHandle> mUnresolvedHandles;
 		Vector<std::function<void()>> mEndCallbacks;
+		Vector<UINT32> mReservedSlots;
+		UINT32 mSlotBatchSize = 0;
 		UINT32 mOptions;
 	};
 
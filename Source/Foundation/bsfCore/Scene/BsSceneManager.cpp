@@ -97,12 +97,25 @@ namespace bs
 
 	void SceneManager::_bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so)
 	{
+		_unbindActor(actor);
+
 		mBoundActors[actor.get()] = BoundActorData(actor, so);
+
+		so->mBoundActors.add(actor.get());
+		so->markBoundActorsDirty();
 	}
 
 	void SceneManager::_unbindActor(const SPtr<SceneActor>& actor)
 	{
-		mBoundActors.erase(actor.get());
+		auto iterFind = mBoundActors.find(actor.get());
+		if (iterFind == mBoundActors.end())
+			return;
+
+		const HSceneObject& so = iterFind->second.so;
+		if (!so.isDestroyed())
+			so->mBoundActors.removeValue(actor.get());
+
+		mBoundActors.erase(iterFind);
 	}
 
 	HSceneObject SceneManager::_getActorSO(const SPtr<SceneActor>& actor) const
@@ -161,8 +174,22 @@ namespace bs
 
 	void SceneManager::_updateCoreObjectTransforms()
 	{
-		for (auto& entry : mBoundActors)
-			entry.second.actor->_updateState(*entry.second.so);
+		for (auto& so : mDirtyBoundActorObjects)
+		{
+			if (so.isDestroyed())
+				continue;
+
+			so->mBoundActorsDirty = false;
+			for (auto& actor : so->mBoundActors)
+				actor->_updateState(*so);
+		}
+
+		mDirtyBoundActorObjects.clear();
+	}
+
+	void SceneManager::_notifyBoundActorsDirty(const HSceneObject& so)
+	{
+		mDirtyBoundActorObjects.push_back(so);
 	}
 
 	SPtr<Camera> SceneManager::getMainCamera() const
@@ -94,8 +94,8 @@ namespace bs
 		void setMainRenderTarget(const SPtr<RenderTarget>& rt);
 
 		/** 
-		 * Binds a scene actor with a scene object. Every frame the scene object's transform will be monitored for
-		 * changes and those changes will be automatically transfered to the actor. 
+		 * Binds a scene actor with a scene object. Any changes to the scene object's transform, mobility or active state
+		 * will be automatically transfered to the actor during the next call to _updateCoreObjectTransforms().
 		 */
 		void _bindActor(const SPtr<SceneActor>& actor, const HSceneObject& so);
 
@@ -120,9 +120,18 @@ namespace bs
 		/** Called at fixed time internals. Calls the fixed update method on all active components. */
 		void _fixedUpdate();
 
-		/** Updates dirty transforms on any core objects that may be tied with scene objects. */
+		/** 
+		 * Updates dirty transforms on any core objects that may be tied with scene objects. Only actors bound to scene
+		 * objects that were modified since the last call are updated.
+		 */
 		void _updateCoreObjectTransforms();
 
+		/** 
+		 * Notifies the manager that the transform, mobility or active state of a scene object with bound actors has 
+		 * changed, and the actors need to be updated on the next call to _updateCoreObjectTransforms().
+		 */
+		void _notifyBoundActorsDirty(const HSceneObject& so);
+
 		/** Notifies the manager that a new component has just been created. The manager triggers necessary callbacks. */
 		void _notifyComponentCreated(const HComponent& component, bool parentActive);
 
@@ -205,6 +214,7 @@ namespace bs
 		HSceneObject mRootNode;
 
 		UnorderedMap<SceneActor*, BoundActorData> mBoundActors;
+		Vector<HSceneObject> mDirtyBoundActorObjects;
 		UnorderedMap<Camera*, SPtr<Camera>> mCameras;
 		Vector<SPtr<Camera>> mMainCameras;
 
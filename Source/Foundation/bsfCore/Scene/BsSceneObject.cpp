@@ -53,10 +53,12 @@ namespace bs
 		return sceneObject;
 	}
 
-	HSceneObject SceneObject::createInternal(const SPtr<SceneObject>& soPtr)
+	HSceneObject SceneObject::createInternal(const SPtr<SceneObject>& soPtr, GameObjectDeserializationState* goState)
 	{
-		HSceneObject sceneObject = static_object_cast<SceneObject>(
-			GameObjectManager::instance().registerObject(soPtr));
+		const GameObjectHandleBase handle = goState != nullptr ? 
+			goState->registerNewObject(soPtr) : GameObjectManager::instance().registerObject(soPtr);
+
+		HSceneObject sceneObject = static_object_cast<SceneObject>(handle);
 		sceneObject->mThisHandle = sceneObject;
 
 		return sceneObject;
@@ -437,6 +439,10 @@ namespace bs
 			mDirtyHash++;
 		}
 
+		// Immovable objects ignore transform changes, so their actors only need updating when mobility changes
+		if ((componentFlags & (TCF_Transform | TCF_Mobility)) != 0)
+			markBoundActorsDirty();
+
 		// Only send component flags if we haven't removed them all
 		if (componentFlags != 0)
 		{
@@ -460,6 +466,15 @@ namespace bs
 		}
 	}
 
+	void SceneObject::markBoundActorsDirty() const
+	{
+		if (mBoundActors.empty() || mBoundActorsDirty)
+			return;
+
+		mBoundActorsDirty = true;
+		gSceneManager()._notifyBoundActorsDirty(mThisHandle);
+	}
+
 	void SceneObject::updateWorldTfrm() const
 	{
 		mWorldTfrm = mLocalTfrm;
@@ -681,6 +696,7 @@ namespace bs
 		if (mActiveHierarchy != activeHierarchy)
 		{
 			mActiveHierarchy = activeHierarchy;
+			markBoundActorsDirty();
 
 			if (triggerEvents)
 			{
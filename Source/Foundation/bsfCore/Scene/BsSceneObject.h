@@ -165,8 +165,10 @@ namespace bs
 		 * and returns a handle to the object.
 		 *			
 		 * @param[in]	soPtr		Pointer to the scene object register and return a handle to.
+		 * @param[in]	goState		Optional deserialization state to register the object through, if the object is being
+		 *							deserialized.
 		 */
-		static HSceneObject createInternal(const SPtr<SceneObject>& soPtr);
+		static HSceneObject createInternal(const SPtr<SceneObject>& soPtr, GameObjectDeserializationState* goState = nullptr);
 
 		/**
 		 * Destroys this object and any of its held components.
@@ -311,6 +313,9 @@ namespace bs
 		mutable UINT32 mDirtyFlags;
 		mutable UINT32 mDirtyHash;
 
+		SmallVector<SceneActor*, 1> mBoundActors;
+		mutable bool mBoundActorsDirty = false;
+
 		/** 
 		 * Notifies components and child scene object that a transform has been changed.  
 		 * 
@@ -318,6 +323,12 @@ namespace bs
 		 */
 		void notifyTransformChanged(TransformChangedFlags flags) const;
 
+		/** 
+		 * Queues the actors bound to this object for an update with the scene manager, if there are any. Should be called
+		 * whenever the transform, mobility or active state of the object changes.
+		 */
+		void markBoundActorsDirty() const;
+
 		/** Updates the local transform. Normally just reconstructs the transform matrix from the position/rotation/scale. */
 		void updateLocalTfrm() const;
 
@@ -0,0 +1,356 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Scene/BsTransformHierarchy.h"
+#include "Scene/BsSceneObject.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Math/BsSIMD.h"
+
+namespace bs
+{
+	/** Minimum number of nodes in a single depth level before their world transforms are calculated on multiple threads. */
+	static constexpr UINT32 PARALLEL_UPDATE_MIN_NODES = 16384;
+
+	/** Minimum number of nodes processed by a single task, when a depth level is processed on multiple threads. */
+	static constexpr UINT32 PARALLEL_UPDATE_GRAIN_SIZE = 4096;
+
+	/** Loads the values at the four provided indices from @p values into a single register. */
+	static simd::float32x4 gather(const Vector<float>& values, const INT32* indices)
+	{
+		return simd::make_float(values[indices[0]], values[indices[1]], values[indices[2]], values[indices[3]]);
+	}
+
+	void TransformHierarchy::TransformArrays::resize(UINT32 size)
+	{
+		for(auto& entry : position)
+			entry.resize(size);
+
+		for(auto& entry : rotation)
+			entry.resize(size);
+
+		for(auto& entry : scale)
+			entry.resize(size);
+	}
+
+	void TransformHierarchy::TransformArrays::set(UINT32 idx, const Transform& transform)
+	{
+		const Vector3& pos = transform.getPosition();
+		const Quaternion& rot = transform.getRotation();
+		const Vector3& scl = transform.getScale();
+
+		position[0][idx] = pos.x;
+		position[1][idx] = pos.y;
+		position[2][idx] = pos.z;
+
+		rotation[0][idx] = rot.x;
+		rotation[1][idx] = rot.y;
+		rotation[2][idx] = rot.z;
+		rotation[3][idx] = rot.w;
+
+		scale[0][idx] = scl.x;
+		scale[1][idx] = scl.y;
+		scale[2][idx] = scl.z;
+	}
+
+	Transform TransformHierarchy::TransformArrays::get(UINT32 idx) const
+	{
+		return Transform(
+			Vector3(position[0][idx], position[1][idx], position[2][idx]),
+			Quaternion(rotation[3][idx], rotation[0][idx], rotation[1][idx], rotation[2][idx]),
+			Vector3(scale[0][idx], scale[1][idx], scale[2][idx]));
+	}
+
+	void TransformHierarchy::TransformArrays::copy(const TransformArrays& other, UINT32 start, UINT32 count)
+	{
+		for(UINT32 i = 0; i < 3; i++)
+			std::copy_n(other.position[i].begin() + start, count, position[i].begin() + start);
+
+		for(UINT32 i = 0; i < 4; i++)
+			std::copy_n(other.rotation[i].begin() + start, count, rotation[i].begin() + start);
+
+		for(UINT32 i = 0; i < 3; i++)
+			std::copy_n(other.scale[i].begin() + start, count, scale[i].begin() + start);
+	}
+
+	void TransformHierarchy::build(const Vector<INT32>& parents, const Vector<Transform>& locals)
+	{
+		clear();
+
+		if(parents.size() != locals.size())
+		{
+			LOGERR("Number of parents (" + toString((UINT32)parents.size()) + ") doesn't match the number of local "
+				"transforms (" + toString((UINT32)locals.size()) + ").");
+			return;
+		}
+
+		const UINT32 numNodes = (UINT32)parents.size();
+		for(UINT32 i = 0; i < numNodes; i++)
+		{
+			if(parents[i] >= (INT32)numNodes)
+			{
+				LOGERR("Invalid parent index: " + toString(parents[i]) + " for node " + toString(i) + ". Valid range: "
+					"0 .. " + toString(numNodes - 1) + ".");
+				return;
+			}
+		}
+
+		// Find children of each node, with children of all nodes stored in a single array
+		Vector<UINT32> childOffsets(numNodes + 1, 0);
+		for(UINT32 i = 0; i < numNodes; i++)
+		{
+			if(parents[i] >= 0)
+				childOffsets[parents[i] + 1]++;
+		}
+
+		for(UINT32 i = 0; i < numNodes; i++)
+			childOffsets[i + 1] += childOffsets[i];
+
+		Vector<UINT32> children(childOffsets[numNodes]);
+		Vector<UINT32> childWriteOffsets(childOffsets.begin(), childOffsets.end() - 1);
+		for(UINT32 i = 0; i < numNodes; i++)
+		{
+			if(parents[i] >= 0)
+				children[childWriteOffsets[parents[i]]++] = i;
+		}
+
+		// Traverse the hierarchy breadth-first, starting with all nodes without a parent. Each pass over the traversed
+		// nodes adds exactly one depth level.
+		Vector<UINT32> order;
+		order.reserve(numNodes);
+
+		for(UINT32 i = 0; i < numNodes; i++)
+		{
+			if(parents[i] < 0)
+				order.push_back(i);
+		}
+
+		UINT32 levelStart = 0;
+		while(levelStart < (UINT32)order.size())
+		{
+			const UINT32 levelEnd = (UINT32)order.size();
+			mLevelOffsets.push_back(levelEnd);
+
+			for(UINT32 i = levelStart; i < levelEnd; i++)
+			{
+				const UINT32 nodeIdx = order[i];
+				for(UINT32 j = childOffsets[nodeIdx]; j < childOffsets[nodeIdx + 1]; j++)
+					order.push_back(children[j]);
+			}
+
+			levelStart = levelEnd;
+		}
+
+		// Nodes that are part of a cycle, or descend from one, are never reached
+		if(order.size() != numNodes)
+		{
+			LOGERR("Unable to build the transform hierarchy, " + toString(numNodes - (UINT32)order.size()) + " nodes "
+				"are part of a cycle or descend from one.");
+
+			clear();
+			return;
+		}
+
+		mNodeIndices.resize(numNodes);
+		for(UINT32 i = 0; i < numNodes; i++)
+			mNodeIndices[order[i]] = i;
+
+		mParents.resize(numNodes);
+		mLocal.resize(numNodes);
+		mWorld.resize(numNodes);
+		for(UINT32 i = 0; i < numNodes; i++)
+		{
+			const INT32 parentIdx = parents[order[i]];
+
+			mParents[i] = parentIdx >= 0 ? (INT32)mNodeIndices[parentIdx] : -1;
+			mLocal.set(i, locals[order[i]]);
+		}
+	}
+
+	void TransformHierarchy::build(const HSceneObject& root)
+	{
+		Vector<HSceneObject> objects;
+		Vector<INT32> parents;
+		Vector<Transform> locals;
+
+		objects.push_back(root);
+		parents.push_back(-1);
+
+		for(UINT32 i = 0; i < (UINT32)objects.size(); i++)
+		{
+			// The root has no parent in the hierarchy, so it's stored with its world transform in order to account for
+			// transforms of its ancestors
+			const HSceneObject so = objects[i];
+			locals.push_back(i == 0 ? so->getTransform() : so->getLocalTransform());
+
+			const UINT32 numChildren = so->getNumChildren();
+			for(UINT32 j = 0; j < numChildren; j++)
+			{
+				HSceneObject child = so->getChild(j);
+
+				objects.push_back(child);
+				parents.push_back(child->getMobility() == ObjectMobility::Movable ? (INT32)i : -1);
+			}
+		}
+
+		build(parents, locals);
+
+		mSceneObjects.resize(objects.size());
+		for(UINT32 i = 0; i < (UINT32)objects.size(); i++)
+			mSceneObjects[mNodeIndices[i]] = objects[i];
+	}
+
+	void TransformHierarchy::applyToSceneObjects() const
+	{
+		for(UINT32 i = 0; i < (UINT32)mSceneObjects.size(); i++)
+		{
+			const HSceneObject& so = mSceneObjects[i];
+			if(so.isDestroyed())
+				continue;
+
+			const Transform local = mLocal.get(i);
+
+			// The root is stored with its world transform, see build()
+			if(i == mNodeIndices[0])
+			{
+				so->setWorldPosition(local.getPosition());
+				so->setWorldRotation(local.getRotation());
+				so->setWorldScale(local.getScale());
+				continue;
+			}
+
+			// Avoid notifying the object, and all of its descendants, of transform changes if nothing changed
+			const Transform& current = so->getLocalTransform();
+			if(current.getPosition() != local.getPosition())
+				so->setPosition(local.getPosition());
+
+			if(current.getRotation() != local.getRotation())
+				so->setRotation(local.getRotation());
+
+			if(current.getScale() != local.getScale())
+				so->setScale(local.getScale());
+		}
+	}
+
+	void TransformHierarchy::clear()
+	{
+		mParents.clear();
+		mLevelOffsets.assign(1, 0);
+		mNodeIndices.clear();
+		mSceneObjects.clear();
+		mLocal.resize(0);
+		mWorld.resize(0);
+	}
+
+	void TransformHierarchy::updateWorldTransforms()
+	{
+		if(getNumNodes() == 0)
+			return;
+
+		// Nodes without a parent are all in the first level
+		mWorld.copy(mLocal, 0, mLevelOffsets[1]);
+
+		// Levels must be processed in order, as each level depends on the world transforms of the previous one
+		TaskScheduler& taskScheduler = TaskScheduler::instance();
+		for(UINT32 i = 1; i < getNumLevels(); i++)
+		{
+			const UINT32 start = mLevelOffsets[i];
+			const UINT32 end = mLevelOffsets[i + 1];
+
+			if((end - start) >= PARALLEL_UPDATE_MIN_NODES)
+			{
+				taskScheduler.parallelFor(start, end, PARALLEL_UPDATE_GRAIN_SIZE,
+					[this](UINT32 rangeStart, UINT32 rangeEnd)
+				{
+					updateWorldTransforms(rangeStart, rangeEnd);
+				});
+			}
+			else
+				updateWorldTransforms(start, end);
+		}
+	}
+
+	void TransformHierarchy::updateWorldTransforms(UINT32 start, UINT32 end)
+	{
+		const simd::float32x4 one = simd::make_float(1.0f);
+
+		// Same as Transform::makeWorld(), for four nodes at a time
+		UINT32 i = start;
+		for(; i + 4 <= end; i += 4)
+		{
+			const INT32* parentIndices = &mParents[i];
+
+			const simd::float32x4 parentRotX = gather(mWorld.rotation[0], parentIndices);
+			const simd::float32x4 parentRotY = gather(mWorld.rotation[1], parentIndices);
+			const simd::float32x4 parentRotZ = gather(mWorld.rotation[2], parentIndices);
+			const simd::float32x4 parentRotW = gather(mWorld.rotation[3], parentIndices);
+
+			const simd::float32x4 localRotX = simd::load_u<simd::float32x4>(&mLocal.rotation[0][i]);
+			const simd::float32x4 localRotY = simd::load_u<simd::float32x4>(&mLocal.rotation[1][i]);
+			const simd::float32x4 localRotZ = simd::load_u<simd::float32x4>(&mLocal.rotation[2][i]);
+			const simd::float32x4 localRotW = simd::load_u<simd::float32x4>(&mLocal.rotation[3][i]);
+
+			// Rotation, same as Quaternion::operator*
+			simd::store_u(&mWorld.rotation[3][i], simd::sub(simd::sub(simd::sub(
+				simd::mul(parentRotW, localRotW), simd::mul(parentRotX, localRotX)), simd::mul(parentRotY, localRotY)),
+				simd::mul(parentRotZ, localRotZ)));
+			simd::store_u(&mWorld.rotation[0][i], simd::sub(simd::add(simd::add(
+				simd::mul(parentRotW, localRotX), simd::mul(parentRotX, localRotW)), simd::mul(parentRotY, localRotZ)),
+				simd::mul(parentRotZ, localRotY)));
+			simd::store_u(&mWorld.rotation[1][i], simd::sub(simd::add(simd::add(
+				simd::mul(parentRotW, localRotY), simd::mul(parentRotY, localRotW)), simd::mul(parentRotZ, localRotX)),
+				simd::mul(parentRotX, localRotZ)));
+			simd::store_u(&mWorld.rotation[2][i], simd::sub(simd::add(simd::add(
+				simd::mul(parentRotW, localRotZ), simd::mul(parentRotZ, localRotW)), simd::mul(parentRotX, localRotY)),
+				simd::mul(parentRotY, localRotX)));
+
+			// Scale, and position scaled by the parent's scale
+			simd::float32x4 scaledPos[3];
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const simd::float32x4 parentScale = gather(mWorld.scale[j], parentIndices);
+				const simd::float32x4 localScale = simd::load_u<simd::float32x4>(&mLocal.scale[j][i]);
+				const simd::float32x4 localPos = simd::load_u<simd::float32x4>(&mLocal.position[j][i]);
+
+				simd::store_u(&mWorld.scale[j][i], simd::mul(parentScale, localScale));
+				scaledPos[j] = simd::mul(parentScale, localPos);
+			}
+
+			// Position rotated by the parent's rotation, same as Quaternion::rotate
+			const simd::float32x4 tx = simd::add(parentRotX, parentRotX);
+			const simd::float32x4 ty = simd::add(parentRotY, parentRotY);
+			const simd::float32x4 tz = simd::add(parentRotZ, parentRotZ);
+			const simd::float32x4 twx = simd::mul(tx, parentRotW);
+			const simd::float32x4 twy = simd::mul(ty, parentRotW);
+			const simd::float32x4 twz = simd::mul(tz, parentRotW);
+			const simd::float32x4 txx = simd::mul(tx, parentRotX);
+			const simd::float32x4 txy = simd::mul(ty, parentRotX);
+			const simd::float32x4 txz = simd::mul(tz, parentRotX);
+			const simd::float32x4 tyy = simd::mul(ty, parentRotY);
+			const simd::float32x4 tyz = simd::mul(tz, parentRotY);
+			const simd::float32x4 tzz = simd::mul(tz, parentRotZ);
+
+			const simd::float32x4 rotation[3][3] =
+			{
+				{ simd::sub(one, simd::add(tyy, tzz)), simd::sub(txy, twz), simd::add(txz, twy) },
+				{ simd::add(txy, twz), simd::sub(one, simd::add(txx, tzz)), simd::sub(tyz, twx) },
+				{ simd::sub(txz, twy), simd::add(tyz, twx), simd::sub(one, simd::add(txx, tyy)) }
+			};
+
+			for(UINT32 j = 0; j < 3; j++)
+			{
+				const simd::float32x4 rotatedPos = simd::add(simd::add(
+					simd::mul(rotation[j][0], scaledPos[0]), simd::mul(rotation[j][1], scaledPos[1])),
+					simd::mul(rotation[j][2], scaledPos[2]));
+
+				simd::store_u(&mWorld.position[j][i], simd::add(rotatedPos, gather(mWorld.position[j], parentIndices)));
+			}
+		}
+
+		for(; i < end; i++)
+		{
+			Transform world = mLocal.get(i);
+			world.makeWorld(mWorld.get(mParents[i]));
+
+			mWorld.set(i, world);
+		}
+	}
+}
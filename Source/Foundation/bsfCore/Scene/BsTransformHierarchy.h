@@ -0,0 +1,133 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsCorePrerequisites.h"
+#include "Scene/BsTransform.h"
+
+namespace bs
+{
+	/** @addtogroup Scene-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Stores transforms of a hierarchy of nodes in contiguous arrays, allowing world transforms of the entire hierarchy to
+	 * be calculated in a single linear pass. This is an optional alternative to the per-object transforms of SceneObject,
+	 * useful when world transforms of a large hierarchy need to be calculated all at once.
+	 *
+	 * Nodes are stored in breadth-first order, so all nodes of the same depth are stored next to each other and every
+	 * parent is stored before its children. Position, rotation and scale of local and world transforms are each stored in
+	 * separate arrays per component.
+	 *
+	 * The hierarchy is not kept in sync with the scene objects it was built from. Changes made to the scene objects after
+	 * the hierarchy was built require the hierarchy to be rebuilt, and local transforms modified in the hierarchy are
+	 * only applied to the scene objects by calling applyToSceneObjects().
+	 */
+	class BS_CORE_EXPORT TransformHierarchy
+	{
+		/** Transforms of all nodes, with each component of position, rotation and scale stored in a separate array. */
+		struct TransformArrays
+		{
+			/** Changes the number of stored transforms. */
+			void resize(UINT32 size);
+
+			/** Assigns the transform at the specified index. */
+			void set(UINT32 idx, const Transform& transform);
+
+			/** Returns the transform at the specified index. */
+			Transform get(UINT32 idx) const;
+
+			/** Copies @p count transforms starting at @p start from @p other. */
+			void copy(const TransformArrays& other, UINT32 start, UINT32 count);
+
+			Vector<float> position[3];
+			Vector<float> rotation[4];
+			Vector<float> scale[3];
+		};
+
+	public:
+		/**
+		 * Rebuilds the hierarchy from the provided set of nodes.
+		 *
+		 * @param[in]	parents		Index of the parent of each node, or -1 if the node has no parent. Parents can be
+		 *							provided in any order, as long as the hierarchy contains no cycles.
+		 * @param[in]	locals		Transform of each node, relative to its parent. Must be the same size as @p parents.
+		 *
+		 * @note	If the sizes don't match, a parent index is out of range or the nodes contain a cycle, an error is
+		 *			logged and the hierarchy is left empty.
+		 */
+		void build(const Vector<INT32>& parents, const Vector<Transform>& locals);
+
+		/**
+		 * Rebuilds the hierarchy from the scene object @p root and all of its descendants. Objects that are not movable
+		 * are stored as nodes without a parent, since they ignore parent transforms. The root is stored with its world
+		 * transform, since transforms of its ancestors are not part of the hierarchy. Scene object of each node can be
+		 * retrieved through getSceneObject().
+		 */
+		void build(const HSceneObject& root);
+
+		/** Recalculates world transforms of all nodes from their local transforms. */
+		void updateWorldTransforms();
+
+		/**
+		 * Assigns the local transforms of all nodes to the scene objects they were created from. Only relevant if the
+		 * hierarchy was built from a scene object hierarchy. The root object is assigned its world transform, and objects
+		 * that are not movable or were destroyed since the hierarchy was built are skipped.
+		 */
+		void applyToSceneObjects() const;
+
+		/** Returns the number of nodes in the hierarchy. */
+		UINT32 getNumNodes() const { return (UINT32)mParents.size(); }
+
+		/** Returns the number of depth levels in the hierarchy. Nodes without parents are at level 0. */
+		UINT32 getNumLevels() const { return (UINT32)mLevelOffsets.size() - 1; }
+
+		/**
+		 * Maps the index of a node as provided to build() to the index of the node in the hierarchy, as used by all other
+		 * methods.
+		 */
+		UINT32 getNodeIdx(UINT32 buildIdx) const { return mNodeIndices[buildIdx]; }
+
+		/** Returns the index of the parent of the specified node, or -1 if it has no parent. */
+		INT32 getParent(UINT32 nodeIdx) const { return mParents[nodeIdx]; }
+
+		/**
+		 * Returns the scene object the node was created from. Only valid if the hierarchy was built from a scene object
+		 * hierarchy.
+		 */
+		const HSceneObject& getSceneObject(UINT32 nodeIdx) const { return mSceneObjects[nodeIdx]; }
+
+		/**
+		 * Determines the transform of the node relative to its parent. World transforms are not updated until the next
+		 * call to updateWorldTransforms().
+		 */
+		void setLocalTransform(UINT32 nodeIdx, const Transform& transform) { mLocal.set(nodeIdx, transform); }
+
+		/** @copydoc setLocalTransform */
+		Transform getLocalTransform(UINT32 nodeIdx) const { return mLocal.get(nodeIdx); }
+
+		/** Returns the world transform of the node, as of the last call to updateWorldTransforms(). */
+		Transform getWorldTransform(UINT32 nodeIdx) const { return mWorld.get(nodeIdx); }
+
+	private:
+		/** Removes all nodes from the hierarchy. */
+		void clear();
+
+		/**
+		 * Calculates world transforms for nodes in range [@p start, @p end). World transforms of the parents of those
+		 * nodes must already be up to date.
+		 */
+		void updateWorldTransforms(UINT32 start, UINT32 end);
+
+		Vector<INT32> mParents;
+		Vector<UINT32> mLevelOffsets = { 0 };
+		Vector<UINT32> mNodeIndices;
+		Vector<HSceneObject> mSceneObjects;
+
+		TransformArrays mLocal;
+		TransformArrays mWorld;
+	};
+
+	/** @} */
+}
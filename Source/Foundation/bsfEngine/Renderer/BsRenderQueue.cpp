@@ -7,10 +7,37 @@
 #include "Material/BsMaterial.h"
 #include "Renderer/BsRenderElement.h"
 
-using namespace std::placeholders;
-
 namespace bs { namespace ct
 {
+	/** Number of key bits used for storing the queue priority. */
+	static constexpr UINT32 PRIORITY_BITS = 16;
+
+	/** Number of key bits used for storing the distance from the camera, when grouped together with material data. */
+	static constexpr UINT32 DISTANCE_BITS = 24;
+
+	/** Number of key bits used for storing material data (shader, technique and pass indices). */
+	static constexpr UINT32 SHADER_BITS = 14;
+	static constexpr UINT32 TECHNIQUE_BITS = 6;
+	static constexpr UINT32 PASS_BITS = 4;
+
+	static_assert(PRIORITY_BITS + DISTANCE_BITS + SHADER_BITS + TECHNIQUE_BITS + PASS_BITS == 64,
+		"Sort key must use exactly 64 bits.");
+
+	/** Converts a floating point value into an unsigned integer that sorts in the same order as the original value. */
+	static UINT32 toSortableBits(float value)
+	{
+		// Make sure negative zero sorts the same as positive zero
+		if(value == 0.0f)
+			value = 0.0f;
+
+		UINT32 bits;
+		memcpy(&bits, &value, sizeof(bits));
+
+		// Flip all bits of negative values so they sort in reverse, and set the sign bit of positive values so they sort
+		// after negative ones
+		return (bits & 0x80000000) ? ~bits : (bits | 0x80000000);
+	}
+
 	RenderQueue::RenderQueue(StateReduction mode)
 		:mStateReductionMode(mode)
 	{
@@ -20,7 +47,6 @@ namespace bs { namespace ct
 	void RenderQueue::clear()
 	{
 		mSortableElements.clear();
-		mSortableElementIdx.clear();
 		mElements.clear();
 
 		mSortedRenderElements.clear();
@@ -30,12 +56,14 @@ namespace bs { namespace ct
 	{
 		SPtr<Material> material = element->material;
 		SPtr<Shader> shader = material->getShader();
-		
-		UINT32 queuePriority = shader->getQueuePriority();
-		QueueSortType sortType = shader->getQueueSortType();
-		UINT32 shaderId = shader->getId();
-		bool separablePasses = shader->getAllowSeparablePasses();
 
+		add(element, distFromCamera, techniqueIdx, material->getNumPasses(techniqueIdx), shader->getId(), 
+			shader->getQueuePriority(), shader->getQueueSortType(), shader->getAllowSeparablePasses());
+	}
+
+	void RenderQueue::add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx, UINT32 numPasses,
+		UINT32 shaderId, INT32 queuePriority, QueueSortType sortType, bool separablePasses)
+	{
 		switch (sortType)
 		{
 		case QueueSortType::None:
@@ -48,23 +76,20 @@ namespace bs { namespace ct
 			break;
 		}
 
-		UINT32 numPasses = material->getNumPasses(techniqueIdx);
-		if (!separablePasses)
-			numPasses = std::min(1U, numPasses);
+		// Separable passes are sorted individually, otherwise all passes are sorted (and rendered) as a single element
+		const UINT32 numSortablePasses = separablePasses ? numPasses : std::min(1U, numPasses);
+		const UINT32 numPassesPerElement = separablePasses ? 1 : numPasses;
 
-		for (UINT32 i = 0; i < numPasses; i++)
+		for (UINT32 i = 0; i < numSortablePasses; i++)
 		{
-			UINT32 idx = (UINT32)mSortableElementIdx.size();
-			mSortableElementIdx.push_back(idx);
-
 			mSortableElements.push_back(SortableElement());
 			SortableElement& sortableElem = mSortableElements.back();
 
-			sortableElem.seqIdx = idx;
 			sortableElem.priority = queuePriority;
 			sortableElem.shaderId = shaderId;
 			sortableElem.techniqueIdx = techniqueIdx;
 			sortableElem.passIdx = i;
+			sortableElem.numPasses = numPassesPerElement;
 			sortableElem.distFromCamera = distFromCamera;
 
 			mElements.push_back(element);
@@ -73,138 +98,87 @@ namespace bs { namespace ct
 
 	void RenderQueue::sort()
 	{
-		std::function<bool(UINT32, UINT32, const Vector<SortableElement>&)> sortMethod;
+		const auto numElements = (UINT32)mSortableElements.size();
 
-		switch (mStateReductionMode)
+		mSortKeys.resize(numElements);
+		mSortScratch.resize(numElements);
+
+		UINT32 numSortedElements = 0;
+		for (UINT32 i = 0; i < numElements; i++)
 		{
-		case StateReduction::None:
-			sortMethod = &elementSorterNoGroup;
-			break;
-		case StateReduction::Material:
-			sortMethod = &elementSorterPreferGroup;
-			break;
-		case StateReduction::Distance:
-			sortMethod = &elementSorterPreferSort;
-			break;
+			mSortKeys[i].key = getSortKey(mSortableElements[i]);
+			mSortKeys[i].value = i;
+
+			numSortedElements += mSortableElements[i].numPasses;
 		}
 
-		// Sort only indices since we generate an entirely new data set anyway, it doesn't make sense to move sortable elements
-		std::sort(mSortableElementIdx.begin(), mSortableElementIdx.end(), std::bind(sortMethod, _1, _2, mSortableElements));
+		// Radix sort is stable, so elements with equal keys remain in the order they were added in
+		RadixSort::sort(mSortKeys.data(), mSortScratch.data(), numElements);
+
+		mSortedRenderElements.resize(numSortedElements);
 
 		UINT32 prevShaderId = (UINT32)-1;
 		UINT32 prevTechniqueIdx = (UINT32)-1;
 		UINT32 prevPassIdx = (UINT32)-1;
-		for (UINT32 i = 0; i < (UINT32)mSortableElementIdx.size(); i++)
+		UINT32 outputIdx = 0;
+		for (UINT32 i = 0; i < numElements; i++)
 		{
-			const UINT32 idx = mSortableElementIdx[i];
+			const UINT32 idx = mSortKeys[i].value;
 			const SortableElement& elem = mSortableElements[idx];
 			const RenderElement* renderElem = mElements[idx];
 
-			const bool separablePasses = renderElem->material->getShader()->getAllowSeparablePasses();
-
-			if (separablePasses)
+			for (UINT32 j = 0; j < elem.numPasses; j++)
 			{
-				mSortedRenderElements.push_back(RenderQueueElement());
+				const UINT32 passIdx = elem.passIdx + j;
 
-				RenderQueueElement& sortedElem = mSortedRenderElements.back();
+				RenderQueueElement& sortedElem = mSortedRenderElements[outputIdx++];
 				sortedElem.renderElem = renderElem;
 				sortedElem.techniqueIdx = elem.techniqueIdx;
-				sortedElem.passIdx = elem.passIdx;
+				sortedElem.passIdx = passIdx;
 
-				if (prevShaderId != elem.shaderId || prevTechniqueIdx != elem.techniqueIdx ||  prevPassIdx != elem.passIdx)
+				if (prevShaderId != elem.shaderId || prevTechniqueIdx != elem.techniqueIdx || prevPassIdx != passIdx)
 				{
 					sortedElem.applyPass = true;
 					prevShaderId = elem.shaderId;
 					prevTechniqueIdx = elem.techniqueIdx;
-					prevPassIdx = elem.passIdx;
+					prevPassIdx = passIdx;
 				}
 				else
 					sortedElem.applyPass = false;
 			}
-			else
-			{
-				const UINT32 numPasses = renderElem->material->getNumPasses(elem.techniqueIdx);
-				for (UINT32 j = 0; j < numPasses; j++)
-				{
-					mSortedRenderElements.push_back(RenderQueueElement());
-
-					RenderQueueElement& sortedElem = mSortedRenderElements.back();
-					sortedElem.renderElem = renderElem;
-					sortedElem.techniqueIdx = elem.techniqueIdx;
-					sortedElem.passIdx = j;
-
-					if (prevShaderId != elem.shaderId || prevTechniqueIdx != elem.techniqueIdx || prevPassIdx != j)
-					{
-						sortedElem.applyPass = true;
-						prevShaderId = elem.shaderId;
-						prevTechniqueIdx = elem.techniqueIdx;
-						prevPassIdx = j;
-					}
-					else
-						sortedElem.applyPass = false;
-				}
-			}
 		}
 	}
 
-	bool RenderQueue::elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
+	UINT64 RenderQueue::getSortKey(const SortableElement& element) const
 	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
+		// Higher priority elements are rendered first
+		const INT32 priority = Math::clamp(element.priority, (INT32)std::numeric_limits<INT16>::min(),
+			(INT32)std::numeric_limits<INT16>::max());
+		const UINT64 priorityBits = (UINT64)(std::numeric_limits<INT16>::max() - priority);
 
-		UINT8 isLower = (a.priority < b.priority) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
+		const UINT64 distanceBits = toSortableBits(element.distFromCamera);
 
-		return isHigher > isLower;
-	}
+		// Only used for grouping elements with the same state together, so potential collisions in the lower bits only
+		// affect the number of state changes
+		const UINT64 materialBits =
+			((UINT64)(element.shaderId & ((1 << SHADER_BITS) - 1)) << (TECHNIQUE_BITS + PASS_BITS)) |
+			((UINT64)(element.techniqueIdx & ((1 << TECHNIQUE_BITS) - 1)) << PASS_BITS) |
+			(UINT64)(element.passIdx & ((1 << PASS_BITS) - 1));
 
-	bool RenderQueue::elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-		
-		UINT8 isHigher = (a.priority > b.priority) << 5 |
-			(a.shaderId < b.shaderId) << 4 |
-			(a.techniqueIdx < b.techniqueIdx) << 3 |
-			(a.passIdx < b.passIdx) << 2 |
-			(a.distFromCamera < b.distFromCamera) << 1 |
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 5 |
-			(a.shaderId > b.shaderId) << 4 |
-			(a.techniqueIdx > b.techniqueIdx) << 3 |
-			(a.passIdx > b.passIdx) << 2 |
-			(a.distFromCamera > b.distFromCamera) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
-	}
+		const UINT32 priorityShift = 64 - PRIORITY_BITS;
+		const UINT32 materialBitCount = SHADER_BITS + TECHNIQUE_BITS + PASS_BITS;
+		const UINT64 quantizedDistanceBits = distanceBits >> (32 - DISTANCE_BITS);
 
-	bool RenderQueue::elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup)
-	{
-		const SortableElement& a = lookup[aIdx];
-		const SortableElement& b = lookup[bIdx];
-
-		UINT8 isHigher = (a.priority > b.priority) << 5 | 
-			(a.distFromCamera < b.distFromCamera) << 4 | 
-			(a.shaderId < b.shaderId) << 3 | 
-			(a.techniqueIdx < b.techniqueIdx) << 2 |
-			(a.passIdx < b.passIdx) << 1 | 
-			(a.seqIdx < b.seqIdx);
-
-		UINT8 isLower = (a.priority < b.priority) << 5 |
-			(a.distFromCamera > b.distFromCamera) << 4 |
-			(a.shaderId > b.shaderId) << 3 |
-			(a.techniqueIdx > b.techniqueIdx) << 2 |
-			(a.passIdx > b.passIdx) << 1 |
-			(a.seqIdx > b.seqIdx);
-
-		return isHigher > isLower;
+		switch (mStateReductionMode)
+		{
+		default:
+		case StateReduction::None:
+			return (priorityBits << priorityShift) | (distanceBits << (priorityShift - 32));
+		case StateReduction::Material:
+			return (priorityBits << priorityShift) | (materialBits << DISTANCE_BITS) | quantizedDistanceBits;
+		case StateReduction::Distance:
+			return (priorityBits << priorityShift) | (quantizedDistanceBits << materialBitCount) | materialBits;
+		}
 	}
 
 	const Vector<RenderQueueElement>& RenderQueue::getSortedElements() const
@@ -5,6 +5,7 @@
 #include "BsPrerequisites.h"
 #include "Math/BsVector3.h"
 #include "RenderAPI/BsSubMesh.h"
+#include "Utility/BsRadixSort.h"
 
 namespace bs { namespace ct
 {
@@ -38,17 +39,6 @@ namespace bs { namespace ct
 	 */
 	class BS_EXPORT RenderQueue
 	{
-		/**	Data used for renderable element sorting. Represents a single pass for a single mesh. */
-		struct SortableElement
-		{
-			UINT32 seqIdx;
-			INT32 priority;
-			float distFromCamera;
-			UINT32 shaderId;
-			UINT32 techniqueIdx;
-			UINT32 passIdx;
-		};
-
 	public:
 		RenderQueue(StateReduction grouping = StateReduction::Distance);
 		virtual ~RenderQueue() = default;
@@ -79,18 +69,47 @@ namespace bs { namespace ct
 		void setStateReduction(StateReduction mode) { mStateReductionMode = mode; }
 
 	protected:
-		/**	Callback used for sorting elements with no material grouping. */
-		static bool elementSorterNoGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Data used for renderable element sorting. Represents a single pass for a single mesh, or all passes of a mesh if
+		 * the shader doesn't allow its passes to be separated.
+		 */
+		struct SortableElement
+		{
+			INT32 priority;
+			float distFromCamera;
+			UINT32 shaderId;
+			UINT32 techniqueIdx;
+			UINT32 passIdx;
+			UINT32 numPasses;
+		};
 
-		/**	Callback used for sorting elements with preferred material grouping. */
-		static bool elementSorterPreferGroup(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Adds a new entry to the render queue, using the provided shader properties instead of reading them from the
+		 * element's material.
+		 *
+		 * @param[in]	element			Renderable element to add to the queue.
+		 * @param[in]	distFromCamera	Distance of this object from the camera. Used for distance sorting.
+		 * @param[in]	techniqueIdx	Index of the technique to render the element with.
+		 * @param[in]	numPasses		Number of passes in the technique.
+		 * @param[in]	shaderId		Unique identifier of the shader, used for grouping elements by material.
+		 * @param[in]	queuePriority	Priority of the shader's queue. Higher priority elements are rendered first.
+		 * @param[in]	sortType		Determines how are the shader's elements sorted by distance.
+		 * @param[in]	separablePasses	If true each pass is sorted as a separate element, otherwise all passes are sorted
+		 *								(and rendered) together.
+		 */
+		void add(const RenderElement* element, float distFromCamera, UINT32 techniqueIdx, UINT32 numPasses, 
+			UINT32 shaderId, INT32 queuePriority, QueueSortType sortType, bool separablePasses);
 
-		/**	Callback used for sorting elements with material grouping after sorting. */
-		static bool elementSorterPreferSort(UINT32 aIdx, UINT32 bIdx, const Vector<SortableElement>& lookup);
+		/**
+		 * Encodes the properties of a sortable element into a key that sorts in the order in which the elements should be
+		 * rendered, according to the current state reduction mode.
+		 */
+		UINT64 getSortKey(const SortableElement& element) const;
 
 		Vector<SortableElement> mSortableElements;
-		Vector<UINT32> mSortableElementIdx;
 		Vector<const RenderElement*> mElements;
+		Vector<RadixSortEntry> mSortKeys;
+		Vector<RadixSortEntry> mSortScratch;
 
 		Vector<RenderQueueElement> mSortedRenderElements;
 		StateReduction mStateReductionMode;
@@ -24,6 +24,22 @@ namespace bs
 		return Importer::instance().import<ShaderInclude>(path);
 	}
 
+	Path EngineShaderIncludeHandler::findIncludePath(const String& name) const
+	{
+		Path path = toResourcePath(name);
+
+		if (path.isEmpty())
+			return Path::BLANK;
+
+		if (name.size() >= 8)
+		{
+			if (name.substr(0, 8) == "$ENGINE$")
+				return path;
+		}
+
+		return Paths::findPath(name);
+	}
+
 	Path EngineShaderIncludeHandler::toResourcePath(const String& name)
 	{
 		if (name.substr(0, 8) == "$ENGINE$")
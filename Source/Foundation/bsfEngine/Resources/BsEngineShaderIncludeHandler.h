@@ -21,6 +21,9 @@ namespace bs
 		/** @copydoc IShaderIncludeHandler::findInclude */
 		HShaderInclude findInclude(const String& name) const override;
 
+		/** @copydoc IShaderIncludeHandler::findIncludePath */
+		Path findIncludePath(const String& name) const override;
+
 		/** Converts a shader include name or path to a path of the resource containing include data. */
 		static Path toResourcePath(const String& name);
 	};
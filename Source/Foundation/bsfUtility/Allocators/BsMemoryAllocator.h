@@ -9,6 +9,8 @@
 #include <cstdint>
 #include <utility>
 
+#include "Allocators/BsThreadCachingAlloc.h"
+
 #if BS_PLATFORM == BS_PLATFORM_LINUX
 #  include <malloc.h>
 #endif
@@ -136,7 +138,8 @@ namespace bs
 	 * Memory allocator providing a generic implementation. Specialize for specific categories as needed.
 	 *
 	 * @note	For example you might implement a pool allocator for specific types in order
-	 * 			to reduce allocation overhead. By default standard malloc/free are used.
+	 * 			to reduce allocation overhead. By default standard malloc/free are used, unless BS_USE_CACHING_ALLOCATOR
+	 *			is enabled in which case ThreadCachingAlloc is used instead.
 	 */
 	template<class T>
 	class MemoryAllocator : public MemoryAllocatorBase
@@ -149,7 +152,11 @@ namespace bs
 			incAllocCount();
 #endif
 
+#if BS_USE_CACHING_ALLOCATOR
+			return ThreadCachingAlloc::allocate(bytes);
+#else
 			return malloc(bytes);
+#endif
 		}
 
 		/**
@@ -182,7 +189,11 @@ namespace bs
 			incFreeCount();
 #endif
 
+#if BS_USE_CACHING_ALLOCATOR
+			ThreadCachingAlloc::free(ptr);
+#else
 			::free(ptr);
+#endif
 		}
 
 		/** Frees memory allocated with allocateAligned() */
@@ -20,6 +20,8 @@ namespace bs
 	 * @note		Static allocations can only be freed if memory is deallocated in opposite order it is allocated.
 	 *				Otherwise static memory gets orphaned until a call to clear(). Dynamic memory allocations behave
 	 *				depending on the selected allocator.
+	 * @note		Static allocations are aligned to 16 bytes, so the allocator can hold SIMD types. Dynamic allocations
+	 *				are aligned as the selected allocator aligns them.
 	 * 
 	 * @tparam	BlockSize			Size of the initially allocated static block, and minimum size of any dynamically 
 	 *								allocated memory.
@@ -68,6 +70,21 @@ namespace bs
 			MemBlock* mNextBlock = nullptr;
 		};
 
+		/** Alignment of all static allocations, and the size of the allocation header in debug mode. */
+		static constexpr UINT32 ALIGNMENT = 16;
+
+#if BS_DEBUG_MODE
+		static constexpr UINT32 HEADER_SIZE = ALIGNMENT;
+#else
+		static constexpr UINT32 HEADER_SIZE = 0;
+#endif
+
+		/** Returns the number of bytes taken by an allocation of the specified size, including header and padding. */
+		static UINT32 getPaddedSize(UINT32 amount)
+		{
+			return (amount + HEADER_SIZE + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+		}
+
 	public:
 		StaticAlloc() = default;
 		~StaticAlloc() = default;
@@ -82,9 +99,7 @@ namespace bs
 			if (amount == 0)
 				return nullptr;
 
-#if BS_DEBUG_MODE
-			amount += sizeof(UINT32);
-#endif
+			amount = getPaddedSize(amount);
 
 			UINT32 freeMem = BlockSize - mFreePtr;
 			
@@ -102,11 +117,9 @@ namespace bs
 
 			UINT32* storedSize = reinterpret_cast<UINT32*>(data);
 			*storedSize = amount;
-
-			return data + sizeof(UINT32);
-#else
-			return data;
 #endif
+
+			return data + HEADER_SIZE;
 		}
 
 		/** Deallocates a previously allocated piece of memory. */
@@ -115,17 +128,16 @@ namespace bs
 			if (data == nullptr)
 				return;
 
-			UINT8* dataPtr = (UINT8*)data;
+			UINT8* dataPtr = (UINT8*)data - HEADER_SIZE;
 #if BS_DEBUG_MODE
-			dataPtr -= sizeof(UINT32);
-
 			UINT32* storedSize = (UINT32*)(dataPtr);
 			mTotalAllocBytes -= *storedSize;
 #endif
 
-			if(data > mStaticData && data < (mStaticData + BlockSize))
+			if(dataPtr >= mStaticData && dataPtr < (mStaticData + BlockSize))
 			{
-				if((((UINT8*)data) + allocSize) == (mStaticData + mFreePtr))
+				allocSize = getPaddedSize(allocSize);
+				if((dataPtr + allocSize) == (mStaticData + mFreePtr))
 					mFreePtr -= allocSize;
 			}
 			else
@@ -138,14 +150,12 @@ namespace bs
 			if (data == nullptr)
 				return;
 
-			UINT8* dataPtr = (UINT8*)data;
+			UINT8* dataPtr = (UINT8*)data - HEADER_SIZE;
 #if BS_DEBUG_MODE
-			dataPtr -= sizeof(UINT32);
-
 			UINT32* storedSize = (UINT32*)(dataPtr);
 			mTotalAllocBytes -= *storedSize;
 #endif
-			if(data < mStaticData || data >= (mStaticData + BlockSize))
+			if(dataPtr < mStaticData || dataPtr >= (mStaticData + BlockSize))
 				mDynamicAlloc.free(dataPtr);
 		}
 
@@ -206,7 +216,7 @@ namespace bs
 		}
 
 	private:
-		UINT8 mStaticData[BlockSize];
+		alignas(ALIGNMENT) UINT8 mStaticData[BlockSize];
 		UINT32 mFreePtr = 0;
 		DynamicAllocator mDynamicAlloc;
 
@@ -257,7 +267,7 @@ namespace bs
 		/** Deallocate storage p of deleted elements. */
 		void deallocate(T* p, size_t num) const noexcept
 		{
-			mStaticAlloc->free((UINT8*)p, (UINT32)num);
+			mStaticAlloc->free((UINT8*)p, (UINT32)(num * sizeof(T)));
 		}
 
 		StaticAlloc<BlockSize, FreeAlloc>* mStaticAlloc = nullptr;
@@ -0,0 +1,276 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Allocators/BsThreadCachingAlloc.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** Number of size classes for allocations up to 128 bytes, in 16 byte increments. */
+	static constexpr UINT32 NUM_LINEAR_SIZE_CLASSES = 8;
+
+	/**
+	 * Number of size classes for each power of two range above 128 bytes. Each range is split into this many equally
+	 * sized classes, meaning at most 25% of each allocation is wasted.
+	 */
+	static constexpr UINT32 NUM_SIZE_CLASSES_PER_RANGE = 4;
+
+	/** Number of power of two ranges above 128 bytes (128-256, 256-512, ...). */
+	static constexpr UINT32 NUM_RANGES = 5;
+
+	static constexpr UINT32 NUM_SIZE_CLASSES = NUM_LINEAR_SIZE_CLASSES + NUM_RANGES * NUM_SIZE_CLASSES_PER_RANGE;
+
+	/** Largest allocation served from the per-thread caches. Larger allocations use the system allocator. */
+	static constexpr size_t MAX_SMALL_ALLOC_SIZE = 128 << NUM_RANGES;
+
+	/** Size of the memory chunks requested from the system when a cache runs out of free blocks of some size class. */
+	static constexpr size_t CHUNK_SIZE = 64 * 1024;
+
+	/** Size class used for marking allocations forwarded to the system allocator. */
+	static constexpr UINT32 LARGE_SIZE_CLASS = (UINT32)-1;
+
+	struct ThreadCache;
+
+	/** Header stored in front of every allocation. Its size keeps allocations 16 byte aligned. */
+	struct BlockHeader
+	{
+		ThreadCache* owner;
+		UINT32 sizeClass;
+		UINT32 padding;
+	};
+
+	static constexpr size_t HEADER_SIZE = sizeof(BlockHeader);
+	static_assert(HEADER_SIZE == 16, "Allocation header must preserve 16 byte alignment.");
+
+	/** Entry in a free list, stored in the memory of the freed allocation (after the header). */
+	struct FreeBlock
+	{
+		FreeBlock* next;
+	};
+
+	/** Free blocks owned by a single thread. */
+	struct ThreadCache
+	{
+		/** Blocks freed by the owning thread, one list per size class. Only accessed by the owning thread. */
+		FreeBlock* freeLists[NUM_SIZE_CLASSES] = { };
+
+		/** Blocks freed by other threads, to be moved to the free lists by the owning thread. */
+		std::atomic<FreeBlock*> remoteFreeList{nullptr};
+
+		/** Next cache in the list of caches whose threads have exited. */
+		ThreadCache* nextOrphan = nullptr;
+	};
+
+	/** Caches released by exited threads, ready to be reused by new threads. Constant initialized. */
+	static std::atomic_flag gOrphanLock = ATOMIC_FLAG_INIT;
+	static ThreadCache* gOrphanedCaches = nullptr;
+
+	static BS_THREADLOCAL ThreadCache* gThreadCache = nullptr;
+	static BS_THREADLOCAL bool gThreadExited = false;
+
+	/** Returns the size class for an allocation of the specified size. Size must be non-zero. */
+	static UINT32 getSizeClass(size_t size)
+	{
+		const auto lastByte = (UINT32)(size - 1);
+		if(size <= 128)
+			return lastByte >> 4;
+
+		// Split the [2^N, 2^(N+1)) range the size falls in into NUM_SIZE_CLASSES_PER_RANGE parts
+		const UINT32 range = Bitwise::mostSignificantBit(lastByte);
+		const UINT32 classInRange = (lastByte - (1 << range)) >> (range - 2);
+
+		return NUM_LINEAR_SIZE_CLASSES + (range - 7) * NUM_SIZE_CLASSES_PER_RANGE + classInRange;
+	}
+
+	/** Returns the number of bytes available in allocations of the specified size class. */
+	static size_t getSizeClassSize(UINT32 sizeClass)
+	{
+		if(sizeClass < NUM_LINEAR_SIZE_CLASSES)
+			return (sizeClass + 1) * 16;
+
+		const UINT32 range = (sizeClass - NUM_LINEAR_SIZE_CLASSES) / NUM_SIZE_CLASSES_PER_RANGE;
+		const UINT32 classInRange = (sizeClass - NUM_LINEAR_SIZE_CLASSES) % NUM_SIZE_CLASSES_PER_RANGE;
+
+		const size_t rangeStart = (size_t)128 << range;
+		return rangeStart + (classInRange + 1) * (rangeStart / NUM_SIZE_CLASSES_PER_RANGE);
+	}
+
+	static BlockHeader* getHeader(void* ptr)
+	{
+		return (BlockHeader*)((UINT8*)ptr - HEADER_SIZE);
+	}
+
+	/** Returns the cache of a thread that exited, or creates a new cache if there are none. */
+	static ThreadCache* acquireCache()
+	{
+		ThreadCache* cache = nullptr;
+
+		while(gOrphanLock.test_and_set(std::memory_order_acquire))
+		{ }
+
+		if(gOrphanedCaches != nullptr)
+		{
+			cache = gOrphanedCaches;
+			gOrphanedCaches = cache->nextOrphan;
+		}
+
+		gOrphanLock.clear(std::memory_order_release);
+
+		if(cache == nullptr)
+			return new (::malloc(sizeof(ThreadCache))) ThreadCache();
+
+		cache->nextOrphan = nullptr;
+		return cache;
+	}
+
+	/**
+	 * Makes the cache available to other threads. Caches are never destroyed since allocations they own might still be
+	 * alive and freed at a later point.
+	 */
+	static void releaseCache(ThreadCache* cache)
+	{
+		while(gOrphanLock.test_and_set(std::memory_order_acquire))
+		{ }
+
+		cache->nextOrphan = gOrphanedCaches;
+		gOrphanedCaches = cache;
+
+		gOrphanLock.clear(std::memory_order_release);
+	}
+
+	/** Releases the cache of the current thread when the thread exits. */
+	struct ThreadCacheRelease
+	{
+		~ThreadCacheRelease()
+		{
+			if(gThreadCache != nullptr)
+				releaseCache(gThreadCache);
+
+			gThreadCache = nullptr;
+			gThreadExited = true;
+		}
+	};
+
+	/** Returns the cache of the current thread, or null if the thread is in the process of exiting. */
+	static ThreadCache* getThreadCache()
+	{
+		if(gThreadCache != nullptr)
+			return gThreadCache;
+
+		// Thread-local destructors already ran, the cache can no longer be released on exit
+		if(gThreadExited)
+			return nullptr;
+
+		static thread_local ThreadCacheRelease release;
+		(void)release;
+
+		gThreadCache = acquireCache();
+		return gThreadCache;
+	}
+
+	/** Moves blocks freed by other threads into the free lists of the provided cache. */
+	static void collectRemoteFrees(ThreadCache* cache)
+	{
+		FreeBlock* block = cache->remoteFreeList.exchange(nullptr, std::memory_order_acquire);
+		while(block != nullptr)
+		{
+			FreeBlock* next = block->next;
+
+			const UINT32 sizeClass = getHeader(block)->sizeClass;
+			block->next = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block;
+
+			block = next;
+		}
+	}
+
+	/** Splits a new chunk of memory into blocks of the specified size class, and adds them to the cache. */
+	static void allocateChunk(ThreadCache* cache, UINT32 sizeClass)
+	{
+		const size_t blockSize = HEADER_SIZE + getSizeClassSize(sizeClass);
+		const size_t numBlocks = CHUNK_SIZE / blockSize;
+
+		auto chunk = (UINT8*)::malloc(numBlocks * blockSize);
+		for(size_t i = 0; i < numBlocks; i++)
+		{
+			auto header = (BlockHeader*)(chunk + i * blockSize);
+			header->owner = cache;
+			header->sizeClass = sizeClass;
+			header->padding = 0;
+
+			auto block = (FreeBlock*)((UINT8*)header + HEADER_SIZE);
+			block->next = cache->freeLists[sizeClass];
+			cache->freeLists[sizeClass] = block;
+		}
+	}
+
+	/** Allocates memory from the system allocator, with a header marking it as such. */
+	static void* allocateLarge(size_t bytes)
+	{
+		auto header = (BlockHeader*)::malloc(HEADER_SIZE + bytes);
+		header->owner = nullptr;
+		header->sizeClass = LARGE_SIZE_CLASS;
+		header->padding = 0;
+
+		return (UINT8*)header + HEADER_SIZE;
+	}
+
+	void* ThreadCachingAlloc::allocate(size_t bytes)
+	{
+		if(bytes > MAX_SMALL_ALLOC_SIZE)
+			return allocateLarge(bytes);
+
+		ThreadCache* cache = getThreadCache();
+		if(cache == nullptr)
+			return allocateLarge(bytes);
+
+		const UINT32 sizeClass = getSizeClass(std::max(bytes, (size_t)1));
+
+		FreeBlock* block = cache->freeLists[sizeClass];
+		if(block == nullptr)
+		{
+			collectRemoteFrees(cache);
+
+			block = cache->freeLists[sizeClass];
+			if(block == nullptr)
+			{
+				allocateChunk(cache, sizeClass);
+				block = cache->freeLists[sizeClass];
+			}
+		}
+
+		cache->freeLists[sizeClass] = block->next;
+		return block;
+	}
+
+	void ThreadCachingAlloc::free(void* ptr)
+	{
+		if(ptr == nullptr)
+			return;
+
+		BlockHeader* header = getHeader(ptr);
+		ThreadCache* owner = header->owner;
+
+		if(owner == nullptr)
+		{
+			::free(header);
+			return;
+		}
+
+		auto block = (FreeBlock*)ptr;
+		if(owner == gThreadCache)
+		{
+			block->next = owner->freeLists[header->sizeClass];
+			owner->freeLists[header->sizeClass] = block;
+			return;
+		}
+
+		// Block belongs to another thread, hand it over through its remote free list
+		FreeBlock* head = owner->remoteFreeList.load(std::memory_order_relaxed);
+		do
+		{
+			block->next = head;
+		} while(!owner->remoteFreeList.compare_exchange_weak(head, block, std::memory_order_release,
+			std::memory_order_relaxed));
+	}
+}
@@ -0,0 +1,42 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include <cstddef>
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Memory-Internal
+	 *  @{
+	 */
+
+	/**
+	 * General purpose allocator optimized for frequent small allocations made from multiple threads. Small allocations
+	 * are rounded up to one of a fixed set of size classes, and served from per-thread caches of free blocks without any
+	 * synchronization. Blocks freed by a thread other than the one that allocated them are returned to the owning
+	 * thread's cache through a lock-free list. Large allocations are forwarded to the system allocator.
+	 *
+	 * When BS_USE_CACHING_ALLOCATOR is enabled, this allocator is used for all allocations made through bs_alloc() and
+	 * related methods.
+	 *
+	 * @note	Memory used for small allocations is never returned to the system, it is instead kept for future
+	 *			allocations. Caches of threads that exit are handed over to new threads.
+	 * @note	Thread safe.
+	 */
+	class BS_UTILITY_EXPORT ThreadCachingAlloc
+	{
+	public:
+		/** Allocates @p bytes bytes. Returned memory is 16 byte aligned. */
+		static void* allocate(size_t bytes);
+
+		/** Frees memory previously allocated with allocate(). Can be called from any thread. */
+		static void free(void* ptr);
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -4,6 +4,8 @@ set(BS_UTILITY_INC_THREADING
 	"bsfUtility/Threading/BsSpinLock.h"
 	"bsfUtility/Threading/BsThreadPool.h"
 	"bsfUtility/Threading/BsTaskScheduler.h"
+	"bsfUtility/Threading/BsWorkStealingQueue.h"
+	"bsfUtility/Threading/BsCommandRing.h"
 )
 
 set(BS_UTILITY_SRC_THIRDPARTY
@@ -51,6 +53,7 @@ set(BS_UTILITY_SRC_UTILITY
 	"bsfUtility/Utility/BsTriangulation.cpp"
 	"bsfUtility/Utility/BsUUID.cpp"
 	"bsfUtility/Utility/BsLookupTable.cpp"
+	"bsfUtility/Utility/BsRadixSort.cpp"
 )
 
 set(BS_UTILITY_INC_DEBUG
@@ -103,12 +106,14 @@ set(BS_UTILITY_INC_UTILITY
 	"bsfUtility/Utility/BsSmallVector.h"
 	"bsfUtility/Utility/BsDynArray.h"
 	"bsfUtility/Utility/BsMinHeap.h"
+	"bsfUtility/Utility/BsRadixSort.h"
 )
 
 set(BS_UTILITY_SRC_ALLOCATORS
 	"bsfUtility/Allocators/BsFrameAlloc.cpp"
 	"bsfUtility/Allocators/BsStackAlloc.cpp"
 	"bsfUtility/Allocators/BsMemoryAllocator.cpp"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.cpp"
 )
 
 set(BS_UTILITY_SRC_REFLECTION
@@ -138,6 +143,7 @@ set(BS_UTILITY_INC_ALLOCATORS
 	"bsfUtility/Allocators/BsGroupAlloc.h"
 	"bsfUtility/Allocators/BsFreeAlloc.h"
 	"bsfUtility/Allocators/BsPoolAlloc.h"
+	"bsfUtility/Allocators/BsThreadCachingAlloc.h"
 )
 
 set(BS_UTILITY_INC_THIRDPARTY
@@ -175,6 +181,7 @@ set(BS_UTILITY_SRC_MATH
 	"bsfUtility/Math/BsLineSegment3.cpp"
 	"bsfUtility/Math/BsCapsule.cpp"
 	"bsfUtility/Math/BsLine2.cpp"
+	"bsfUtility/Math/BsSIMD.cpp"
 )
 
 set(BS_UTILITY_INC_TESTING
@@ -180,7 +180,7 @@ namespace bs
 	MemoryDataStream::MemoryDataStream(size_t size)
 		: DataStream(READ | WRITE), mData(nullptr), mFreeOnClose(true)
 	{
-		mData = mPos = (UINT8*)bs_alloc((UINT32)size);
+		mData = mPos = (UINT8*)bs_alloc(size);
 		mSize = size;
 		mEnd = mData + mSize;
 
@@ -197,13 +197,19 @@ namespace bs
 		assert(mEnd >= mPos);
 	}
 
+	MemoryDataStream::MemoryDataStream(void* memory, size_t inSize, const SPtr<DataStream>& owner)
+		: MemoryDataStream(memory, inSize, false)
+	{
+		mOwner = owner;
+	}
+
 	MemoryDataStream::MemoryDataStream(DataStream& sourceStream)
 		: DataStream(READ | WRITE), mData(nullptr)
 	{
 		// Copy data from incoming stream
 		mSize = sourceStream.size();
 
-		mData = (UINT8*)bs_alloc((UINT32)mSize);
+		mData = (UINT8*)bs_alloc(mSize);
 		mPos = mData;
 		mEnd = mData + sourceStream.read(mData, mSize);
 		mFreeOnClose = true;
@@ -217,7 +223,7 @@ namespace bs
 		// Copy data from incoming stream
 		mSize = sourceStream->size();
 
-		mData = (UINT8*)bs_alloc((UINT32)mSize);
+		mData = (UINT8*)bs_alloc(mSize);
 		mPos = mData;
 		mEnd = mData + sourceStream->read(mData, mSize);
 		mFreeOnClose = true;
@@ -307,6 +313,8 @@ namespace bs
 
 			mData = nullptr;
 		}
+
+		mOwner = nullptr;
 	}
 
 	FileDataStream::FileDataStream(const Path& path, AccessMode accessMode, bool freeOnClose)
@@ -171,6 +171,16 @@ namespace bs
 		 */
 		MemoryDataStream(void* memory, size_t size, bool freeOnClose = true);
 
+		/**
+		 * Wraps a memory chunk owned by another stream, without copying it. The owner stream is kept alive for as long as
+		 * this stream exists.
+		 *
+		 * @param[in] 	memory		Memory to wrap the data stream around.
+		 * @param[in]	size		Size of the memory chunk in bytes.
+		 * @param[in]	owner		Stream that owns the memory.
+		 */
+		MemoryDataStream(void* memory, size_t size, const SPtr<DataStream>& owner);
+
 		/**
 		 * Create a stream which pre-buffers the contents of another stream. Data from the other buffer will be entirely 
 		 * read and stored in an internal buffer.
@@ -196,6 +206,15 @@ namespace bs
 		
 		/** Get a pointer to the current position in the memory block this stream holds. */
 		UINT8* getCurrentPtr() const { return mPos; }
+
+		/**
+		 * Returns true if the memory block remains valid for as long as the stream exists, either because the stream owns
+		 * it or because it keeps the owner alive. Parts of such memory may be referenced directly instead of being copied.
+		 */
+		virtual bool ownsMemory() const { return mFreeOnClose || mOwner != nullptr; }
+
+		/** Returns true if the stream wraps memory owned by another stream. */
+		bool isView() const { return mOwner != nullptr; }
 		
 		/** @copydoc DataStream::read */
 		size_t read(void* buf, size_t count) override;
@@ -227,6 +246,43 @@ namespace bs
 		UINT8* mEnd;
 
 		bool mFreeOnClose;
+		SPtr<DataStream> mOwner;
+	};
+
+	/**
+	 * Read-only data stream for a file mapped into memory. File contents are paged in by the OS as they are accessed 
+	 * instead of being read up front, and parts of the file can be referenced directly from the mapping using views (see
+	 * MemoryDataStream(void*, size_t, const SPtr<DataStream>&)).
+	 *
+	 * @note	
+	 * The mapping is private, meaning any modifications made to the mapped memory are only visible to this process and 
+	 * are never written to the file.
+	 */
+	class BS_UTILITY_EXPORT MappedFileDataStream : public MemoryDataStream
+	{
+	public:
+		/**
+		 * Maps the file at the provided path. If the file cannot be mapped the stream is left empty and no error is logged.
+		 * See isMapped().
+		 */
+		MappedFileDataStream(const Path& filePath);
+		~MappedFileDataStream();
+
+		/** Returns true if the file was successfully mapped. */
+		bool isMapped() const { return mData != nullptr; }
+
+		/** @copydoc MemoryDataStream::ownsMemory */
+		bool ownsMemory() const override { return true; }
+
+		/** @copydoc DataStream::close */
+		void close() override;
+
+		/** Returns the path of the mapped file. */
+		const Path& getPath() const { return mPath; }
+
+	private:
+		Path mPath;
+		void* mMappingHandle = nullptr;
 	};
 
 	/** Data stream for handling data from standard streams. */
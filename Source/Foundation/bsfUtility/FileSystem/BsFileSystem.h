@@ -22,6 +22,14 @@ namespace bs
 		 */
 		static SPtr<DataStream> openFile(const Path& fullPath, bool readOnly = true);
 
+		/**
+		 * Maps a file into memory and returns a read-only data stream accessing it. Returns null without logging an error
+		 * if the file cannot be mapped, in which case openFile() should be used instead.
+		 *
+		 * @param[in]	fullPath	Full path to a file.
+		 */
+		static SPtr<MemoryDataStream> openFileMapped(const Path& fullPath);
+
 		/**
 		 * Opens a file and returns a data stream capable of reading and writing to that file. If file doesn't exist new
 		 * one will be created.
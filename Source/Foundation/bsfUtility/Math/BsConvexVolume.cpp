@@ -141,6 +141,27 @@ namespace bs
 		return true;
 	}
 
+	bool ConvexVolume::contains(const AABox& box) const
+	{
+		Vector3 center = box.getCenter();
+		Vector3 extents = box.getHalfSize();
+		Vector3 absExtents(Math::abs(extents.x), Math::abs(extents.y), Math::abs(extents.z));
+
+		for (auto& plane : mPlanes)
+		{
+			float dist = center.dot(plane.normal) - plane.d;
+
+			float effectiveRadius = absExtents.x * Math::abs(plane.normal.x);
+			effectiveRadius += absExtents.y * Math::abs(plane.normal.y);
+			effectiveRadius += absExtents.z * Math::abs(plane.normal.z);
+
+			if (dist < effectiveRadius)
+				return false;
+		}
+
+		return true;
+	}
+
 	const Plane& ConvexVolume::getPlane(FrustumPlane whichPlane) const
 	{
 		if(whichPlane >= mPlanes.size())
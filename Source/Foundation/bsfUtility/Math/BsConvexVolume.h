@@ -53,8 +53,11 @@ namespace bs
 		 */
 		bool contains(const Vector3& p, float expand = 0.0f) const;
 
+		/** Checks if the convex volume fully contains the provided axis aligned box. */
+		bool contains(const AABox& box) const;
+
 		/** Returns the internal set of planes that represent the volume. */
-		Vector<Plane> getPlanes() const { return mPlanes; }
+		const Vector<Plane>& getPlanes() const { return mPlanes; }
 
 		/** Returns the specified plane that represents the volume. */
 		const Plane& getPlane(FrustumPlane whichPlane) const;
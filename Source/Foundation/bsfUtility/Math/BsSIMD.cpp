@@ -0,0 +1,170 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Math/BsSIMD.h"
+#include "Math/BsMath.h"
+#include "Math/BsBounds.h"
+#include "Math/BsConvexVolume.h"
+
+namespace bs
+{
+	namespace simd
+	{
+		/**
+		 * Tests a single block of BoundsArray entries against a set of planes. Returns a mask with a bit set for each entry
+		 * that intersects the volume formed by the planes. Performs the same calculations as ConvexVolume::intersects() so
+		 * the results match exactly.
+		 */
+		static UINT32 intersectsBlock(const float* block, const Vector<Plane>& planes)
+		{
+			constexpr UINT32 W = BoundsArray::WIDTH;
+
+			const float32x4 sphereX = load_u<float32x4>(block + 0 * W);
+			const float32x4 sphereY = load_u<float32x4>(block + 1 * W);
+			const float32x4 sphereZ = load_u<float32x4>(block + 2 * W);
+			const float32x4 negSphereRadius = neg(load_u<float32x4>(block + 3 * W));
+			const float32x4 boxX = load_u<float32x4>(block + 4 * W);
+			const float32x4 boxY = load_u<float32x4>(block + 5 * W);
+			const float32x4 boxZ = load_u<float32x4>(block + 6 * W);
+			const float32x4 boxExtentX = load_u<float32x4>(block + 7 * W);
+			const float32x4 boxExtentY = load_u<float32x4>(block + 8 * W);
+			const float32x4 boxExtentZ = load_u<float32x4>(block + 9 * W);
+
+			uint32x4 outside = make_zero();
+			for (auto& plane : planes)
+			{
+				const float32x4 normalX = load_splat<float32x4>(&plane.normal.x);
+				const float32x4 normalY = load_splat<float32x4>(&plane.normal.y);
+				const float32x4 normalZ = load_splat<float32x4>(&plane.normal.z);
+				const float32x4 d = load_splat<float32x4>(&plane.d);
+
+				float32x4 sphereDist = add(add(mul(sphereX, normalX), mul(sphereY, normalY)), mul(sphereZ, normalZ));
+				sphereDist = sub(sphereDist, d);
+
+				float32x4 boxDist = add(add(mul(boxX, normalX), mul(boxY, normalY)), mul(boxZ, normalZ));
+				boxDist = sub(boxDist, d);
+
+				float32x4 effectiveRadius = mul(boxExtentX, abs(normalX));
+				effectiveRadius = add(effectiveRadius, mul(boxExtentY, abs(normalY)));
+				effectiveRadius = add(effectiveRadius, mul(boxExtentZ, abs(normalZ)));
+
+				outside = bit_or(outside, bit_cast<uint32x4>(cmp_lt(sphereDist, negSphereRadius)));
+				outside = bit_or(outside, bit_cast<uint32x4>(cmp_lt(boxDist, neg(effectiveRadius))));
+			}
+
+			// One bit per byte, keep only one bit per lane
+			const UINT32 outsideBits = extract_bits_any(bit_cast<uint8x16>(outside));
+			const UINT32 outsideMask = (outsideBits & 0x1) | ((outsideBits >> 3) & 0x2) | ((outsideBits >> 6) & 0x4) |
+				((outsideBits >> 9) & 0x8);
+
+			return ~outsideMask & 0xF;
+		}
+
+		void BoundsArray::add(const Bounds& bounds)
+		{
+			// Padding entries are kept zeroed
+			if((mCount % WIDTH) == 0)
+				mData.resize(mData.size() + BLOCK_SIZE, 0.0f);
+
+			mCount++;
+			set(mCount - 1, bounds);
+		}
+
+		void BoundsArray::set(UINT32 idx, const Bounds& bounds)
+		{
+			const Sphere& sphere = bounds.getSphere();
+			const Vector3& sphereCenter = sphere.getCenter();
+
+			get(idx, SphereX) = sphereCenter.x;
+			get(idx, SphereY) = sphereCenter.y;
+			get(idx, SphereZ) = sphereCenter.z;
+			get(idx, SphereRadius) = sphere.getRadius();
+
+			const bs::AABox& box = bounds.getBox();
+			const Vector3 boxCenter = box.getCenter();
+			const Vector3 boxExtents = box.getHalfSize();
+
+			get(idx, BoxX) = boxCenter.x;
+			get(idx, BoxY) = boxCenter.y;
+			get(idx, BoxZ) = boxCenter.z;
+			get(idx, BoxExtentX) = Math::abs(boxExtents.x);
+			get(idx, BoxExtentY) = Math::abs(boxExtents.y);
+			get(idx, BoxExtentZ) = Math::abs(boxExtents.z);
+		}
+
+		void BoundsArray::remove(UINT32 idx)
+		{
+			const UINT32 lastIdx = mCount - 1;
+			for(UINT32 i = 0; i < NumComponents; i++)
+			{
+				get(idx, (Component)i) = get(lastIdx, (Component)i);
+				get(lastIdx, (Component)i) = 0.0f;
+			}
+
+			mCount--;
+
+			if((mCount % WIDTH) == 0)
+				mData.resize(mData.size() - BLOCK_SIZE);
+		}
+
+		void BoundsArray::clear()
+		{
+			mData.clear();
+			mCount = 0;
+		}
+
+		AABox BoundsArray::getBox(UINT32 idx) const
+		{
+			AABox output;
+			output.center = Vector4(get(idx, BoxX), get(idx, BoxY), get(idx, BoxZ), 0.0f);
+			output.extents = Vector4(get(idx, BoxExtentX), get(idx, BoxExtentY), get(idx, BoxExtentZ), 0.0f);
+
+			return output;
+		}
+
+		void BoundsArray::intersects(const ConvexVolume& volume, UINT32* output) const
+		{
+			static_assert(32 % WIDTH == 0, "Blocks must not straddle output words.");
+
+			const Vector<Plane>& planes = volume.getPlanes();
+			const UINT32 numBlocks = Math::divideAndRoundUp(mCount, WIDTH);
+			const UINT32 numWords = Math::divideAndRoundUp(mCount, 32U);
+
+			memset(output, 0, numWords * sizeof(UINT32));
+			for(UINT32 i = 0; i < numBlocks; i++)
+			{
+				const UINT32 firstIdx = i * WIDTH;
+				output[firstIdx / 32] |= intersectsBlock(&mData[i * BLOCK_SIZE], planes) << (firstIdx % 32);
+			}
+
+			// Clear the bits for the padding entries
+			if((mCount % 32) != 0)
+				output[numWords - 1] &= (1U << (mCount % 32)) - 1;
+		}
+
+		void BoundsArray::intersects(const ConvexVolume& volume, const UINT32* indices, UINT32 count, UINT32* output) const
+		{
+			const Vector<Plane>& planes = volume.getPlanes();
+			const UINT32 numWords = Math::divideAndRoundUp(count, 32U);
+
+			memset(output, 0, numWords * sizeof(UINT32));
+
+			float block[BLOCK_SIZE];
+			for(UINT32 i = 0; i < count; i += WIDTH)
+			{
+				// Gather the entries into a temporary block, padding it with the last entry
+				for(UINT32 j = 0; j < WIDTH; j++)
+				{
+					const UINT32 idx = indices[std::min(i + j, count - 1)];
+					for(UINT32 k = 0; k < NumComponents; k++)
+						block[k * WIDTH + j] = get(idx, (Component)k);
+				}
+
+				output[i / 32] |= intersectsBlock(block, planes) << (i % 32);
+			}
+
+			// Clear the bits for the padding entries
+			if((count % 32) != 0)
+				output[numWords - 1] &= (1U << (count % 32)) - 1;
+		}
+	}
+}
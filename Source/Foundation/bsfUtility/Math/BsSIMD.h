@@ -4,6 +4,7 @@
 
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Math/BsVector4.h"
+#include "Math/BsMatrix4.h"
 #include "Math/BsAABox.h"
 #include "Math/BsSphere.h"
 
@@ -21,6 +22,9 @@
 
 namespace bs
 {
+	class ConvexVolume;
+	class Bounds;
+
 	namespace simd
 	{
 		using namespace simdpp;
@@ -83,6 +87,103 @@ namespace bs
 			}
 		};
 
+		/**
+		 * Multiplies two 4x4 matrices, same as Matrix4::operator*. Each row of the output is calculated at once, by
+		 * combining the rows of @p rhs weighted by the elements of the matching @p lhs row.
+		 */
+		inline Matrix4 multiply(const Matrix4& lhs, const Matrix4& rhs)
+		{
+			const float32x4 rhs0 = load_u<float32x4>(&rhs[0].x);
+			const float32x4 rhs1 = load_u<float32x4>(&rhs[1].x);
+			const float32x4 rhs2 = load_u<float32x4>(&rhs[2].x);
+			const float32x4 rhs3 = load_u<float32x4>(&rhs[3].x);
+
+			Matrix4 output;
+			for(UINT32 i = 0; i < 4; i++)
+			{
+				const Vector4& row = lhs[i];
+
+				float32x4 result = mul(load_splat<float32x4>(&row.x), rhs0);
+				result = add(result, mul(load_splat<float32x4>(&row.y), rhs1));
+				result = add(result, mul(load_splat<float32x4>(&row.z), rhs2));
+				result = add(result, mul(load_splat<float32x4>(&row.w), rhs3));
+
+				store_u(&output[i].x, result);
+			}
+
+			return output;
+		}
+
+		/**
+		 * Stores bounds of multiple objects in structure-of-arrays form, allowing intersection tests to process multiple
+		 * objects at once. Each object is represented by both a bounding sphere and an axis aligned box, and is considered
+		 * intersecting only if both of them intersect. Entries are grouped in blocks of WIDTH entries, where each block
+		 * stores every component of its entries sequentially.
+		 */
+		class BS_UTILITY_EXPORT BoundsArray
+		{
+		public:
+			/** Number of entries processed at once. */
+			static constexpr UINT32 WIDTH = 4;
+
+			/** Registers new bounds at the end of the array. */
+			void add(const Bounds& bounds);
+
+			/** Updates bounds at the specified index. */
+			void set(UINT32 idx, const Bounds& bounds);
+
+			/** Removes the bounds at the specified index. If it wasn't the last entry, the last entry is moved in its place. */
+			void remove(UINT32 idx);
+
+			/** Removes all entries. */
+			void clear();
+
+			/** Returns the axis aligned box of the entry at the specified index. */
+			AABox getBox(UINT32 idx) const;
+
+			/** Returns the number of entries in the array. */
+			UINT32 size() const { return mCount; }
+
+			/**
+			 * Tests all entries against the provided volume. Results are written as a bitmask with a set bit for each entry
+			 * that intersects the volume. @p output must have room for at least Math::divideAndRoundUp(size(), 32) words.
+			 */
+			void intersects(const ConvexVolume& volume, UINT32* output) const;
+
+			/**
+			 * Tests a subset of entries against the provided volume. Results are written as a bitmask with a set bit for
+			 * each element of @p indices whose entry intersects the volume. @p output must have room for at least
+			 * Math::divideAndRoundUp(count, 32) words.
+			 */
+			void intersects(const ConvexVolume& volume, const UINT32* indices, UINT32 count, UINT32* output) const;
+
+		private:
+			/** Components stored for each entry. */
+			enum Component
+			{
+				SphereX, SphereY, SphereZ, SphereRadius,
+				BoxX, BoxY, BoxZ, BoxExtentX, BoxExtentY, BoxExtentZ,
+				NumComponents
+			};
+
+			static constexpr UINT32 BLOCK_SIZE = WIDTH * NumComponents;
+
+			/** Returns the location of a component of an entry. */
+			float& get(UINT32 idx, Component component)
+			{
+				return mData[(idx / WIDTH) * BLOCK_SIZE + component * WIDTH + idx % WIDTH];
+			}
+
+			/** @copydoc get(UINT32, Component) */
+			float get(UINT32 idx, Component component) const
+			{
+				return mData[(idx / WIDTH) * BLOCK_SIZE + component * WIDTH + idx % WIDTH];
+			}
+
+			Vector<float> mData;
+			UINT32 mCount = 0;
+		};
+
 		/** @} */
 	}
 }
@@ -46,6 +46,7 @@ namespace bs
 
 		enum { id = 0 /**< Unique id for the serializable type. */ };
 		enum { hasDynamicSize = 0 /**< 0 (Object has static size less than 255 bytes, for example int) or 1 (Dynamic size with no size restriction, for example string) */ };
+		enum { allowMemcpy = 1 /**< 1 if serialized data is an exact copy of the object's memory, allowing arrays of objects to be serialized in bulk. Assumed 0 if not present. */ };
 
 		/** Serializes the provided object into the provided pre-allocated memory buffer. */
 		static void toMemory(const T& data, char* memory)
@@ -70,6 +71,38 @@ namespace bs
 		}
 	};
 
+	/**
+	 * Checks if the RTTIPlainType specialization for @p T serializes objects by copying their memory, meaning a contiguous
+	 * array of such objects can be serialized with a single copy.
+	 */
+	template<class T>
+	struct RTTIPlainTypeAllowsMemcpy
+	{
+	private:
+		template<class U> static std::integral_constant<bool, U::allowMemcpy != 0 && U::hasDynamicSize == 0> test(int);
+		template<class U> static std::false_type test(...);
+
+	public:
+		static constexpr bool value = decltype(test<RTTIPlainType<T>>(0))::value;
+	};
+
+	/** 
+	 * Returns a pointer to the contiguous element storage of the provided container. Used by the RTTI member macros for 
+	 * accessing arrays in bulk. Pass 0 as the second parameter.
+	 */
+	template<class T>
+	auto rttiGetContiguousData(T& container, int) -> decltype(container.data())
+	{
+		return container.data();
+	}
+
+	/** Fallback for containers that don't store their elements contiguously. Always returns null. */
+	template<class T>
+	typename T::value_type* rttiGetContiguousData(T& container, long)
+	{
+		return nullptr;
+	}
+
 	/**
 	 * Helper method when serializing known data types that have valid
 	 * RTTIPlainType specialization.
@@ -180,7 +213,7 @@ namespace bs
 	static_assert (std::is_trivially_copyable<type>()==true,			\
 						#type " is not trivially copyable");			\
 	template<> struct RTTIPlainType<type>								\
-	{	enum { id=0 }; enum { hasDynamicSize = 0 };						\
+	{	enum { id=0 }; enum { hasDynamicSize = 0 }; enum { allowMemcpy = 1 };	\
 		static void toMemory(const type& data, char* memory)			\
 		{ memcpy(memory, &data, sizeof(type)); }						\
 		static UINT32 fromMemory(type& data, char* memory)				\
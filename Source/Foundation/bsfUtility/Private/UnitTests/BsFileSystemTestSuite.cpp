@@ -5,6 +5,7 @@
 #include "Debug/BsDebug.h"
 #include "Error/BsException.h"
 #include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
 
 #include <algorithm>
 #include <fstream>
@@ -84,6 +85,7 @@ namespace bs
 		BS_ADD_TEST(FileSystemTestSuite::testGetChildren);
 		BS_ADD_TEST(FileSystemTestSuite::testGetLastModifiedTime);
 		BS_ADD_TEST(FileSystemTestSuite::testGetTempDirectoryPath);
+		BS_ADD_TEST(FileSystemTestSuite::testOpenFileMapped);
 	}
 
 	void FileSystemTestSuite::testExists_yes_file()
@@ -299,4 +301,34 @@ namespace bs
 		/* No judging. */
 		BS_TEST_ASSERT(!path.toString().empty());
 	}
+
+	void FileSystemTestSuite::testOpenFileMapped()
+	{
+		Path path = mTestDirectory + "mapped-file";
+		createFile(path, "0123456789");
+
+		SPtr<DataStream> view;
+		{
+			SPtr<MemoryDataStream> stream = FileSystem::openFileMapped(path);
+			BS_TEST_ASSERT(stream != nullptr);
+			BS_TEST_ASSERT(stream->size() == 10);
+			BS_TEST_ASSERT(memcmp(stream->getPtr(), "0123456789", 10) == 0);
+
+			view = bs_shared_ptr_new<MemoryDataStream>(stream->getPtr() + 2, 4, stream);
+		}
+
+		// View keeps the mapping alive, and modifications don't reach the file
+		char viewData[4];
+		BS_TEST_ASSERT(view->read(viewData, 4) == 4);
+		BS_TEST_ASSERT(memcmp(viewData, "2345", 4) == 0);
+
+		std::static_pointer_cast<MemoryDataStream>(view)->getPtr()[0] = 'x';
+		view = nullptr;
+
+		BS_TEST_ASSERT(readFile(path) == "0123456789");
+
+		Path emptyPath = mTestDirectory + "mapped-file-empty";
+		createEmptyFile(emptyPath);
+		BS_TEST_ASSERT(FileSystem::openFileMapped(emptyPath) == nullptr);
+	}
 }
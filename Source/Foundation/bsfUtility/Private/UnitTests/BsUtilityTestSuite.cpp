@@ -7,6 +7,21 @@
 #include "Utility/BsDynArray.h"
 #include "Math/BsComplex.h"
 #include "Utility/BsMinHeap.h"
+#include "Utility/BsTimer.h"
+#include "Utility/BsTime.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Debug/BsDebug.h"
+#include "Math/BsBounds.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsRandom.h"
+#include "Utility/BsRadixSort.h"
+#include "Threading/BsCommandRing.h"
+#include "Reflection/BsRTTIType.h"
+#include "Serialization/BsMemorySerializer.h"
+#include "Serialization/BsFileSerializer.h"
+#include "FileSystem/BsFileSystem.h"
+#include "FileSystem/BsDataStream.h"
+#include "Utility/BsCompression.h"
 
 namespace bs
 {
@@ -42,14 +57,93 @@ namespace bs
 	};
 
 	typedef Octree<UINT32, DebugOctreeOptions> DebugOctree;
+
+	static constexpr UINT32 TID_SerializerTestObject = 99000;
+
+	/** Object containing large arrays of plain values, used for testing serialization. */
+	class SerializerTestObject : public IReflectable
+	{
+	public:
+		String mName;
+		Vector<float> mBulkValues;
+		Vector<float> mElementValues;
+
+		friend class SerializerTestObjectRTTI;
+		static RTTITypeBase* getRTTIStatic();
+		RTTITypeBase* getRTTI() const override;
+	};
+
+	/** 
+	 * RTTI for SerializerTestObject. Serializes one array with contiguous storage access, and another one element by 
+	 * element.
+	 */
+	class SerializerTestObjectRTTI : public RTTIType<SerializerTestObject, IReflectable, SerializerTestObjectRTTI>
+	{
+	private:
+		BS_BEGIN_RTTI_MEMBERS
+			BS_RTTI_MEMBER_PLAIN(mName, 0)
+			BS_RTTI_MEMBER_PLAIN_ARRAY(mBulkValues, 1)
+		BS_END_RTTI_MEMBERS
+
+		float& getElementValue(SerializerTestObject* obj, UINT32 idx) { return obj->mElementValues[idx]; }
+		void setElementValue(SerializerTestObject* obj, UINT32 idx, float& val) { obj->mElementValues[idx] = val; }
+		UINT32 getNumElementValues(SerializerTestObject* obj) { return (UINT32)obj->mElementValues.size(); }
+		void setNumElementValues(SerializerTestObject* obj, UINT32 val) { obj->mElementValues.resize(val); }
+
+	public:
+		SerializerTestObjectRTTI()
+		{
+			addPlainArrayField("mElementValues", 2, &SerializerTestObjectRTTI::getElementValue, 
+				&SerializerTestObjectRTTI::getNumElementValues, &SerializerTestObjectRTTI::setElementValue, 
+				&SerializerTestObjectRTTI::setNumElementValues);
+		}
+
+		const String& getRTTIName() override
+		{
+			static String name = "SerializerTestObject";
+			return name;
+		}
+
+		UINT32 getRTTIId() override
+		{
+			return TID_SerializerTestObject;
+		}
+
+		SPtr<IReflectable> newRTTIObject() override
+		{
+			return bs_shared_ptr_new<SerializerTestObject>();
+		}
+	};
+
+	RTTITypeBase* SerializerTestObject::getRTTIStatic()
+	{
+		return SerializerTestObjectRTTI::instance();
+	}
+
+	RTTITypeBase* SerializerTestObject::getRTTI() const
+	{
+		return getRTTIStatic();
+	}
+
 	void UtilityTestSuite::startUp()
 	{
 		SPtr<TestSuite> fileSystemTests = create<FileSystemTestSuite>();
 		add(fileSystemTests);
+
+		// Required by the task scheduler and benchmark logging
+		const UINT32 numCores = std::max(1U, BS_THREAD_HARDWARE_CONCURRENCY);
+		ThreadPool::startUp<TThreadPool<>>(numCores, numCores * 8 + 16);
+		Time::startUp();
+
+		// Required by the serializer
+		MemStack::beginThread();
 	}
 
 	void UtilityTestSuite::shutDown()
 	{
+		MemStack::endThread();
+		Time::shutDown();
+		ThreadPool::shutDown();
 	}
 
 	UtilityTestSuite::UtilityTestSuite()
@@ -60,6 +154,14 @@ namespace bs
 		BS_ADD_TEST(UtilityTestSuite::testDynArray)
 		BS_ADD_TEST(UtilityTestSuite::testComplex)
 		BS_ADD_TEST(UtilityTestSuite::testMinHeap)
+		BS_ADD_TEST(UtilityTestSuite::testTaskScheduler)
+		BS_ADD_TEST(UtilityTestSuite::testTaskGraph)
+		BS_ADD_TEST(UtilityTestSuite::testBoundsCulling)
+		BS_ADD_TEST(UtilityTestSuite::testRadixSort)
+		BS_ADD_TEST(UtilityTestSuite::testThreadCachingAlloc)
+		BS_ADD_TEST(UtilityTestSuite::testCommandRing)
+		BS_ADD_TEST(UtilityTestSuite::testSerializerThroughput)
+		BS_ADD_TEST(UtilityTestSuite::testBlockCompression)
 	}
 
 	void UtilityTestSuite::testBitfield()
@@ -549,4 +651,944 @@ namespace bs
 		m.erase(elements, v);
 		BS_TEST_ASSERT(m.size() == 1);
 	}
+
+	void UtilityTestSuite::testTaskScheduler()
+	{
+		static constexpr UINT32 NUM_TASKS = 20000;
+		static constexpr UINT32 NUM_CHAINED_TASKS = 100;
+		static constexpr UINT32 NUM_WAKE_UPS = 100;
+
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			const TaskSchedulerMode mode = i == 0 ? TaskSchedulerMode::GlobalQueue : TaskSchedulerMode::WorkStealing;
+			const char* modeName = i == 0 ? "Global queue" : "Work stealing";
+
+			// Modules can only be started once, so create the scheduler directly
+			TaskScheduler* scheduler = bs_new<TaskScheduler>(mode);
+
+			// Throughput of small tasks
+			std::atomic<UINT32> numExecuted{0};
+			Vector<SPtr<Task>> tasks(NUM_TASKS);
+
+			Timer timer;
+			for(UINT32 j = 0; j < NUM_TASKS; j++)
+			{
+				const TaskPriority priority = (TaskPriority)((UINT32)TaskPriority::VeryLow + j % 5);
+				tasks[j] = Task::create("Test", [&numExecuted]() { numExecuted++; }, priority);
+				scheduler->addTask(tasks[j]);
+			}
+
+			for(auto& entry : tasks)
+				entry->wait();
+
+			const UINT64 throughputTime = std::max(timer.getMicroseconds(), (UINT64)1);
+			BS_TEST_ASSERT(numExecuted == NUM_TASKS);
+
+			// Dependencies must execute in order, even when queued in reverse
+			std::atomic<UINT32> nextChainIdx{0};
+			std::atomic<bool> chainInOrder{true};
+
+			Vector<SPtr<Task>> chain(NUM_CHAINED_TASKS);
+			for(UINT32 j = 0; j < NUM_CHAINED_TASKS; j++)
+			{
+				const auto worker = [j, &nextChainIdx, &chainInOrder]()
+				{
+					if(nextChainIdx++ != j)
+						chainInOrder = false;
+				};
+
+				chain[j] = Task::create("Chain", worker, TaskPriority::Normal, j > 0 ? chain[j - 1] : nullptr);
+			}
+
+			for(UINT32 j = NUM_CHAINED_TASKS; j > 0; j--)
+				scheduler->addTask(chain[j - 1]);
+
+			chain.back()->wait();
+			BS_TEST_ASSERT(chainInOrder && nextChainIdx == NUM_CHAINED_TASKS);
+
+			// Task groups waited on from within another task
+			std::atomic<UINT32> numGroupItems{0};
+			SPtr<Task> outerTask = Task::create("Outer", [scheduler, &numGroupItems]()
+			{
+				SPtr<TaskGroup> group = TaskGroup::create("Inner", [&numGroupItems](UINT32) { numGroupItems++; }, 64);
+				scheduler->addTaskGroup(group);
+				group->wait();
+			});
+
+			scheduler->addTask(outerTask);
+			outerTask->wait();
+			BS_TEST_ASSERT(numGroupItems == 64);
+
+			// Parallel for must process each item exactly once
+			static constexpr UINT32 NUM_RANGE_ITEMS = 100000;
+			static constexpr UINT32 RANGE_OFFSET = 10;
+
+			Vector<UINT8> itemCounts(NUM_RANGE_ITEMS + RANGE_OFFSET, 0);
+			scheduler->parallelFor(RANGE_OFFSET, NUM_RANGE_ITEMS + RANGE_OFFSET, 64, [&itemCounts](UINT32 begin, UINT32 end)
+			{
+				for(UINT32 j = begin; j < end; j++)
+					itemCounts[j]++;
+			});
+
+			bool allItemsProcessedOnce = true;
+			for(UINT32 j = 0; j < (UINT32)itemCounts.size(); j++)
+				allItemsProcessedOnce &= itemCounts[j] == (j < RANGE_OFFSET ? 0 : 1);
+
+			BS_TEST_ASSERT(allItemsProcessedOnce);
+
+			// Parallel for that may not execute other tasks must leave them to the workers while it waits
+			const ThreadId callingThreadId = BS_THREAD_CURRENT_ID;
+			std::atomic<bool> inParallelFor{false};
+			std::atomic<bool> otherTaskExecutedByCaller{false};
+
+			Vector<SPtr<Task>> otherTasks(32);
+			for(auto& entry : otherTasks)
+			{
+				entry = Task::create("Other", [callingThreadId, &inParallelFor, &otherTaskExecutedByCaller]()
+				{
+					if(inParallelFor && BS_THREAD_CURRENT_ID == callingThreadId)
+						otherTaskExecutedByCaller = true;
+
+					BS_THREAD_SLEEP(1);
+				});
+			}
+
+			inParallelFor = true;
+			for(auto& entry : otherTasks)
+				scheduler->addTask(entry);
+
+			std::atomic<UINT32> numExclusiveItems{0};
+			scheduler->parallelFor(0, 16, 1, [&numExclusiveItems](UINT32 begin, UINT32 end)
+			{
+				BS_THREAD_SLEEP(1);
+				numExclusiveItems += end - begin;
+			}, TaskPriority::VeryLow, false);
+
+			inParallelFor = false;
+			for(auto& entry : otherTasks)
+				entry->wait();
+
+			BS_TEST_ASSERT(numExclusiveItems == 16);
+			BS_TEST_ASSERT(!otherTaskExecutedByCaller);
+
+			// Latency between queuing a task and it starting execution on an idle worker
+			UINT64 totalWakeUpTime = 0;
+			for(UINT32 j = 0; j < NUM_WAKE_UPS; j++)
+			{
+				BS_THREAD_SLEEP(1);
+
+				std::atomic<UINT64> startTime{0};
+				std::atomic<bool> started{false};
+				Timer wakeUpTimer;
+				SPtr<Task> task = Task::create("WakeUp", [&startTime, &started, &wakeUpTimer]()
+				{
+					startTime = wakeUpTimer.getMicroseconds();
+					started = true;
+				});
+
+				scheduler->addTask(task);
+
+				// Don't wait on the task directly, as that could execute it on this thread
+				while(!started)
+					std::this_thread::yield();
+
+				task->wait();
+
+				totalWakeUpTime += startTime;
+			}
+
+			bs_delete(scheduler);
+
+			const double tasksPerSecond = NUM_TASKS / (throughputTime / 1000000.0);
+			const double avgWakeUpTime = totalWakeUpTime / (double)NUM_WAKE_UPS;
+
+			gDebug().logDebug(String(modeName) + " task scheduler: " + toString((UINT64)tasksPerSecond) + 
+				" tasks/s, average wake-up latency " + toString((float)avgWakeUpTime) + " us");
+		}
+	}
+
+	void UtilityTestSuite::testTaskGraph()
+	{
+		// Simulates a frame pipeline (e.g. animation -> skinning bounds -> culling -> render queue build), where each
+		// node depends on a few nodes from the previous stage
+		static constexpr UINT32 NUM_STAGES = 4;
+		static constexpr UINT32 NUM_NODES_PER_STAGE = 1000;
+		static constexpr UINT32 NUM_NODES = NUM_STAGES * NUM_NODES_PER_STAGE;
+		static constexpr UINT32 NUM_FRAMES = 10;
+		static constexpr UINT32 DEPENDENCY_OFFSETS[] = { 0, 1, 7 };
+
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			const TaskSchedulerMode mode = i == 0 ? TaskSchedulerMode::GlobalQueue : TaskSchedulerMode::WorkStealing;
+			const char* modeName = i == 0 ? "Global queue" : "Work stealing";
+
+			TaskScheduler* scheduler = bs_new<TaskScheduler>(mode);
+
+			UINT64 totalTime = 0;
+			bool dependenciesRespected = true;
+			for(UINT32 frame = 0; frame < NUM_FRAMES; frame++)
+			{
+				Vector<std::atomic<bool>> nodeDone(NUM_NODES);
+				for(auto& entry : nodeDone)
+					entry = false;
+
+				std::atomic<bool> inOrder{true};
+
+				Timer timer;
+				Vector<SPtr<Task>> nodes(NUM_NODES);
+				for(UINT32 stage = 0; stage < NUM_STAGES; stage++)
+				{
+					for(UINT32 j = 0; j < NUM_NODES_PER_STAGE; j++)
+					{
+						const UINT32 nodeIdx = stage * NUM_NODES_PER_STAGE + j;
+						const auto worker = [nodeIdx, stage, j, &nodeDone, &inOrder]()
+						{
+							if(stage > 0)
+							{
+								for(auto& offset : DEPENDENCY_OFFSETS)
+								{
+									const UINT32 dependencyIdx = (stage - 1) * NUM_NODES_PER_STAGE + 
+										(j + offset) % NUM_NODES_PER_STAGE;
+
+									if(!nodeDone[dependencyIdx])
+										inOrder = false;
+								}
+							}
+
+							nodeDone[nodeIdx] = true;
+						};
+
+						nodes[nodeIdx] = Task::create("Node", worker);
+
+						if(stage > 0)
+						{
+							for(auto& offset : DEPENDENCY_OFFSETS)
+							{
+								const UINT32 dependencyIdx = (stage - 1) * NUM_NODES_PER_STAGE + 
+									(j + offset) % NUM_NODES_PER_STAGE;
+
+								nodes[nodeIdx]->addDependency(nodes[dependencyIdx]);
+							}
+						}
+					}
+				}
+
+				// Queue the last stages first, so dependants are already waiting when their dependencies complete
+				for(UINT32 j = NUM_NODES; j > 0; j--)
+					scheduler->addTask(nodes[j - 1]);
+
+				for(UINT32 j = 0; j < NUM_NODES_PER_STAGE; j++)
+					nodes[(NUM_STAGES - 1) * NUM_NODES_PER_STAGE + j]->wait();
+
+				totalTime += timer.getMicroseconds();
+
+				for(auto& entry : nodeDone)
+					dependenciesRespected &= entry;
+
+				dependenciesRespected &= inOrder;
+			}
+
+			// Canceling a task cancels everything that depends on it, so waiting on the dependants doesn't block. The root
+			// waits on a gate task so that it's guaranteed to still be pending when it gets canceled.
+			std::atomic<UINT32> numCanceledExecuted{0};
+			const auto canceledWorker = [&numCanceledExecuted]() { numCanceledExecuted++; };
+			const auto emptyWorker = []() { };
+
+			SPtr<Task> gate = Task::create("Gate", emptyWorker);
+			SPtr<Task> other = Task::create("Other", emptyWorker);
+			SPtr<Task> root = Task::create("Root", canceledWorker, TaskPriority::Normal, gate);
+			SPtr<Task> child = Task::create("Child", canceledWorker, TaskPriority::Normal, root);
+			SPtr<Task> grandchild = Task::create("Grandchild", canceledWorker, TaskPriority::Normal, { child, other });
+			SPtr<TaskGroup> group = TaskGroup::create("Group", [&numCanceledExecuted](UINT32) { numCanceledExecuted++; },
+				16, TaskPriority::Normal, child);
+
+			scheduler->addTask(root);
+			scheduler->addTask(child);
+			scheduler->addTask(grandchild);
+			scheduler->addTaskGroup(group);
+
+			root->cancel();
+
+			// Tasks queued after their dependency was canceled are canceled right away
+			SPtr<Task> late = Task::create("Late", canceledWorker, TaskPriority::Normal, child);
+			scheduler->addTask(late);
+
+			scheduler->addTask(other);
+			scheduler->addTask(gate);
+
+			grandchild->wait();
+			group->wait();
+			late->wait();
+			gate->wait();
+			other->wait();
+
+			BS_TEST_ASSERT(child->isCanceled() && grandchild->isCanceled() && late->isCanceled());
+			BS_TEST_ASSERT(group->isCanceled() && !group->isComplete());
+			BS_TEST_ASSERT(gate->isComplete() && other->isComplete());
+			BS_TEST_ASSERT(numCanceledExecuted == 0);
+
+			bs_delete(scheduler);
+
+			BS_TEST_ASSERT(dependenciesRespected);
+
+			const double avgFrameTime = totalTime / (double)NUM_FRAMES;
+			gDebug().logDebug(String(modeName) + " task graph: " + toString(NUM_NODES) + " nodes in " + 
+				toString((float)avgFrameTime) + " us per frame");
+		}
+	}
+
+	void UtilityTestSuite::testBoundsCulling()
+	{
+		static constexpr UINT32 NUM_OBJECTS[] = { 10000, 100000, 1000000 };
+		static constexpr UINT32 NUM_OBJECTS_PER_SIZE = 10000000;
+
+		const Matrix4 proj = Matrix4::projectionPerspective(Degree(90.0f), 16.0f / 9.0f, 0.1f, 1000.0f);
+		const ConvexVolume frustum(proj);
+
+		Random random(1234);
+		for(auto& numObjects : NUM_OBJECTS)
+		{
+			Vector<Bounds> bounds(numObjects);
+			simd::BoundsArray boundsArray;
+			for(UINT32 i = 0; i < numObjects; i++)
+			{
+				Vector3 center(random.getSNorm(), random.getSNorm(), random.getSNorm());
+				center *= 1000.0f;
+
+				Vector3 extents(random.getUNorm(), random.getUNorm(), random.getUNorm());
+				extents *= 10.0f;
+
+				const AABox box(center - extents, center + extents);
+				bounds[i] = Bounds(box, Sphere(center, box.getRadius()));
+				boundsArray.add(bounds[i]);
+			}
+
+			const UINT32 numWords = Math::divideAndRoundUp(numObjects, 32U);
+			const UINT32 numIterations = NUM_OBJECTS_PER_SIZE / numObjects;
+
+			// Reference implementation, testing one object at a time
+			Vector<UINT32> scalarMask(numWords);
+			Timer scalarTimer;
+			for(UINT32 i = 0; i < numIterations; i++)
+			{
+				memset(scalarMask.data(), 0, numWords * sizeof(UINT32));
+				for(UINT32 j = 0; j < numObjects; j++)
+				{
+					if(frustum.intersects(bounds[j].getSphere()) && frustum.intersects(bounds[j].getBox()))
+						scalarMask[j / 32] |= 1U << (j % 32);
+				}
+			}
+			const UINT64 scalarTime = scalarTimer.getMicroseconds();
+
+			Vector<UINT32> simdMask(numWords);
+			Timer simdTimer;
+			for(UINT32 i = 0; i < numIterations; i++)
+				boundsArray.intersects(frustum, simdMask.data());
+			const UINT64 simdTime = simdTimer.getMicroseconds();
+
+			BS_TEST_ASSERT(scalarMask == simdMask);
+
+			auto objectsPerMs = [numObjects, numIterations](UINT64 time)
+			{
+				return (UINT64)(numObjects * (double)numIterations / std::max(time / 1000.0, 0.001));
+			};
+
+			gDebug().logDebug("Bounds culling: " + toString(numObjects) + " objects, scalar " + 
+				toString(objectsPerMs(scalarTime)) + " objects/ms, SIMD " + toString(objectsPerMs(simdTime)) +
+				" objects/ms");
+		}
+	}
+
+	void UtilityTestSuite::testRadixSort()
+	{
+		static constexpr UINT32 NUM_ENTRIES = 50000;
+		static constexpr UINT32 NUM_ITERATIONS = 20;
+
+		// Keys laid out similarly to render queue sort keys, with a mostly constant priority, followed by a distance and a
+		// small number of distinct materials
+		Random random(1234);
+		Vector<RadixSortEntry> entries(NUM_ENTRIES);
+		for(UINT32 i = 0; i < NUM_ENTRIES; i++)
+		{
+			const UINT64 priority = (i % 100) == 0 ? 1 : 0;
+			const UINT64 distance = random.get() & 0xFFFFFF;
+			const UINT64 material = random.getRange(0, 63);
+
+			entries[i].key = (priority << 48) | (distance << 24) | material;
+			entries[i].value = i;
+		}
+
+		// Reference implementation, sorting indices using a comparator, ordered by sequence for equal keys
+		Vector<UINT32> indices(NUM_ENTRIES);
+		const std::function<bool(UINT32, UINT32)> comparator = [&entries](UINT32 a, UINT32 b)
+		{
+			if(entries[a].key != entries[b].key)
+				return entries[a].key < entries[b].key;
+
+			return a < b;
+		};
+
+		Timer comparisonTimer;
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			for(UINT32 j = 0; j < NUM_ENTRIES; j++)
+				indices[j] = j;
+
+			std::sort(indices.begin(), indices.end(), comparator);
+		}
+		const UINT64 comparisonTime = comparisonTimer.getMicroseconds();
+
+		Vector<RadixSortEntry> sorted(NUM_ENTRIES);
+		Vector<RadixSortEntry> scratch(NUM_ENTRIES);
+
+		Timer radixTimer;
+		for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+		{
+			sorted = entries;
+			RadixSort::sort(sorted.data(), scratch.data(), NUM_ENTRIES);
+		}
+		const UINT64 radixTime = radixTimer.getMicroseconds();
+
+		bool matches = true;
+		for(UINT32 i = 0; i < NUM_ENTRIES; i++)
+			matches &= sorted[i].value == indices[i];
+
+		BS_TEST_ASSERT(matches);
+
+		// Keys that differ only in the upper bits
+		Vector<RadixSortEntry> highBitEntries = { { 3ULL << 60, 0 }, { 1ULL << 60, 1 }, { 3ULL << 60, 2 }, { 0, 3 } };
+		RadixSort::sort(highBitEntries.data(), scratch.data(), (UINT32)highBitEntries.size());
+
+		BS_TEST_ASSERT(highBitEntries[0].value == 3 && highBitEntries[1].value == 1 && highBitEntries[2].value == 0 &&
+			highBitEntries[3].value == 2);
+
+		gDebug().logDebug("Sort " + toString(NUM_ENTRIES) + " entries: comparison sort " + 
+			toString((float)comparisonTime / NUM_ITERATIONS) + " us, radix sort " + 
+			toString((float)radixTime / NUM_ITERATIONS) + " us");
+	}
+
+	void UtilityTestSuite::testThreadCachingAlloc()
+	{
+		static constexpr UINT32 NUM_LIVE_ALLOCS = 1024;
+		static constexpr UINT32 NUM_OPS = 2000000;
+		static constexpr UINT32 NUM_CROSS_THREAD_BATCHES = 50;
+		static constexpr UINT32 CROSS_THREAD_BATCH_SIZE = 10000;
+
+		// Allocations of all sizes must be aligned and must not overlap
+		Random random(1234);
+		Vector<std::pair<UINT8*, UINT32>> allocs;
+		for(UINT32 i = 0; i < 5000; i += 7)
+		{
+			auto data = (UINT8*)ThreadCachingAlloc::allocate(i);
+			memset(data, (UINT8)i, i);
+
+			allocs.push_back(std::make_pair(data, i));
+		}
+
+		bool allValid = true;
+		for(auto& entry : allocs)
+		{
+			allValid &= ((UINT64)entry.first & 15) == 0;
+
+			for(UINT32 i = 0; i < entry.second; i++)
+				allValid &= entry.first[i] == (UINT8)entry.second;
+
+			ThreadCachingAlloc::free(entry.first);
+		}
+
+		BS_TEST_ASSERT(allValid);
+
+		struct Allocator
+		{
+			const char* name;
+			void* (*allocate)(size_t);
+			void (*free)(void*);
+		};
+
+		const Allocator allocators[] =
+		{
+			{ "System", &::malloc, &::free },
+			{ "Thread caching", &ThreadCachingAlloc::allocate, &ThreadCachingAlloc::free }
+		};
+
+		Vector<UINT32> sizes(NUM_OPS);
+		for(auto& entry : sizes)
+			entry = 8 + random.get() % 248;
+
+		for(auto& allocator : allocators)
+		{
+			// Allocation churn on a single thread, with a fixed number of live allocations
+			void* liveAllocs[NUM_LIVE_ALLOCS] = { };
+
+			Timer singleThreadTimer;
+			for(UINT32 i = 0; i < NUM_OPS; i++)
+			{
+				const UINT32 slot = i % NUM_LIVE_ALLOCS;
+
+				allocator.free(liveAllocs[slot]);
+				liveAllocs[slot] = allocator.allocate(sizes[i]);
+			}
+			const UINT64 singleThreadTime = singleThreadTimer.getMicroseconds();
+
+			for(auto& entry : liveAllocs)
+				allocator.free(entry);
+
+			// Allocations made on a worker thread and freed on this thread
+			Vector<void*> batch(CROSS_THREAD_BATCH_SIZE);
+
+			Timer crossThreadTimer;
+			for(UINT32 i = 0; i < NUM_CROSS_THREAD_BATCHES; i++)
+			{
+				Thread producer([&batch, &sizes, &allocator]()
+				{
+					for(UINT32 j = 0; j < CROSS_THREAD_BATCH_SIZE; j++)
+						batch[j] = allocator.allocate(sizes[j]);
+				});
+				producer.join();
+
+				for(auto& entry : batch)
+					allocator.free(entry);
+			}
+			const UINT64 crossThreadTime = crossThreadTimer.getMicroseconds();
+
+			const UINT64 numCrossThreadOps = NUM_CROSS_THREAD_BATCHES * CROSS_THREAD_BATCH_SIZE;
+			gDebug().logDebug(String(allocator.name) + " allocator: " + 
+				toString(NUM_OPS * 1000 / std::max(singleThreadTime, (UINT64)1)) + " alloc/free pairs per ms, " + 
+				toString(numCrossThreadOps * 1000 / std::max(crossThreadTime, (UINT64)1)) + 
+				" cross-thread alloc/free pairs per ms");
+		}
+	}
+
+	void UtilityTestSuite::testCommandRing()
+	{
+		static constexpr UINT32 NUM_COMMANDS = 1 << 20;
+		static constexpr UINT32 MAX_PRODUCERS = 16;
+
+		// Commands too large to be stored inline must still be executed and destroyed
+		{
+			SPtr<UINT32> counter = bs_shared_ptr_new<UINT32>(0);
+			{
+				CommandRing<> ring(4);
+
+				UINT8 largeCapture[256] = { };
+				largeCapture[255] = 1;
+
+				ring.push([counter, largeCapture]() { *counter += largeCapture[255]; });
+				ring.push([counter]() { *counter += 2; });
+				ring.push([counter]() { *counter += 4; }); // Never executed, released by the destructor
+
+				BS_TEST_ASSERT(ring.tryExecute() && ring.tryExecute());
+				BS_TEST_ASSERT(*counter == 3);
+			}
+
+			BS_TEST_ASSERT(counter.use_count() == 1);
+		}
+
+		// A full ring must reject new commands until the consumer makes room
+		{
+			CommandRing<> ring(2);
+
+			BS_TEST_ASSERT(ring.tryPush([]() { }) && ring.tryPush([]() { }));
+			BS_TEST_ASSERT(!ring.tryPush([]() { }));
+			BS_TEST_ASSERT(ring.tryExecute() && ring.tryPush([]() { }));
+		}
+
+		// Each producer's commands must be executed in the order they were queued. Compare against a mutex protected
+		// queue of std::function, which is what the core thread used to use.
+		struct LockedQueue
+		{
+			void push(std::function<void()> command)
+			{
+				Lock lock(mutex);
+				commands.push(std::move(command));
+			}
+
+			bool tryExecute()
+			{
+				std::function<void()> command;
+				{
+					Lock lock(mutex);
+					if(commands.empty())
+						return false;
+
+					command = std::move(commands.front());
+					commands.pop();
+				}
+
+				command();
+				return true;
+			}
+
+			Mutex mutex;
+			Queue<std::function<void()>> commands;
+		};
+
+		auto runBenchmark = [](auto& queue, UINT32 numProducers, bool& inOrder)
+		{
+			UINT32 lastExecuted[MAX_PRODUCERS] = { };
+			const UINT32 numPerProducer = NUM_COMMANDS / numProducers;
+
+			Timer timer;
+
+			Vector<Thread> producers;
+			for(UINT32 i = 0; i < numProducers; i++)
+			{
+				producers.emplace_back([&queue, &lastExecuted, &inOrder, i, numPerProducer]()
+				{
+					for(UINT32 j = 1; j <= numPerProducer; j++)
+					{
+						queue.push([&lastExecuted, &inOrder, i, j]()
+						{
+							inOrder &= lastExecuted[i] + 1 == j;
+							lastExecuted[i] = j;
+						});
+					}
+				});
+			}
+
+			UINT32 numExecuted = 0;
+			while(numExecuted < numPerProducer * numProducers)
+			{
+				if(queue.tryExecute())
+					numExecuted++;
+				else
+					std::this_thread::yield();
+			}
+
+			for(auto& entry : producers)
+				entry.join();
+
+			return timer.getMicroseconds();
+		};
+
+		bool inOrder = true;
+		for(UINT32 numProducers : { 1U, 4U, 16U })
+		{
+			LockedQueue lockedQueue;
+			const UINT64 lockedTime = runBenchmark(lockedQueue, numProducers, inOrder);
+
+			CommandRing<> ring(4096);
+			const UINT64 ringTime = runBenchmark(ring, numProducers, inOrder);
+
+			gDebug().logDebug(toString(numProducers) + " producer(s): mutex queue " + 
+				toString(NUM_COMMANDS * 1000 / std::max(lockedTime, (UINT64)1)) + " commands per ms, command ring " + 
+				toString(NUM_COMMANDS * 1000 / std::max(ringTime, (UINT64)1)) + " commands per ms");
+		}
+
+		BS_TEST_ASSERT(inOrder);
+	}
+
+	void UtilityTestSuite::testSerializerThroughput()
+	{
+		static constexpr UINT32 NUM_VALUES = 4 * 1024 * 1024;
+		static constexpr UINT32 NUM_ITERATIONS = 4;
+
+		Random random(1234);
+		Vector<float> values(NUM_VALUES);
+		for(auto& entry : values)
+			entry = random.getSNorm();
+
+		SPtr<SerializerTestObject> bulkObject = bs_shared_ptr_new<SerializerTestObject>();
+		bulkObject->mName = "Bulk";
+		bulkObject->mBulkValues = values;
+
+		SPtr<SerializerTestObject> elementObject = bs_shared_ptr_new<SerializerTestObject>();
+		elementObject->mName = "Element";
+		elementObject->mElementValues = values;
+
+		const auto matches = [&values](const SPtr<IReflectable>& decoded, const SPtr<SerializerTestObject>& original)
+		{
+			if(decoded == nullptr || decoded->getTypeId() != TID_SerializerTestObject)
+				return false;
+
+			auto object = std::static_pointer_cast<SerializerTestObject>(decoded);
+			return object->mName == original->mName && object->mBulkValues == original->mBulkValues &&
+				object->mElementValues == original->mElementValues;
+		};
+
+		const float dataSizeMB = NUM_VALUES * sizeof(float) / (1024.0f * 1024.0f);
+		const auto toMBps = [dataSizeMB](UINT64 time)
+		{
+			return toString(dataSizeMB * NUM_ITERATIONS * 1000000.0f / std::max(time, (UINT64)1)) + " MB/s";
+		};
+
+		// Encode and decode from memory
+		for(auto& object : { elementObject, bulkObject })
+		{
+			MemorySerializer serializer;
+
+			UINT64 encodeTime = 0;
+			UINT64 decodeTime = 0;
+			bool decodedMatches = true;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				UINT32 size = 0;
+
+				Timer encodeTimer;
+				UINT8* data = serializer.encode(object.get(), size);
+				encodeTime += encodeTimer.getMicroseconds();
+
+				Timer decodeTimer;
+				SPtr<IReflectable> decoded = serializer.decode(data, size);
+				decodeTime += decodeTimer.getMicroseconds();
+
+				decodedMatches &= matches(decoded, object);
+				bs_free(data);
+			}
+
+			BS_TEST_ASSERT(decodedMatches);
+
+			gDebug().logDebug(object->mName + " array of " + toString(dataSizeMB) + " MB: encode " + toMBps(encodeTime) +
+				", decode " + toMBps(decodeTime));
+		}
+
+		// Decode from a file, which is read in chunks. Element by element decoding crosses many chunk boundaries.
+		const Path filePath = FileSystem::getTempDirectoryPath() + "SerializerThroughputTest.asset";
+		for(auto& object : { elementObject, bulkObject })
+		{
+			{
+				FileEncoder encoder(filePath);
+				encoder.encode(object.get());
+			}
+
+			Timer decodeTimer;
+			FileDecoder decoder(filePath);
+			SPtr<IReflectable> decoded = decoder.decode();
+			const UINT64 decodeTime = decodeTimer.getMicroseconds();
+
+			BS_TEST_ASSERT(matches(decoded, object));
+
+			gDebug().logDebug(object->mName + " array of " + toString(dataSizeMB) + " MB: file decode " + 
+				toMBps(decodeTime * NUM_ITERATIONS));
+		}
+
+		FileSystem::remove(filePath);
+	}
+
+	void UtilityTestSuite::testBlockCompression()
+	{
+		static constexpr UINT32 DATA_SIZE = 32 * 1024 * 1024;
+		static constexpr UINT32 NUM_ITERATIONS = 4;
+		static constexpr UINT32 NUM_RANGE_READS = 1000;
+
+		TaskScheduler::startUp();
+
+		// Most of the data consists of short runs of repeating values and compresses well, while the rest is random
+		Random random(1234);
+		Vector<UINT8> data(DATA_SIZE);
+
+		const UINT32 compressibleSize = DATA_SIZE / 4 * 3;
+		for(UINT32 i = 0; i < compressibleSize; )
+		{
+			const UINT32 runLength = std::min((UINT32)random.getRange(1, 32), compressibleSize - i);
+			const UINT8 value = (UINT8)random.getRange(0, 15);
+
+			memset(&data[i], value, runLength);
+			i += runLength;
+		}
+
+		for(UINT32 i = compressibleSize; i < DATA_SIZE; i++)
+			data[i] = (UINT8)random.getRange(0, 255);
+
+		const auto createInput = [&data]()
+		{
+			return std::static_pointer_cast<DataStream>(
+				bs_shared_ptr_new<MemoryDataStream>(data.data(), data.size(), false));
+		};
+
+		const auto matches = [&data](const SPtr<MemoryDataStream>& stream)
+		{
+			return stream != nullptr && stream->size() == data.size() && 
+				memcmp(stream->getPtr(), data.data(), data.size()) == 0;
+		};
+
+		const float dataSizeMB = DATA_SIZE / (1024.0f * 1024.0f);
+		const auto toMBps = [dataSizeMB](UINT64 time)
+		{
+			return toString(dataSizeMB * NUM_ITERATIONS * 1000000.0f / std::max(time, (UINT64)1)) + " MB/s";
+		};
+
+		const auto logResults = [&](const String& name, UINT64 compressTime, UINT64 decompressTime, size_t compressedSize)
+		{
+			gDebug().logDebug(name + ": compress " + toMBps(compressTime) + ", decompress " + toMBps(decompressTime) + 
+				", ratio " + toString(DATA_SIZE / (float)compressedSize));
+		};
+
+		// Whole stream compression, for comparison
+		{
+			UINT64 compressTime = 0;
+			UINT64 decompressTime = 0;
+			size_t compressedSize = 0;
+			bool decompressedMatches = true;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				SPtr<DataStream> input = createInput();
+
+				Timer compressTimer;
+				SPtr<DataStream> compressed = Compression::compress(input);
+				compressTime += compressTimer.getMicroseconds();
+
+				Timer decompressTimer;
+				SPtr<MemoryDataStream> decompressed = Compression::decompress(compressed);
+				decompressTime += decompressTimer.getMicroseconds();
+
+				compressedSize = compressed->size();
+				decompressedMatches &= matches(decompressed);
+			}
+
+			BS_TEST_ASSERT(decompressedMatches);
+			logResults("Whole stream", compressTime, decompressTime, compressedSize);
+		}
+
+		// Block compression, blocks are processed in parallel
+		SPtr<MemoryDataStream> blockCompressed;
+		for(auto level : { CompressionLevel::None, CompressionLevel::Fast })
+		{
+			UINT64 compressTime = 0;
+			UINT64 decompressTime = 0;
+			bool decompressedMatches = true;
+			for(UINT32 i = 0; i < NUM_ITERATIONS; i++)
+			{
+				SPtr<DataStream> input = createInput();
+
+				Timer compressTimer;
+				blockCompressed = Compression::compressBlocks(input, level);
+				compressTime += compressTimer.getMicroseconds();
+
+				SPtr<DataStream> compressed = blockCompressed;
+
+				Timer decompressTimer;
+				SPtr<MemoryDataStream> decompressed = Compression::decompressBlocks(compressed);
+				decompressTime += decompressTimer.getMicroseconds();
+
+				decompressedMatches &= matches(decompressed);
+				decompressedMatches &= compressed->eof();
+			}
+
+			BS_TEST_ASSERT(decompressedMatches);
+
+			const String name = level == CompressionLevel::None ? "Blocks (none)" : "Blocks (fast)";
+			logResults(name, compressTime, decompressTime, blockCompressed->size());
+		}
+
+		// Random access, from memory and from a file
+		blockCompressed->seek(0);
+
+		const Path filePath = FileSystem::getTempDirectoryPath() + "BlockCompressionTest.bin";
+		{
+			SPtr<DataStream> fileStream = FileSystem::createAndOpenFile(filePath);
+			fileStream->write(blockCompressed->getPtr(), blockCompressed->size());
+		}
+
+		for(UINT32 i = 0; i < 2; i++)
+		{
+			const bool fromFile = i == 1;
+			SPtr<DataStream> input = fromFile ? FileSystem::openFile(filePath) : blockCompressed;
+
+			BlockDecompressor decompressor(input);
+			BS_TEST_ASSERT(decompressor.isValid());
+			BS_TEST_ASSERT(decompressor.getSize() == DATA_SIZE);
+
+			Vector<UINT8> buffer(Compression::DEFAULT_BLOCK_SIZE * 3);
+			bool rangesMatch = true;
+
+			Timer timer;
+			for(UINT32 j = 0; j < NUM_RANGE_READS; j++)
+			{
+				const UINT32 offset = (UINT32)random.getRange(0, DATA_SIZE - 1);
+				const UINT32 count = std::min((UINT32)random.getRange(1, (INT32)buffer.size()), DATA_SIZE - offset);
+
+				rangesMatch &= decompressor.read(offset, buffer.data(), count) == count;
+				rangesMatch &= memcmp(buffer.data(), &data[offset], count) == 0;
+			}
+
+			const UINT64 time = timer.getMicroseconds();
+
+			// Reading past the end only returns the available data
+			rangesMatch &= decompressor.read(DATA_SIZE - 16, buffer.data(), 64) == 16;
+			rangesMatch &= decompressor.read(DATA_SIZE, buffer.data(), 64) == 0;
+
+			BS_TEST_ASSERT(rangesMatch);
+			BS_TEST_ASSERT(matches(decompressor.readAll()));
+
+			gDebug().logDebug(String("Random access from ") + (fromFile ? "file" : "memory") + ": " + 
+				toString(NUM_RANGE_READS) + " range reads in " + toString(time / 1000.0f) + " ms");
+		}
+
+		FileSystem::remove(filePath);
+
+		// Corrupt data is detected
+		{
+			blockCompressed->seek(0);
+			blockCompressed->getPtr()[0] ^= 0xFF;
+
+			SPtr<DataStream> input = blockCompressed;
+			BS_TEST_ASSERT(!BlockDecompressor(input).isValid());
+
+			blockCompressed->seek(0);
+			blockCompressed->getPtr()[0] ^= 0xFF;
+
+			SPtr<DataStream> truncated = bs_shared_ptr_new<MemoryDataStream>(blockCompressed->getPtr(), 
+				blockCompressed->size() / 2, false);
+			BS_TEST_ASSERT(!BlockDecompressor(truncated).isValid());
+
+			// Header specifying more blocks than the stream can hold
+			const UINT32 blockSize = 1;
+			const UINT64 size = std::numeric_limits<UINT32>::max();
+			const UINT32 numBlocks = std::numeric_limits<UINT32>::max();
+
+			SPtr<MemoryDataStream> header = bs_shared_ptr_new<MemoryDataStream>(20);
+			header->write(blockCompressed->getPtr(), sizeof(UINT32));
+			header->write(&blockSize, sizeof(blockSize));
+			header->write(&size, sizeof(size));
+			header->write(&numBlocks, sizeof(numBlocks));
+			header->seek(0);
+
+			SPtr<DataStream> oversized = header;
+			BS_TEST_ASSERT(!BlockDecompressor(oversized).isValid());
+
+			// Headers with compressed blocks that can't decompress to the size the header claims. These must be rejected
+			// before the output is allocated.
+			const auto createBlocks = [&blockCompressed](UINT32 blockSize, UINT64 size, const Vector<UINT32>& index,
+				const Vector<UINT8>& blockData)
+			{
+				const UINT32 numBlocks = (UINT32)index.size();
+
+				SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(20 + numBlocks * sizeof(UINT32) +
+					blockData.size());
+				stream->write(blockCompressed->getPtr(), sizeof(UINT32));
+				stream->write(&blockSize, sizeof(blockSize));
+				stream->write(&size, sizeof(size));
+				stream->write(&numBlocks, sizeof(numBlocks));
+				stream->write(index.data(), numBlocks * sizeof(UINT32));
+				stream->write(blockData.data(), blockData.size());
+				stream->seek(0);
+
+				return std::static_pointer_cast<DataStream>(stream);
+			};
+
+			const UINT32 largeBlockSize = 1024 * 1024 * 1024;
+			SPtr<DataStream> emptyBlocks = createBlocks(largeBlockSize, largeBlockSize * 4ULL, { 0, 0, 0, 0 }, {});
+			BS_TEST_ASSERT(!BlockDecompressor(emptyBlocks).isValid());
+			BS_TEST_ASSERT(Compression::decompressBlocks(emptyBlocks) == nullptr);
+
+			SPtr<DataStream> tinyBlocks = createBlocks(largeBlockSize, largeBlockSize * 2ULL, { 3, 3 },
+				{ 0x80, 0x80, 0x80, 0x80, 0x80, 0x80 });
+			BS_TEST_ASSERT(!BlockDecompressor(tinyBlocks).isValid());
+
+			// Block whose encoded length (63) doesn't match the block size (64)
+			SPtr<DataStream> wrongLength = createBlocks(64, 64, { 8 }, { 63, 0, 0, 0, 0, 0, 0, 0 });
+			BS_TEST_ASSERT(!BlockDecompressor(wrongLength).isValid());
+
+			// Compressed block larger than any block of the block size could compress to
+			SPtr<DataStream> largeBlock = createBlocks(4, 4, { 64 }, Vector<UINT8>(64, 0));
+			BS_TEST_ASSERT(!BlockDecompressor(largeBlock).isValid());
+
+			// Size that needs more blocks than the header specifies
+			SPtr<DataStream> missingBlocks = createBlocks(4, 12, { 4 | 0x80000000, 4 | 0x80000000 }, Vector<UINT8>(8, 0));
+			BS_TEST_ASSERT(!BlockDecompressor(missingBlocks).isValid());
+		}
+
+		TaskScheduler::shutDown();
+	}
 }
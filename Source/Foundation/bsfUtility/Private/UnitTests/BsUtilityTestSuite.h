@@ -20,5 +20,13 @@ namespace bs
 		void testDynArray();
 		void testComplex();
 		void testMinHeap();
+		void testTaskScheduler();
+		void testTaskGraph();
+		void testBoundsCulling();
+		void testRadixSort();
+		void testThreadCachingAlloc();
+		void testCommandRing();
+		void testSerializerThroughput();
+		void testBlockCompression();
 	};
 }
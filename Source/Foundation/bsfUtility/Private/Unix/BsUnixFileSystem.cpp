@@ -8,6 +8,8 @@
 
 #include <dirent.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -145,6 +147,15 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(path, accessMode, true);
 	}
 
+	SPtr<MemoryDataStream> FileSystem::openFileMapped(const Path& path)
+	{
+		SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(path);
+		if(!stream->isMapped())
+			return nullptr;
+
+		return stream;
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& path)
 	{
 		return bs_shared_ptr_new<FileDataStream>(path, DataStream::AccessMode::WRITE, true);
@@ -349,4 +360,48 @@ namespace bs
 
 		return Path(String(directoryName) + "/");
 	}
+
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath)
+		: MemoryDataStream(nullptr, 0, false), mPath(filePath)
+	{
+		mAccess = READ;
+
+		String pathString = filePath.toString();
+		// Failures aren't reported, callers are expected to fall back to FileSystem::openFile() which reports them
+		int fd = open(pathString.c_str(), O_RDONLY);
+		if (fd == -1)
+			return;
+
+		struct stat st_buf;
+		if (fstat(fd, &st_buf) == 0 && st_buf.st_size > 0)
+		{
+			// Private mapping so that the memory may be modified without affecting the file
+			void* data = mmap(nullptr, (size_t)st_buf.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+			if (data != MAP_FAILED)
+			{
+				mData = mPos = (UINT8*)data;
+				mSize = (size_t)st_buf.st_size;
+				mEnd = mData + mSize;
+			}
+		}
+
+		// Mapping remains valid after the descriptor is closed
+		::close(fd);
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			munmap(mData, mSize);
+
+			mData = mPos = mEnd = nullptr;
+			mSize = 0;
+		}
+	}
 }
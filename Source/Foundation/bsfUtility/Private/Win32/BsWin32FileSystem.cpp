@@ -288,6 +288,15 @@ namespace bs
 		return bs_shared_ptr_new<FileDataStream>(fullPath, accessMode, true);
 	}
 
+	SPtr<MemoryDataStream> FileSystem::openFileMapped(const Path& fullPath)
+	{
+		SPtr<MappedFileDataStream> stream = bs_shared_ptr_new<MappedFileDataStream>(fullPath);
+		if (!stream->isMapped())
+			return nullptr;
+
+		return stream;
+	}
+
 	SPtr<DataStream> FileSystem::createAndOpenFile(const Path& fullPath)
 	{
 		return bs_shared_ptr_new<FileDataStream>(fullPath, DataStream::AccessMode::WRITE, true);
@@ -474,4 +483,58 @@ namespace bs
 		const String utf8dir = UTF8::fromWide(win32_getTempDirectory());
 		return Path(utf8dir);
 	}
+
+	MappedFileDataStream::MappedFileDataStream(const Path& filePath)
+		: MemoryDataStream(nullptr, 0, false), mPath(filePath)
+	{
+		mAccess = READ;
+
+		// Failures aren't reported, callers are expected to fall back to FileSystem::openFile() which reports them
+		WString pathString = UTF8::toWide(filePath.toString());
+		HANDLE file = CreateFileW(pathString.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, 
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return;
+
+		LARGE_INTEGER fileSize;
+		if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0)
+		{
+			// Copy-on-write mapping so that the memory may be modified without affecting the file
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+			if (mapping != nullptr)
+			{
+				void* data = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+				if (data != nullptr)
+				{
+					mData = mPos = (UINT8*)data;
+					mSize = (size_t)fileSize.QuadPart;
+					mEnd = mData + mSize;
+					mMappingHandle = mapping;
+				}
+				else
+					CloseHandle(mapping);
+			}
+		}
+
+		// Mapping keeps the file open for as long as it exists
+		CloseHandle(file);
+	}
+
+	MappedFileDataStream::~MappedFileDataStream()
+	{
+		close();
+	}
+
+	void MappedFileDataStream::close()
+	{
+		if (mData != nullptr)
+		{
+			UnmapViewOfFile(mData);
+			CloseHandle((HANDLE)mMappingHandle);
+
+			mData = mPos = mEnd = nullptr;
+			mMappingHandle = nullptr;
+			mSize = 0;
+		}
+	}
 }
@@ -94,6 +94,17 @@ namespace bs
 		 * location and contains the proper type.
 		 */
 		virtual void arrayElemFromBuffer(RTTITypeBase* rtti, void* object, int index, void* buffer) = 0;
+
+		/**
+		 * Returns a pointer to contiguous storage of the array managed by the field, if the array elements are stored
+		 * contiguously and can be serialized by copying their memory. This allows the entire array to be copied at once 
+		 * instead of going through arrayElemToBuffer() and arrayElemFromBuffer() for each element. Returns null if the 
+		 * field doesn't support such access, in which case elements must be accessed individually.
+		 */
+		virtual void* getArrayData(RTTITypeBase* rtti, void* object)
+		{
+			return nullptr;
+		}
 	};
 
 	/** Represents a plain class field containing a specific type. */
@@ -107,6 +118,7 @@ namespace bs
 		typedef void (InterfaceType::*ArraySetterType)(ObjectType*, UINT32, DataType&);
 		typedef UINT32(InterfaceType::*ArrayGetSizeType)(ObjectType*);
 		typedef void(InterfaceType::*ArraySetSizeType)(ObjectType*, UINT32);
+		typedef DataType* (InterfaceType::*ArrayGetDataType)(ObjectType*);
 
 		/**
 		 * Initializes a plain field containing a single value.
@@ -145,9 +157,13 @@ namespace bs
 		 * @param[in]	setter  	The setter method for the field.
 		 * @param[in]	setSize 	Setter method that allows you to resize an array. Can be null.
 		 * @param[in]	flags		Various flags you can use to specialize how outside systems handle this field. See "RTTIFieldFlag".
+		 * @param[in]	getData		Optional method that returns a pointer to contiguous array storage, or null if the
+		 *							array isn't stored contiguously. Only used if the data type can be serialized using
+		 *							memcpy. See getArrayData().
 		 */
 		void initArray(String name, UINT16 uniqueId, ArrayGetterType getter,
-			ArrayGetSizeType getSize, ArraySetterType setter, ArraySetSizeType setSize, UINT64 flags)
+			ArrayGetSizeType getSize, ArraySetterType setter, ArraySetSizeType setSize, UINT64 flags, 
+			ArrayGetDataType getData = nullptr)
 		{
 			static_assert((RTTIPlainType<DataType>::id != 0) || true, ""); // Just making sure provided type has a type ID
 
@@ -159,6 +175,7 @@ namespace bs
 			arraySetter = setter;
 			arrayGetSize = getSize;
 			arraySetSize = setSize;
+			arrayGetData = RTTIPlainTypeAllowsMemcpy<DataType>::value ? getData : nullptr;
 
 			init(std::move(name), uniqueId, true, SerializableFT_Plain, flags);
 		}
@@ -300,6 +317,19 @@ namespace bs
 			(rttiObject->*arraySetter)(castObject, index, value);
 		}
 
+		/** @copydoc RTTIPlainFieldBase::getArrayData */
+		void* getArrayData(RTTITypeBase* rtti, void* object) override
+		{
+			checkIsArray(true);
+
+			if(!arrayGetData)
+				return nullptr;
+
+			InterfaceType* rttiObject = static_cast<InterfaceType*>(rtti);
+			ObjectType* castObject = static_cast<ObjectType*>(object);
+			return (rttiObject->*arrayGetData)(castObject);
+		}
+
 	private:
 		union
 		{
@@ -318,6 +348,8 @@ namespace bs
 				ArraySetSizeType arraySetSize;
 			};
 		};
+
+		ArrayGetDataType arrayGetData = nullptr;
 	};
 
 	/** @} */
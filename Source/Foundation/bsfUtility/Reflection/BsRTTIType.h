@@ -77,11 +77,13 @@ namespace bs
 	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::name)>::type::value_type& val) { obj->name[idx] = val; }		\
 	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->name.size(); }																		\
 	void setSize##name(OwnerType* obj, UINT32 val) { obj->name.resize(val); }																		\
+	std::common_type<decltype(OwnerType::name)>::type::value_type* getData##name(OwnerType* obj) { return bs::rttiGetContiguousData(obj->name, 0); }		\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name,	\
+			&MyType::getData##name);																\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -97,11 +99,13 @@ namespace bs
 	void set##name(OwnerType* obj, UINT32 idx, std::common_type<decltype(OwnerType::field)>::type::value_type& val) { obj->field[idx] = val; }		\
 	UINT32 getSize##name(OwnerType* obj) { return (UINT32)obj->field.size(); }																		\
 	void setSize##name(OwnerType* obj, UINT32 val) { obj->field.resize(val); }																		\
+	std::common_type<decltype(OwnerType::field)>::type::value_type* getData##name(OwnerType* obj) { return bs::rttiGetContiguousData(obj->field, 0); }		\
 																								\
 	struct META_NextEntry_##name{};																\
 	void META_InitPrevEntry(META_NextEntry_##name typeId)										\
 	{																							\
-		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name);						\
+		addPlainArrayField(#name, id, &MyType::get##name, &MyType::getSize##name, &MyType::set##name, &MyType::setSize##name,	\
+			&MyType::getData##name);																\
 		META_InitPrevEntry(META_Entry_##name());												\
 	}																							\
 																								\
@@ -626,6 +630,31 @@ namespace bs
 			addNewField(newField);
 		}	
 
+		/** 
+		 * Registers a field referencing an array of plain types, with an additional method providing access to contiguous
+		 * array storage. If the method returns non-null and the data type can be serialized using memcpy, the entire array
+		 * is serialized with a single copy.
+		 */
+		template<class InterfaceType, class ObjectType, class DataType>
+		void addPlainArrayField(const String& name, UINT32 uniqueId, 
+			DataType& (InterfaceType::*getter)(ObjectType*, UINT32),
+			UINT32(InterfaceType::*getSize)(ObjectType*),
+			void (InterfaceType::*setter)(ObjectType*, UINT32, DataType&),
+			void(InterfaceType::*setSize)(ObjectType*, UINT32),
+			DataType* (InterfaceType::*getData)(ObjectType*),
+			UINT64 flags = 0)
+		{
+			static_assert((std::is_base_of<bs::RTTIType<Type, BaseType, MyRTTIType>, InterfaceType>::value), 
+				"Class with the get/set methods must derive from bs::RTTIType.");
+
+			static_assert(!(std::is_base_of<bs::IReflectable, DataType>::value), 
+				"Data type derives from IReflectable but it is being added as a plain field.");
+
+			auto newField = bs_new<RTTIPlainField<InterfaceType, DataType, ObjectType>>();
+			newField->initArray(name, uniqueId, getter, getSize, setter, setSize, flags, getData);
+			addNewField(newField);
+		}
+
 		/** Registers a field referencing an array of IReflectable objects. */
 		template<class InterfaceType, class ObjectType, class DataType>
 		void addReflectableArrayField(const String& name, UINT32 uniqueId, 
@@ -40,6 +40,143 @@ buffer += size;															\
 
 namespace bs
 {
+	/**
+	 * Provides read access to a range of a data stream during decoding. File streams are read in fixed size chunks so 
+	 * the many small reads and seeks performed during decoding don't each go to the file, while memory usage stays 
+	 * bounded regardless of the data size. Memory streams are accessed directly.
+	 */
+	class BinarySerializer::StreamReader
+	{
+	public:
+		StreamReader(const SPtr<DataStream>& stream, size_t end)
+			:mStream(stream), mPos(stream->tell()), mEnd(end)
+		{
+			if(stream->isFile())
+			{
+				mChunk = (UINT8*)bs_alloc(DECODE_CHUNK_SIZE);
+				mWindow = mChunk;
+				mWindowStart = mWindowEnd = mPos;
+			}
+			else
+			{
+				auto memStream = static_cast<MemoryDataStream*>(stream.get());
+				mWindow = memStream->getPtr();
+				mWindowStart = 0;
+				mWindowEnd = std::min(end, memStream->size());
+			}
+		}
+
+		~StreamReader()
+		{
+			if(mChunk)
+				bs_free(mChunk);
+		}
+
+		/** Reads @p count bytes into @p buffer and advances the read position. Returns the number of bytes read. */
+		size_t read(void* buffer, size_t count)
+		{
+			UINT8* dst = (UINT8*)buffer;
+			size_t numRead = 0;
+
+			while(numRead < count)
+			{
+				if(mPos >= mWindowStart && mPos < mWindowEnd)
+				{
+					const size_t size = std::min(count - numRead, mWindowEnd - mPos);
+					memcpy(dst + numRead, mWindow + (mPos - mWindowStart), size);
+
+					numRead += size;
+					mPos += size;
+					continue;
+				}
+
+				if(!mChunk || mPos >= mEnd)
+					break;
+
+				// Large reads bypass the chunk
+				const size_t remaining = std::min(count - numRead, mEnd - mPos);
+				if(remaining >= DECODE_CHUNK_SIZE)
+				{
+					mStream->seek(mPos);
+					const size_t size = mStream->read(dst + numRead, remaining);
+
+					numRead += size;
+					mPos += size;
+					break;
+				}
+
+				if(!readChunk())
+					break;
+			}
+
+			return numRead;
+		}
+
+		/** Moves the read position to the specified offset from the start of the stream. */
+		void seek(size_t pos) { mPos = pos; }
+
+		/** Advances the read position by @p count bytes. */
+		void skip(size_t count) { mPos += count; }
+
+		/** Returns the current read position, as an offset from the start of the stream. */
+		size_t tell() const { return mPos; }
+
+		/**
+		 * Creates a stream referencing the next @p size bytes without copying them, and advances the read position past
+		 * them. Returns null if the data can't be safely referenced, in which case it needs to be read instead.
+		 */
+		SPtr<DataStream> createView(size_t size)
+		{
+			if(mChunk || mPos + size > mWindowEnd)
+				return nullptr;
+
+			// Memory must remain valid after decoding, for as long as the view exists
+			auto memStream = static_cast<MemoryDataStream*>(mStream.get());
+			if(!memStream->ownsMemory())
+				return nullptr;
+
+			SPtr<DataStream> view = bs_shared_ptr_new<MemoryDataStream>(memStream->getPtr() + mPos, size, mStream);
+			mPos += size;
+
+			return view;
+		}
+
+		/** 
+		 * Returns the underlying stream, positioned at the current read position. Stream position may be freely modified 
+		 * by the caller.
+		 */
+		const SPtr<DataStream>& getStream() const
+		{
+			mStream->seek(mPos);
+			return mStream;
+		}
+
+	private:
+		/** Reads the next chunk of the stream, starting at the current read position. */
+		bool readChunk()
+		{
+			// Stream position might have been modified externally, so always seek
+			mStream->seek(mPos);
+
+			const size_t size = std::min((size_t)DECODE_CHUNK_SIZE, mEnd - mPos);
+			const size_t numRead = mStream->read(mChunk, size);
+
+			mWindowStart = mPos;
+			mWindowEnd = mPos + numRead;
+
+			return numRead > 0;
+		}
+
+		SPtr<DataStream> mStream;
+		size_t mPos;
+		size_t mEnd;
+
+		UINT8* mChunk = nullptr;
+		const UINT8* mWindow = nullptr;
+		size_t mWindowStart = 0;
+		size_t mWindowEnd = 0;
+	};
+
 	BinarySerializer::BinarySerializer()
 		:mAlloc(&gFrameAlloc())
 	{ }
@@ -123,8 +260,19 @@ namespace bs
 		mAlloc->clear();
 	}
 
+	SPtr<IReflectable> BinarySerializer::decode(const SPtr<DataStream>& data, SerializationContext* context)
+	{
+		return decodeInternal(data, data->size() - data->tell(), context);
+	}
+
 	SPtr<IReflectable> BinarySerializer::decode(const SPtr<DataStream>& data, UINT32 dataLength, 
 		SerializationContext* context)
+	{
+		return decodeInternal(data, dataLength, context);
+	}
+
+	SPtr<IReflectable> BinarySerializer::decodeInternal(const SPtr<DataStream>& data, size_t dataLength, 
+		SerializationContext* context)
 	{
 		mContext = context;
 
@@ -135,6 +283,8 @@ namespace bs
 		const size_t end = start + dataLength;
 		mDecodeObjectMap.clear();
 
+		StreamReader reader(data, end);
+
 		// Note: Ideally we can avoid iterating twice over the stream data
 		// Create empty instances of all ptr objects
 		SPtr<IReflectable> rootObject = nullptr;
@@ -144,12 +294,12 @@ namespace bs
 			objectMetaData.objectMeta = 0;
 			objectMetaData.typeId = 0;
 
-			if(data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+			if(reader.read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
 			{
 				BS_EXCEPT(InternalErrorException, "Error decoding data.");
 			}
 
-			data->seek(data->tell() - sizeof(ObjectMetaData));
+			reader.seek(reader.tell() - sizeof(ObjectMetaData));
 
 			UINT32 objectId = 0;
 			UINT32 objectTypeId = 0;
@@ -163,12 +313,12 @@ namespace bs
 			}
 
 			SPtr<IReflectable> object = IReflectable::createInstanceFromTypeId(objectTypeId);
-			mDecodeObjectMap.insert(std::make_pair(objectId, ObjectToDecode(object, data->tell())));
+			mDecodeObjectMap.insert(std::make_pair(objectId, ObjectToDecode(object, reader.tell())));
 
 			if(rootObject == nullptr)
 				rootObject = object;
 
-		} while (decodeEntry(data, end, nullptr));
+		} while (decodeEntry(reader, end, nullptr));
 
 		// Now go through all of the objects and actually decode them
 		for(auto iter = mDecodeObjectMap.begin(); iter != mDecodeObjectMap.end(); ++iter)
@@ -178,10 +328,10 @@ namespace bs
 			if(objToDecode.isDecoded)
 				continue;
 
-			data->seek(objToDecode.offset);
+			reader.seek(objToDecode.offset);
 
 			objToDecode.decodeInProgress = true;
-			decodeEntry(data, end, objToDecode.object);
+			decodeEntry(reader, end, objToDecode.object);
 			objToDecode.decodeInProgress = false;
 			objToDecode.isDecoded = true;
 		}
@@ -283,6 +433,25 @@ namespace bs
 						{
 							RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+							// Copy the entire array at once if the field provides direct access to contiguous storage
+							UINT8* arrayData = nullptr;
+							if(!curField->hasDynamicSize() && arrayNumElems > 0)
+								arrayData = (UINT8*)curField->getArrayData(rttiInstance, object);
+
+							if(arrayData != nullptr)
+							{
+								const UINT32 arraySize = arrayNumElems * curField->getTypeSize();
+								buffer = dataBlockToBuffer(arrayData, arraySize, buffer, bufferLength, bytesWritten, flushBufferCallback);
+
+								if (buffer == nullptr || bufferLength == 0)
+								{
+									cleanup();
+									return nullptr;
+								}
+
+								break;
+							}
+
 							for(UINT32 arrIdx = 0; arrIdx < arrayNumElems; arrIdx++)
 							{
 								UINT32 typeSize = 0;
@@ -429,13 +598,13 @@ namespace bs
 		return buffer;
 	}
 
-	bool BinarySerializer::decodeEntry(const SPtr<DataStream>& data, size_t dataEnd, const SPtr<IReflectable>& output)
+	bool BinarySerializer::decodeEntry(StreamReader& data, size_t dataEnd, const SPtr<IReflectable>& output)
 	{
 		ObjectMetaData objectMetaData;
 		objectMetaData.objectMeta = 0;
 		objectMetaData.typeId = 0;
 
-		if(data->read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+		if(data.read(&objectMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
 		{
 			BS_EXCEPT(InternalErrorException, "Error decoding data.");
 		}
@@ -490,10 +659,10 @@ namespace bs
 		if(!rttiInstances.empty())
 			rttiInstance = rttiInstances[0];
 
-		while (data->tell() < dataEnd)
+		while (data.tell() < dataEnd)
 		{
 			int metaData = -1;
-			if(data->read(&metaData, META_SIZE) != META_SIZE)
+			if(data.read(&metaData, META_SIZE) != META_SIZE)
 			{
 				BS_EXCEPT(InternalErrorException, "Error decoding data.");
 			}
@@ -504,8 +673,8 @@ namespace bs
 				objMetaData.objectMeta = 0;
 				objMetaData.typeId = 0;
 
-				data->seek(data->tell() - META_SIZE);
-				if (data->read(&objMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
+				data.seek(data.tell() - META_SIZE);
+				if (data.read(&objMetaData, sizeof(ObjectMetaData)) != sizeof(ObjectMetaData))
 				{
 					BS_EXCEPT(InternalErrorException, "Error decoding data.");
 				}
@@ -538,7 +707,7 @@ namespace bs
 				else
 				{
 					// Found new object, we're done
-					data->seek(data->tell() - sizeof(ObjectMetaData));
+					data.seek(data.tell() - sizeof(ObjectMetaData));
 
 					finalizeObject(output.get());
 					return true;
@@ -592,7 +761,7 @@ namespace bs
 			int arrayNumElems = 1;
 			if (isArray)
 			{
-				if(data->read(&arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
+				if(data.read(&arrayNumElems, NUM_ELEM_FIELD_SIZE) != NUM_ELEM_FIELD_SIZE)
 				{
 					BS_EXCEPT(InternalErrorException, "Error decoding data.");
 				}
@@ -609,7 +778,7 @@ namespace bs
 					for (int i = 0; i < arrayNumElems; i++)
 					{
 						int childObjectId = 0;
-						if(data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+						if(data.read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
 						{
 							BS_EXCEPT(InternalErrorException, "Error decoding data.");
 						}
@@ -647,10 +816,10 @@ namespace bs
 									{
 										objToDecode.decodeInProgress = true;
 
-										const size_t curOffset = data->tell();
-										data->seek(objToDecode.offset);
+										const size_t curOffset = data.tell();
+										data.seek(objToDecode.offset);
 										decodeEntry(data, dataEnd, objToDecode.object);
-										data->seek(curOffset);
+										data.seek(curOffset);
 
 										objToDecode.decodeInProgress = false;
 										objToDecode.isDecoded = true;
@@ -688,13 +857,39 @@ namespace bs
 				{
 					RTTIPlainFieldBase* curField = static_cast<RTTIPlainFieldBase*>(curGenericField);
 
+					// Elements with static size are stored back to back, so when the field provides direct access to
+					// contiguous storage the entire array can be read at once
+					if (!hasDynamicSize)
+					{
+						void* arrayData = nullptr;
+						if (curField != nullptr)
+							arrayData = curField->getArrayData(rttiInstance, output.get());
+
+						const size_t arraySize = arrayNumElems * (size_t)fieldSize;
+						if (arrayData != nullptr)
+						{
+							if (data.read(arrayData, arraySize) != arraySize)
+							{
+								BS_EXCEPT(InternalErrorException, "Error decoding data.");
+							}
+
+							break;
+						}
+						
+						if (curField == nullptr)
+						{
+							data.skip(arraySize);
+							break;
+						}
+					}
+
 					for (int i = 0; i < arrayNumElems; i++)
 					{
 						UINT32 typeSize = fieldSize;
 						if (hasDynamicSize)
 						{
-							data->read(&typeSize, sizeof(UINT32));
-							data->seek(data->tell() - sizeof(UINT32));
+							data.read(&typeSize, sizeof(UINT32));
+							data.seek(data.tell() - sizeof(UINT32));
 						}
 
 						if (curField != nullptr)
@@ -703,13 +898,13 @@ namespace bs
 							//  - Copy from stream into a temporary buffer (use stream directly for decoding)
 							//  - Internally the field will do a value copy of the decoded object (ideally we decode directly into the destination)
 							void* fieldValue = bs_stack_alloc(typeSize);
-							data->read(fieldValue, typeSize);
+							data.read(fieldValue, typeSize);
 
 							curField->arrayElemFromBuffer(rttiInstance, output.get(), i, fieldValue);
 							bs_stack_free(fieldValue);
 						}
 						else
-							data->skip(typeSize);
+							data.skip(typeSize);
 					}
 					break;
 				}
@@ -728,7 +923,7 @@ namespace bs
 					RTTIReflectablePtrFieldBase* curField = static_cast<RTTIReflectablePtrFieldBase*>(curGenericField);
 
 					int childObjectId = 0;
-					if(data->read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
+					if(data.read(&childObjectId, COMPLEX_TYPE_FIELD_SIZE) != COMPLEX_TYPE_FIELD_SIZE)
 					{
 						BS_EXCEPT(InternalErrorException, "Error decoding data.");
 					}
@@ -766,10 +961,10 @@ namespace bs
 								{
 									objToDecode.decodeInProgress = true;
 
-									const size_t curOffset = data->tell();
-									data->seek(objToDecode.offset);
+									const size_t curOffset = data.tell();
+									data.seek(objToDecode.offset);
 									decodeEntry(data, dataEnd, objToDecode.object);
-									data->seek(curOffset);
+									data.seek(curOffset);
 
 									objToDecode.decodeInProgress = false;
 									objToDecode.isDecoded = true;
@@ -808,8 +1003,8 @@ namespace bs
 					UINT32 typeSize = fieldSize;
 					if (hasDynamicSize)
 					{
-						data->read(&typeSize, sizeof(UINT32));
-						data->seek(data->tell() - sizeof(UINT32));
+						data.read(&typeSize, sizeof(UINT32));
+						data.seek(data.tell() - sizeof(UINT32));
 					}
 
 					if (curField != nullptr)
@@ -818,13 +1013,13 @@ namespace bs
 						//  - Copy from stream into a temporary buffer (use stream directly for decoding)
 						//  - Internally the field will do a value copy of the decoded object (ideally we decode directly into the destination)
 						void* fieldValue = bs_stack_alloc(typeSize);
-						data->read(fieldValue, typeSize);
+						data.read(fieldValue, typeSize);
 
 						curField->fromBuffer(rttiInstance, output.get(), fieldValue);
 						bs_stack_free(fieldValue);
 					}
 					else
-						data->skip(typeSize);
+						data.skip(typeSize);
 
 					break;
 				}
@@ -834,7 +1029,7 @@ namespace bs
 
 					// Data block size
 					UINT32 dataBlockSize = 0;
-					if(data->read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
+					if(data.read(&dataBlockSize, DATA_BLOCK_TYPE_FIELD_SIZE) != DATA_BLOCK_TYPE_FIELD_SIZE)
 					{
 						BS_EXCEPT(InternalErrorException, "Error decoding data.");
 					}
@@ -842,25 +1037,32 @@ namespace bs
 					// Data block data
 					if (curField != nullptr)
 					{
-						if (data->isFile()) // Allow streaming
+						const SPtr<DataStream>& stream = data.getStream();
+						if (stream->isFile()) // Allow streaming
 						{
-							const size_t dataBlockOffset = data->tell();
-							curField->setValue(rttiInstance, output.get(), data, dataBlockSize);
+							const size_t dataBlockOffset = data.tell();
+							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
 
 							// Seek past the data (use original offset in case the field read from the stream)
-							data->seek(dataBlockOffset + dataBlockSize);
+							data.seek(dataBlockOffset + dataBlockSize);
 						}
 						else
 						{
-							UINT8* dataBlockBuffer = (UINT8*)bs_alloc(dataBlockSize);
-							data->read(dataBlockBuffer, dataBlockSize);
+							// Reference the data directly if possible (e.g. when decoding from a mapped file)
+							SPtr<DataStream> blockStream = data.createView(dataBlockSize);
+							if (blockStream == nullptr)
+							{
+								UINT8* dataBlockBuffer = (UINT8*)bs_alloc(dataBlockSize);
+								data.read(dataBlockBuffer, dataBlockSize);
 
-							SPtr<DataStream> stream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, dataBlockSize);
-							curField->setValue(rttiInstance, output.get(), stream, dataBlockSize);
+								blockStream = bs_shared_ptr_new<MemoryDataStream>(dataBlockBuffer, dataBlockSize);
+							}
+
+							curField->setValue(rttiInstance, output.get(), blockStream, dataBlockSize);
 						}
 					}
 					else
-						data->skip(dataBlockSize);
+						data.skip(dataBlockSize);
 
 					break;
 				}
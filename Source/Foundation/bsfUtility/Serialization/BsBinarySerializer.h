@@ -62,7 +62,22 @@ namespace bs
 			bool shallow = false, SerializationContext* context = nullptr);
 
 		/**
-		 * Decodes an object from binary data.
+		 * Decodes an object from binary data, starting at the current position and continuing until the end of the
+		 * stream. Data is read from the stream in fixed size chunks, so the memory used for decoding doesn't depend on
+		 * the size of the data. Memory streams are read directly, without intermediate copies.
+		 *
+		 * @param[in]	data  		Binary data to decode.
+		 * @param[in]	context		Optional object that will be passed along to all serialized objects through
+		 *							their deserialization callbacks. Can be used for controlling deserialization, 
+		 *							maintaining state or sharing information between objects during deserialization.
+		 */
+		SPtr<IReflectable> decode(const SPtr<DataStream>& data, SerializationContext* context = nullptr);
+
+		/**
+		 * Decodes an object from binary data that is followed by other data in the same stream. Same as 
+		 * decode(const SPtr<DataStream>&, SerializationContext*), except that decoding stops after @p dataLength bytes.
+		 * The encoded data doesn't store its own length, so it must be provided when the data doesn't extend to the end
+		 * of the stream.
 		 *
 		 * @param[in]	data  		Binary data to decode.
 		 * @param[in]	dataLength	Length of the data in bytes.
@@ -72,6 +87,8 @@ namespace bs
 		 */
 		SPtr<IReflectable> decode(const SPtr<DataStream>& data, UINT32 dataLength, SerializationContext* context = nullptr);
 	private:
+		class StreamReader;
+
 		struct ObjectMetaData
 		{
 			UINT32 objectMeta;
@@ -104,8 +121,12 @@ namespace bs
 		UINT8* encodeEntry(IReflectable* object, UINT32 objectId, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
 			std::function<UINT8*(UINT8* buffer, UINT32 bytesWritten, UINT32& newBufferSize)> flushBufferCallback, bool shallow);
 
+		/** Decodes an object from the next @p dataLength bytes of @p data. */
+		SPtr<IReflectable> decodeInternal(const SPtr<DataStream>& data, size_t dataLength, 
+			SerializationContext* context);
+
 		/**	Decodes a single IReflectable object. */
-		bool decodeEntry(const SPtr<DataStream>& data, size_t dataLength, const SPtr<IReflectable>& output);
+		bool decodeEntry(StreamReader& data, size_t dataEnd, const SPtr<IReflectable>& output);
 
 		/**	Helper method for encoding a complex object and copying its data to a buffer. */
 		UINT8* complexTypeToBuffer(IReflectable* object, UINT8* buffer, UINT32& bufferLength, UINT32* bytesWritten,
@@ -162,12 +183,11 @@ namespace bs
 		static constexpr const int NUM_ELEM_FIELD_SIZE = 4; // Size of the field storing number of array elements
 		static constexpr const int COMPLEX_TYPE_FIELD_SIZE = 4; // Size of the field storing the size of a child complex type
 		static constexpr const int DATA_BLOCK_TYPE_FIELD_SIZE = 4;
+		static constexpr const UINT32 DECODE_CHUNK_SIZE = 64 * 1024; // Size of the chunks data is read in when decoding
 	};
 
 	// TODO - Potential improvements:
 	//  - I will probably want to extract a generalized Serializer class so we can re-use the code in text or other serializers
-	//  - Encode does a chunk-based encode so that we don't need to know the buffer size in advance, and don't have to use 
-	//    a lot of memory for the buffer. Consider doing something similar for decode.
 	//  - Add a simple encode method that doesn't require a callback, instead it calls the callback internally and creates
 	//    the buffer internally.
 
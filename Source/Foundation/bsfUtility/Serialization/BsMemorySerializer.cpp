@@ -58,7 +58,7 @@ namespace bs
 		SPtr<MemoryDataStream> stream = bs_shared_ptr_new<MemoryDataStream>(buffer, bufferSize, false);
 
 		BinarySerializer bs;
-		SPtr<IReflectable> object = bs.decode(stream, (UINT32)bufferSize, context);
+		SPtr<IReflectable> object = bs.decode(stream, context);
 
 		return object;
 	}
@@ -0,0 +1,210 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Fixed capacity lock-free ring buffer of commands, with any number of producers and a single consumer. Commands are
+	 * arbitrary callables taking no parameters. They are type-erased and constructed directly in the ring slots, so
+	 * queuing a command doesn't allocate as long as its captures fit in @p InlineSize bytes. Larger commands fall back to
+	 * a heap allocation.
+	 *
+	 * Producers reserve slots using a compare-and-swap on the tail index, and publish them by advancing the slot's sequence
+	 * number, so they never contend on a lock. Commands are executed in the order their slots were reserved.
+	 *
+	 * @tparam	InlineSize	Number of bytes available for storing the command in each slot.
+	 *
+	 * @note	tryPush() and push() may be called from any thread. tryExecute() and isEmpty() must only be called from the
+	 *			consumer thread.
+	 */
+	template<UINT32 InlineSize = 96>
+	class CommandRing final
+	{
+		/** Type-erased operations on a command stored in a slot. */
+		struct CommandOps
+		{
+			void(*execute)(void* data);
+			void(*destroy)(void* data);
+		};
+
+		/** Operations for commands stored directly in the slot. */
+		template<class T>
+		struct InlineOps
+		{
+			static void execute(void* data) { (*(T*)data)(); }
+			static void destroy(void* data) { ((T*)data)->~T(); }
+
+			static constexpr CommandOps OPS = { &execute, &destroy };
+		};
+
+		/** Operations for commands too large for the slot, which store a pointer to the command instead. */
+		template<class T>
+		struct HeapOps
+		{
+			static void execute(void* data) { (**(T**)data)(); }
+			static void destroy(void* data) { bs_delete(*(T**)data); }
+
+			static constexpr CommandOps OPS = { &execute, &destroy };
+		};
+
+		/** Single element of the ring. */
+		struct Slot
+		{
+			std::atomic<UINT64> sequence;
+			const CommandOps* ops;
+			typename std::aligned_storage<InlineSize, alignof(std::max_align_t)>::type data;
+		};
+
+	public:
+		/** Constructs the ring able to hold up to @p capacity commands. Capacity must be a power of two. */
+		explicit CommandRing(UINT32 capacity = 1024)
+			: mCapacity(capacity), mMask(capacity - 1)
+		{
+			assert(Bitwise::isPow2(capacity));
+
+			mSlots = bs_newN<Slot>(capacity);
+			for(UINT32 i = 0; i < capacity; i++)
+				mSlots[i].sequence.store(i, std::memory_order_relaxed);
+		}
+
+		~CommandRing()
+		{
+			// Release any commands that were never executed
+			UINT64 head = mHead;
+			while(true)
+			{
+				Slot& slot = mSlots[head & mMask];
+				if(slot.sequence.load(std::memory_order_acquire) != head + 1)
+					break;
+
+				slot.ops->destroy(&slot.data);
+				head++;
+			}
+
+			bs_deleteN(mSlots, mCapacity);
+		}
+
+		CommandRing(const CommandRing&) = delete;
+		CommandRing& operator=(const CommandRing&) = delete;
+
+		/** Attempts to queue a new command. Returns false if the ring is full. */
+		template<class T>
+		bool tryPush(T&& command)
+		{
+			typedef typename std::decay<T>::type CommandType;
+
+			UINT64 pos = mTail.load(std::memory_order_relaxed);
+			Slot* slot;
+			while(true)
+			{
+				slot = &mSlots[pos & mMask];
+				const UINT64 sequence = slot->sequence.load(std::memory_order_acquire);
+				const INT64 diff = (INT64)(sequence - pos);
+
+				if(diff == 0)
+				{
+					if(mTail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if(diff < 0)
+					return false; // Consumer hasn't yet released the slot from the previous lap
+				else
+					pos = mTail.load(std::memory_order_relaxed);
+			}
+
+			construct<CommandType>(*slot, std::forward<T>(command));
+			slot->sequence.store(pos + 1, std::memory_order_release);
+
+			return true;
+		}
+
+		/** Queues a new command. If the ring is full the calling thread yields until the consumer makes room. */
+		template<class T>
+		void push(T&& command)
+		{
+			while(!tryPush(std::forward<T>(command)))
+				std::this_thread::yield();
+		}
+
+		/**
+		 * Executes the oldest queued command and removes it from the ring. Returns false if no command was ready. Must only
+		 * be called from the consumer thread.
+		 */
+		bool tryExecute()
+		{
+			Slot& slot = mSlots[mHead & mMask];
+			if(slot.sequence.load(std::memory_order_acquire) != mHead + 1)
+				return false;
+
+			slot.ops->execute(&slot.data);
+			slot.ops->destroy(&slot.data);
+
+			slot.sequence.store(mHead + mCapacity, std::memory_order_release);
+			mHead++;
+
+			return true;
+		}
+
+		/**
+		 * Returns true if there are no commands ready for execution. Commands whose slots were reserved but not yet
+		 * published count as not ready. Must only be called from the consumer thread.
+		 */
+		bool isEmpty() const
+		{
+			const Slot& slot = mSlots[mHead & mMask];
+			return slot.sequence.load(std::memory_order_acquire) != mHead + 1;
+		}
+
+		/** Returns the maximum number of commands the ring can hold. */
+		UINT32 getCapacity() const { return mCapacity; }
+
+	private:
+		/** Constructs the command in the provided slot, in place if it fits or on the heap otherwise. */
+		template<class T, class U>
+		static typename std::enable_if<sizeof(T) <= InlineSize && alignof(T) <= alignof(std::max_align_t)>::type
+			construct(Slot& slot, U&& command)
+		{
+			new (&slot.data) T(std::forward<U>(command));
+			slot.ops = &InlineOps<T>::OPS;
+		}
+
+		/** @copydoc construct */
+		template<class T, class U>
+		static typename std::enable_if<!(sizeof(T) <= InlineSize && alignof(T) <= alignof(std::max_align_t))>::type
+			construct(Slot& slot, U&& command)
+		{
+			new (&slot.data) T*(bs_new<T>(std::forward<U>(command)));
+			slot.ops = &HeapOps<T>::OPS;
+		}
+
+		Slot* mSlots;
+		UINT32 mCapacity;
+		UINT64 mMask;
+
+		alignas(64) std::atomic<UINT64> mTail{0};
+		alignas(64) UINT64 mHead = 0;
+	};
+
+	template<UINT32 InlineSize>
+	template<class T>
+	constexpr typename CommandRing<InlineSize>::CommandOps CommandRing<InlineSize>::InlineOps<T>::OPS;
+
+	template<UINT32 InlineSize>
+	template<class T>
+	constexpr typename CommandRing<InlineSize>::CommandOps CommandRing<InlineSize>::HeapOps<T>::OPS;
+
+	/** @} */
+	/** @} */
+}
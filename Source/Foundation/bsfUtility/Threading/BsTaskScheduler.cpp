@@ -2,12 +2,27 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Threading/BsTaskScheduler.h"
 #include "Threading/BsThreadPool.h"
+#include "Math/BsMath.h"
 
 namespace bs
 {
+	/** Work stealing worker (if any) executing on the current thread, and the scheduler it belongs to. */
+	static BS_THREADLOCAL TaskScheduler* gWorkerScheduler = nullptr;
+	static BS_THREADLOCAL UINT32 gWorkerIdx = 0;
+
+	/** Number of times an idle work stealing worker will look for new tasks before going to sleep. */
+	static constexpr UINT32 NUM_IDLE_SPINS = 64;
+
+	/**
+	 * Maximum number of tasks a work stealing worker will move from the injection queue into its own queue at once, so
+	 * other workers can steal them without going through the injection queue lock.
+	 */
+	static constexpr UINT32 INJECT_BATCH_SIZE = 16;
+
 	Task::Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
-		TaskPriority priority, SPtr<Task> dependency)
-		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
+		TaskPriority priority, Vector<SPtr<Task>> dependencies)
+		: mName(name), mPriority(priority), mTaskWorker(std::move(taskWorker))
+		, mDependencies(dependencies.begin(), dependencies.end())
 	{
 
 	}
@@ -15,7 +30,27 @@ namespace bs
 	SPtr<Task> Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
 		SPtr<Task> dependency)
 	{
-		return bs_shared_ptr_new<Task>(PrivatelyConstruct(), name, std::move(taskWorker), priority, std::move(dependency));
+		Vector<SPtr<Task>> dependencies;
+		if(dependency != nullptr)
+			dependencies.push_back(std::move(dependency));
+
+		return bs_shared_ptr_new<Task>(PrivatelyConstruct(), name, std::move(taskWorker), priority, 
+			std::move(dependencies));
+	}
+
+	SPtr<Task> Task::create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
+		Vector<SPtr<Task>> dependencies)
+	{
+		return bs_shared_ptr_new<Task>(PrivatelyConstruct(), name, std::move(taskWorker), priority, 
+			std::move(dependencies));
+	}
+
+	void Task::addDependency(SPtr<Task> dependency)
+	{
+		assert(mState != 1 && "Dependencies cannot be added while the task is executing.");
+
+		if(dependency != nullptr)
+			mDependencies.push_back(std::move(dependency));
 	}
 
 	bool Task::isComplete() const
@@ -36,13 +71,29 @@ namespace bs
 
 	void Task::cancel()
 	{
-		mState = 3;
+		UINT32 expectedState = 0;
+		if(!mState.compare_exchange_strong(expectedState, 3))
+			return;
+
+		// Tasks depending on this task will never execute, so cancel them right away. No new dependants can register
+		// after this point, as registration checks for cancelation under the same lock.
+		Vector<SPtr<Task>> continuations;
+		{
+			ScopedSpinLock lock(mContinuationLock);
+			std::swap(continuations, mContinuations);
+		}
+
+		for(auto& entry : continuations)
+			entry->cancel();
+
+		if(mParent != nullptr)
+			mParent->notifyTaskCanceled();
 	}
 
-	TaskGroup::TaskGroup(const PrivatelyConstruct& dummy, String name, std::function<void(UINT32)> taskWorker, 
-		UINT32 count, TaskPriority priority, SPtr<Task> dependency)
-		: mName(std::move(name)), mCount(count), mPriority(priority), mTaskWorker(std::move(taskWorker))
-		, mTaskDependency(std::move(dependency))
+	TaskGroup::TaskGroup(const PrivatelyConstruct& dummy, String name, std::function<void(UINT32, UINT32)> taskWorker, 
+		UINT32 count, UINT32 grainSize, TaskPriority priority, SPtr<Task> dependency)
+		: mName(std::move(name)), mCount(count), mGrainSize(std::max(grainSize, 1U)), mPriority(priority)
+		, mTaskWorker(std::move(taskWorker)), mTaskDependency(std::move(dependency))
 	{
 
 	}
@@ -50,8 +101,21 @@ namespace bs
 	SPtr<TaskGroup> TaskGroup::create(String name, std::function<void(UINT32)> taskWorker, UINT32 count, 
 		TaskPriority priority, SPtr<Task> dependency)
 	{
-		return bs_shared_ptr_new<TaskGroup>(PrivatelyConstruct(), std::move(name), std::move(taskWorker), count, priority, 
-			std::move(dependency));
+		auto chunkWorker = [taskWorker = std::move(taskWorker)](UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+				taskWorker(i);
+		};
+
+		return bs_shared_ptr_new<TaskGroup>(PrivatelyConstruct(), std::move(name), std::move(chunkWorker), count, 1, 
+			priority, std::move(dependency));
+	}
+
+	SPtr<TaskGroup> TaskGroup::createChunked(String name, std::function<void(UINT32, UINT32)> taskWorker, UINT32 count,
+		UINT32 grainSize, TaskPriority priority, SPtr<Task> dependency)
+	{
+		return bs_shared_ptr_new<TaskGroup>(PrivatelyConstruct(), std::move(name), std::move(taskWorker), count, 
+			grainSize, priority, std::move(dependency));
 	}
 
 	bool TaskGroup::isComplete() const
@@ -59,22 +123,109 @@ namespace bs
 		return mNumRemainingTasks == 0;
 	}
 
+	bool TaskGroup::isCanceled() const
+	{
+		const SPtr<Task> dependency = mTaskDependency.lock();
+		return dependency != nullptr && dependency->isCanceled();
+	}
+
 	void TaskGroup::wait()
 	{
 		if(mParent != nullptr)
 			mParent->waitUntilComplete(this);
 	}
 
-	TaskScheduler::TaskScheduler()
-		:mTaskQueue(&TaskScheduler::taskCompare)
+	bool TaskGroup::processChunk()
+	{
+		// Claim progressively smaller chunks as the number of remaining items decreases, so that larger chunks keep the
+		// claiming overhead low, while the smaller chunks near the end keep the threads evenly loaded
+		UINT32 begin = mNextItem.load(std::memory_order_relaxed);
+		UINT32 end;
+		do
+		{
+			if(begin >= mCount)
+				return false;
+
+			const UINT32 numRemaining = mCount - begin;
+			const UINT32 chunkSize = std::min(numRemaining, std::max(mGrainSize, numRemaining / (mNumThreads * 2)));
+
+			end = begin + chunkSize;
+		} while(!mNextItem.compare_exchange_weak(begin, end));
+
+		mTaskWorker(begin, end);
+		mNumRemainingTasks -= end - begin;
+
+		return true;
+	}
+
+	TaskScheduler::TaskScheduler(TaskSchedulerMode mode)
+		:mMode(mode), mTaskQueue(&TaskScheduler::taskCompare)
 	{
 		mMaxActiveTasks = BS_THREAD_HARDWARE_CONCURRENCY;
 
-		mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			// Reserve worker slots for any workers added through addWorker(), as the worker list cannot be resized while
+			// other threads are stealing from it
+			const UINT32 maxWorkers = std::max(1U, mMaxActiveTasks.load()) * 2;
+
+			mWorkers.resize(maxWorkers);
+			for(UINT32 i = 0; i < maxWorkers; i++)
+			{
+				mWorkers[i] = bs_new<WorkStealingWorker>();
+				mWorkers[i]->index = i;
+			}
+
+			Lock lock(mReadyMutex);
+			for(UINT32 i = 0; i < mMaxActiveTasks; i++)
+				startWorkStealingWorker();
+		}
+		else
+			mTaskSchedulerThread = ThreadPool::instance().run("TaskScheduler", std::bind(&TaskScheduler::runMain, this));
 	}
 
 	TaskScheduler::~TaskScheduler()
 	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			// Let the workers finish their current tasks and exit
+			{
+				Lock lock(mSleepMutex);
+				mWorkersShutdown = true;
+			}
+
+			mWorkAvailableCond.notify_all();
+			mWorkerActivatedCond.notify_all();
+
+			const UINT32 numStartedWorkers = mNumStartedWorkers;
+			for(UINT32 i = 0; i < numStartedWorkers; i++)
+				mWorkers[i]->thread.blockUntilComplete();
+
+			// Release any tasks that never got to execute
+			for(auto& worker : mWorkers)
+			{
+				for(auto& queue : worker->queues)
+				{
+					while(Task* task = queue.pop())
+						task->mQueuedRef = nullptr;
+				}
+
+				bs_delete(worker);
+			}
+
+			for(auto& queue : mInjectQueues)
+			{
+				while(!queue.empty())
+				{
+					queue.front()->mQueuedRef = nullptr;
+					queue.pop();
+				}
+			}
+
+			mWorkers.clear();
+			return;
+		}
+
 		// Wait until all tasks complete
 		{
 			Lock activeTaskLock(mReadyMutex);
@@ -103,46 +254,84 @@ namespace bs
 
 	void TaskScheduler::addTask(SPtr<Task> task)
 	{
-		Lock lock(mReadyMutex);
-
 		assert(task->mState != 1 && "Task is already executing, it cannot be executed again until it finishes.");
 
 		task->mParent = this;
-		task->mTaskId = mNextTaskId++;
 		task->mState.store(0); // Reset state in case the task is getting re-queued
 
-		mCheckTasks = true;
-		mTaskQueue.insert(std::move(task));
+		// Register with the dependencies, so they queue this task once they all complete. An extra dependency is counted
+		// until registration is done, so the task cannot get queued while still registering. If a dependency was already
+		// canceled the task will never execute, so it's canceled as well, and gets dropped once it's queued.
+		bool dependencyCanceled = false;
+		task->mNumPendingDependencies = (UINT32)task->mDependencies.size() + 1;
+		for(auto& entry : task->mDependencies)
+		{
+			const SPtr<Task> dependency = entry.lock();
+			if(dependency == nullptr)
+			{
+				task->mNumPendingDependencies--;
+				continue;
+			}
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+			ScopedSpinLock lock(dependency->mContinuationLock);
+
+			if(dependency->isComplete() || dependency->isCanceled())
+			{
+				dependencyCanceled |= dependency->isCanceled();
+				task->mNumPendingDependencies--;
+			}
+			else
+				dependency->mContinuations.push_back(task);
+		}
+
+		if(dependencyCanceled)
+			task->cancel();
+
+		resolveDependency(std::move(task));
 	}
 
 	void TaskScheduler::addTaskGroup(const SPtr<TaskGroup>& taskGroup)
 	{
-		Lock lock(mReadyMutex);
+		// Spawn at most one task per worker, each processing chunks until no items remain
+		const UINT32 numChunks = Math::divideAndRoundUp(taskGroup->mCount, taskGroup->mGrainSize);
+		const UINT32 numTasks = std::min(numChunks, std::max(mMaxActiveTasks.load(), 1U));
+
+		taskGroup->mParent = this;
+		taskGroup->mNumThreads = numTasks + 1; // +1 for the thread that waits on the group
 
-		for(UINT32 i = 0; i < taskGroup->mCount; i++)
+		const auto worker = [taskGroup]
 		{
-			const auto worker = [i, taskGroup] 
-			{ 
-				taskGroup->mTaskWorker(i); 
-				--taskGroup->mNumRemainingTasks;
-			};
+			while(taskGroup->processChunk())
+			{ }
+		};
 
-			SPtr<Task> task = Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency);
-			task->mParent = this;
-			task->mTaskId = mNextTaskId++;
-			task->mState.store(0); // Reset state in case the task is getting re-queued
+		for(UINT32 i = 0; i < numTasks; i++)
+			addTask(Task::create(taskGroup->mName, worker, taskGroup->mPriority, taskGroup->mTaskDependency.lock()));
+	}
 
-			mCheckTasks = true;
-			mTaskQueue.insert(std::move(task));
+	void TaskScheduler::parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, 
+		const std::function<void(UINT32, UINT32)>& worker, TaskPriority priority, bool executeOtherTasks)
+	{
+		if(begin >= end)
+			return;
+
+		const UINT32 count = end - begin;
+		if(count <= grainSize)
+		{
+			worker(begin, end);
+			return;
 		}
 
-		taskGroup->mParent = this;
+		const auto chunkWorker = [begin, &worker](UINT32 chunkBegin, UINT32 chunkEnd)
+		{
+			worker(begin + chunkBegin, begin + chunkEnd);
+		};
 
-		// Wake main scheduler thread
-		mTaskReadyCond.notify_one();
+		// Note: Tasks might outlive this call, but they will not reference the worker once all items are processed
+		SPtr<TaskGroup> taskGroup = TaskGroup::createChunked("ParallelFor", chunkWorker, count, grainSize, priority);
+		addTaskGroup(taskGroup);
+
+		waitUntilComplete(taskGroup.get(), executeOtherTasks);
 	}
 
 	void TaskScheduler::addWorker()
@@ -151,6 +340,20 @@ namespace bs
 
 		mMaxActiveTasks++;
 
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			if(mMaxActiveTasks > mNumStartedWorkers)
+				startWorkStealingWorker();
+
+			// Wake up the worker in case it was previously parked by removeWorker()
+			{
+				Lock sleepLock(mSleepMutex);
+			}
+
+			mWorkerActivatedCond.notify_all();
+			return;
+		}
+
 		// A spot freed up, queue new tasks on main scheduler thread if they exist
 		mTaskReadyCond.notify_one();
 	}
@@ -186,13 +389,9 @@ namespace bs
 
 				if(curTask->isCanceled())
 				{
-					iter = mTaskQueue.erase(iter);
-					continue;
-				}
+					completeTask(curTask.get(), false);
 
-				if(curTask->mTaskDependency != nullptr && !curTask->mTaskDependency->isComplete())
-				{
-					++iter;
+					iter = mTaskQueue.erase(iter);
 					continue;
 				}
 
@@ -228,14 +427,18 @@ namespace bs
 				mActiveTasks.erase(findIter);
 		}
 
+		Vector<SPtr<Task>> continuations;
 		{
 			Lock lock(mCompleteMutex);
-			task->mState.store(2);
+			continuations = completeTask(task.get(), true);
 
 			mTaskCompleteCond.notify_all();
 		}
 
-		// Wake the main scheduler thread in case there are other tasks waiting or this task was someone's dependency
+		for(auto& entry : continuations)
+			resolveDependency(std::move(entry));
+
+		// Wake the main scheduler thread in case there are other tasks waiting
 		{
 			Lock lock(mReadyMutex);
 
@@ -249,10 +452,16 @@ namespace bs
 		if(task->isCanceled())
 			return;
 
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			helpUntil([task]() { return task->isComplete() || task->isCanceled(); });
+			return;
+		}
+
 		{
 			Lock lock(mCompleteMutex);
 
-			while(!task->isComplete())
+			while(!task->isComplete() && !task->isCanceled())
 			{
 				addWorker();
 				mTaskCompleteCond.wait(lock);
@@ -261,11 +470,43 @@ namespace bs
 		}
 	}
 
-	void TaskScheduler::waitUntilComplete(const TaskGroup* taskGroup)
+	void TaskScheduler::waitUntilComplete(TaskGroup* taskGroup, bool executeOtherTasks)
 	{
+		// Items of a group whose dependency was canceled never get processed
+		if(taskGroup->isCanceled())
+			return;
+
+		// Process the remaining items on this thread instead of just blocking (unless still waiting on the dependency)
+		const SPtr<Task> dependency = taskGroup->mTaskDependency.lock();
+		if(dependency == nullptr || dependency->isComplete())
+		{
+			while(taskGroup->processChunk())
+			{ }
+		}
+
+		const auto isDone = [taskGroup]() { return taskGroup->mNumRemainingTasks == 0 || taskGroup->isCanceled(); };
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			if(executeOtherTasks)
+			{
+				helpUntil(isDone);
+				return;
+			}
+
+			// Only wait for the chunks being processed by other threads to finish
+			Lock lock(mCompleteMutex);
+			mNumWaiters++;
+
+			while(!isDone())
+				mTaskCompleteCond.wait(lock);
+
+			mNumWaiters--;
+			return;
+		}
+
 		Lock lock(mCompleteMutex);
 
-		while (taskGroup->mNumRemainingTasks > 0)
+		while (!isDone())
 		{
 			addWorker();
 			mTaskCompleteCond.wait(lock);
@@ -282,4 +523,282 @@ namespace bs
 		// Otherwise the task with the higher priority always goes first
 		return lhs->mPriority > rhs->mPriority;
 	}
+
+	void TaskScheduler::startWorkStealingWorker()
+	{
+		const UINT32 workerIdx = mNumStartedWorkers;
+		if(workerIdx >= (UINT32)mWorkers.size())
+			return;
+
+		mNumStartedWorkers++;
+		mWorkers[workerIdx]->thread = ThreadPool::instance().run("TaskWorker", 
+			std::bind(&TaskScheduler::runWorkStealingWorker, this, workerIdx));
+	}
+
+	void TaskScheduler::runWorkStealingWorker(UINT32 workerIdx)
+	{
+		gWorkerScheduler = this;
+		gWorkerIdx = workerIdx;
+
+		WorkStealingWorker* worker = mWorkers[workerIdx];
+
+		UINT32 numIdleSpins = 0;
+		while(!mWorkersShutdown)
+		{
+			// Park the worker if it was removed through removeWorker(). Any tasks left in its queues will get stolen.
+			if(workerIdx >= mMaxActiveTasks)
+			{
+				Lock lock(mSleepMutex);
+
+				while(workerIdx >= mMaxActiveTasks && !mWorkersShutdown)
+					mWorkerActivatedCond.wait(lock);
+
+				continue;
+			}
+
+			SPtr<Task> task = findTask(worker);
+			if(task != nullptr)
+			{
+				executeTask(std::move(task));
+				numIdleSpins = 0;
+
+				continue;
+			}
+
+			if(numIdleSpins < NUM_IDLE_SPINS)
+			{
+				numIdleSpins++;
+				std::this_thread::yield();
+
+				continue;
+			}
+
+			numIdleSpins = 0;
+
+			// Register as sleeping before the final check, so that any task queued after the check is guaranteed to see
+			// the sleeping worker and wake it up
+			mNumSleepingWorkers++;
+			const UINT64 workEpoch = mWorkEpoch;
+
+			task = findTask(worker);
+			if(task == nullptr)
+			{
+				Lock lock(mSleepMutex);
+
+				while(workEpoch == mWorkEpoch && !mWorkersShutdown)
+					mWorkAvailableCond.wait(lock);
+			}
+
+			mNumSleepingWorkers--;
+
+			if(task != nullptr)
+				executeTask(std::move(task));
+		}
+
+		gWorkerScheduler = nullptr;
+	}
+
+	void TaskScheduler::resolveDependency(SPtr<Task> task)
+	{
+		if(--task->mNumPendingDependencies == 0)
+			queueReadyTask(std::move(task));
+	}
+
+	void TaskScheduler::queueReadyTask(SPtr<Task> task)
+	{
+		if(mMode == TaskSchedulerMode::WorkStealing)
+		{
+			pushReadyTask(std::move(task));
+			return;
+		}
+
+		Lock lock(mReadyMutex);
+
+		task->mTaskId = mNextTaskId++;
+
+		mCheckTasks = true;
+		mTaskQueue.insert(std::move(task));
+
+		// Wake main scheduler thread
+		mTaskReadyCond.notify_one();
+	}
+
+	Vector<SPtr<Task>> TaskScheduler::completeTask(Task* task, bool executed)
+	{
+		Vector<SPtr<Task>> continuations;
+		{
+			ScopedSpinLock lock(task->mContinuationLock);
+
+			std::swap(continuations, task->mContinuations);
+
+			if(executed)
+				task->mState.store(2);
+		}
+
+		// Dependants of tasks that were canceled before executing were canceled along with the task, just release them
+		if(!executed)
+			continuations.clear();
+
+		return continuations;
+	}
+
+	void TaskScheduler::pushReadyTask(SPtr<Task> task)
+	{
+		Task* taskPtr = task.get();
+		const UINT32 priorityIdx = (UINT32)taskPtr->mPriority - (UINT32)TaskPriority::VeryLow;
+
+		taskPtr->mQueuedRef = std::move(task);
+
+		if(gWorkerScheduler == this)
+			mWorkers[gWorkerIdx]->queues[priorityIdx].push(taskPtr);
+		else
+		{
+			ScopedSpinLock lock(mInjectLock);
+
+			mInjectQueues[priorityIdx].push(taskPtr);
+			mNumInjectedTasks++;
+		}
+
+		wakeWorker();
+	}
+
+	SPtr<Task> TaskScheduler::findTask(WorkStealingWorker* worker)
+	{
+		Task* task = nullptr;
+
+		// Check own queues first, most recently queued tasks first as their data is most likely still in cache
+		if(worker != nullptr)
+		{
+			for(INT32 i = NUM_PRIORITIES - 1; i >= 0 && task == nullptr; i--)
+				task = worker->queues[i].pop();
+		}
+
+		// Check the tasks queued from non-worker threads
+		if(task == nullptr && mNumInjectedTasks.load(std::memory_order_relaxed) > 0)
+		{
+			ScopedSpinLock lock(mInjectLock);
+
+			for(INT32 i = NUM_PRIORITIES - 1; i >= 0 && task == nullptr; i--)
+			{
+				Queue<Task*>& queue = mInjectQueues[i];
+				if(queue.empty())
+					continue;
+
+				task = queue.front();
+				queue.pop();
+				mNumInjectedTasks--;
+
+				// Move a batch of tasks into the worker's own queue, so other workers can steal them from there
+				if(worker != nullptr)
+				{
+					for(UINT32 j = 0; j < INJECT_BATCH_SIZE && !queue.empty(); j++)
+					{
+						worker->queues[i].push(queue.front());
+						queue.pop();
+						mNumInjectedTasks--;
+					}
+				}
+			}
+		}
+
+		// Steal from other workers, starting with the next worker to spread out the thieves
+		if(task == nullptr)
+		{
+			const UINT32 numWorkers = mNumStartedWorkers;
+			const UINT32 startIdx = worker != nullptr ? worker->index + 1 : 0;
+
+			for(INT32 i = NUM_PRIORITIES - 1; i >= 0 && task == nullptr; i--)
+			{
+				for(UINT32 j = 0; j < numWorkers && task == nullptr; j++)
+				{
+					WorkStealingWorker* victim = mWorkers[(startIdx + j) % numWorkers];
+					if(victim == worker)
+						continue;
+
+					task = victim->queues[i].steal();
+				}
+			}
+		}
+
+		if(task == nullptr)
+			return nullptr;
+
+		return std::move(task->mQueuedRef);
+	}
+
+	void TaskScheduler::executeTask(SPtr<Task> task)
+	{
+		// Canceled tasks are just dropped, along with any tasks that depend on them
+		UINT32 expectedState = 0;
+		const bool execute = task->mState.compare_exchange_strong(expectedState, 1);
+		if(execute)
+			task->mTaskWorker();
+
+		Vector<SPtr<Task>> continuations = completeTask(task.get(), execute);
+		for(auto& entry : continuations)
+			resolveDependency(std::move(entry));
+
+		notifyTaskComplete();
+	}
+
+	void TaskScheduler::wakeWorker()
+	{
+		mWorkEpoch++;
+
+		if(mNumSleepingWorkers > 0)
+		{
+			{
+				Lock lock(mSleepMutex);
+			}
+
+			mWorkAvailableCond.notify_one();
+		}
+	}
+
+	void TaskScheduler::notifyTaskComplete()
+	{
+		if(mNumWaiters > 0)
+		{
+			{
+				Lock lock(mCompleteMutex);
+			}
+
+			mTaskCompleteCond.notify_all();
+		}
+	}
+
+	void TaskScheduler::notifyTaskCanceled()
+	{
+		// Waiters in both modes check for cancelation under the complete lock, so this cannot be missed
+		{
+			Lock lock(mCompleteMutex);
+		}
+
+		mTaskCompleteCond.notify_all();
+	}
+
+	void TaskScheduler::helpUntil(const std::function<bool()>& predicate)
+	{
+		WorkStealingWorker* worker = gWorkerScheduler == this ? mWorkers[gWorkerIdx] : nullptr;
+
+		while(!predicate())
+		{
+			// Execute other tasks while waiting, instead of leaving the core idle
+			SPtr<Task> task = findTask(worker);
+			if(task != nullptr)
+			{
+				executeTask(std::move(task));
+				continue;
+			}
+
+			// Nothing to execute, wait until some task completes and check again
+			Lock lock(mCompleteMutex);
+			mNumWaiters++;
+
+			if(!predicate())
+				mTaskCompleteCond.wait(lock);
+
+			mNumWaiters--;
+		}
+	}
 }
@@ -5,6 +5,7 @@
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "Utility/BsModule.h"
 #include "Threading/BsThreadPool.h"
+#include "Threading/BsWorkStealingQueue.h"
 
 namespace bs
 {
@@ -23,6 +24,25 @@ namespace bs
 		VeryHigh = 102
 	};
 
+	/** Determines how does the TaskScheduler distribute queued tasks to worker threads. */
+	enum class TaskSchedulerMode
+	{
+		/**
+		 * A dedicated scheduler thread pulls tasks from a single priority-sorted queue and hands them over to threads
+		 * from the ThreadPool. Strictly respects task priorities and queue order, but every queue and dispatch operation
+		 * goes through a global lock. Best used for a small number of coarse tasks.
+		 */
+		GlobalQueue,
+
+		/**
+		 * Each worker thread owns a set of lock-free queues (one per priority) which it pushes and pops tasks from, while
+		 * idle workers steal tasks from other workers. Tasks queued from non-worker threads go through a shared injection
+		 * queue. Priorities are respected per-worker, but not strictly across workers. Best used for a large number of
+		 * small tasks.
+		 */
+		WorkStealing
+	};
+
 	/**
 	 * Represents a single task that may be queued in the TaskScheduler.
 	 *
@@ -34,7 +54,7 @@ namespace bs
 
 	public:
 		Task(const PrivatelyConstruct& dummy, const String& name, std::function<void()> taskWorker,
-			TaskPriority priority, SPtr<Task> dependency);
+			TaskPriority priority, Vector<SPtr<Task>> dependencies);
 
 		/**
 		 * Creates a new task. Task should be provided to TaskScheduler in order for it to start.
@@ -48,6 +68,28 @@ namespace bs
 		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, 
 			TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
 
+		/**
+		 * Creates a new task that depends on multiple other tasks. Task should be provided to TaskScheduler in order for
+		 * it to start.
+		 *
+		 * @param[in]	name			Name you can use to more easily identify the task.
+		 * @param[in]	taskWorker		Worker method that does all of the work in the task.
+		 * @param[in]	priority  		Higher priority means the tasks will be executed sooner.
+		 * @param[in]	dependencies	Tasks that must complete before this task is executed.
+		 */
+		static SPtr<Task> create(const String& name, std::function<void()> taskWorker, TaskPriority priority, 
+			Vector<SPtr<Task>> dependencies);
+
+		/** 
+		 * Adds a task that must complete before this task is executed. Must be called before the task is queued in the
+		 * TaskScheduler. Allows you to build arbitrary graphs of tasks, where each task can have any number of 
+		 * dependencies and dependants.
+		 *
+		 * @note	Tasks only hold weak references to their dependencies, as the dependencies reference their dependants
+		 *			until they complete. A dependency that is destroyed before this task is queued is considered complete.
+		 */
+		void addDependency(SPtr<Task> dependency);
+
 		/** Returns true if the task has completed. */
 		bool isComplete() const;
 
@@ -61,7 +103,10 @@ namespace bs
 		 */
 		void wait();
 
-		/** Cancels the task and removes it from the TaskSchedulers queue. */
+		/** 
+		 * Cancels the task and removes it from the TaskSchedulers queue. Any tasks depending on this task, directly or
+		 * indirectly, get canceled as well. Has no effect if the task has already started executing.
+		 */
 		void cancel();
 
 	private:
@@ -71,14 +116,20 @@ namespace bs
 		TaskPriority mPriority;
 		UINT32 mTaskId = 0;
 		std::function<void()> mTaskWorker;
-		SPtr<Task> mTaskDependency;
+		Vector<std::weak_ptr<Task>> mDependencies;
 		std::atomic<UINT32> mState{0}; /**< 0 - Inactive, 1 - In progress, 2 - Completed, 3 - Canceled */
 
 		TaskScheduler* mParent = nullptr;
+
+		SPtr<Task> mQueuedRef; /**< Keeps the task alive while it's referenced by a work stealing queue. */
+		SpinLock mContinuationLock;
+		Vector<SPtr<Task>> mContinuations; /**< Tasks waiting on this task to complete before they can be queued. */
+		std::atomic<UINT32> mNumPendingDependencies{0}; /**< Number of dependencies that haven't completed yet. */
 	};
 
 	/**
-	 * Represents a group of tasks that may be queued in the TaskScheduler to be processed in parallel.
+	 * Represents a group of tasks that may be queued in the TaskScheduler to be processed in parallel. Items in the group
+	 * are processed in chunks by a small number of tasks (at most one per worker), so no per-item allocations are made.
 	 *
 	 * @note	Thread safe.
 	 */
@@ -87,8 +138,8 @@ namespace bs
 		struct PrivatelyConstruct {};
 
 	public:
-		TaskGroup(const PrivatelyConstruct& dummy, String name, std::function<void(UINT32)> taskWorker, UINT32 count,
-			TaskPriority priority, SPtr<Task> dependency);
+		TaskGroup(const PrivatelyConstruct& dummy, String name, std::function<void(UINT32, UINT32)> taskWorker, 
+			UINT32 count, UINT32 grainSize, TaskPriority priority, SPtr<Task> dependency);
 
 		/**
 		 * Creates a new task group. Task group should be provided to TaskScheduler in order for it to start.
@@ -104,25 +155,54 @@ namespace bs
 		static SPtr<TaskGroup> create(String name, std::function<void(UINT32)> taskWorker, UINT32 count,
 			TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
 
+		/**
+		 * Creates a new task group whose worker processes a range of items at once. Task group should be provided to
+		 * TaskScheduler in order for it to start.
+		 *
+		 * @param[in]	name		Name you can use to more easily identify the tasks in the group.
+		 * @param[in]	taskWorker	Worker method that will get called for each chunk of items in the group. Each call will
+		 *							receive the index of the first item in the chunk, and the index one past the last item.
+		 * @param[in]	count		Number of items in the task group.
+		 * @param[in]	grainSize	Minimum number of items to process in a single chunk. Chunks start out larger and
+		 *							shrink as fewer items remain, so that work stays evenly distributed between threads.
+		 * @param[in]	priority  	(optional) Higher priority means the tasks will be executed sooner.
+		 * @param[in]	dependency	(optional) Task dependency if one exists. If provided the task will
+		 * 							not be executed until its dependency is complete.
+		 */
+		static SPtr<TaskGroup> createChunked(String name, std::function<void(UINT32, UINT32)> taskWorker, UINT32 count,
+			UINT32 grainSize, TaskPriority priority = TaskPriority::Normal, SPtr<Task> dependency = nullptr);
+
 		/** Returns true if all the tasks in the group have completed. */
 		bool isComplete() const;
 
+		/** Returns true if the dependency of the group was canceled, in which case none of its items will be processed. */
+		bool isCanceled() const;
+
 		/**
 		 * Blocks the current thread until all tasks in the group have completed.
 		 *
-		 * @note	While waiting adds a new worker thread, so that the blocking threads core can be utilized.
+		 * @note	While waiting the current thread will process remaining items in the group itself.
 		 */
 		void wait();
 
 	private:
 		friend class TaskScheduler;
 
+		/** 
+		 * Claims the next chunk of unprocessed items and processes it. Returns false if there were no more items to
+		 * claim.
+		 */
+		bool processChunk();
+
 		String mName;
 		UINT32 mCount;
+		UINT32 mGrainSize;
 		TaskPriority mPriority;
-		std::function<void(UINT32)> mTaskWorker;
-		SPtr<Task> mTaskDependency;
+		std::function<void(UINT32, UINT32)> mTaskWorker;
+		std::weak_ptr<Task> mTaskDependency;
 		std::atomic<UINT32> mNumRemainingTasks{mCount};
+		std::atomic<UINT32> mNextItem{0};
+		UINT32 mNumThreads = 1;
 
 		TaskScheduler* mParent = nullptr;
 	};
@@ -134,9 +214,9 @@ namespace bs
 	 * @note
 	 * Thread safe.
 	 * @note
-	 * This type of task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
-	 * in the order of hundreds. Higher number of tasks might require different queuing and locking mechanism, potentially
-	 * at the cost of flexibility.)
+	 * By default the task scheduler uses a global queue and is best used for coarse granularity of tasks. (Number of tasks
+	 * in the order of hundreds.) For a higher number of tasks use the work stealing mode, at the cost of only approximately
+	 * respecting task priorities. See TaskSchedulerMode.
 	 * @note
 	 * By default the task scheduler will create as many threads as there are physical CPU cores. You may add or remove
 	 * threads using addWorker()/removeWorker() methods.
@@ -144,7 +224,12 @@ namespace bs
 	class BS_UTILITY_EXPORT TaskScheduler : public Module<TaskScheduler>
 	{
 	public:
-		TaskScheduler();
+		/**
+		 * Constructs a new task scheduler.
+		 *
+		 * @param[in]	mode	Determines how are tasks distributed between worker threads.
+		 */
+		TaskScheduler(TaskSchedulerMode mode = TaskSchedulerMode::GlobalQueue);
 		~TaskScheduler();
 
 		/** Queues a new task. */
@@ -153,6 +238,25 @@ namespace bs
 		/** Queues a new task group. */
 		void addTaskGroup(const SPtr<TaskGroup>& taskGroup);
 
+		/**
+		 * Processes the range of items [@p begin, @p end) in parallel and blocks until all the items have been processed.
+		 * The calling thread processes items as well, instead of just waiting.
+		 *
+		 * @param[in]	begin		Index of the first item to process.
+		 * @param[in]	end			Index one past the last item to process.
+		 * @param[in]	grainSize	Minimum number of items to process in a single chunk. Ranges smaller than this are
+		 *							processed directly on the calling thread.
+		 * @param[in]	worker		Worker method that will get called for each chunk of items. Receives the index of the
+		 *							first item in the chunk, and the index one past the last item.
+		 * @param[in]	priority  	(optional) Higher priority means the chunks will be processed sooner.
+		 * @param[in]	executeOtherTasks	(optional) In the work stealing mode, determines can the calling thread execute
+		 *									other queued tasks while it waits for chunks being processed by other threads.
+		 *									Disable if calling while holding a lock that those tasks might try to
+		 *									acquire.
+		 */
+		void parallelFor(UINT32 begin, UINT32 end, UINT32 grainSize, const std::function<void(UINT32, UINT32)>& worker,
+			TaskPriority priority = TaskPriority::Normal, bool executeOtherTasks = true);
+
 		/**	Adds a new worker thread which will be used for executing queued tasks. */
 		void addWorker();
 
@@ -161,6 +265,9 @@ namespace bs
 
 		/** Returns the maximum available worker threads (maximum number of tasks that can be executed simultaneously). */
 		UINT32 getNumWorkers() const { return mMaxActiveTasks; }
+
+		/** Returns the mode that determines how are tasks distributed between worker threads. */
+		TaskSchedulerMode getMode() const { return mMode; }
 	protected:
 		friend class Task;
 		friend class TaskGroup;
@@ -174,16 +281,84 @@ namespace bs
 		/**	Blocks the calling thread until the specified task has completed. */
 		void waitUntilComplete(const Task* task);
 
-		/**	Blocks the calling thread until all the tasks in the provided task group have completed. */
-		void waitUntilComplete(const TaskGroup* taskGroup);
+		/**	
+		 * Blocks the calling thread until all the tasks in the provided task group have completed. Processes remaining
+		 * items in the group on the calling thread in the meantime. In the work stealing mode other queued tasks are
+		 * executed as well, unless @p executeOtherTasks is false.
+		 */
+		void waitUntilComplete(TaskGroup* taskGroup, bool executeOtherTasks = true);
 
 		/**	Method used for sorting tasks. */
 		static bool taskCompare(const SPtr<Task>& lhs, const SPtr<Task>& rhs);
 
+		/** Number of different task priorities. Each work stealing worker keeps a separate queue per priority. */
+		static constexpr UINT32 NUM_PRIORITIES = (UINT32)TaskPriority::VeryHigh - (UINT32)TaskPriority::VeryLow + 1;
+
+		/** Worker thread and its task queues used in the work stealing mode. */
+		struct WorkStealingWorker
+		{
+			WorkStealingQueue<Task*> queues[NUM_PRIORITIES];
+			UINT32 index = 0;
+			HThread thread;
+		};
+
+		/** Starts a new work stealing worker thread, if the maximum number of workers hasn't been reached. */
+		void startWorkStealingWorker();
+
+		/** Main loop of a work stealing worker thread. */
+		void runWorkStealingWorker(UINT32 workerIdx);
+
+		/** 
+		 * Notifies the task that one of its dependencies has completed (or that it has finished registering with its
+		 * dependencies). Queues the task for execution once no more dependencies remain.
+		 */
+		void resolveDependency(SPtr<Task> task);
+
+		/** Queues a task whose dependencies have all completed for execution. */
+		void queueReadyTask(SPtr<Task> task);
+
+		/**
+		 * Marks the task as complete and returns a list of tasks that were waiting on it. If the task was canceled before
+		 * it got to execute (@p executed is false) its dependants are released instead, as they will never execute.
+		 */
+		Vector<SPtr<Task>> completeTask(Task* task, bool executed);
+
+		/**
+		 * Queues a task whose dependencies have completed for execution in the work stealing mode. If called from a 
+		 * worker thread the task is pushed onto that worker's queue, otherwise it's pushed onto the injection queue.
+		 */
+		void pushReadyTask(SPtr<Task> task);
+
+		/**
+		 * Attempts to find a task to execute, first checking the provided worker's own queues (if any), then the injection
+		 * queue and finally queues of other workers. Returns null if no task was found.
+		 */
+		SPtr<Task> findTask(WorkStealingWorker* worker);
+
+		/** Executes a task retrieved from one of the work stealing queues and queues any tasks that depend on it. */
+		void executeTask(SPtr<Task> task);
+
+		/** Wakes up a single sleeping work stealing worker, if any. */
+		void wakeWorker();
+
+		/** Wakes up any threads blocked waiting on task completion in the work stealing mode. */
+		void notifyTaskComplete();
+
+		/** Wakes up any threads blocked waiting on task completion, in either mode, after a task was canceled. */
+		void notifyTaskCanceled();
+
+		/**
+		 * Blocks the calling thread until the provided predicate returns true, executing queued tasks in the meantime. Used
+		 * for waiting in the work stealing mode.
+		 */
+		void helpUntil(const std::function<bool()>& predicate);
+
+		TaskSchedulerMode mMode;
+
 		HThread mTaskSchedulerThread;
 		Set<SPtr<Task>, std::function<bool(const SPtr<Task>&, const SPtr<Task>&)>> mTaskQueue;
 		Vector<SPtr<Task>> mActiveTasks;
-		UINT32 mMaxActiveTasks = 0;
+		std::atomic<UINT32> mMaxActiveTasks{0};
 		UINT32 mNextTaskId = 0;
 		bool mShutdown = false;
 		bool mCheckTasks = false;
@@ -192,6 +367,23 @@ namespace bs
 		Mutex mCompleteMutex;
 		Signal mTaskReadyCond;
 		Signal mTaskCompleteCond;
+
+		// Work stealing mode
+		Vector<WorkStealingWorker*> mWorkers;
+		std::atomic<UINT32> mNumStartedWorkers{0};
+		std::atomic<bool> mWorkersShutdown{false};
+
+		SpinLock mInjectLock;
+		Queue<Task*> mInjectQueues[NUM_PRIORITIES];
+		std::atomic<UINT32> mNumInjectedTasks{0};
+
+		std::atomic<UINT32> mNumSleepingWorkers{0};
+		std::atomic<UINT64> mWorkEpoch{0};
+		Mutex mSleepMutex;
+		Signal mWorkAvailableCond;
+		Signal mWorkerActivatedCond;
+
+		std::atomic<UINT32> mNumWaiters{0};
 	};
 
 	/** @} */
@@ -0,0 +1,177 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+#include "Utility/BsBitwise.h"
+
+namespace bs
+{
+	/** @addtogroup Internal-Utility
+	 *  @{
+	 */
+
+	/** @addtogroup Threading-Internal
+	 *  @{
+	 */
+
+	/**
+	 * Lock-free double ended queue (Chase-Lev) that has a single owner and any number of thieves. The owner pushes and
+	 * pops elements from the bottom of the queue (LIFO), while other threads may steal elements from the top (FIFO).
+	 * Storage grows automatically when the owner pushes into a full queue.
+	 *
+	 * @tparam	T	Type of the stored elements. Must be a pointer type.
+	 *
+	 * @note	push() and pop() must only be called from the owner thread. steal() may be called from any thread.
+	 */
+	template<class T>
+	class WorkStealingQueue final
+	{
+		static_assert(std::is_pointer<T>::value, "WorkStealingQueue can only store pointers.");
+
+		/** Circular buffer of a power of two size. */
+		struct Buffer
+		{
+			explicit Buffer(INT64 capacity)
+				: capacity(capacity), mask(capacity - 1)
+			{
+				elements = bs_newN<std::atomic<T>>((size_t)capacity);
+			}
+
+			~Buffer()
+			{
+				bs_deleteN(elements, (size_t)capacity);
+			}
+
+			T get(INT64 idx) const { return elements[idx & mask].load(std::memory_order_acquire); }
+			void put(INT64 idx, T value) { elements[idx & mask].store(value, std::memory_order_release); }
+
+			INT64 capacity;
+			INT64 mask;
+			std::atomic<T>* elements;
+		};
+
+	public:
+		/** Constructs the queue with initial capacity. Capacity must be a power of two. */
+		explicit WorkStealingQueue(UINT32 capacity = 256)
+		{
+			assert(Bitwise::isPow2(capacity));
+
+			Buffer* buffer = bs_new<Buffer>((INT64)capacity);
+			mBuffer.store(buffer, std::memory_order_relaxed);
+			mRetiredBuffers.push_back(buffer);
+		}
+
+		~WorkStealingQueue()
+		{
+			for(auto& entry : mRetiredBuffers)
+				bs_delete(entry);
+		}
+
+		WorkStealingQueue(const WorkStealingQueue&) = delete;
+		WorkStealingQueue& operator=(const WorkStealingQueue&) = delete;
+
+		/** Pushes a new element to the bottom of the queue. Must only be called by the owner thread. */
+		void push(T value)
+		{
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			const INT64 top = mTop.load(std::memory_order_acquire);
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+
+			if(bottom - top > buffer->capacity - 1)
+				buffer = grow(buffer, top, bottom);
+
+			buffer->put(bottom, value);
+			std::atomic_thread_fence(std::memory_order_release);
+			mBottom.store(bottom + 1, std::memory_order_relaxed);
+		}
+
+		/**
+		 * Pops an element from the bottom of the queue (most recently pushed). Returns null if the queue is empty. Must
+		 * only be called by the owner thread.
+		 */
+		T pop()
+		{
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed) - 1;
+			Buffer* buffer = mBuffer.load(std::memory_order_relaxed);
+			mBottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			INT64 top = mTop.load(std::memory_order_relaxed);
+
+			T output = nullptr;
+			if(top <= bottom)
+			{
+				output = buffer->get(bottom);
+
+				// Last element, race against thieves
+				if(top == bottom)
+				{
+					if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						output = nullptr;
+
+					mBottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+			}
+			else
+				mBottom.store(bottom + 1, std::memory_order_relaxed);
+
+			return output;
+		}
+
+		/**
+		 * Steals an element from the top of the queue (least recently pushed). Returns null if the queue is empty or if
+		 * another thread won the race for the element. Can be called from any thread.
+		 */
+		T steal()
+		{
+			INT64 top = mTop.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const INT64 bottom = mBottom.load(std::memory_order_acquire);
+
+			if(top >= bottom)
+				return nullptr;
+
+			Buffer* buffer = mBuffer.load(std::memory_order_acquire);
+			T output = buffer->get(top);
+
+			if(!mTop.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				return nullptr;
+
+			return output;
+		}
+
+		/** Returns true if the queue appears empty. The result is only a hint if other threads are accessing the queue. */
+		bool isEmpty() const
+		{
+			const INT64 bottom = mBottom.load(std::memory_order_relaxed);
+			const INT64 top = mTop.load(std::memory_order_relaxed);
+
+			return bottom <= top;
+		}
+
+	private:
+		/**
+		 * Allocates a buffer twice the size of the current one and copies the existing elements. Old buffers are kept alive
+		 * until the queue is destroyed since thieves might still be reading from them.
+		 */
+		Buffer* grow(Buffer* buffer, INT64 top, INT64 bottom)
+		{
+			Buffer* newBuffer = bs_new<Buffer>(buffer->capacity * 2);
+			for(INT64 i = top; i < bottom; i++)
+				newBuffer->put(i, buffer->get(i));
+
+			mRetiredBuffers.push_back(newBuffer);
+			mBuffer.store(newBuffer, std::memory_order_release);
+
+			return newBuffer;
+		}
+
+		alignas(64) std::atomic<INT64> mTop{0};
+		alignas(64) std::atomic<INT64> mBottom{0};
+		std::atomic<Buffer*> mBuffer{nullptr};
+		Vector<Buffer*> mRetiredBuffers;
+	};
+
+	/** @} */
+	/** @} */
+}
@@ -238,7 +238,7 @@ namespace bs
 		{
 			if (value <= 0.0f) return 0;
 			if (value >= 1.0f) return (1 << bits) - 1;
-			return Math::roundToInt(value * (1 << bits));
+			return Math::roundToInt(value * ((1 << bits) - 1));
 		}
 
 		/** 
@@ -271,7 +271,7 @@ namespace bs
 		{
 			if (value <= 0.0f) return 0;
 			if (value >= 1.0f) return (1 << bits) - 1;
-			return Math::roundToInt(value * (1 << bits));
+			return Math::roundToInt(value * ((1 << bits) - 1));
 		}
 
 		/** 
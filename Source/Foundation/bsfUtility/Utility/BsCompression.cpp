@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Utility/BsCompression.h"
 #include "FileSystem/BsDataStream.h"
+#include "Threading/BsTaskScheduler.h"
 
 // Third party
 #include "snappy.h"
@@ -191,4 +192,376 @@ namespace bs
 
 		return dst.GetOutput();
 	}
+
+	/** Identifies data compressed using Compression::compressBlocks(). */
+	static constexpr UINT32 BLOCK_COMPRESSION_MAGIC = 0x43424342;
+
+	/** Set in the block index entry of blocks stored without compression. The remaining bits contain the block size. */
+	static constexpr UINT32 BLOCK_STORED_FLAG = 0x80000000;
+
+	/**
+	 * Upper bound on how many times larger a snappy compressed block can get once decompressed. The largest expansion is
+	 * produced by copy elements with a 2-byte offset, which output up to 64 bytes from 3 bytes of input.
+	 */
+	static constexpr UINT32 MAX_BLOCK_EXPANSION = 22;
+
+	/** Maximum number of bytes used for storing the decompressed length at the start of a snappy compressed block. */
+	static constexpr UINT32 MAX_BLOCK_LENGTH_HEADER_SIZE = 5;
+
+	/** Calls @p worker for ranges of blocks in [0, @p numBlocks), in parallel if the task scheduler is running. */
+	static void forEachBlock(UINT32 numBlocks, const std::function<void(UINT32, UINT32)>& worker)
+	{
+		if (numBlocks > 1 && TaskScheduler::isStarted())
+			TaskScheduler::instance().parallelFor(0, numBlocks, 1, worker);
+		else
+			worker(0, numBlocks);
+	}
+
+	SPtr<MemoryDataStream> Compression::compressBlocks(SPtr<DataStream>& input, CompressionLevel level, UINT32 blockSize)
+	{
+		assert(blockSize > 0 && blockSize < BLOCK_STORED_FLAG);
+
+		// Blocks are compressed in parallel, so the entire input needs to be in memory
+		const UINT8* source;
+		UINT8* sourceBuffer = nullptr;
+		size_t sourceSize = input->size() - input->tell();
+		if (input->isFile())
+		{
+			sourceBuffer = (UINT8*)bs_alloc(sourceSize);
+			sourceSize = input->read(sourceBuffer, sourceSize);
+			source = sourceBuffer;
+		}
+		else
+		{
+			source = static_cast<MemoryDataStream*>(input.get())->getCurrentPtr();
+			input->skip(sourceSize);
+		}
+
+		const UINT32 numBlocks = (UINT32)((sourceSize + blockSize - 1) / blockSize);
+		const size_t maxCompressedBlockSize = snappy::MaxCompressedLength(blockSize);
+
+		UINT8* compressed = nullptr;
+		if (level != CompressionLevel::None)
+			compressed = (UINT8*)bs_alloc(maxCompressedBlockSize * numBlocks);
+
+		Vector<UINT32> index(numBlocks);
+		forEachBlock(numBlocks, [&](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				const size_t offset = (size_t)i * blockSize;
+				const UINT32 size = (UINT32)std::min((size_t)blockSize, sourceSize - offset);
+
+				if (level == CompressionLevel::None)
+				{
+					index[i] = size | BLOCK_STORED_FLAG;
+					continue;
+				}
+
+				size_t compressedSize = 0;
+				snappy::RawCompress((const char*)source + offset, size, (char*)compressed + i * maxCompressedBlockSize, 
+					&compressedSize);
+
+				// Stored blocks decompress much faster, so only keep compressed blocks that save a reasonable amount
+				if (compressedSize < (size - size / 8))
+					index[i] = (UINT32)compressedSize;
+				else
+					index[i] = size | BLOCK_STORED_FLAG;
+			}
+		});
+
+		size_t dataSize = 0;
+		for (auto& entry : index)
+			dataSize += entry & ~BLOCK_STORED_FLAG;
+
+		const UINT64 uncompressedSize = sourceSize;
+		const size_t headerSize = sizeof(BLOCK_COMPRESSION_MAGIC) + sizeof(blockSize) + sizeof(uncompressedSize) + 
+			sizeof(numBlocks) + numBlocks * sizeof(UINT32);
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>(headerSize + dataSize);
+		output->write(&BLOCK_COMPRESSION_MAGIC, sizeof(BLOCK_COMPRESSION_MAGIC));
+		output->write(&blockSize, sizeof(blockSize));
+		output->write(&uncompressedSize, sizeof(uncompressedSize));
+		output->write(&numBlocks, sizeof(numBlocks));
+		output->write(index.data(), numBlocks * sizeof(UINT32));
+
+		for (UINT32 i = 0; i < numBlocks; i++)
+		{
+			if ((index[i] & BLOCK_STORED_FLAG) != 0)
+				output->write(source + (size_t)i * blockSize, index[i] & ~BLOCK_STORED_FLAG);
+			else
+				output->write(compressed + i * maxCompressedBlockSize, index[i]);
+		}
+
+		output->seek(0);
+
+		if (compressed != nullptr)
+			bs_free(compressed);
+
+		if (sourceBuffer != nullptr)
+			bs_free(sourceBuffer);
+
+		return output;
+	}
+
+	SPtr<MemoryDataStream> Compression::decompressBlocks(SPtr<DataStream>& input)
+	{
+		BlockDecompressor decompressor(input);
+		if (!decompressor.isValid())
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		return decompressor.readAll();
+	}
+
+	BlockDecompressor::BlockDecompressor(const SPtr<DataStream>& input)
+		:mInput(input)
+	{
+		UINT32 magic = 0;
+		UINT32 numBlocks = 0;
+
+		input->read(&magic, sizeof(magic));
+		input->read(&mBlockSize, sizeof(mBlockSize));
+		input->read(&mSize, sizeof(mSize));
+		if (input->read(&numBlocks, sizeof(numBlocks)) != sizeof(numBlocks) || magic != BLOCK_COMPRESSION_MAGIC)
+			return;
+
+		if (mBlockSize == 0 || mBlockSize >= BLOCK_STORED_FLAG)
+			return;
+
+		// All blocks but the last must be full, and the last one can't be empty
+		const UINT64 maxSize = (UINT64)numBlocks * mBlockSize;
+		if (mSize > maxSize || (numBlocks > 0 && mSize <= maxSize - mBlockSize) || (numBlocks == 0 && mSize != 0))
+			return;
+
+		// Make sure the stream can hold the index before allocating it, as a corrupt header can specify any block count
+		const size_t indexSize = (size_t)numBlocks * sizeof(UINT32);
+		if (input->size() - input->tell() < indexSize)
+			return;
+
+		Vector<UINT32> index(numBlocks);
+		if (input->read(index.data(), indexSize) != indexSize)
+			return;
+
+		mBlocks.resize(numBlocks);
+
+		// Block sizes are validated before anything is allocated for the output, as a corrupt header could otherwise claim
+		// an output of any size backed by very little data
+		const size_t maxCompressedBlockSize = snappy::MaxCompressedLength(mBlockSize);
+
+		UINT64 offset = 0;
+		for (UINT32 i = 0; i < numBlocks; i++)
+		{
+			BlockInfo& block = mBlocks[i];
+			block.offset = offset;
+			block.size = index[i] & ~BLOCK_STORED_FLAG;
+			block.compressed = (index[i] & BLOCK_STORED_FLAG) == 0;
+
+			const UINT32 decompressedSize = getDecompressedBlockSize(i);
+			if (block.compressed)
+			{
+				if (block.size == 0 || block.size > maxCompressedBlockSize || 
+					(UINT64)block.size * MAX_BLOCK_EXPANSION < decompressedSize)
+					return;
+			}
+			else if (block.size != decompressedSize) // Stored blocks are copied directly to the output
+				return;
+
+			offset += block.size;
+		}
+
+		mDataStart = input->tell();
+		if (input->size() - mDataStart < offset)
+			return;
+
+		if (!input->isFile())
+			mData = static_cast<MemoryDataStream*>(input.get())->getCurrentPtr();
+
+		// Compressed blocks must decompress to exactly the size of the block
+		for (UINT32 i = 0; i < numBlocks; i++)
+		{
+			const BlockInfo& block = mBlocks[i];
+			if (!block.compressed)
+				continue;
+
+			const size_t headerSize = std::min((size_t)block.size, (size_t)MAX_BLOCK_LENGTH_HEADER_SIZE);
+
+			char headerBuffer[MAX_BLOCK_LENGTH_HEADER_SIZE];
+			const char* header = headerBuffer;
+			if (mData != nullptr)
+				header = (const char*)mData + block.offset;
+			else
+			{
+				input->seek(mDataStart + (size_t)block.offset);
+				if (input->read(headerBuffer, headerSize) != headerSize)
+					return;
+			}
+
+			size_t decompressedSize = 0;
+			if (!snappy::GetUncompressedLength(header, headerSize, &decompressedSize) || 
+				decompressedSize != getDecompressedBlockSize(i))
+				return;
+		}
+
+		input->seek(mDataStart + (size_t)offset);
+		mIsValid = true;
+	}
+
+	BlockDecompressor::~BlockDecompressor()
+	{
+		if (mStoredBlock != nullptr)
+			bs_free(mStoredBlock);
+
+		if (mCachedBlock != nullptr)
+			bs_free(mCachedBlock);
+	}
+
+	size_t BlockDecompressor::read(UINT64 offset, void* output, size_t count)
+	{
+		if (!mIsValid || offset >= mSize)
+			return 0;
+
+		count = (size_t)std::min((UINT64)count, mSize - offset);
+
+		UINT8* dst = (UINT8*)output;
+		size_t numRead = 0;
+		while (numRead < count)
+		{
+			const UINT64 position = offset + numRead;
+			const UINT32 idx = (UINT32)(position / mBlockSize);
+			const UINT32 blockOffset = (UINT32)(position % mBlockSize);
+			const UINT32 blockSize = getDecompressedBlockSize(idx);
+			const size_t toCopy = std::min((size_t)(blockSize - blockOffset), count - numRead);
+
+			if (blockOffset == 0 && toCopy == blockSize && idx != mCachedBlockIdx)
+			{
+				// Entire block is requested, decompress it directly into the output
+				const UINT8* stored = getStoredBlock(idx);
+				if (stored == nullptr || !decompressBlock(idx, stored, dst + numRead))
+					break;
+			}
+			else
+			{
+				if (idx != mCachedBlockIdx)
+				{
+					if (mCachedBlock == nullptr)
+						mCachedBlock = (UINT8*)bs_alloc(mBlockSize);
+
+					mCachedBlockIdx = (UINT32)-1;
+
+					const UINT8* stored = getStoredBlock(idx);
+					if (stored == nullptr || !decompressBlock(idx, stored, mCachedBlock))
+						break;
+
+					mCachedBlockIdx = idx;
+				}
+
+				memcpy(dst + numRead, mCachedBlock + blockOffset, toCopy);
+			}
+
+			numRead += toCopy;
+		}
+
+		return numRead;
+	}
+
+	SPtr<MemoryDataStream> BlockDecompressor::readAll()
+	{
+		if (!mIsValid)
+			return nullptr;
+
+		// Blocks are decompressed in parallel, so they all need to be in memory
+		const UINT8* data = mData;
+		UINT8* dataBuffer = nullptr;
+		if (data == nullptr && !mBlocks.empty())
+		{
+			const BlockInfo& lastBlock = mBlocks.back();
+			const size_t dataSize = (size_t)(lastBlock.offset + lastBlock.size);
+
+			dataBuffer = (UINT8*)bs_alloc(dataSize);
+
+			const size_t endPosition = mInput->tell();
+			mInput->seek(mDataStart);
+			const size_t numRead = mInput->read(dataBuffer, dataSize);
+			mInput->seek(endPosition);
+
+			if (numRead != dataSize)
+			{
+				bs_free(dataBuffer);
+				return nullptr;
+			}
+
+			data = dataBuffer;
+		}
+
+		SPtr<MemoryDataStream> output = bs_shared_ptr_new<MemoryDataStream>((size_t)mSize);
+		UINT8* outputData = output->getPtr();
+
+		std::atomic<bool> failed{false};
+		forEachBlock(getNumBlocks(), [&](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				if (!decompressBlock(i, data + mBlocks[i].offset, outputData + (size_t)i * mBlockSize))
+					failed = true;
+			}
+		});
+
+		if (dataBuffer != nullptr)
+			bs_free(dataBuffer);
+
+		if (failed)
+		{
+			LOGERR("Decompression failed, corrupt data.");
+			return nullptr;
+		}
+
+		return output;
+	}
+
+	bool BlockDecompressor::decompressBlock(UINT32 idx, const UINT8* source, UINT8* output) const
+	{
+		const BlockInfo& block = mBlocks[idx];
+		if (!block.compressed)
+		{
+			memcpy(output, source, block.size);
+			return true;
+		}
+
+		size_t size = 0;
+		if (!snappy::GetUncompressedLength((const char*)source, block.size, &size) || size != getDecompressedBlockSize(idx))
+			return false;
+
+		return snappy::RawUncompress((const char*)source, block.size, (char*)output);
+	}
+
+	UINT32 BlockDecompressor::getDecompressedBlockSize(UINT32 idx) const
+	{
+		return (UINT32)std::min((UINT64)mBlockSize, mSize - (UINT64)idx * mBlockSize);
+	}
+
+	const UINT8* BlockDecompressor::getStoredBlock(UINT32 idx)
+	{
+		const BlockInfo& block = mBlocks[idx];
+		if (mData != nullptr)
+			return mData + block.offset;
+
+		if (mStoredBlockCapacity < block.size)
+		{
+			if (mStoredBlock != nullptr)
+				bs_free(mStoredBlock);
+
+			mStoredBlock = (UINT8*)bs_alloc(block.size);
+			mStoredBlockCapacity = block.size;
+		}
+
+		const size_t endPosition = mInput->tell();
+		mInput->seek(mDataStart + (size_t)block.offset);
+		const size_t numRead = mInput->read(mStoredBlock, block.size);
+		mInput->seek(endPosition);
+
+		return numRead == block.size ? mStoredBlock : nullptr;
+	}
 }
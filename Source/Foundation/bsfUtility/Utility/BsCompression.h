@@ -10,15 +10,143 @@ namespace bs
 	 *  @{
 	 */
 
+	/** Determines how are individual blocks compressed by Compression::compressBlocks(). */
+	enum class CompressionLevel
+	{
+		/** Blocks are stored without compression. Fastest to compress and decompress, but doesn't save any space. */
+		None,
+
+		/** 
+		 * Blocks are compressed using Snappy. Favors compression and decompression speed over compression ratio. Blocks
+		 * that don't compress well are stored without compression.
+		 */
+		Fast
+	};
+
 	/** Performs generic compression and decompression on raw data. */
 	class BS_UTILITY_EXPORT Compression
 	{
 	public:
+		/** Default size of a single block used by compressBlocks(), in bytes. */
+		static constexpr UINT32 DEFAULT_BLOCK_SIZE = 64 * 1024;
+
 		/** Compresses the data from the provided data stream and outputs the new stream with compressed data. */
 		static SPtr<MemoryDataStream> compress(SPtr<DataStream>& input);
 
 		/** Decompresses the data from the provided data stream and outputs the new stream with decompressed data. */
 		static SPtr<MemoryDataStream> decompress(SPtr<DataStream>& input);
+
+		/** 
+		 * Compresses the data from the provided data stream by splitting it into blocks and compressing each block 
+		 * independently. Output starts with an index of all the blocks, followed by the compressed blocks. Unlike 
+		 * compress(), such data can be decompressed in parallel, and can be partially decompressed using 
+		 * BlockDecompressor. 
+		 *
+		 * @param[in]	input		Stream to compress, starting at its current position.
+		 * @param[in]	level		Determines how are the blocks compressed.
+		 * @param[in]	blockSize	Size of a single block before compression, in bytes. Smaller blocks allow for more
+		 *							parallelism and finer grained random access, at the cost of compression ratio.
+		 * @return					Stream containing the compressed data.
+		 *
+		 * @note	Blocks are compressed in parallel if the TaskScheduler is running.
+		 */
+		static SPtr<MemoryDataStream> compressBlocks(SPtr<DataStream>& input, 
+			CompressionLevel level = CompressionLevel::Fast, UINT32 blockSize = DEFAULT_BLOCK_SIZE);
+
+		/** 
+		 * Decompresses data compressed using compressBlocks() and outputs the new stream with decompressed data. Returns
+		 * null if the data is corrupt.
+		 *
+		 * @note	Blocks are decompressed in parallel if the TaskScheduler is running.
+		 */
+		static SPtr<MemoryDataStream> decompressBlocks(SPtr<DataStream>& input);
+	};
+
+	/** 
+	 * Provides access to data compressed using Compression::compressBlocks(). Data can be decompressed all at once, or 
+	 * specific ranges can be decompressed, in which case only the blocks overlapping the range are decompressed.
+	 *
+	 * @note	Not thread safe.
+	 */
+	class BS_UTILITY_EXPORT BlockDecompressor
+	{
+	public:
+		/** 
+		 * Reads the block index from the provided stream, which must be positioned at the start of the compressed data.
+		 * Once constructed the stream is positioned at the end of the compressed data. Memory streams are referenced
+		 * directly, while for file streams the blocks are read as required.
+		 */
+		BlockDecompressor(const SPtr<DataStream>& input);
+		~BlockDecompressor();
+
+		BlockDecompressor(const BlockDecompressor&) = delete;
+		BlockDecompressor& operator=(const BlockDecompressor&) = delete;
+
+		/** Returns false if the provided data doesn't contain valid block compressed data. */
+		bool isValid() const { return mIsValid; }
+
+		/** Returns the size of the data after decompression, in bytes. */
+		UINT64 getSize() const { return mSize; }
+
+		/** Returns the size of a single block after decompression, in bytes. The last block can be smaller. */
+		UINT32 getBlockSize() const { return mBlockSize; }
+
+		/** Returns the number of blocks the data was split into. */
+		UINT32 getNumBlocks() const { return (UINT32)mBlocks.size(); }
+
+		/** 
+		 * Decompresses a range of the data into the provided buffer. Only the blocks overlapping the range are 
+		 * decompressed. Returns the number of bytes written, which is less than @p count if the range extends past the
+		 * end of the data, or if the data is corrupt.
+		 *
+		 * @param[in]	offset	Offset into the decompressed data to start reading at, in bytes.
+		 * @param[out]	output	Buffer of at least @p count bytes to output the data in.
+		 * @param[in]	count	Number of bytes to read.
+		 */
+		size_t read(UINT64 offset, void* output, size_t count);
+
+		/** 
+		 * Decompresses all the data and outputs the new stream with decompressed data. Returns null if the data is 
+		 * corrupt. Blocks are decompressed in parallel if the TaskScheduler is running.
+		 */
+		SPtr<MemoryDataStream> readAll();
+
+	private:
+		/** Information about a single compressed block. */
+		struct BlockInfo
+		{
+			UINT64 offset; /**< Offset of the block relative to the start of the block data. */
+			UINT32 size; /**< Size of the block as stored. */
+			bool compressed; /**< False if the block is stored without compression. */
+		};
+
+		/** 
+		 * Decompresses the block at the specified index into the output buffer, which must be large enough to hold the
+		 * entire block. @p source must contain the block as stored. Returns false if the block is corrupt.
+		 */
+		bool decompressBlock(UINT32 idx, const UINT8* source, UINT8* output) const;
+
+		/** Returns the size of the block at the specified index, after decompression. */
+		UINT32 getDecompressedBlockSize(UINT32 idx) const;
+
+		/** Returns a pointer to the block at the specified index as stored, reading it from the file if needed. */
+		const UINT8* getStoredBlock(UINT32 idx);
+
+		SPtr<DataStream> mInput;
+		const UINT8* mData = nullptr; /**< Start of block data, if the input is a memory stream. */
+		size_t mDataStart = 0; /**< Position of the block data within the input stream. */
+		UINT64 mSize = 0;
+		UINT32 mBlockSize = 0;
+		Vector<BlockInfo> mBlocks;
+		bool mIsValid = false;
+
+		// File streams only
+		UINT8* mStoredBlock = nullptr;
+		size_t mStoredBlockCapacity = 0;
+
+		// Most recently decompressed block, used when reading ranges that don't cover entire blocks
+		UINT8* mCachedBlock = nullptr;
+		UINT32 mCachedBlockIdx = (UINT32)-1;
 	};
 
 	/** @} */
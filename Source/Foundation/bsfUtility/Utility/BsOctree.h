@@ -250,7 +250,7 @@ namespace bs
 				auto positiveCenter = simd::add(nodeCenter, childOffset);
 				auto positiveDiff = simd::sub(positiveCenter, queryCenter);
 
-				auto diff = simd::min(negativeDiff, positiveDiff);
+				auto diff = simd::min(simd::abs(negativeDiff), simd::abs(positiveDiff));
 
 				auto queryExtents = simd::load<simd::float32x4>(&bounds.extents);
 				auto childExtent = simd::load_splat<simd::float32x4>(&mChildExtent);
@@ -604,6 +604,8 @@ namespace bs
 
 			if(nodeToCollapse)
 			{
+				node = nodeToCollapse;
+
 				// Add all the child node elements to the current node
 				bs_frame_mark();
 				{
@@ -758,7 +760,7 @@ namespace bs
 
 			ElementGroup* elemGroup;
 			ElementBoundGroup* boundGroup;
-			elementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
+			UINT32 groupElementIdx = node->mapToGroup(elementIdx, &elemGroup, &boundGroup);
 
 			ElementGroup* lastElemGroup;
 			ElementBoundGroup* lastBoundGroup;
@@ -766,10 +768,10 @@ namespace bs
 
 			if(elements.count > 1)
 			{
-				std::swap(elemGroup->v[elementIdx], lastElemGroup->v[lastElementIdx]);
-				std::swap(boundGroup->v[elementIdx], lastBoundGroup->v[lastElementIdx]);
+				std::swap(elemGroup->v[groupElementIdx], lastElemGroup->v[lastElementIdx]);
+				std::swap(boundGroup->v[groupElementIdx], lastBoundGroup->v[lastElementIdx]);
 
-				Options::setElementId(elemGroup->v[elementIdx], OctreeElementId(node, elementIdx), mContext);
+				Options::setElementId(elemGroup->v[groupElementIdx], OctreeElementId(node, elementIdx), mContext);
 			}
 
 			if(lastElementIdx == 0) // Last element in that group, remove it completely
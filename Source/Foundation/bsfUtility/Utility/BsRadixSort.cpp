@@ -0,0 +1,57 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "Utility/BsRadixSort.h"
+
+namespace bs
+{
+	void RadixSort::sort(RadixSortEntry* entries, RadixSortEntry* scratch, UINT32 count)
+	{
+		static constexpr UINT32 NUM_DIGITS = sizeof(UINT64);
+		static constexpr UINT32 NUM_BUCKETS = 256;
+
+		if(count < 2)
+			return;
+
+		// Count occurrences of each digit value for all digits in a single pass
+		UINT32 counts[NUM_DIGITS][NUM_BUCKETS];
+		memset(counts, 0, sizeof(counts));
+
+		for(UINT32 i = 0; i < count; i++)
+		{
+			const UINT64 key = entries[i].key;
+			for(UINT32 j = 0; j < NUM_DIGITS; j++)
+				counts[j][(key >> (j * 8)) & 0xFF]++;
+		}
+
+		RadixSortEntry* src = entries;
+		RadixSortEntry* dst = scratch;
+		for(UINT32 i = 0; i < NUM_DIGITS; i++)
+		{
+			const UINT32 shift = i * 8;
+			UINT32* digitCounts = counts[i];
+
+			// All keys share the same value for this digit, nothing to sort
+			if(digitCounts[(src[0].key >> shift) & 0xFF] == count)
+				continue;
+
+			UINT32 offset = 0;
+			for(UINT32 j = 0; j < NUM_BUCKETS; j++)
+			{
+				const UINT32 bucketCount = digitCounts[j];
+				digitCounts[j] = offset;
+				offset += bucketCount;
+			}
+
+			for(UINT32 j = 0; j < count; j++)
+			{
+				const UINT32 bucket = (src[j].key >> shift) & 0xFF;
+				dst[digitCounts[bucket]++] = src[j];
+			}
+
+			std::swap(src, dst);
+		}
+
+		if(src != entries)
+			memcpy(entries, src, count * sizeof(RadixSortEntry));
+	}
+}
@@ -0,0 +1,38 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "Prerequisites/BsPrerequisitesUtil.h"
+
+namespace bs
+{
+	/** @addtogroup General
+	 *  @{
+	 */
+
+	/** Entry sorted by RadixSort, consisting of a sort key and an arbitrary value (e.g. index of the sorted object). */
+	struct RadixSortEntry
+	{
+		UINT64 key;
+		UINT32 value;
+	};
+
+	/** Sorts entries with integer keys using the least significant digit radix sort algorithm. */
+	class BS_UTILITY_EXPORT RadixSort
+	{
+	public:
+		/**
+		 * Sorts the provided entries by their keys, in ascending order. The sort is stable, meaning entries with equal keys
+		 * keep their relative order. Keys are processed 8 bits at a time and bytes that are equal in all keys are skipped,
+		 * so keys that don't use all of their bits sort faster.
+		 *
+		 * @param[in, out]	entries		Entries to sort. Contains the sorted entries after the method returns.
+		 * @param[in]		scratch		Temporary buffer of the same size as @p entries, used during sorting. Its contents
+		 *								after the method returns are undefined.
+		 * @param[in]		count		Number of entries in the @p entries and @p scratch buffers.
+		 */
+		static void sort(RadixSortEntry* entries, RadixSortEntry* scratch, UINT32 count);
+	};
+
+	/** @} */
+}
@@ -2,6 +2,7 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Prerequisites/BsPrerequisitesUtil.h"
 #include "ThirdParty/md5.h"
+#include "FileSystem/BsDataStream.h"
 
 namespace bs
 {
@@ -38,4 +39,33 @@ namespace bs
 
 		return buf;
 	}
+
+	String md5(DataStream& source)
+	{
+		static constexpr UINT32 CHUNK_SIZE = 64 * 1024;
+
+		MD5 md5;
+		UINT8* chunk = (UINT8*)bs_stack_alloc(CHUNK_SIZE);
+		while (!source.eof())
+		{
+			const size_t numRead = source.read(chunk, CHUNK_SIZE);
+			if (numRead == 0)
+				break;
+
+			md5.update(chunk, (UINT32)numRead);
+		}
+
+		bs_stack_free(chunk);
+		md5.finalize();
+
+		UINT8 digest[16];
+		md5.decdigest(digest, sizeof(digest));
+
+		String buf;
+		buf.resize(32);
+		for (int i = 0; i < 16; i++)
+			snprintf(&(buf[0]) + i * 2, 3, "%02x", digest[i]);
+
+		return buf;
+	}
 }
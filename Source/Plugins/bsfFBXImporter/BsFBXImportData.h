@@ -32,6 +32,7 @@ namespace bs
 		float animSampleRate = 1.0f / 60.0f;
 		bool animResample = false;
 		bool reduceKeyframes = true;
+		float keyframeReductionError = 0.0001f;
 	};
 
 	/**	Represents a single node in the FBX transform hierarchy. */
@@ -181,7 +181,10 @@ namespace bs
 			{
 				SPtr<AnimationClip> clip = AnimationClip::_createPtr(entry.curves, entry.isAdditive, entry.sampleRate, 
 					entry.rootMotion);
-				
+
+				if(meshImportOptions->getAnimationCompression())
+					clip->compress();
+
 				for(auto& eventsEntry : events)
 				{
 					if(entry.name == eventsEntry.name)
@@ -219,6 +222,7 @@ namespace bs
 		fbxImportOptions.importSkin = meshImportOptions->getImportSkin();
 		fbxImportOptions.importScale = meshImportOptions->getImportScale();
 		fbxImportOptions.reduceKeyframes = meshImportOptions->getKeyFrameReduction();
+		fbxImportOptions.keyframeReductionError = meshImportOptions->getKeyFrameReductionError();
 
 		FBXImportScene importedScene;
 		bakeTransforms(fbxScene);
@@ -1865,15 +1869,18 @@ namespace bs
 				*eulerAnimation = TAnimationCurve<Vector3>(keyframes);
 			}
 
+			boneAnim.translation = AnimationUtility::scaleCurve(boneAnim.translation, importScene.scaleFactor);
+			boneAnim.rotation = *AnimationUtility::eulerToQuaternionCurve(eulerAnimation);
+
+			// Reduce after conversion, so the error is measured in the same units the curves are evaluated in
 			if(importOptions.reduceKeyframes)
 			{
-				boneAnim.translation = reduceKeyframes(boneAnim.translation);
-				boneAnim.scale = reduceKeyframes(boneAnim.scale);
-				*eulerAnimation = reduceKeyframes(*eulerAnimation);
-			}
+				const float maxError = importOptions.keyframeReductionError;
 
-			boneAnim.translation = AnimationUtility::scaleCurve(boneAnim.translation, importScene.scaleFactor);
-			boneAnim.rotation = *AnimationUtility::eulerToQuaternionCurve(eulerAnimation);
+				boneAnim.translation = boneAnim.translation.reduce(maxError);
+				boneAnim.rotation = boneAnim.rotation.reduce(maxError);
+				boneAnim.scale = boneAnim.scale.reduce(maxError);
+			}
 		}
 
 		if (importOptions.importBlendShapes)
@@ -1979,47 +1986,6 @@ namespace bs
 		bs_frame_clear();
 	}
 
-	TAnimationCurve<Vector3> FBXImporter::reduceKeyframes(TAnimationCurve<Vector3>& curve)
-	{
-		UINT32 keyCount = curve.getNumKeyFrames();
-
-		Vector<TKeyframe<Vector3>> newKeyframes;
-
-		bool lastWasEqual = false;
-		for (UINT32 i = 0; i < keyCount; i++)
-		{
-			bool isEqual = true;
-
-			const TKeyframe<Vector3>& curKey = curve.getKeyFrame(i);
-			if (i > 0)
-			{
-				TKeyframe<Vector3>& prevKey = newKeyframes.back();
-
-				isEqual = Math::approxEquals(prevKey.value, curKey.value) &&
-					Math::approxEquals(prevKey.outTangent, curKey.inTangent) && isEqual;
-			}
-			else
-				isEqual = false;
-
-			// More than two keys in a row are equal, remove previous key by replacing it with this one
-			if (lastWasEqual && isEqual)
-			{
-				TKeyframe<Vector3>& prevKey = newKeyframes.back();
-
-				// Other properties are guaranteed unchanged
-				prevKey.time = curKey.time;
-				prevKey.outTangent = curKey.outTangent;
-
-				continue;
-			}
-
-			newKeyframes.push_back(curKey);
-			lastWasEqual = isEqual;
-		}
-
-		return TAnimationCurve<Vector3>(newKeyframes);
-	}
-
 	template<class T>
 	void setKeyframeValues(TKeyframe<T>& keyFrame, int idx, float value, float inTangent, float outTangent)
 	{
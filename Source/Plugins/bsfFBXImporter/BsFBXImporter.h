@@ -114,12 +114,6 @@ namespace bs
 		void convertAnimations(const Vector<FBXAnimationClip>& clips, const Vector<AnimationSplitInfo>& splits, 
 			const SPtr<Skeleton>& skeleton, bool importRootMotion, Vector<FBXAnimationClipData>& output);
 
-		/** 
-		 * Removes identical sequential keyframes for the provided set of curves. The keyframe must be identical over all
-		 * the curves in order for it to be removed.
-		 */
-		TAnimationCurve<Vector3> reduceKeyframes(TAnimationCurve<Vector3>& curve);
-
 		/**
 		 * Converts all the meshes from per-index attributes to per-vertex attributes.
 		 *
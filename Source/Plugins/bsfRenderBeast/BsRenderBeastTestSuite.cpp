@@ -2,6 +2,8 @@
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "Testing/BsTestSuite.h"
 #include "Utility/BsTextureRowAllocator.h"
+#include "Utility/BsSceneOctree.h"
+#include "Math/BsRandom.h"
 
 namespace bs
 {
@@ -13,11 +15,13 @@ namespace bs
 
 	private:
 		void testTextureRowAllocator();
+		void testSceneOctree();
 	};
 
 	RenderBeastTestSuite::RenderBeastTestSuite()
 	{
 		BS_ADD_TEST(RenderBeastTestSuite::testTextureRowAllocator);
+		BS_ADD_TEST(RenderBeastTestSuite::testSceneOctree);
 	}
 
 	void RenderBeastTestSuite::testTextureRowAllocator()
@@ -71,4 +75,83 @@ namespace bs
 		auto a13 = alloc.alloc(0);
 		BS_TEST_ASSERT(a13.length == 0);
 	}
+
+	void RenderBeastTestSuite::testSceneOctree()
+	{
+		Random random(1234);
+		auto randomBounds = [&random](float placementExtent, float maxSize)
+		{
+			Vector3 center(random.getSNorm(), random.getSNorm(), random.getSNorm());
+			center *= placementExtent;
+
+			Vector3 extents(random.getUNorm(), random.getUNorm(), random.getUNorm());
+			extents *= maxSize;
+
+			const AABox box(center - extents, center + extents);
+			return Bounds(box, Sphere(center, box.getRadius()));
+		};
+
+		// Includes objects outside of the area covered by the octree, and ones with infinite bounds
+		ct::SceneOctree octree;
+		Vector<Bounds> bounds;
+		for(UINT32 i = 0; i < 20000; i++)
+		{
+			bounds.push_back(randomBounds(10000.0f, (i % 10) == 0 ? 500.0f : 20.0f));
+			octree.add(bounds.back());
+		}
+
+		bounds.push_back(Bounds(AABox::INF_BOX, Sphere(Vector3::ZERO, std::numeric_limits<float>::infinity())));
+		octree.add(bounds.back());
+
+		// Move some elements around, and remove others, mirroring the way scene object arrays are updated
+		for(UINT32 i = 0; i < 5000; i++)
+		{
+			const UINT32 idx = random.get() % (UINT32)bounds.size();
+			if((i % 3) == 0)
+			{
+				bounds[idx] = bounds.back();
+				bounds.erase(bounds.end() - 1);
+				octree.remove(idx);
+			}
+			else
+			{
+				bounds[idx] = randomBounds(10000.0f, 20.0f);
+				octree.update(idx, bounds[idx]);
+			}
+		}
+
+		BS_TEST_ASSERT(octree.size() == (UINT32)bounds.size());
+
+		Vector<Plane> planes =
+		{
+			Plane(Vector3(1.0f, 0.0f, 0.0f), -2000.0f),
+			Plane(Vector3(-1.0f, 0.0f, 0.0f), -3000.0f),
+			Plane(Vector3(0.0f, 1.0f, 0.0f), -1000.0f),
+			Plane(Vector3(0.0f, -1.0f, 0.0f), -1000.0f),
+			Plane(Vector3(0.0f, 0.0f, 1.0f), 0.0f),
+			Plane(Vector3(0.0f, 0.0f, -1.0f), -6000.0f),
+			Plane(Vector3::normalize(Vector3(1.0f, 1.0f, 1.0f)), -500.0f)
+		};
+		ConvexVolume volume(planes);
+
+		// Results must match testing every element individually
+		Vector<bool> visible(bounds.size(), false);
+		octree.intersect(volume, [&](UINT32 idx)
+		{
+			BS_TEST_ASSERT(!visible[idx]);
+			visible[idx] = true;
+		});
+
+		UINT32 numVisible = 0;
+		for(UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		{
+			const bool expected = volume.intersects(bounds[i].getSphere()) && volume.intersects(bounds[i].getBox());
+			BS_TEST_ASSERT(visible[i] == expected);
+
+			if(visible[i])
+				numVisible++;
+		}
+
+		BS_TEST_ASSERT(numVisible > 0 && numVisible < (UINT32)bounds.size());
+	}
 }
@@ -156,6 +156,7 @@ namespace bs {	namespace ct
 
 				mInfo.radialLights.push_back(RendererLight(light));
 				mInfo.radialLightWorldBounds.push_back(light->getBounds());
+				mInfo.radialLightOctree.add(light->getBounds());
 			}
 			else // Spot
 			{
@@ -164,6 +165,7 @@ namespace bs {	namespace ct
 
 				mInfo.spotLights.push_back(RendererLight(light));
 				mInfo.spotLightWorldBounds.push_back(light->getBounds());
+				mInfo.spotLightOctree.add(light->getBounds());
 			}
 		}
 	}
@@ -173,9 +175,15 @@ namespace bs {	namespace ct
 		UINT32 lightId = light->getRendererId();
 
 		if (light->getType() == LightType::Radial)
+		{
 			mInfo.radialLightWorldBounds[lightId] = light->getBounds();
+			mInfo.radialLightOctree.update(lightId, light->getBounds());
+		}
 		else if(light->getType() == LightType::Spot)
+		{
 			mInfo.spotLightWorldBounds[lightId] = light->getBounds();
+			mInfo.spotLightOctree.update(lightId, light->getBounds());
+		}
 	}
 
 	void RendererScene::unregisterLight(Light* light)
@@ -215,6 +223,7 @@ namespace bs {	namespace ct
 				// Last element is the one we want to erase
 				mInfo.radialLights.erase(mInfo.radialLights.end() - 1);
 				mInfo.radialLightWorldBounds.erase(mInfo.radialLightWorldBounds.end() - 1);
+				mInfo.radialLightOctree.remove(lightId);
 			}
 			else // Spot
 			{
@@ -233,6 +242,7 @@ namespace bs {	namespace ct
 				// Last element is the one we want to erase
 				mInfo.spotLights.erase(mInfo.spotLights.end() - 1);
 				mInfo.spotLightWorldBounds.erase(mInfo.spotLightWorldBounds.end() - 1);
+				mInfo.spotLightOctree.remove(lightId);
 			}
 		}
 	}
@@ -245,6 +255,7 @@ namespace bs {	namespace ct
 
 		mInfo.renderables.push_back(bs_new<RendererRenderable>());
 		mInfo.renderableCullInfos.push_back(CullInfo(renderable->getBounds(), renderable->getLayer()));
+		mInfo.renderableOctree.add(mInfo.renderableCullInfos.back().bounds);
 
 		RendererRenderable* rendererRenderable = mInfo.renderables.back();
 		rendererRenderable->renderable = renderable;
@@ -436,6 +447,7 @@ namespace bs {	namespace ct
 
 		mInfo.renderables[renderableId]->updatePerObjectBuffer();
 		mInfo.renderableCullInfos[renderableId].bounds = renderable->getBounds();
+		mInfo.renderableOctree.update(renderableId, mInfo.renderableCullInfos[renderableId].bounds);
 	}
 
 	void RendererScene::unregisterRenderable(Renderable* renderable)
@@ -464,6 +476,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.renderables.erase(mInfo.renderables.end() - 1);
 		mInfo.renderableCullInfos.erase(mInfo.renderableCullInfos.end() - 1);
+		mInfo.renderableOctree.remove(renderableId);
 
 		bs_delete(rendererRenderable);
 	}
@@ -477,6 +490,7 @@ namespace bs {	namespace ct
 		RendererReflectionProbe& probeInfo = mInfo.reflProbes.back();
 
 		mInfo.reflProbeWorldBounds.push_back(probe->getBounds());
+		mInfo.reflProbeOctree.add(probe->getBounds());
 
 		// Find a spot in cubemap array
 		UINT32 numArrayEntries = (UINT32)mInfo.reflProbeCubemapArrayUsedSlots.size();
@@ -509,6 +523,7 @@ namespace bs {	namespace ct
 		// Should only get called if transform changes, any other major changes and ReflProbeInfo entry gets rebuild
 		UINT32 probeId = probe->getRendererId();
 		mInfo.reflProbeWorldBounds[probeId] = probe->getBounds();
+		mInfo.reflProbeOctree.update(probeId, probe->getBounds());
 
 		if (texture)
 		{
@@ -540,6 +555,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.reflProbes.erase(mInfo.reflProbes.end() - 1);
 		mInfo.reflProbeWorldBounds.erase(mInfo.reflProbeWorldBounds.end() - 1);
+		mInfo.reflProbeOctree.remove(probeId);
 	}
 
 	void RendererScene::setReflectionProbeArrayIndex(UINT32 probeIdx, UINT32 arrayIdx, bool markAsClean)
@@ -589,6 +605,7 @@ namespace bs {	namespace ct
 
 		mInfo.particleSystems.push_back(RendererParticles());
 		mInfo.particleSystemCullInfos.push_back(CullInfo(Bounds(), particleSystem->getLayer()));
+		mInfo.particleSystemOctree.add(Bounds());
 
 		RendererParticles& rendererParticles = mInfo.particleSystems.back();
 		rendererParticles.particleSystem = particleSystem;
@@ -923,6 +940,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.particleSystems.erase(mInfo.particleSystems.end() - 1);
 		mInfo.particleSystemCullInfos.erase(mInfo.particleSystemCullInfos.end() - 1);
+		mInfo.particleSystemOctree.remove(rendererId);
 	}
 
 	void RendererScene::registerDecal(Decal* decal)
@@ -932,6 +950,7 @@ namespace bs {	namespace ct
 
 		mInfo.decals.emplace_back();
 		mInfo.decalCullInfos.push_back(CullInfo(decal->getBounds(), decal->getLayer()));
+		mInfo.decalOctree.add(decal->getBounds());
 
 		RendererDecal& rendererDecal = mInfo.decals.back();
 		rendererDecal.decal = decal;
@@ -1007,6 +1026,7 @@ namespace bs {	namespace ct
 
 		mInfo.decals[rendererId].updatePerObjectBuffer();
 		mInfo.decalCullInfos[rendererId].bounds = decal->getBounds();
+		mInfo.decalOctree.update(rendererId, decal->getBounds());
 	}
 
 	void RendererScene::unregisterDecal(Decal* decal)
@@ -1034,6 +1054,7 @@ namespace bs {	namespace ct
 		// Last element is the one we want to erase
 		mInfo.decals.erase(mInfo.decals.end() - 1);
 		mInfo.decalCullInfos.erase(mInfo.decalCullInfos.end() - 1);
+		mInfo.decalOctree.remove(rendererId);
 	}
 
 	void RendererScene::setOptions(const SPtr<RenderBeastOptions>& options)
@@ -1317,7 +1338,9 @@ namespace bs {	namespace ct
 				worldAABox.transformAffine(entry.localToWorld);
 
 			const Sphere worldSphere(worldAABox.getCenter(), worldAABox.getRadius());
-			mInfo.particleSystemCullInfos[rendererId] = Bounds(worldAABox, worldSphere);
+			const Bounds worldBounds(worldAABox, worldSphere);
+			mInfo.particleSystemCullInfos[rendererId].bounds = worldBounds;
+			mInfo.particleSystemOctree.update(rendererId, worldBounds);
 		}
 	}
 
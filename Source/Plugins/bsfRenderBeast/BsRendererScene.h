@@ -8,6 +8,7 @@
 #include "BsRendererParticles.h"
 #include "Shading/BsLightProbes.h"
 #include "Utility/BsSamplerOverrides.h"
+#include "Utility/BsSceneOctree.h"
 
 namespace bs 
 { 
@@ -38,6 +39,7 @@ namespace bs
 		// Renderables
 		Vector<RendererRenderable*> renderables;
 		Vector<CullInfo> renderableCullInfos;
+		SceneOctree renderableOctree;
 
 		// Lights
 		Vector<RendererLight> directionalLights;
@@ -45,10 +47,13 @@ namespace bs
 		Vector<RendererLight> spotLights;
 		Vector<Sphere> radialLightWorldBounds;
 		Vector<Sphere> spotLightWorldBounds;
+		SceneOctree radialLightOctree;
+		SceneOctree spotLightOctree;
 
 		// Reflection probes
 		Vector<RendererReflectionProbe> reflProbes;
 		Vector<Sphere> reflProbeWorldBounds;
+		SceneOctree reflProbeOctree;
 		Vector<bool> reflProbeCubemapArrayUsedSlots;
 		SPtr<Texture> reflProbeCubemapsTex;
 
@@ -58,10 +63,12 @@ namespace bs
 		// Particles
 		Vector<RendererParticles> particleSystems;
 		Vector<CullInfo> particleSystemCullInfos;
+		SceneOctree particleSystemOctree;
 
 		// Decals
 		Vector<RendererDecal> decals;
 		Vector<CullInfo> decalCullInfos;
+		SceneOctree decalOctree;
 
 		// Sky
 		Skybox* skybox = nullptr;
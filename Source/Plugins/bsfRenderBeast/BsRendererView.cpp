@@ -11,6 +11,7 @@
 #include "BsRendererScene.h"
 #include "BsRenderBeast.h"
 #include <BsRendererDecal.h>
+#include "Threading/BsTaskScheduler.h"
 
 namespace bs { namespace ct
 {
@@ -180,7 +181,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-		Vector<bool>* visibility)
+		const SceneOctree& octree, Vector<bool>* visibility)
 	{
 		mVisibility.renderables.clear();
 		mVisibility.renderables.resize(renderables.size(), false);
@@ -188,7 +189,7 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.renderables);
+		calculateVisibility(cullInfos, octree, mVisibility.renderables);
 
 		if(visibility != nullptr)
 		{
@@ -202,7 +203,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos, 
-		Vector<bool>* visibility)
+		const SceneOctree& octree, Vector<bool>* visibility)
 	{
 		mVisibility.particleSystems.clear();
 		mVisibility.particleSystems.resize(particleSystems.size(), false);
@@ -210,7 +211,7 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.particleSystems);
+		calculateVisibility(cullInfos, octree, mVisibility.particleSystems);
 
 		if(visibility != nullptr)
 		{
@@ -224,7 +225,7 @@ namespace bs { namespace ct
 	}
 
 	void RendererView::determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos, 
-		Vector<bool>* visibility)
+		const SceneOctree& octree, Vector<bool>* visibility)
 	{
 		mVisibility.decals.clear();
 		mVisibility.decals.resize(decals.size(), false);
@@ -232,7 +233,7 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(cullInfos, mVisibility.decals);
+		calculateVisibility(cullInfos, octree, mVisibility.decals);
 
 		if(visibility != nullptr)
 		{
@@ -245,7 +246,7 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, 
+	void RendererView::determineVisible(const Vector<RendererLight>& lights, const SceneOctree& octree,
 		LightType lightType, Vector<bool>* visibility)
 	{
 		// Special case for directional lights, they're always visible
@@ -276,7 +277,7 @@ namespace bs { namespace ct
 		if (mRenderSettings->overlayOnly)
 			return;
 
-		calculateVisibility(bounds, *perViewVisibility);
+		calculateVisibility(octree, *perViewVisibility);
 
 		if(visibility != nullptr)
 		{
@@ -289,40 +290,27 @@ namespace bs { namespace ct
 		}
 	}
 
-	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const Vector<CullInfo>& cullInfos, const SceneOctree& octree,
+		Vector<bool>& visibility) const
 	{
 		UINT64 cameraLayers = mProperties.visibleLayers;
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)cullInfos.size(); i++)
+		octree.intersect(worldFrustum, [&](UINT32 idx)
 		{
-			if ((cullInfos[i].layer & cameraLayers) == 0)
-				continue;
-
-			// Do frustum culling
-			// Note: This is bound to be a bottleneck at some point. When it is ensure that intersect methods use vector
-			// operations, as it is trivial to update them. Also consider spatial partitioning.
-			const Sphere& boundingSphere = cullInfos[i].bounds.getSphere();
-			if (worldFrustum.intersects(boundingSphere))
-			{
-				// More precise with the box
-				const AABox& boundingBox = cullInfos[i].bounds.getBox();
-
-				if (worldFrustum.intersects(boundingBox))
-					visibility[i] = true;
-			}
-		}
+			if ((cullInfos[idx].layer & cameraLayers) != 0)
+				visibility[idx] = true;
+		});
 	}
 
-	void RendererView::calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const
+	void RendererView::calculateVisibility(const SceneOctree& octree, Vector<bool>& visibility) const
 	{
 		const ConvexVolume& worldFrustum = mProperties.cullFrustum;
 
-		for (UINT32 i = 0; i < (UINT32)bounds.size(); i++)
+		octree.intersect(worldFrustum, [&](UINT32 idx)
 		{
-			if (worldFrustum.intersects(bounds[i]))
-				visibility[i] = true;
-		}
+			visibility[idx] = true;
+		});
 	}
 
 	void RendererView::calculateVisibility(const Vector<AABox>& bounds, Vector<bool>& visibility) const
@@ -692,18 +680,6 @@ namespace bs { namespace ct
 		mVisibility.decals.resize(sceneInfo.decals.size(), false);
 		mVisibility.decals.assign(sceneInfo.decals.size(), false);
 
-		for(UINT32 i = 0; i < numViews; i++)
-		{
-			mViews[i]->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, &mVisibility.renderables);
-			mViews[i]->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemCullInfos, &mVisibility.particleSystems);
-			mViews[i]->determineVisible(sceneInfo.decals, sceneInfo.decalCullInfos, &mVisibility.decals);
-		}
-		
-		// Generate render queues per camera
-		for(UINT32 i = 0; i < numViews; i++)
-			mViews[i]->queueRenderElements(sceneInfo);
-
-		// Calculate light visibility for all views
 		const auto numRadialLights = (UINT32)sceneInfo.radialLights.size();
 		mVisibility.radialLights.resize(numRadialLights, false);
 		mVisibility.radialLights.assign(numRadialLights, false);
@@ -712,16 +688,44 @@ namespace bs { namespace ct
 		mVisibility.spotLights.resize(numSpotLights, false);
 		mVisibility.spotLights.assign(numSpotLights, false);
 
+		// Views are independent, so cull and generate render queues for each one in parallel. Each view only writes to
+		// its own visibility masks and render queues, which are then merged into the group visibility below.
+		const auto cullAndQueue = [this, &sceneInfo](UINT32 begin, UINT32 end)
+		{
+			for(UINT32 i = begin; i < end; i++)
+			{
+				RendererView* view = mViews[i];
+
+				view->determineVisible(sceneInfo.renderables, sceneInfo.renderableCullInfos, sceneInfo.renderableOctree);
+				view->determineVisible(sceneInfo.particleSystems, sceneInfo.particleSystemCullInfos,
+					sceneInfo.particleSystemOctree);
+				view->determineVisible(sceneInfo.decals, sceneInfo.decalCullInfos, sceneInfo.decalOctree);
+
+				view->queueRenderElements(sceneInfo);
+
+				if (view->getRenderSettings().overlayOnly)
+					continue;
+
+				view->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightOctree, LightType::Radial);
+				view->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightOctree, LightType::Spot);
+			}
+		};
+
+		TaskScheduler::instance().parallelFor(0, numViews, 1, cullAndQueue);
+
 		for (UINT32 i = 0; i < numViews; i++)
 		{
+			const VisibilityInfo& viewVisibility = mViews[i]->getVisibilityMasks();
+
+			mergeVisibility(viewVisibility.renderables, mVisibility.renderables);
+			mergeVisibility(viewVisibility.particleSystems, mVisibility.particleSystems);
+			mergeVisibility(viewVisibility.decals, mVisibility.decals);
+
 			if (mViews[i]->getRenderSettings().overlayOnly)
 				continue;
 
-			mViews[i]->determineVisible(sceneInfo.radialLights, sceneInfo.radialLightWorldBounds, LightType::Radial,
-				&mVisibility.radialLights);
-
-			mViews[i]->determineVisible(sceneInfo.spotLights, sceneInfo.spotLightWorldBounds, LightType::Spot,
-				&mVisibility.spotLights);
+			mergeVisibility(viewVisibility.radialLights, mVisibility.radialLights);
+			mergeVisibility(viewVisibility.spotLights, mVisibility.spotLights);
 		}
 
 		// Calculate refl. probe visibility for all views
@@ -738,7 +742,7 @@ namespace bs { namespace ct
 			if (viewProps.capturingReflections)
 				continue;
 
-			mViews[i]->calculateVisibility(sceneInfo.reflProbeWorldBounds, mVisibility.reflProbes);
+			mViews[i]->calculateVisibility(sceneInfo.reflProbeOctree, mVisibility.reflProbes);
 		}
 
 		// Organize light and refl. probe visibility infomation in a more GPU friendly manner
@@ -761,4 +765,14 @@ namespace bs { namespace ct
 			}
 		}
 	}
+
+	void RendererViewGroup::mergeVisibility(const Vector<bool>& input, Vector<bool>& output)
+	{
+		for (UINT32 i = 0; i < (UINT32)output.size(); i++)
+		{
+			bool visible = output[i];
+
+			output[i] = visible || input[i];
+		}
+	}
 }}
@@ -20,6 +20,7 @@ namespace bs { namespace ct
 {
 	struct SceneInfo;
 	class RendererLight;
+	class SceneOctree;
 
 	/** @addtogroup RenderBeast
 	 *  @{
@@ -277,6 +278,8 @@ namespace bs { namespace ct
 		 * @param[in]	renderables			A set of renderable objects to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p renderables array.
+		 * @param[in]	octree				Octree containing the bounds from @p cullInfos, used for skipping parts of the
+		 *									scene outside of the view frustum.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible renderable
 		 *									object. If the bit for an object is already set to true, the method will never
 		 *									change it to false which allows the same bitfield to be provided to multiple
@@ -286,7 +289,7 @@ namespace bs { namespace ct
 		 *									retrieved by calling getVisibilityMask().
 		 */
 		void determineVisible(const Vector<RendererRenderable*>& renderables, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+			const SceneOctree& octree, Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Populates view render queues by determining visible particle systems. 
@@ -294,6 +297,8 @@ namespace bs { namespace ct
 		 * @param[in]	particleSystems		A set of particle systems to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p particleSystems array.
+		 * @param[in]	octree				Octree containing the bounds from @p cullInfos, used for skipping parts of the
+		 *									scene outside of the view frustum.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible particle system
 		 *									object. If the bit for an object is already set to true, the method will never
 		 *									change it to false which allows the same bitfield to be provided to multiple
@@ -303,7 +308,7 @@ namespace bs { namespace ct
 		 *									retrieved by calling getVisibilityMask().
 		 */
 		void determineVisible(const Vector<RendererParticles>& particleSystems, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+			const SceneOctree& octree, Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Populates view render queues by determining visible decals. 
@@ -311,6 +316,8 @@ namespace bs { namespace ct
 		 * @param[in]	decals				A set of decals to iterate over and determine visibility for.
 		 * @param[in]	cullInfos			A set of world bounds & other information relevant for culling the provided
 		 *									renderable objects. Must be the same size as the @p decals array.
+		 * @param[in]	octree				Octree containing the bounds from @p cullInfos, used for skipping parts of the
+		 *									scene outside of the view frustum.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible decal
 		 *									object. If the bit for an object is already set to true, the method will never
 		 *									change it to false which allows the same bitfield to be provided to multiple
@@ -320,14 +327,14 @@ namespace bs { namespace ct
 		 *									retrieved by calling getVisibilityMask().
 		 */
 		void determineVisible(const Vector<RendererDecal>& decals, const Vector<CullInfo>& cullInfos,
-			Vector<bool>* visibility = nullptr);
+			const SceneOctree& octree, Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Calculates the visibility masks for all the lights of the provided type.
 		 * 
 		 * @param[in]	lights				A set of lights to determine visibility for.
-		 * @param[in]	bounds				Bounding sphere for each provided light. Must be the same size as the @p lights
-		 *									array.
+		 * @param[in]	octree				Octree containing the bounding sphere of each provided light. Must contain the
+		 *									same number of elements as the @p lights array.
 		 * @param[in]	type				Type of all the lights in the @p lights array.
 		 * @param[out]	visibility			Output parameter that will have the true bit set for any visible light. If the
 		 *									bit for a light is already set to true, the method will never change it to false
@@ -337,20 +344,22 @@ namespace bs { namespace ct
 		 *									As a side-effect, per-view visibility data is also calculated and can be
 		 *									retrieved by calling getVisibilityMask().
 		 */
-		void determineVisible(const Vector<RendererLight>& lights, const Vector<Sphere>& bounds, LightType type, 
+		void determineVisible(const Vector<RendererLight>& lights, const SceneOctree& octree, LightType type,
 			Vector<bool>* visibility = nullptr);
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * which entry is or isn't visible by this view. Both arrays must be of the same size. @p octree must contain the
+		 * same bounds as @p cullInfos, and is used for quickly rejecting groups of objects outside of the frustum.
 		 */
-		void calculateVisibility(const Vector<CullInfo>& cullInfos, Vector<bool>& visibility) const;
+		void calculateVisibility(const Vector<CullInfo>& cullInfos, const SceneOctree& octree,
+			Vector<bool>& visibility) const;
 
 		/**
-		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
-		 * which entry is or isn't visible by this view. Both inputs must be arrays of the same size.
+		 * Culls the bounds stored in the provided octree against the current frustum and outputs a set of visibility flags
+		 * determining which entry is or isn't visible by this view. @p visibility must be the same size as the octree.
 		 */
-		void calculateVisibility(const Vector<Sphere>& bounds, Vector<bool>& visibility) const;
+		void calculateVisibility(const SceneOctree& octree, Vector<bool>& visibility) const;
 
 		/**
 		 * Culls the provided set of bounds against the current frustum and outputs a set of visibility flags determining
@@ -504,6 +513,9 @@ namespace bs { namespace ct
 		void determineVisibility(const SceneInfo& sceneInfo);
 
 	private:
+		/** Marks entries visible in @p input as visible in @p output. Both arrays must be of the same size. */
+		static void mergeVisibility(const Vector<bool>& input, Vector<bool>& output);
+
 		Vector<RendererView*> mViews;
 		VisibilityInfo mVisibility;
 		bool mIsMainPass = false;
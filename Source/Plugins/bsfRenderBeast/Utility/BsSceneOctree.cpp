@@ -0,0 +1,98 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#include "BsSceneOctree.h"
+
+namespace bs { namespace ct
+{
+	/** Half-size of the area covered by the octree. Elements outside of this area are stored in the root node. */
+	static constexpr float SCENE_OCTREE_EXTENT = 8192.0f;
+
+	simd::AABox SceneOctree::Options::getBounds(UINT32 elem, void* context)
+	{
+		auto octree = (SceneOctree*)context;
+		return octree->getOctreeBounds(elem);
+	}
+
+	void SceneOctree::Options::setElementId(UINT32 elem, const OctreeElementId& id, void* context)
+	{
+		auto octree = (SceneOctree*)context;
+		octree->mIds[elem] = id;
+	}
+
+	SceneOctree::SceneOctree()
+		:mOctree(Vector3::ZERO, SCENE_OCTREE_EXTENT, this)
+	{ }
+
+	void SceneOctree::add(const Bounds& bounds)
+	{
+		const UINT32 idx = mBounds.size();
+
+		mBounds.add(bounds);
+		mIds.push_back(OctreeElementId());
+
+		mOctree.addElement(idx);
+	}
+
+	void SceneOctree::update(UINT32 idx, const Bounds& bounds)
+	{
+		const simd::AABox oldBounds = getOctreeBounds(idx);
+		mBounds.set(idx, bounds);
+
+		// Objects are often updated without their bounds changing, in which case there is no need to move them
+		const simd::AABox newBounds = getOctreeBounds(idx);
+		if(oldBounds.center == newBounds.center && oldBounds.extents == newBounds.extents)
+			return;
+
+		mOctree.removeElement(mIds[idx]);
+		mOctree.addElement(idx);
+	}
+
+	void SceneOctree::remove(UINT32 idx)
+	{
+		const UINT32 lastIdx = mBounds.size() - 1;
+
+		mOctree.removeElement(mIds[idx]);
+
+		// Re-insert the last element under its new index
+		if(idx != lastIdx)
+			mOctree.removeElement(mIds[lastIdx]);
+
+		mBounds.remove(idx);
+		mIds.erase(mIds.end() - 1);
+
+		if(idx != lastIdx)
+			mOctree.addElement(idx);
+	}
+
+	simd::AABox SceneOctree::sanitizeBounds(const simd::AABox& bounds)
+	{
+		const Vector4& center = bounds.center;
+		const Vector4& extents = bounds.extents;
+
+		// Infinite or invalid bounds can't be placed in any child node, make sure they end up in the root
+		if(!std::isfinite(center.x) || !std::isfinite(center.y) || !std::isfinite(center.z) ||
+			!std::isfinite(extents.x) || !std::isfinite(extents.y) || !std::isfinite(extents.z))
+		{
+			return simd::AABox(Vector3::ZERO, std::numeric_limits<float>::max());
+		}
+
+		return bounds;
+	}
+
+	AABox SceneOctree::toAABox(const simd::AABox& bounds)
+	{
+		const Vector3 center(bounds.center.x, bounds.center.y, bounds.center.z);
+		const Vector3 extents(bounds.extents.x, bounds.extents.y, bounds.extents.z);
+
+		return AABox(center - extents, center + extents);
+	}
+
+	Bounds SceneOctree::toBounds(const Sphere& sphere)
+	{
+		const Vector3& center = sphere.getCenter();
+		const float radius = sphere.getRadius();
+		const Vector3 extents(radius, radius, radius);
+
+		return Bounds(AABox(center - extents, center + extents), sphere);
+	}
+}}
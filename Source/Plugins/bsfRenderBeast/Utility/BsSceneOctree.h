@@ -0,0 +1,170 @@
+//************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
+//*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
+#pragma once
+
+#include "BsRenderBeastPrerequisites.h"
+#include "Utility/BsOctree.h"
+#include "Math/BsConvexVolume.h"
+#include "Math/BsBounds.h"
+
+namespace bs { namespace ct
+{
+	/** @addtogroup RenderBeast
+	 *  @{
+	 */
+
+	/**
+	 * Keeps track of world bounds of a single type of scene object in an octree, allowing visibility queries to skip
+	 * large parts of the scene without testing every object individually. Elements are identified by their index, which
+	 * is expected to mirror the renderer ID of the object they represent. Like the scene object arrays, removing an
+	 * element moves the last element into the freed index. Bounds are stored in SIMD friendly form so that elements
+	 * which can't be trivially accepted or rejected are tested several at a time.
+	 */
+	class SceneOctree : public INonCopyable
+	{
+		/** Options used for configuring the octree. */
+		struct Options
+		{
+			enum { LoosePadding = 8 };
+			enum { MinElementsPerNode = 8 };
+			enum { MaxElementsPerNode = 16 };
+			enum { MaxDepth = 14 };
+
+			static simd::AABox getBounds(UINT32 elem, void* context);
+			static void setElementId(UINT32 elem, const OctreeElementId& id, void* context);
+		};
+
+		typedef Octree<UINT32, Options> OctreeType;
+	public:
+		SceneOctree();
+
+		/** Registers a new element with the provided bounds. Element index is equal to the number of existing elements. */
+		void add(const Bounds& bounds);
+
+		/** @copydoc add(const Bounds&) */
+		void add(const Sphere& bounds) { add(toBounds(bounds)); }
+
+		/** Updates the bounds of an existing element. */
+		void update(UINT32 idx, const Bounds& bounds);
+
+		/** @copydoc update(UINT32, const Bounds&) */
+		void update(UINT32 idx, const Sphere& bounds) { update(idx, toBounds(bounds)); }
+
+		/** Removes an existing element. If it wasn't the last element, the last element will take over its index. */
+		void remove(UINT32 idx);
+
+		/** Returns the number of elements in the octree. */
+		UINT32 size() const { return mBounds.size(); }
+
+		/**
+		 * Finds all elements that intersect the provided volume and calls @p visitor with the index of each such element.
+		 * Elements in octree nodes fully inside the volume are reported without further testing, while elements in nodes
+		 * intersecting the volume boundary are tested individually against both their bounding sphere and box.
+		 */
+		template<class T>
+		void intersect(const ConvexVolume& volume, T visitor) const;
+
+	private:
+		/** Maximum number of elements from partially visible nodes to test together. */
+		static constexpr UINT32 CANDIDATE_BATCH_SIZE = 256;
+
+		/** Returns the bounds used for placing the element in the octree. */
+		simd::AABox getOctreeBounds(UINT32 idx) const { return sanitizeBounds(mBounds.getBox(idx)); }
+
+		/** Makes sure the provided bounds can be safely inserted in the octree. */
+		static simd::AABox sanitizeBounds(const simd::AABox& bounds);
+
+		/** Converts octree node bounds into a regular axis aligned box. */
+		static AABox toAABox(const simd::AABox& bounds);
+
+		/** Creates bounds enclosing the provided sphere. */
+		static Bounds toBounds(const Sphere& sphere);
+
+		simd::BoundsArray mBounds;
+		Vector<OctreeElementId> mIds;
+		OctreeType mOctree;
+	};
+
+	template<class T>
+	void SceneOctree::intersect(const ConvexVolume& volume, T visitor) const
+	{
+		// Elements of nodes intersecting the volume boundary are gathered and tested in batches
+		UINT32 candidates[CANDIDATE_BATCH_SIZE];
+		UINT32 candidateMask[CANDIDATE_BATCH_SIZE / 32];
+		UINT32 numCandidates = 0;
+
+		auto testCandidates = [&]()
+		{
+			mBounds.intersects(volume, candidates, numCandidates, candidateMask);
+
+			for(UINT32 i = 0; i < numCandidates; i++)
+			{
+				if((candidateMask[i / 32] & (1U << (i % 32))) != 0)
+					visitor(candidates[i]);
+			}
+
+			numCandidates = 0;
+		};
+
+		bool isRoot = true;
+
+		OctreeType::NodeIterator nodeIter(mOctree);
+		while(nodeIter.moveNext())
+		{
+			const OctreeType::HNode& nodeRef = nodeIter.getCurrent();
+			const OctreeType::Node* node = nodeRef.getNode();
+
+			// Elements that don't fit anywhere are stored in the root, so it must always be visited
+			if(!isRoot)
+			{
+				const AABox nodeBounds = toAABox(nodeRef.getBounds().getBounds());
+				if(!volume.intersects(nodeBounds))
+					continue;
+
+				// Entire sub-tree is visible, report all of its elements without further testing
+				if(volume.contains(nodeBounds))
+				{
+					OctreeType::NodeIterator subtreeIter(node, nodeRef.getBounds());
+					while(subtreeIter.moveNext())
+					{
+						const OctreeType::Node* subtreeNode = subtreeIter.getCurrent().getNode();
+
+						OctreeType::ElementIterator elemIter(subtreeNode);
+						while(elemIter.moveNext())
+							visitor(elemIter.getCurrentElem());
+
+						for(UINT32 i = 0; i < 8; i++)
+						{
+							if(subtreeNode->hasChild(i))
+								subtreeIter.pushChild(i);
+						}
+					}
+
+					continue;
+				}
+			}
+
+			isRoot = false;
+
+			OctreeType::ElementIterator elemIter(node);
+			while(elemIter.moveNext())
+			{
+				candidates[numCandidates++] = elemIter.getCurrentElem();
+
+				if(numCandidates == CANDIDATE_BATCH_SIZE)
+					testCandidates();
+			}
+
+			for(UINT32 i = 0; i < 8; i++)
+			{
+				if(node->hasChild(i))
+					nodeIter.pushChild(i);
+			}
+		}
+
+		if(numCandidates > 0)
+			testCandidates();
+	}
+
+	/** @} */
+}}
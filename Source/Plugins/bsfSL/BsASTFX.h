@@ -228,6 +228,8 @@ struct tagParseState
 	int numDefines;
 	int defineCapacity;
 	ConditionalData* conditionalStack;
+
+	void* includeTable;
 };
 
 struct tagOptionInfo
@@ -1,7 +1,7 @@
 //************************************ bs::framework - Copyright 2018 Marko Pintera **************************************//
 //*********** Licensed under the MIT license. See LICENSE.md for full terms. This notice is not to be removed. ***********//
 #include "BsSLPrerequisites.h"
-#include "Material/BsShaderManager.h"
+#include "BsSLFXCompiler.h"
 #include "Material/BsShaderInclude.h"
 
 extern "C" {
@@ -18,10 +18,21 @@ char* includePush(ParseState* state, const char* filename, int line, int column,
 	memcpy(filenameNoQuote, filename + 1, filenameQuotesLen - 2);
 	filenameNoQuote[filenameQuotesLen - 2] = '\0';
 
-	HShaderInclude include = ShaderManager::instance().findInclude(filenameNoQuote);
+	// Parsers running on worker threads may only use includes that were looked up in advance, others get reported back
+	// to the compiler which looks them up and parses again
+	HShaderInclude include;
+	if (state->includeTable != nullptr)
+	{
+		auto includeTable = (BSLFXCompiler::IncludeTable*)state->includeTable;
 
-	if (include != nullptr)
-		include.blockUntilLoaded();
+		auto iterFind = includeTable->resolved->find(filenameNoQuote);
+		if (iterFind != includeTable->resolved->end())
+			include = iterFind->second;
+		else
+			includeTable->unresolved.insert(filenameNoQuote);
+	}
+	else
+		include = BSLFXCompiler::findInclude(filenameNoQuote);
 
 	int filenameLen = (int)strlen(filenameNoQuote);
 	if (include.isLoaded())
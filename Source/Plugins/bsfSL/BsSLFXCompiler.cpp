@@ -18,6 +18,9 @@
 #include "Renderer/BsRendererManager.h"
 #include "FileSystem/BsFileSystem.h"
 #include "FileSystem/BsDataStream.h"
+#include "Importer/BsImporter.h"
+#include "Threading/BsTaskScheduler.h"
+#include "Utility/BsUUID.h"
 
 #define XSC_ENABLE_LANGUAGE_EXT 1
 #include "Xsc/Xsc.h"
@@ -550,7 +553,8 @@ namespace bs
 	};
 
 	String crossCompile(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, bool optionalEntry,
-		UINT32& startBindingSlot, SHADER_DESC* shaderDesc = nullptr, Vector<GpuProgramType>* detectedTypes = nullptr)
+		UINT32& startBindingSlot, Xsc::Reflection::ReflectionData* reflection = nullptr, 
+		Vector<GpuProgramType>* detectedTypes = nullptr)
 	{
 		SPtr<StringStream> input = bs_shared_ptr_new<StringStream>();
 
@@ -626,7 +630,12 @@ namespace bs
 
 		XscLog log;
 		Xsc::Reflection::ReflectionData reflectionData;
-		bool compileSuccess = Xsc::CompileShader(inputDesc, outputDesc, &log, &reflectionData);
+
+		// Safe to call from multiple threads at once. Every call constructs its own compiler, and all the state it works on
+		// (the input and output streams, the log and the reflection data) is created above, per call. The only global 
+		// state Xsc exposes is the console color stack in ConsoleManip, which is only touched by Xsc::StdLog, and isn't
+		// used here.
+		const bool compileSuccess = Xsc::CompileShader(inputDesc, outputDesc, &log, &reflectionData);
 		if (!compileSuccess)
 		{
 			// If enabled, don't fail if entry point isn't found
@@ -695,22 +704,613 @@ namespace bs
 			}
 		}
 
-		if (shaderDesc != nullptr)
-			parseParameters(reflectionData, *shaderDesc);
+		if (reflection != nullptr)
+			*reflection = std::move(reflectionData);
 
 		return output.str();
 	}
 
+	/** Magic number identifying a shader cache entry. */
+	static constexpr UINT32 SHADER_CACHE_MAGIC = 0x43435342;
+
+	/** 
+	 * Version of the shader cache entries. Must be incremented whenever the layout of the entries changes, or whenever
+	 * the compiler starts generating different output for the same input.
+	 */
+	static constexpr UINT32 SHADER_CACHE_VERSION = 2;
+
+	/** Extension used for cache entries containing a single cross compiled program. */
+	static const char* CROSS_COMPILE_CACHE_EXTENSION = ".xsc";
+
+	/** Extension used for cache entries containing reflection information for a single pass. */
+	static const char* REFLECTION_CACHE_EXTENSION = ".xscr";
+
+	/** Extension used for cache entries containing a fully compiled shader variation. */
+	static const char* VARIATION_CACHE_EXTENSION = ".bslv";
+
+	/** 
+	 * Returns the folder compiled variations, reflection information and cross compiled programs are cached in, or an
+	 * empty path if the shader cache is disabled. The shader cache follows the import cache setting and lives in a
+	 * sub-folder of the import cache folder, so only the variations that actually changed get recompiled when a shader
+	 * or one of its includes is modified.
+	 */
+	Path getShaderCacheDirectory()
+	{
+		if (!Importer::isStarted())
+			return Path::BLANK;
+
+		Path cacheDirectory = gImporter().getCacheDirectory();
+		if (cacheDirectory.isEmpty())
+			return Path::BLANK;
+
+		cacheDirectory.append("Shaders/");
+		return cacheDirectory;
+	}
+
+	/** Helper for writing primitive values and strings into a shader cache entry. */
+	class ShaderCacheWriter
+	{
+	public:
+		ShaderCacheWriter(DataStream& stream)
+			:mStream(stream)
+		{ }
+
+		/** Writes a value that can be copied byte by byte. */
+		template<class T>
+		void write(const T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written directly.");
+			mStream.write(&value, sizeof(T));
+		}
+
+		/** Writes a string, prefixed by its length. */
+		template<class A>
+		void write(const std::basic_string<char, std::char_traits<char>, A>& value)
+		{
+			write((UINT32)value.size());
+			mStream.write(value.data(), value.size());
+		}
+
+	private:
+		DataStream& mStream;
+	};
+
+	/** 
+	 * Helper for reading primitive values and strings from a shader cache entry. All methods return false if the entry
+	 * is truncated or corrupt.
+	 */
+	class ShaderCacheReader
+	{
+	public:
+		ShaderCacheReader(DataStream& stream)
+			:mStream(stream)
+		{ }
+
+		/** Reads a value that can be copied byte by byte. */
+		template<class T>
+		bool read(T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read directly.");
+			return mStream.read(&value, sizeof(T)) == sizeof(T);
+		}
+
+		/** Reads a string, prefixed by its length. */
+		template<class A>
+		bool read(std::basic_string<char, std::char_traits<char>, A>& value)
+		{
+			UINT32 size;
+			if (!readCount(size))
+				return false;
+
+			value.resize(size);
+			return size == 0 || mStream.read(&value[0], size) == size;
+		}
+
+		/** 
+		 * Reads a number of elements that follow. Fails if there isn't enough data left in the stream for that many
+		 * elements, so corrupt counts never cause huge allocations.
+		 */
+		bool readCount(UINT32& count)
+		{
+			return read(count) && count <= mStream.size() - mStream.tell();
+		}
+
+		/** Checks that the whole entry was read. */
+		bool isAtEnd() const { return mStream.tell() == mStream.size(); }
+
+	private:
+		DataStream& mStream;
+	};
+
+	/** 
+	 * Opens an entry in the shader cache and validates its header. Returns null if the entry doesn't exist or was written
+	 * by a different version of the compiler.
+	 */
+	SPtr<DataStream> openShaderCacheEntry(const Path& cacheDirectory, const String& key, const char* extension)
+	{
+		Path entryPath = cacheDirectory;
+		entryPath.append(key + extension);
+
+		if (!FileSystem::isFile(entryPath))
+			return nullptr;
+
+		SPtr<DataStream> stream = FileSystem::openFile(entryPath);
+		if (stream == nullptr)
+			return nullptr;
+
+		UINT32 header[2];
+		if (stream->read(header, sizeof(header)) != sizeof(header) || header[0] != SHADER_CACHE_MAGIC)
+		{
+			LOGWRN("Ignoring an invalid shader cache entry: " + entryPath.toString());
+			return nullptr;
+		}
+
+		// Entries written by a different version are expected after an upgrade, they just get overwritten
+		if (header[1] != SHADER_CACHE_VERSION)
+			return nullptr;
+
+		return stream;
+	}
+
+	/** 
+	 * Writes an entry into the shader cache. Entry contents, following the header, are written by the provided callback.
+	 * If the callback returns false the entry is discarded.
+	 */
+	void writeShaderCacheEntry(const Path& cacheDirectory, const String& key, const char* extension,
+		const std::function<bool(ShaderCacheWriter&)>& writeContents)
+	{
+		if (!FileSystem::exists(cacheDirectory))
+			FileSystem::createDir(cacheDirectory);
+
+		Path entryPath = cacheDirectory;
+		entryPath.append(key + extension);
+
+		// Same as with the import cache, write to a unique temporary file first so multiple variations, or multiple
+		// processes, compiling the same program never see a partially written entry
+		Path tempPath = cacheDirectory;
+		tempPath.append(key + "." + UUIDGenerator::generateRandom().toString() + ".tmp");
+
+		SPtr<DataStream> stream = FileSystem::createAndOpenFile(tempPath);
+		if (stream == nullptr)
+			return;
+
+		ShaderCacheWriter writer(*stream);
+		writer.write(SHADER_CACHE_MAGIC);
+		writer.write(SHADER_CACHE_VERSION);
+		const bool valid = writeContents(writer);
+
+		stream->close();
+
+		if (valid)
+			FileSystem::move(tempPath, entryPath);
+		else
+			FileSystem::remove(tempPath);
+	}
+
+	/** 
+	 * Writes reflection information into a shader cache entry. Only the information used by parseParameters() is
+	 * written.
+	 */
+	void writeReflection(ShaderCacheWriter& writer, const Xsc::Reflection::ReflectionData& reflection)
+	{
+		writer.write((UINT32)reflection.uniforms.size());
+		for (auto& entry : reflection.uniforms)
+		{
+			writer.write(entry.ident);
+			writer.write(entry.type);
+			writer.write(entry.baseType);
+			writer.write(entry.uniformBlock);
+			writer.write(entry.defaultValue);
+			writer.write(entry.flags);
+			writer.write(entry.spriteUVRef);
+		}
+
+		writer.write((UINT32)reflection.defaultValues.size());
+		for (auto& entry : reflection.defaultValues)
+			writer.write(entry);
+
+		writer.write((UINT32)reflection.constantBuffers.size());
+		for (auto& entry : reflection.constantBuffers)
+		{
+			writer.write(entry.ident);
+			writer.write(entry.location);
+		}
+
+		writer.write((UINT32)reflection.samplerStates.size());
+		for (auto& entry : reflection.samplerStates)
+		{
+			const Xsc::Reflection::SamplerState& state = entry.second;
+
+			writer.write(entry.first);
+			writer.write(state.filter);
+			writer.write(state.addressU);
+			writer.write(state.addressV);
+			writer.write(state.addressW);
+			writer.write(state.mipLODBias);
+			writer.write(state.maxAnisotropy);
+			writer.write(state.comparisonFunc);
+			writer.write(state.borderColor);
+			writer.write(state.minLOD);
+			writer.write(state.maxLOD);
+			writer.write(state.isNonDefault);
+			writer.write(state.alias);
+		}
+	}
+
+	/** Reads reflection information written by writeReflection(). Returns false if the entry is corrupt. */
+	bool readReflection(ShaderCacheReader& reader, Xsc::Reflection::ReflectionData& reflection)
+	{
+		UINT32 numUniforms;
+		if (!reader.readCount(numUniforms))
+			return false;
+
+		reflection.uniforms.resize(numUniforms);
+		for (auto& entry : reflection.uniforms)
+		{
+			if (!reader.read(entry.ident) || !reader.read(entry.type) || !reader.read(entry.baseType) ||
+				!reader.read(entry.uniformBlock) || !reader.read(entry.defaultValue) || !reader.read(entry.flags) ||
+				!reader.read(entry.spriteUVRef))
+				return false;
+		}
+
+		UINT32 numDefaultValues;
+		if (!reader.readCount(numDefaultValues))
+			return false;
+
+		reflection.defaultValues.resize(numDefaultValues);
+		for (auto& entry : reflection.defaultValues)
+		{
+			if (!reader.read(entry))
+				return false;
+		}
+
+		UINT32 numConstantBuffers;
+		if (!reader.readCount(numConstantBuffers))
+			return false;
+
+		reflection.constantBuffers.resize(numConstantBuffers);
+		for (auto& entry : reflection.constantBuffers)
+		{
+			if (!reader.read(entry.ident) || !reader.read(entry.location))
+				return false;
+		}
+
+		UINT32 numSamplerStates;
+		if (!reader.readCount(numSamplerStates))
+			return false;
+
+		for (UINT32 i = 0; i < numSamplerStates; i++)
+		{
+			std::string ident;
+			Xsc::Reflection::SamplerState state;
+
+			if (!reader.read(ident) || !reader.read(state.filter) || !reader.read(state.addressU) ||
+				!reader.read(state.addressV) || !reader.read(state.addressW) || !reader.read(state.mipLODBias) ||
+				!reader.read(state.maxAnisotropy) || !reader.read(state.comparisonFunc) ||
+				!reader.read(state.borderColor) || !reader.read(state.minLOD) || !reader.read(state.maxLOD) ||
+				!reader.read(state.isNonDefault) || !reader.read(state.alias))
+				return false;
+
+			reflection.samplerStates[ident] = state;
+		}
+
+		return true;
+	}
+
 	// Convert HLSL code to GLSL
 	String HLSLtoGLSL(const String& hlsl, GpuProgramType type, CrossCompileOutput outputType, UINT32& startBindingSlot)
 	{
-		return crossCompile(hlsl, type, outputType, false, startBindingSlot);
+		const Path cacheDirectory = getShaderCacheDirectory();
+		if (cacheDirectory.isEmpty())
+			return crossCompile(hlsl, type, outputType, false, startBindingSlot);
+
+		// Code has already been pre-processed with the variation defines at this point, so the code hash covers them
+		StringStream keyStream;
+		keyStream << md5(hlsl) << ":" << (UINT32)type << ":" << (UINT32)outputType << ":" << startBindingSlot << ":" 
+			<< XSC_VERSION_STRING;
+
+		const String key = md5(keyStream.str());
+
+		String output;
+		SPtr<DataStream> entry = openShaderCacheEntry(cacheDirectory, key, CROSS_COMPILE_CACHE_EXTENSION);
+		if (entry != nullptr)
+		{
+			ShaderCacheReader reader(*entry);
+
+			UINT32 cachedBindingSlot;
+			if (reader.read(cachedBindingSlot) && reader.read(output) && reader.isAtEnd())
+			{
+				startBindingSlot = cachedBindingSlot;
+				return output;
+			}
+
+			LOGWRN("Ignoring an invalid shader cache entry: " + key + CROSS_COMPILE_CACHE_EXTENSION);
+		}
+
+		output = crossCompile(hlsl, type, outputType, false, startBindingSlot);
+
+		// Failed compilations aren't cached so their errors get reported every time
+		if (!output.empty())
+		{
+			writeShaderCacheEntry(cacheDirectory, key, CROSS_COMPILE_CACHE_EXTENSION, [&](ShaderCacheWriter& writer)
+			{
+				writer.write(startBindingSlot);
+				writer.write(output);
+
+				return true;
+			});
+		}
+
+		return output;
 	}
 
-	void reflectHLSL(const String& hlsl, SHADER_DESC& shaderDesc, Vector<GpuProgramType>& entryPoints)
+	void reflectHLSL(const String& hlsl, Xsc::Reflection::ReflectionData& reflection, 
+		Vector<GpuProgramType>& entryPoints)
 	{
+		const Path cacheDirectory = getShaderCacheDirectory();
+
+		// Reflection doesn't depend on the program type or the output language, so the code is the only input
+		String key;
+		if (!cacheDirectory.isEmpty())
+		{
+			key = md5(md5(hlsl) + ":reflection:" + XSC_VERSION_STRING);
+
+			SPtr<DataStream> entry = openShaderCacheEntry(cacheDirectory, key, REFLECTION_CACHE_EXTENSION);
+			if (entry != nullptr)
+			{
+				ShaderCacheReader reader(*entry);
+
+				bool valid = true;
+				UINT32 numEntryPoints;
+				if (reader.readCount(numEntryPoints))
+				{
+					entryPoints.resize(numEntryPoints);
+					for (auto& entryPoint : entryPoints)
+						valid &= reader.read(entryPoint);
+				}
+				else
+					valid = false;
+
+				if (valid && readReflection(reader, reflection) && reader.isAtEnd())
+					return;
+
+				LOGWRN("Ignoring an invalid shader cache entry: " + key + REFLECTION_CACHE_EXTENSION);
+
+				reflection = Xsc::Reflection::ReflectionData();
+				entryPoints.clear();
+			}
+		}
+
 		UINT32 dummy = 0;
-		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &shaderDesc, &entryPoints);
+		crossCompile(hlsl, GPT_VERTEX_PROGRAM, CrossCompileOutput::GLSL45, true, dummy, &reflection, &entryPoints);
+
+		// No entry points means the compilation failed, don't cache those so the errors get reported every time
+		if (!key.empty() && !entryPoints.empty())
+		{
+			writeShaderCacheEntry(cacheDirectory, key, REFLECTION_CACHE_EXTENSION, [&](ShaderCacheWriter& writer)
+			{
+				writer.write((UINT32)entryPoints.size());
+				for (auto& entryPoint : entryPoints)
+					writer.write(entryPoint);
+
+				writeReflection(writer, reflection);
+
+				return true;
+			});
+		}
+	}
+
+	/** 
+	 * Returns a hash of the current contents of the include with the provided name, or an empty string if the include 
+	 * cannot be found. Hashes are stored in @p hashes, as most variations share the same includes.
+	 */
+	String getIncludeHash(const String& name, UnorderedMap<String, String>& hashes)
+	{
+		auto iterFind = hashes.find(name);
+		if (iterFind != hashes.end())
+			return iterFind->second;
+
+		String hash;
+		HShaderInclude include = BSLFXCompiler::findInclude(name);
+		if (include.isLoaded())
+			hash = md5(include->getString());
+
+		hashes[name] = hash;
+		return hash;
+	}
+
+	struct BSLFXCompiler::CompiledVariation
+	{
+		String shaderName;
+		ShaderVariation variation;
+		BSLFXCompileResult result;
+
+		/** Shader data containing the generated code, one entry per shader and shading language. */
+		Vector<ShaderData> shaders;
+
+		/** Reflection information for every pass, used for registering the shader parameters. */
+		Vector<Xsc::Reflection::ReflectionData> reflection;
+
+		UnorderedSet<String> includes;
+
+		/** Global defines combined with the variation defines. */
+		UnorderedMap<String, String> defines;
+
+		/** Key of the shader cache entry for this variation. Empty if the shader cache is disabled. */
+		String cacheKey;
+
+		/** True if the variation was read from the shader cache and doesn't need to be compiled. */
+		bool isCached = false;
+
+		/** 
+		 * Includes the variation needs that weren't looked up before it was parsed. If not empty the variation needs to be
+		 * parsed again once the includes are looked up.
+		 */
+		UnorderedSet<String> unresolvedIncludes;
+
+		/** 
+		 * Writes the compiled code, reflection information and the includes the variation was compiled with into a shader
+		 * cache entry. Returns false if an include cannot be found, in which case the entry should be discarded.
+		 */
+		bool write(ShaderCacheWriter& writer, UnorderedMap<String, String>& includeHashes) const;
+
+		/** 
+		 * Reads the variation from a shader cache entry. Returns false if the entry is corrupt, or if any of the includes
+		 * changed since the entry was written.
+		 */
+		bool read(ShaderCacheReader& reader, UnorderedMap<String, String>& includeHashes);
+	};
+
+	bool BSLFXCompiler::CompiledVariation::write(ShaderCacheWriter& writer, 
+		UnorderedMap<String, String>& includeHashes) const
+	{
+		static_assert(std::is_trivially_copyable<BLEND_STATE_DESC>::value &&
+			std::is_trivially_copyable<RASTERIZER_STATE_DESC>::value &&
+			std::is_trivially_copyable<DEPTH_STENCIL_STATE_DESC>::value,
+			"Pipeline state descriptors are written directly into the shader cache.");
+
+		// Hash all includes first, so nothing gets written if one is missing
+		Vector<std::pair<String, String>> includeEntries;
+		for (auto& include : includes)
+		{
+			String hash = getIncludeHash(include, includeHashes);
+			if (hash.empty())
+				return false;
+
+			includeEntries.push_back(std::make_pair(include, hash));
+		}
+
+		writer.write((UINT32)includeEntries.size());
+		for (auto& entry : includeEntries)
+		{
+			writer.write(entry.first);
+			writer.write(entry.second);
+		}
+
+		writer.write((UINT32)reflection.size());
+		for (auto& entry : reflection)
+			writeReflection(writer, entry);
+
+		writer.write((UINT32)shaders.size());
+		for (auto& shader : shaders)
+		{
+			const ShaderMetaData& metaData = shader.metaData;
+
+			writer.write(metaData.name);
+			writer.write(metaData.isMixin);
+			writer.write(metaData.language);
+			writer.write(metaData.featureSet);
+
+			writer.write((UINT32)metaData.tags.size());
+			for (auto& tag : metaData.tags)
+				writer.write(String(tag.c_str()));
+
+			writer.write((UINT32)shader.passes.size());
+			for (auto& pass : shader.passes)
+			{
+				writer.write(pass.blendDesc);
+				writer.write(pass.rasterizerDesc);
+				writer.write(pass.depthStencilDesc);
+				writer.write(pass.stencilRefValue);
+				writer.write(pass.seqIdx);
+				writer.write(pass.blendIsDefault);
+				writer.write(pass.rasterizerIsDefault);
+				writer.write(pass.depthStencilIsDefault);
+				writer.write(pass.vertexCode);
+				writer.write(pass.fragmentCode);
+				writer.write(pass.geometryCode);
+				writer.write(pass.hullCode);
+				writer.write(pass.domainCode);
+				writer.write(pass.computeCode);
+			}
+		}
+
+		return true;
+	}
+
+	bool BSLFXCompiler::CompiledVariation::read(ShaderCacheReader& reader, 
+		UnorderedMap<String, String>& includeHashes)
+	{
+		UINT32 numIncludes;
+		if (!reader.readCount(numIncludes))
+			return false;
+
+		for (UINT32 i = 0; i < numIncludes; i++)
+		{
+			String include;
+			String hash;
+			if (!reader.read(include) || !reader.read(hash))
+				return false;
+
+			// Include was modified or removed since the entry was written
+			if (getIncludeHash(include, includeHashes) != hash)
+				return false;
+
+			includes.insert(include);
+		}
+
+		UINT32 numReflection;
+		if (!reader.readCount(numReflection))
+			return false;
+
+		reflection.resize(numReflection);
+		for (auto& entry : reflection)
+		{
+			if (!readReflection(reader, entry))
+				return false;
+		}
+
+		UINT32 numShaders;
+		if (!reader.readCount(numShaders))
+			return false;
+
+		shaders.resize(numShaders);
+		for (auto& shader : shaders)
+		{
+			ShaderMetaData& metaData = shader.metaData;
+
+			UINT32 numTags;
+			if (!reader.read(metaData.name) || !reader.read(metaData.isMixin) || !reader.read(metaData.language) ||
+				!reader.read(metaData.featureSet) || !reader.readCount(numTags))
+				return false;
+
+			for (UINT32 i = 0; i < numTags; i++)
+			{
+				String tag;
+				if (!reader.read(tag))
+					return false;
+
+				metaData.tags.push_back(tag);
+			}
+
+			UINT32 numPasses;
+			if (!reader.readCount(numPasses))
+				return false;
+
+			shader.passes.resize(numPasses);
+			for (auto& pass : shader.passes)
+			{
+				if (!reader.read(pass.blendDesc) || !reader.read(pass.rasterizerDesc) || 
+					!reader.read(pass.depthStencilDesc) || !reader.read(pass.stencilRefValue) ||
+					!reader.read(pass.seqIdx) || !reader.read(pass.blendIsDefault) || 
+					!reader.read(pass.rasterizerIsDefault) || !reader.read(pass.depthStencilIsDefault) ||
+					!reader.read(pass.vertexCode) || !reader.read(pass.fragmentCode) || 
+					!reader.read(pass.geometryCode) || !reader.read(pass.hullCode) ||
+					!reader.read(pass.domainCode) || !reader.read(pass.computeCode))
+					return false;
+			}
+		}
+
+		return reader.isAtEnd();
+	}
+
+	HShaderInclude BSLFXCompiler::findInclude(const String& name)
+	{
+		HShaderInclude include = ShaderManager::instance().findInclude(name);
+		if (include != nullptr)
+			include.blockUntilLoaded();
+
+		return include;
 	}
 
 	BSLFXCompileResult BSLFXCompiler::compile(const String& name, const String& source,
@@ -1663,12 +2263,12 @@ namespace bs
 	BSLFXCompileResult BSLFXCompiler::compileTechniques(
 		const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData, const String& source,
 		const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, SHADER_DESC& shaderDesc, 
-		Vector<String>& includes)
+		Vector<String>& includes, UnorderedMap<String, HShaderInclude>& resolvedIncludes)
 	{
 		BSLFXCompileResult output;
 
-		// Build a list of different variations and re-parse the source using the relevant defines
-		UnorderedSet<String> includeSet;
+		// Build a list of different variations of all shaders
+		Vector<CompiledVariation> compiledVariations;
 		for (auto& entry : shaderMetaData)
 		{
 			const ShaderMetaData& metaData = entry.second;
@@ -1751,40 +2351,158 @@ namespace bs
 				}
 			}
 
-			// For every variation, re-parse the file with relevant defines
 			for (auto& variation : variations)
 			{
-				UnorderedMap<String, String> globalDefines = defines;
-				UnorderedMap<String, String> variationDefines = variation.getDefines().getAll();
+				compiledVariations.push_back(CompiledVariation());
+				compiledVariations.back().shaderName = metaData.name;
+				compiledVariations.back().variation = variation;
+			}
+		}
+
+		// Look for variations compiled during a previous compilation in the shader cache. The key covers everything the
+		// variation is compiled from except the includes, whose contents are checked against the entry instead. This is
+		// done before compilation starts, on this thread, so that include lookups don't need to happen in parallel.
+		const Path cacheDirectory = getShaderCacheDirectory();
+		const String sourceHash = cacheDirectory.isEmpty() ? "" : md5(source);
+		UnorderedMap<String, String> includeHashes;
+
+		for (auto& compiledVariation : compiledVariations)
+		{
+			compiledVariation.defines = defines;
+
+			UnorderedMap<String, String> variationDefines = compiledVariation.variation.getDefines().getAll();
+			for (auto& define : variationDefines)
+				compiledVariation.defines[define.first] = define.second;
+
+			if (cacheDirectory.isEmpty())
+				continue;
+
+			StringStream keyStream;
+			keyStream << sourceHash << ":" << compiledVariation.shaderName << ":" << (UINT32)languages << ":";
+
+			Map<String, String> sortedDefines(compiledVariation.defines.begin(), compiledVariation.defines.end());
+			for (auto& define : sortedDefines)
+				keyStream << define.first << "=" << define.second << ";";
+
+			keyStream << ":" << SHADER_CACHE_VERSION << ":" << XSC_VERSION_STRING;
+			compiledVariation.cacheKey = md5(keyStream.str());
+
+			SPtr<DataStream> entry = openShaderCacheEntry(cacheDirectory, compiledVariation.cacheKey, 
+				VARIATION_CACHE_EXTENSION);
+
+			if (entry == nullptr)
+				continue;
+
+			ShaderCacheReader reader(*entry);
+			compiledVariation.isCached = compiledVariation.read(reader, includeHashes);
+
+			// Entry is out of date, discard anything that was read before that was detected
+			if (!compiledVariation.isCached)
+			{
+				compiledVariation.shaders.clear();
+				compiledVariation.reflection.clear();
+				compiledVariation.includes.clear();
+			}
+		}
 
-				for (auto& define : variationDefines)
-					globalDefines[define.first] = define.second;
+		// For every variation that wasn't cached, re-parse the file with relevant defines and generate the program code.
+		// Variations are independent of each other so this is done in parallel, while the GPU objects are created 
+		// afterwards, in order.
+		Vector<UINT32> pendingVariations;
+		for (UINT32 i = 0; i < (UINT32)compiledVariations.size(); i++)
+		{
+			if (!compiledVariations[i].isCached)
+				pendingVariations.push_back(i);
+		}
+
+		auto compileRange = [&](UINT32 begin, UINT32 end)
+		{
+			for (UINT32 i = begin; i < end; i++)
+			{
+				CompiledVariation& compiledVariation = compiledVariations[pendingVariations[i]];
+
+				IncludeTable includeTable;
+				includeTable.resolved = &resolvedIncludes;
 
 				ParseState* variationParseState = parseStateCreate();
-				output = parseFX(variationParseState, source.c_str(), globalDefines);
+				variationParseState->includeTable = &includeTable;
 
-				if (!output.errorMessage.empty())
+				compiledVariation.result = parseFX(variationParseState, source.c_str(), compiledVariation.defines);
+				compiledVariation.unresolvedIncludes = std::move(includeTable.unresolved);
+
+				if (!compiledVariation.result.errorMessage.empty())
+				{
 					parseStateDelete(variationParseState);
-				else
+					continue;
+				}
+
+				Vector<String> codeBlocks;
+				RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
+				while (rawCode != nullptr)
 				{
-					Vector<String> codeBlocks;
-					RawCode* rawCode = variationParseState->rawCodeBlock[RCT_CodeBlock];
-					while (rawCode != nullptr)
-					{
-						while ((INT32)codeBlocks.size() <= rawCode->index)
-							codeBlocks.push_back(String());
+					while ((INT32)codeBlocks.size() <= rawCode->index)
+						codeBlocks.push_back(String());
 
-						codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
-						rawCode = rawCode->next;
-					}
+					codeBlocks[rawCode->index] = String(rawCode->code, rawCode->size);
+					rawCode = rawCode->next;
+				}
+
+				compiledVariation.result = compileVariation(variationParseState, compiledVariation.shaderName, 
+					codeBlocks, languages, compiledVariation);
+			}
+		};
+
+		// Includes are only looked up on this thread. Variations that ran into an include that wasn't looked up yet (e.g.
+		// one that's only included under a variation define) get parsed again after it has been. Every pass looks up at
+		// least one new include, so this terminates.
+		while (!pendingVariations.empty())
+		{
+			const auto numVariations = (UINT32)pendingVariations.size();
+			if (numVariations > 1 && TaskScheduler::isStarted())
+				TaskScheduler::instance().parallelFor(0, numVariations, 1, compileRange);
+			else
+				compileRange(0, numVariations);
 
-					output = compileTechniques(variationParseState, entry.second.name, codeBlocks, variation, languages,
-						includeSet, shaderDesc);
+			Vector<UINT32> unresolvedVariations;
+			for (auto& index : pendingVariations)
+			{
+				CompiledVariation& compiledVariation = compiledVariations[index];
+				if (compiledVariation.unresolvedIncludes.empty())
+					continue;
 
-					if (!output.errorMessage.empty())
-						return output;
+				for (auto& include : compiledVariation.unresolvedIncludes)
+				{
+					if (resolvedIncludes.find(include) == resolvedIncludes.end())
+						resolvedIncludes[include] = findInclude(include);
 				}
+
+				compiledVariation.unresolvedIncludes.clear();
+				compiledVariation.result = BSLFXCompileResult();
+				unresolvedVariations.push_back(index);
+			}
+
+			pendingVariations = std::move(unresolvedVariations);
+		}
+
+		UnorderedSet<String> includeSet;
+		for (auto& entry : compiledVariations)
+		{
+			if (!entry.result.errorMessage.empty())
+				return entry.result;
+
+			if (!entry.isCached && !entry.cacheKey.empty())
+			{
+				writeShaderCacheEntry(cacheDirectory, entry.cacheKey, VARIATION_CACHE_EXTENSION, 
+					[&](ShaderCacheWriter& writer)
+				{
+					return entry.write(writer, includeHashes);
+				});
 			}
+
+			for (auto& include : entry.includes)
+				includeSet.insert(include);
+
+			createTechniques(entry, shaderDesc);
 		}
 
 		// Generate a shader from the parsed techniques
@@ -1885,6 +2603,19 @@ namespace bs
 			rawCode = rawCode->next;
 		}
 
+		// Includes found by this parse were already looked up, remember them so the variations can be parsed without
+		// looking them up again
+		UnorderedMap<String, HShaderInclude> resolvedIncludes;
+		IncludeLink* includeLink = parseState->includes;
+		while (includeLink != nullptr)
+		{
+			String includeName = includeLink->data->filename;
+			if (resolvedIncludes.find(includeName) == resolvedIncludes.end())
+				resolvedIncludes[includeName] = findInclude(includeName);
+
+			includeLink = includeLink->next;
+		}
+
 		parseStateDelete(parseState);
 
 		output = populateVariations(shaderMetaData);
@@ -1892,7 +2623,7 @@ namespace bs
 		if (!output.errorMessage.empty())
 			return output;
 
-		output = compileTechniques(shaderMetaData, source, defines, languages, shaderDesc, includes);
+		output = compileTechniques(shaderMetaData, source, defines, languages, shaderDesc, includes, resolvedIncludes);
 
 		if (!output.errorMessage.empty())
 			return output;
@@ -1949,18 +2680,17 @@ namespace bs
 		return output;
 	}
 
-	BSLFXCompileResult BSLFXCompiler::compileTechniques(ParseState* parseState, const String& name,
-		const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages,
-		UnorderedSet<String>& includes, SHADER_DESC& shaderDesc)
+	BSLFXCompileResult BSLFXCompiler::compileVariation(ParseState* parseState, const String& name,
+		const Vector<String>& codeBlocks, ShadingLanguageFlags languages, CompiledVariation& output)
 	{
-		BSLFXCompileResult output;
+		BSLFXCompileResult result;
 
 		if (parseState->rootNode == nullptr || parseState->rootNode->type != NT_Root)
 		{
 			parseStateDelete(parseState);
 
-			output.errorMessage = "Root is null or not a shader.";
-			return output;
+			result.errorMessage = "Root is null or not a shader.";
+			return result;
 		}
 
 		Vector<pair<ASTFXNode*, ShaderData>> shaderData;
@@ -2037,7 +2767,7 @@ namespace bs
 				}
 				else
 				{
-					output.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
+					result.errorMessage = "Mixin \"" + includes + "\" cannot be found.";
 					return false;
 				}
 			}
@@ -2057,7 +2787,7 @@ namespace bs
 			{
 				parseStateDelete(parseState);
 				bs_stack_free(mixinWasParsed);
-				return output;
+				return result;
 			}
 
 			parseShader(entry.first, codeBlocks, entry.second);
@@ -2068,12 +2798,7 @@ namespace bs
 		IncludeLink* includeLink = parseState->includes;
 		while(includeLink != nullptr)
 		{
-			String includeFilename = includeLink->data->filename;
-
-			auto iterFind = std::find(includes.begin(), includes.end(), includeFilename);
-			if (iterFind == includes.end())
-				includes.insert(includeFilename);
-
+			output.includes.insert(includeLink->data->filename);
 			includeLink = includeLink->next;
 		}
 
@@ -2081,7 +2806,6 @@ namespace bs
 
 		// Parse extended HLSL code and generate per-program code, also convert to GLSL/VKSL
 		const auto end = (UINT32)shaderData.size();
-		Vector<pair<ASTFXNode*, ShaderData>> outputShaderData;
 		for(UINT32 i = 0; i < end; i++)
 		{
 			const ShaderMetaData& metaData = shaderData[i].second.metaData;
@@ -2116,7 +2840,8 @@ namespace bs
 				// type. If performance is ever important here it could be good to update XShaderCompiler so it can
 				// somehow save the AST and then re-use it for multiple actions.
 				Vector<GpuProgramType> types;
-				reflectHLSL(passData.code, shaderDesc, types);
+				output.reflection.push_back(Xsc::Reflection::ReflectionData());
+				reflectHLSL(passData.code, output.reflection.back(), types);
 
 				if(languages.isSet(ShadingLanguageFlag::GLSL))
 				{
@@ -2244,19 +2969,27 @@ namespace bs
 				}
 			}
 
-			outputShaderData.push_back(std::make_pair(nullptr, hlslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, glslShaderData));
-			outputShaderData.push_back(std::make_pair(nullptr, vkslShaderData));
+			output.shaders.push_back(hlslShaderData);
+			output.shaders.push_back(glslShaderData);
+			output.shaders.push_back(vkslShaderData);
 		}
 
-		for(auto& entry : outputShaderData)
+		return result;
+	}
+
+	void BSLFXCompiler::createTechniques(const CompiledVariation& variation, SHADER_DESC& shaderDesc)
+	{
+		for (auto& entry : variation.reflection)
+			parseParameters(entry, shaderDesc);
+
+		for(auto& entry : variation.shaders)
 		{
-			const ShaderMetaData& metaData = entry.second.metaData;
+			const ShaderMetaData& metaData = entry.metaData;
 			if (metaData.isMixin)
 				continue;
 
 			Map<UINT32, SPtr<Pass>, std::greater<UINT32>> passes;
-			for (auto& passData : entry.second.passes)
+			for (auto& passData : entry.passes)
 			{
 				PASS_DESC passDesc;
 				passDesc.blendStateDesc = passData.blendDesc;
@@ -2325,12 +3058,11 @@ namespace bs
 
 			if (!orderedPasses.empty())
 			{
-				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation, orderedPasses);
+				SPtr<Technique> technique = Technique::create(metaData.language, metaData.tags, variation.variation, 
+					orderedPasses);
 				shaderDesc.techniques.push_back(technique);
 			}
 		}
-
-		return output;
 	}
 
 	String BSLFXCompiler::removeQuotes(const char* input)
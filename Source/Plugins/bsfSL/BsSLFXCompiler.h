@@ -90,6 +90,9 @@ namespace bs
 			Vector<PassData> passes;
 		};
 
+		/** Output of compileVariation(). */
+		struct CompiledVariation;
+
 		/** Temporary data describing a sub-shader during parsing. */
 		struct SubShaderData
 		{
@@ -102,6 +105,23 @@ namespace bs
 		static BSLFXCompileResult compile(const String& name, const String& source, 
 			const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages);
 
+		/** 
+		 * Includes looked up on the thread that started the compilation, for use by variations parsed on worker threads.
+		 * Lookups go through the importer and the resource manager, which may run other tasks while waiting, so they are
+		 * never performed from within a variation compile.
+		 */
+		struct IncludeTable
+		{
+			/** Includes that were looked up, mapped by name. Includes that weren't found map to an empty handle. */
+			const UnorderedMap<String, HShaderInclude>* resolved = nullptr;
+
+			/** Includes requested by the parser that weren't looked up yet. Filled in during parsing. */
+			UnorderedSet<String> unresolved;
+		};
+
+		/** Finds the include with the provided name and waits until it is loaded. */
+		static HShaderInclude findInclude(const String& name);
+
 	private:
 		/** Converts the provided source into an abstract syntax tree using the lexer & parser for BSL FX syntax. */
 		static BSLFXCompileResult parseFX(ParseState* parseState, const char* source, 
@@ -254,7 +274,7 @@ namespace bs
 
 		/**
 		 * Uses the provided list of shaders/mixins to generate a list of techniques. A technique is generated for
-		 * every variation and render backend.
+		 * every variation and render backend. Variations are compiled in parallel if the task scheduler is running.
 		 * 
 		 * @param[in]	shaderMetaData		A list of mixins and shaders. Shaders should contain a list of variations to
 		 *									generate (usually populated via a previous call to populateVariations()).
@@ -267,31 +287,39 @@ namespace bs
 		 * @param[out]	shaderDesc			Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *									registered with.
 		 * @param[out]	includes			A list of all include files included by the BSL source.
+		 * @param[in]	resolvedIncludes	Includes already looked up while parsing @p source. Includes only referenced by
+		 *									some variations are looked up and added as variations request them.
 		 * @return							A result object containing an error message if not successful.
 		 */
 		static BSLFXCompileResult compileTechniques(const Vector<std::pair<ASTFXNode*, ShaderMetaData>>& shaderMetaData,
 			const String& source, const UnorderedMap<String, String>& defines, ShadingLanguageFlags languages, 
-			SHADER_DESC& shaderDesc, Vector<String>& includes);
+			SHADER_DESC& shaderDesc, Vector<String>& includes, UnorderedMap<String, HShaderInclude>& resolvedIncludes);
 
 		/**
-		 * Generates a set of techniques for a single variation. Uses AST parse state as input, which must be created using
-		 * the defines of the relevant variation.
+		 * Generates per-program code for a single variation, for all the requested shading languages. Uses AST parse
+		 * state as input, which must be created using the defines of the relevant variation. Doesn't create any GPU
+		 * objects so it is safe to call from any thread.
 		 *
-		 * @param[in, out]	parseState	Parser state object that has previously been initialized with the AST using 
-		 *								parseFX().
+		 * @param[in]	parseState		Parser state object that has previously been initialized with the AST using 
+		 *								parseFX(). The method takes ownership of the object and will delete it.
 		 * @param[in]	name			Name of the shader to generate the variation for.
 		 * @param[in]	codeBlocks		Blocks containing GPU program source code that are referenced by the AST.
-		 * @param[in]	variation		Shader variation the AST was parsed with.
-		 * @param[in]	languages		Shading languages to generate techniques for. Each shader variation will be
-		 *								compiled into a separate technique for each of the provided languages.
-		 * @param[out]	includes		Set to append newly found includes to.
+		 * @param[in]	languages		Shading languages to generate code for.
+		 * @param[out]	output			Object to receive the generated code, reflected parameters and found includes.
+		 * @return						A result object containing an error message if not successful.
+		 */
+		static BSLFXCompileResult compileVariation(ParseState* parseState, const String& name, 
+			const Vector<String>& codeBlocks, ShadingLanguageFlags languages, CompiledVariation& output);
+
+		/**
+		 * Creates a set of techniques for a variation previously compiled through compileVariation(). Must be called
+		 * for variations in a consistent order, as parameters registered first take precedence.
+		 *
+		 * @param[in]	variation		Compiled variation to create the techniques from.
 		 * @param[out]	shaderDesc		Shader descriptor that resulting techniques, and non-internal parameters will be
 		 *								registered with.
-		 * @return						A result object containing an error message if not successful.
 		 */
-		static BSLFXCompileResult compileTechniques(ParseState* parseState, const String& name, 
-			const Vector<String>& codeBlocks, const ShaderVariation& variation, ShadingLanguageFlags languages, 
-			UnorderedSet<String>& includes, SHADER_DESC& shaderDesc);
+		static void createTechniques(const CompiledVariation& variation, SHADER_DESC& shaderDesc);
 
 		/**
 		 * Converts a null-terminated string into a standard string, and eliminates quotes that are assumed to be at the 
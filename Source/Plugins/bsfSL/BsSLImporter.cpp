@@ -5,6 +5,9 @@
 #include "FileSystem/BsFileSystem.h"
 #include "BsSLFXCompiler.h"
 #include "Importer/BsShaderImportOptions.h"
+#include "Material/BsShader.h"
+#include "Material/BsShaderManager.h"
+#include "Reflection/BsRTTIType.h"
 
 namespace bs
 {
@@ -53,6 +56,29 @@ namespace bs
 		return result.shader;
 	}
 
+	bool SLImporter::getDependencies(const Path& filePath, const Vector<SubResourceRaw>& resources, 
+		Vector<Path>& dependencies) const
+	{
+		for (auto& entry : resources)
+		{
+			if (!rtti_is_of_type<Shader>(entry.value))
+				continue;
+
+			// Includes list every file included by the shader, including those included by other includes
+			SPtr<ShaderMetaData> metaData = std::static_pointer_cast<ShaderMetaData>(entry.value->getMetaData());
+			for (auto& include : metaData->includes)
+			{
+				Path includePath = ShaderManager::instance().findIncludePath(include);
+				if (includePath.isEmpty())
+					return false;
+
+				dependencies.push_back(includePath);
+			}
+		}
+
+		return true;
+	}
+
 	SPtr<ImportOptions> SLImporter::createImportOptions() const
 	{
 		return bs_shared_ptr_new<ShaderImportOptions>();
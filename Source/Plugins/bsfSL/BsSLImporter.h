@@ -30,6 +30,10 @@ namespace bs
 		/** @copydoc SpecificImporter::getAsyncMode */
 		ImporterAsyncMode getAsyncMode() const override { return ImporterAsyncMode::Single; }
 
+		/** @copydoc SpecificImporter::getDependencies */
+		bool getDependencies(const Path& filePath, const Vector<SubResourceRaw>& resources, 
+			Vector<Path>& dependencies) const override;
+
 		/** @copydoc SpecificImporter::import */
 		SPtr<Resource> import(const Path& filePath, SPtr<const ImportOptions> importOptions) override;
 